@@ -0,0 +1,193 @@
+/****************************************************************************
+ * AIMLAB - Shared-Memory Bridge Latency Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Measures the age of each tool-state sample as seen by a bridge
+ *   consumer, i.e. (consumer clock at read) - (writer timestamp).
+ *
+ *   Default mode runs a private 1 kHz publisher thread and a consumer
+ *   polling at Unity's 90 Hz, both in this process but talking only
+ *   through the shared segment. With --attach the benchmark acts as a
+ *   pure consumer of a running aimlab-haptics instance.
+ *
+ * Usage:
+ *   bench-bridge-latency [--seconds S] [--rate HZ] [--consumer-hz HZ]
+ *                        [--attach [NAME]]
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Publishes into tool slot 0
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "SharedMemoryBridge.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//===========================================================================
+// HELPERS
+//===========================================================================
+
+static double percentileUs(const vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return (double)sorted[index] / 1000.0;
+}
+
+static void sleepUntilNs(uint64_t deadline) {
+    uint64_t now = aimlab_bridge_now_ns();
+    if (deadline > now + 200000) {
+        this_thread::sleep_for(chrono::nanoseconds(deadline - now - 200000));
+    }
+    while (aimlab_bridge_now_ns() < deadline) {
+        // short final spin for an accurate publish period
+    }
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    double seconds = 5.0;
+    double rateHz = 1000.0;
+    double consumerHz = 90.0;
+    bool attach = false;
+    string name = "/aimlab_bridge_bench";
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--rate") && i + 1 < argc) {
+            rateHz = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--consumer-hz") && i + 1 < argc) {
+            consumerHz = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--attach")) {
+            attach = true;
+            name = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : AIMLAB_BRIDGE_DEFAULT_NAME;
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [--rate HZ] [--consumer-hz HZ] [--attach [NAME]]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+    // PUBLISHER (self-contained mode only)
+    //-----------------------------------------------------------------------
+    SharedMemoryBridge writer;
+    atomic<bool> running(true);
+    atomic<uint64_t> publishNsTotal(0);
+    atomic<uint64_t> publishCount(0);
+    thread publisher;
+
+    if (!attach) {
+        if (!writer.create(name.c_str())) {
+            fprintf(stderr, "could not create segment %s\n", name.c_str());
+            return 1;
+        }
+        publisher = thread([&]() {
+            const uint64_t period = (uint64_t)(1e9 / rateHz);
+            uint64_t deadline = aimlab_bridge_now_ns();
+            double pos[3] = { 0.0, 0.0, 0.0 };
+            double proxy[3] = { 0.0, 0.0, 0.0 };
+            double force[3] = { 0.0, 0.0, 0.0 };
+            while (running.load(memory_order_relaxed)) {
+                pos[0] += 1e-6;
+                uint64_t t0 = aimlab_bridge_now_ns();
+                writer.publishState(0, pos, proxy, force);
+                uint64_t t1 = aimlab_bridge_now_ns();
+                publishNsTotal.fetch_add(t1 - t0, memory_order_relaxed);
+                publishCount.fetch_add(1, memory_order_relaxed);
+                deadline += period;
+                sleepUntilNs(deadline);
+            }
+        });
+    }
+
+    //-----------------------------------------------------------------------
+    // CONSUMER
+    //-----------------------------------------------------------------------
+    aimlab_bridge* reader = aimlab_bridge_open(name.c_str());
+    if (reader == nullptr) {
+        fprintf(stderr, "could not attach to segment %s\n", name.c_str());
+        running = false;
+        if (publisher.joinable()) {
+            publisher.join();
+        }
+        return 1;
+    }
+
+    vector<uint64_t> ages;
+    ages.reserve((size_t)(seconds * consumerHz) + 16);
+    uint64_t busy = 0;
+    uint64_t empty = 0;
+    uint64_t repeated = 0;
+    uint64_t lastTick = 0;
+
+    const uint64_t period = (uint64_t)(1e9 / consumerHz);
+    const uint64_t end = aimlab_bridge_now_ns() + (uint64_t)(seconds * 1e9);
+    uint64_t deadline = aimlab_bridge_now_ns();
+
+    while (aimlab_bridge_now_ns() < end) {
+        aimlab_haptic_state state;
+        int rc = aimlab_bridge_read_state(reader, &state);
+        uint64_t now = aimlab_bridge_now_ns();
+
+        if (rc == AIMLAB_BRIDGE_OK) {
+            if (state.tick == lastTick) {
+                ++repeated;
+            }
+            lastTick = state.tick;
+            ages.push_back(now - state.timestamp_ns);
+        } else if (rc == AIMLAB_BRIDGE_BUSY) {
+            ++busy;
+        } else {
+            ++empty;
+        }
+
+        deadline += period;
+        sleepUntilNs(deadline);
+    }
+
+    running = false;
+    if (publisher.joinable()) {
+        publisher.join();
+    }
+    aimlab_bridge_close(reader);
+
+    //-----------------------------------------------------------------------
+    // REPORT
+    //-----------------------------------------------------------------------
+    sort(ages.begin(), ages.end());
+    printf("bridge latency (%s, consumer %.0f Hz, %.1f s)\n",
+           attach ? "attached" : "self-contained", consumerHz, seconds);
+    printf("  samples      : %zu (busy %llu, empty %llu, repeated %llu)\n", ages.size(),
+           (unsigned long long)busy, (unsigned long long)empty, (unsigned long long)repeated);
+    printf("  age min/p50  : %.2f / %.2f us\n", percentileUs(ages, 0.0), percentileUs(ages, 0.5));
+    printf("  age p99/p999 : %.2f / %.2f us\n", percentileUs(ages, 0.99), percentileUs(ages, 0.999));
+    printf("  age max      : %.2f us\n", percentileUs(ages, 1.0));
+    if (!attach && publishCount.load() > 0) {
+        printf("  publish cost : %.1f ns/tick over %llu ticks\n",
+               (double)publishNsTotal.load() / (double)publishCount.load(),
+               (unsigned long long)publishCount.load());
+    }
+
+    return 0;
+}
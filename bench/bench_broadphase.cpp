@@ -0,0 +1,261 @@
+/****************************************************************************
+ * AIMLAB - Broad-Phase Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Per-tick collision cost as the scene grows from 1 to 100k objects:
+ *
+ *     brute   the tool tests every sphere (what computeInteractionForces()
+ *             does with every object attached to the haptic world)
+ *     moves   BroadPhaseGrid::update() for the objects moved this tick;
+ *             depends on how many moved, not on the scene size
+ *     query   BroadPhaseGrid query around the tool, then the same test on
+ *             the candidates only
+ *
+ *   Spheres are scattered at a constant density, so a larger scene is a
+ *   larger room, not a more crowded one. Each tick the tool advances along
+ *   a circle through the scene and --moving random objects take a step of
+ *   up to 5 mm per axis, as Unity moves them through the bridge. The narrow phase is
+ *   a penalty force, summed in object order both ways; the benchmark exits
+ *   non-zero unless both give bit-identical forces on every tick.
+ *
+ *   CHAI3D-free: HapticBroadPhase only decides which objects are attached
+ *   to the haptic world, so the grid is measured here on its own.
+ *
+ * Usage:
+ *   bench-broadphase [--max-objects N] [--ticks N] [--moving N]
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "BroadPhaseGrid.h"
+#include "HapticClock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+static const double PI = 3.14159265358979323846;
+static const double SPACING = 0.05;         // about one object per 5 cm cube
+static const double TOOL_RADIUS = 0.015;
+static const double STIFFNESS = 500.0;
+static const double STEP = 0.005;           // largest move per axis per tick
+
+//===========================================================================
+// SCENE
+//===========================================================================
+
+struct Sphere {
+    double pos[3];
+    double radius;
+};
+
+/**
+ * @brief Small deterministic generator, so every run builds the same scene
+ */
+class Random {
+public:
+    explicit Random(uint64_t a_seed) : m_state(a_seed) {}
+    double next() {
+        m_state = m_state * 6364136223846793005ull + 1442695040888963407ull;
+        return (double)(m_state >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+static void sphereBox(const Sphere& a_sphere, double a_min[3], double a_max[3]) {
+    for (int k = 0; k < 3; k++) {
+        a_min[k] = a_sphere.pos[k] - a_sphere.radius;
+        a_max[k] = a_sphere.pos[k] + a_sphere.radius;
+    }
+}
+
+/**
+ * @brief Penalty force of one sphere on the tool (added to a_force)
+ */
+static void addContactForce(const Sphere& a_sphere, const double a_tool[3], double a_force[3]) {
+    const double d[3] = { a_tool[0] - a_sphere.pos[0], a_tool[1] - a_sphere.pos[1],
+                          a_tool[2] - a_sphere.pos[2] };
+    const double reach = a_sphere.radius + TOOL_RADIUS;
+    const double dist2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    if (dist2 >= reach * reach || dist2 == 0.0) {
+        return;
+    }
+    const double dist = sqrt(dist2);
+    const double scale = STIFFNESS * (reach - dist) / dist;
+    for (int k = 0; k < 3; k++) {
+        a_force[k] += scale * d[k];
+    }
+}
+
+//===========================================================================
+// RUN
+//===========================================================================
+
+struct SweepResult {
+    size_t objects;
+    double side;
+    double buildMs;
+    double bruteUs;
+    double movesUs;
+    double queryUs;
+    double queryP99Us;
+    double candidates;
+    bool identical;
+};
+
+static double percentile(vector<double>& a_values, double a_p) {
+    sort(a_values.begin(), a_values.end());
+    return a_values[min(a_values.size() - 1, (size_t)(a_p * (double)a_values.size()))];
+}
+
+static SweepResult runScene(size_t a_objects, int a_ticks, size_t a_moving) {
+    SweepResult result;
+    result.objects = a_objects;
+    result.side = SPACING * cbrt((double)a_objects);
+
+    Random random(12345 + a_objects);
+    vector<Sphere> spheres(a_objects);
+    for (size_t i = 0; i < a_objects; i++) {
+        for (int k = 0; k < 3; k++) {
+            spheres[i].pos[k] = random.next() * result.side;
+        }
+        spheres[i].radius = 0.005 + 0.015 * random.next();
+    }
+
+    // Same cell size rule as HapticBroadPhase: median size (25 mm), at least
+    // twice the tool radius
+    uint64_t t0 = hapticNowNs();
+    BroadPhaseGrid grid(max(0.025, 2.0 * TOOL_RADIUS), a_objects);
+    for (size_t i = 0; i < a_objects; i++) {
+        double min[3], max[3];
+        sphereBox(spheres[i], min, max);
+        grid.insert(min, max);
+    }
+    result.buildMs = (double)(hapticNowNs() - t0) * 1e-6;
+
+    vector<uint32_t> candidates;
+    candidates.reserve(a_objects);
+    vector<double> queryTimes;
+    queryTimes.reserve(a_ticks);
+    double bruteNs = 0.0, movesNs = 0.0, queryNs = 0.0, candidateSum = 0.0;
+    bool identical = true;
+
+    for (int tick = 0; tick < a_ticks; tick++) {
+        // Tool on a circle through the scene, slightly inside its edges
+        const double angle = 2.0 * PI * tick / a_ticks;
+        const double centre = 0.5 * result.side;
+        const double tool[3] = { centre + 0.4 * result.side * cos(angle),
+                                 centre + 0.4 * result.side * sin(angle), centre };
+
+        // Objects the bridge moved this tick (not timed: both sides pay it)
+        size_t moved[64];
+        const size_t movedCount = min(min(a_moving, a_objects), (size_t)64);
+        for (size_t m = 0; m < movedCount; m++) {
+            moved[m] = (size_t)(random.next() * (double)a_objects) % a_objects;
+            for (int k = 0; k < 3; k++) {
+                double& p = spheres[moved[m]].pos[k];
+                p = min(result.side, max(0.0, p + STEP * (2.0 * random.next() - 1.0)));
+            }
+        }
+
+        // Brute force: every object
+        t0 = hapticNowNs();
+        double bruteForce[3] = { 0.0, 0.0, 0.0 };
+        for (size_t i = 0; i < a_objects; i++) {
+            addContactForce(spheres[i], tool, bruteForce);
+        }
+        const uint64_t t1 = hapticNowNs();
+
+        // Grid: incremental moves, then query and narrow phase on the candidates
+        for (size_t m = 0; m < movedCount; m++) {
+            double min[3], max[3];
+            sphereBox(spheres[moved[m]], min, max);
+            grid.update((uint32_t)moved[m], min, max);
+        }
+        const uint64_t t2 = hapticNowNs();
+        double queryMin[3], queryMax[3];
+        for (int k = 0; k < 3; k++) {
+            queryMin[k] = tool[k] - TOOL_RADIUS;
+            queryMax[k] = tool[k] + TOOL_RADIUS;
+        }
+        candidates.clear();
+        grid.query(queryMin, queryMax, candidates);
+        sort(candidates.begin(), candidates.end());     // same summation order as brute
+        double gridForce[3] = { 0.0, 0.0, 0.0 };
+        for (size_t i = 0; i < candidates.size(); i++) {
+            addContactForce(spheres[candidates[i]], tool, gridForce);
+        }
+        const uint64_t t3 = hapticNowNs();
+
+        bruteNs += (double)(t1 - t0);
+        movesNs += (double)(t2 - t1);
+        queryNs += (double)(t3 - t2);
+        queryTimes.push_back((double)(t3 - t2) * 1e-3);
+        candidateSum += (double)candidates.size();
+
+        if (memcmp(bruteForce, gridForce, sizeof(bruteForce)) != 0) {
+            identical = false;
+        }
+    }
+
+    result.bruteUs = bruteNs * 1e-3 / a_ticks;
+    result.movesUs = movesNs * 1e-3 / a_ticks;
+    result.queryUs = queryNs * 1e-3 / a_ticks;
+    result.queryP99Us = percentile(queryTimes, 0.99);
+    result.candidates = candidateSum / a_ticks;
+    result.identical = identical;
+    return result;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    size_t maxObjects = 100000;
+    int ticks = 2000;
+    size_t moving = 16;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--max-objects") && i + 1 < argc) {
+            maxObjects = max((size_t)1, (size_t)atol(argv[++i]));
+        } else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+            ticks = max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--moving") && i + 1 < argc) {
+            moving = (size_t)atol(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--max-objects N] [--ticks N] [--moving N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("broad phase (%d ticks per scene, %zu objects moved per tick, tool radius %.0f mm)\n",
+           ticks, min(moving, (size_t)64), TOOL_RADIUS * 1e3);
+    printf("  %8s %7s %9s %10s %9s %9s %9s %8s %10s  %s\n", "objects", "side m", "build ms",
+           "brute us", "moves us", "query us", "q p99 us", "speedup", "candidates", "forces");
+
+    bool pass = true;
+    for (size_t objects = 1; objects <= maxObjects; objects *= 10) {
+        const SweepResult r = runScene(objects, ticks, moving);
+        printf("  %8zu %7.2f %9.2f %10.3f %9.3f %9.3f %9.3f %7.1fx %10.2f  %s\n", r.objects,
+               r.side, r.buildMs, r.bruteUs, r.movesUs, r.queryUs, r.queryP99Us,
+               r.bruteUs / (r.movesUs + r.queryUs), r.candidates,
+               r.identical ? "identical" : "DIFFER");
+        pass = pass && r.identical;
+    }
+    printf("  result: %s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+/****************************************************************************
+ * AIMLAB - Device Filter Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.2
+ *
+ * Description:
+ *   Highest wall stiffness that renders stably through a slow device, with
+ *   and without the --device-filter stage (DeviceFilter):
+ *
+ *     raw        the 1 kHz haptic tick pushes on the newest device sample
+ *                (what the tool does today)
+ *     extrap     DeviceFilter without the passivity controller: least-
+ *                squares velocity, extrapolation and force low-pass only
+ *     filter     the full DeviceFilter (--device-filter defaults)
+ *
+ *   A simulated hand (mass, spring toward a target 3 mm inside the wall,
+ *   light damping) is integrated at 20 kHz. It reaches the wall at
+ *   0.15 m/s and then keeps pressing. The device measures its position at
+ *   --device-rate with 10 um encoder steps and delivers each sample
+ *   --latency-ms later, like a serial device; --jitter-ms adds up to that
+ *   much again at random to each delivery (fixed seed, same order). The
+ *   wall is a one-sided spring; the device saturates at 10 N.
+ *
+ *   Per stiffness and mode the report gives the peak-to-peak position
+ *   over the last second (a stable contact has settled), the net work the
+ *   wall did on the hand (positive = the wall is active and the contact
+ *   buzzes) and, with the filter, the p99 time since the reading changed
+ *   (DeviceFilter::timeSinceChangeNs()). A run is stable when the contact
+ *   has settled to within 0.1 mm.
+ *
+ *   Measured limit at the defaults: raw 250 N/m, extrapolation and the full
+ *   filter 500 N/m. The low-pass and the passivity controller do not raise
+ *   the stable stiffness; above it they only cut the wall's work. The
+ *   default scene material (1000 N/m) is unstable in every mode. A larger
+ *   damping limit, another cutoff or window, or a horizon capped at the
+ *   sample period did not move the limit; a 10 ms horizon reached 750 N/m
+ *   at 100 Hz and 2 ms latency only, so the defaults were left alone.
+ *
+ *   CHAI3D-free and deterministic. Fails unless the filter stays stable
+ *   up to at least twice the stiffness raw sampling does, and at least as
+ *   high as extrapolation alone (the low-pass and the passivity
+ *   controller must not cost stable stiffness).
+ *
+ * Usage:
+ *   bench-device-filter [--device-rate HZ] [--latency-ms MS] [--jitter-ms MS]
+ *                       [--seconds S] [--stiffness N,N,...]
+ *
+ * Changelog:
+ *   v1.2 - 16 October 2026 - Time since change instead of sample age; measured limit stated
+ *   v1.1 - 16 October 2026 - Also fails if the full filter is less stable than extrapolation alone
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "DeviceFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const double PHYSICS_HZ = 20000.0;
+static const double HAPTIC_HZ = 1000.0;
+static const double HAND_MASS = 0.3;            // kg, hand and linkage
+static const double HAND_STIFFNESS = 200.0;     // N/m toward the target
+static const double HAND_DAMPING = 4.0;         // N.s/m
+static const double HAND_TARGET = 0.003;        // m inside the wall
+static const double START_POS = -0.005;         // m, outside the wall
+static const double START_VEL = 0.15;           // m/s toward the wall
+static const double ENCODER_STEP = 10e-6;       // m
+static const double MAX_FORCE = 10.0;           // N
+static const double MAX_DAMPING = 20.0;         // N.s/m, the device's maximum
+static const double SETTLED_PP = 1e-4;          // m peak-to-peak over the last second
+
+enum FilterMode {
+    MODE_RAW,
+    MODE_EXTRAPOLATE,
+    MODE_FILTER,
+    MODE_COUNT
+};
+
+static const char* modeName(int a_mode) {
+    switch (a_mode) {
+        case MODE_RAW:          return "raw";
+        case MODE_EXTRAPOLATE:  return "extrap";
+        default:                return "filter";
+    }
+}
+
+struct RunResult {
+    double peakToPeak;          // m over the last second
+    double wallWork;            // J the wall did on the hand
+    double sinceChangeP99Ms;    // time since the reading changed, per tick (filter modes)
+    uint64_t dampedTicks;
+};
+
+//===========================================================================
+// SIMULATION
+//===========================================================================
+
+/**
+ * @brief One contact run: the hand hits the wall and keeps pressing
+ */
+static RunResult run(int a_mode, double a_stiffness, double a_seconds, double a_deviceHz,
+                     double a_latencyS, double a_jitterS) {
+    DeviceFilterConfig config;
+    config.passivity = (a_mode == MODE_FILTER);
+    DeviceFilter filter(config, MAX_DAMPING);
+
+    const double dt = 1.0 / PHYSICS_HZ;
+    const long long steps = (long long)(a_seconds * PHYSICS_HZ);
+    const long long stepsPerTick = (long long)(PHYSICS_HZ / HAPTIC_HZ);
+    const double samplePeriod = 1.0 / a_deviceHz;
+
+    // Samples in flight: (delivery time, measured position)
+    vector<pair<double, double> > inFlight;
+    double nextSample = 0.0;
+    double delivered = START_POS;
+    uint32_t seed = 12345;
+
+    double x = START_POS, v = START_VEL, force = 0.0;
+    double lo = 1e9, hi = -1e9, work = 0.0;
+    vector<uint64_t> sinceChange;
+
+    for (long long n = 0; n < steps; n++) {
+        const double t = n * dt;
+
+        // Device transport: measure, quantise, deliver after the latency
+        // and jitter, in order
+        if (t >= nextSample) {
+            seed = seed * 1103515245u + 12345u;
+            const double jitter = a_jitterS * ((seed >> 8) & 0xffff) / 65536.0;
+            inFlight.push_back(make_pair(t + a_latencyS + jitter,
+                                         floor(x / ENCODER_STEP) * ENCODER_STEP));
+            nextSample += samplePeriod;
+        }
+        while (!inFlight.empty() && inFlight.front().first <= t) {
+            delivered = inFlight.front().second;
+            inFlight.erase(inFlight.begin());
+        }
+
+        // Haptic tick: wall force from the (filtered) position, held until the next tick
+        if (n % stepsPerTick == 0) {
+            double pos = delivered;
+            if (a_mode != MODE_RAW) {
+                filter.beginTick((uint64_t)(n * (1e9 / PHYSICS_HZ)));
+                const double reading[3] = { delivered, 0.0, 0.0 };
+                filter.addReading(reading);
+                double estimate[3];
+                filter.getPosition(estimate);
+                pos = estimate[0];
+                sinceChange.push_back(filter.timeSinceChangeNs());
+            }
+            double command[3] = { (pos > 0.0) ? -a_stiffness * pos : 0.0, 0.0, 0.0 };
+            if (a_mode != MODE_RAW) {
+                double out[3];
+                filter.filterForce(command, out);
+                command[0] = out[0];
+            }
+            force = max(-MAX_FORCE, min(command[0], MAX_FORCE));
+        }
+
+        // Hand and linkage (semi-implicit Euler)
+        const double hand = HAND_STIFFNESS * (HAND_TARGET - x) - HAND_DAMPING * v;
+        v += (hand + force) / HAND_MASS * dt;
+        x += v * dt;
+        work += force * v * dt;
+
+        if (t >= a_seconds - 1.0) {
+            lo = min(lo, x);
+            hi = max(hi, x);
+        }
+    }
+
+    RunResult result;
+    result.peakToPeak = hi - lo;
+    result.wallWork = work;
+    result.sinceChangeP99Ms = 0.0;
+    if (!sinceChange.empty()) {
+        sort(sinceChange.begin(), sinceChange.end());
+        result.sinceChangeP99Ms = sinceChange[(size_t)(0.99 * (sinceChange.size() - 1))] * 1e-6;
+    }
+    result.dampedTicks = filter.dampedTicks();
+    return result;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    double deviceHz = 100.0;
+    double latencyMs = 2.0;
+    double jitterMs = 0.0;
+    double seconds = 3.0;
+    vector<double> stiffness = { 250.0, 500.0, 750.0, 1000.0, 1500.0, 2000.0, 3000.0 };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--device-rate") && i + 1 < argc) {
+            deviceHz = max(1.0, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--latency-ms") && i + 1 < argc) {
+            latencyMs = max(0.0, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--jitter-ms") && i + 1 < argc) {
+            jitterMs = max(0.0, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = max(2.0, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--stiffness") && i + 1 < argc) {
+            stiffness.clear();
+            string list = argv[++i];
+            for (size_t begin = 0; begin <= list.size(); ) {
+                const size_t end = min(list.find(',', begin), list.size());
+                stiffness.push_back(atof(list.substr(begin, end - begin).c_str()));
+                begin = end + 1;
+            }
+        } else {
+            fprintf(stderr, "usage: %s [--device-rate HZ] [--latency-ms MS] [--jitter-ms MS] "
+                    "[--seconds S] [--stiffness N,N,...]\n"
+                    "  At the defaults the filter holds 500 N/m, as extrapolation alone does;\n"
+                    "  the default scene material (1000 N/m) is unstable in every mode.\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("device filter (%.0f Hz device, %.1f ms latency + %.1f ms jitter, %.0f Hz haptic, "
+           "%.1f s per run)\n", deviceHz, latencyMs, jitterMs, HAPTIC_HZ, seconds);
+    printf("  %9s %7s %12s %11s %12s %13s %7s\n", "stiffness", "mode", "p-p last s",
+           "wall work", "change p99", "damped ticks", "stable");
+
+    // Highest stiffness each mode renders stably, with every lower one stable too
+    double stable[MODE_COUNT] = { 0.0, 0.0, 0.0 };
+    bool broken[MODE_COUNT] = { false, false, false };
+    for (size_t i = 0; i < stiffness.size(); i++) {
+        for (int mode = 0; mode < MODE_COUNT; mode++) {
+            const RunResult r = run(mode, stiffness[i], seconds, deviceHz, latencyMs * 1e-3,
+                                      jitterMs * 1e-3);
+            const bool ok = r.peakToPeak < SETTLED_PP;
+            printf("  %5.0f N/m %7s %9.3f mm %9.4f J %9.2f ms %13llu %7s\n", stiffness[i],
+                   modeName(mode), r.peakToPeak * 1e3, r.wallWork, r.sinceChangeP99Ms,
+                   (unsigned long long)r.dampedTicks, ok ? "yes" : "no");
+            if (ok && !broken[mode]) {
+                stable[mode] = stiffness[i];
+            } else if (!ok) {
+                broken[mode] = true;
+            }
+        }
+    }
+
+    printf("  highest stable stiffness:");
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+        printf(" %s %.0f N/m%s", modeName(mode), stable[mode], (mode + 1 < MODE_COUNT) ? "," : "\n");
+    }
+    const bool pass = stable[MODE_FILTER] >= 2.0 * stable[MODE_RAW] &&
+                      stable[MODE_FILTER] >= stable[MODE_EXTRAPOLATE] && stable[MODE_FILTER] > 0.0;
+    printf("  result: %s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/****************************************************************************
+ * AIMLAB - Logging Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   How long a thread is blocked per message: cout << ... << endl, as the
+ *   application used to print, against AIMLAB_LOG_INFO. Both write the same
+ *   stats-style line with four numbers to the same file (--sink). For the
+ *   cout run, cout is redirected to the file so every endl still flushes
+ *   with one write() per line. Two patterns:
+ *
+ *     paced   one message per tick from a 1 kHz thread, like a haptic
+ *             thread printing every tick
+ *     burst   --burst messages back to back every 50 ms, like a stats
+ *             dump or a startup banner
+ *
+ *   For each run the report gives the p50, p99 and maximum time in the
+ *   call and the number of messages the log dropped. Writing to a
+ *   terminal or a slow pipe makes cout much worse; --sink /dev/tty
+ *   shows that. CHAI3D-free.
+ *   Fails unless the log's p99 is below cout's in both patterns and the
+ *   paced run drops nothing.
+ *
+ * Usage:
+ *   bench-logging [--messages N] [--burst N] [--sink PATH]
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "AsyncLog.h"
+#include "HapticClock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//===========================================================================
+// MESSAGE SOURCES
+//===========================================================================
+
+enum Pattern { PATTERN_PACED, PATTERN_BURST };
+enum Method { METHOD_COUT, METHOD_ASYNC };
+
+struct RunResult {
+    uint64_t p50Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t maxNs = 0;
+    uint64_t dropped = 0;
+};
+
+/**
+ * @brief Emit a_messages lines from a fresh thread and time every call
+ */
+static RunResult runPattern(Method a_method, Pattern a_pattern, int a_messages, int a_burst) {
+    vector<uint64_t> durations;
+    durations.reserve(a_messages);
+
+    std::thread producer([&]() {
+        uint64_t next = hapticNowNs();
+        for (int i = 0; i < a_messages; i++) {
+            if (a_pattern == PATTERN_PACED || i % a_burst == 0) {
+                next += (a_pattern == PATTERN_PACED) ? 1000000ull : 50000000ull;
+                while (hapticNowNs() < next) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+
+            const double x = 0.001 * (i % 97), y = -0.002 * (i % 31), z = 0.0005 * (i % 13);
+            const double force = 0.01 * (i % 211);
+            const uint64_t t0 = hapticNowNs();
+            if (a_method == METHOD_COUT) {
+                cout << "[bench] tick " << i << " pos " << fixed << setprecision(4) << x << ", "
+                     << y << ", " << z << " force " << setprecision(3) << force << " N" << endl;
+            } else {
+                AIMLAB_LOG_INFO("[bench] tick %d pos %.4f, %.4f, %.4f force %.3f N", i, x, y, z, force);
+            }
+            durations.push_back(hapticNowNs() - t0);
+        }
+    });
+    producer.join();
+
+    RunResult result;
+    std::sort(durations.begin(), durations.end());
+    if (!durations.empty()) {
+        result.p50Ns = durations[durations.size() / 2];
+        result.p99Ns = durations[std::min(durations.size() - 1, durations.size() * 99 / 100)];
+        result.maxNs = durations.back();
+    }
+    return result;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    int messages = 5000;
+    int burst = 200;
+    string sink = "bench-logging.log";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--messages") == 0 && i + 1 < argc) {
+            messages = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--burst") == 0 && i + 1 < argc) {
+            burst = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sink") == 0 && i + 1 < argc) {
+            sink = argv[++i];
+        } else {
+            printf("Usage: bench-logging [--messages N] [--burst N] [--sink PATH]\n");
+            return 1;
+        }
+    }
+    if (messages < 1 || burst < 1) {
+        printf("--messages and --burst must be positive\n");
+        return 1;
+    }
+
+    printf("[bench] Blocking time per message, %d messages per run, to %s\n", messages, sink.c_str());
+    printf("[bench] %-7s %-6s %10s %10s %10s %8s\n", "pattern", "method", "p50 us", "p99 us", "max us",
+           "dropped");
+
+    bool pass = true;
+    const Pattern patterns[] = { PATTERN_PACED, PATTERN_BURST };
+    for (Pattern pattern : patterns) {
+        // cout, redirected to the sink file; endl flushes every line
+        RunResult coutResult;
+        {
+            ofstream file(sink.c_str(), ios::out | ios::trunc);
+            if (!file) {
+                printf("[bench] Could not open %s\n", sink.c_str());
+                return 1;
+            }
+            streambuf* console = cout.rdbuf(file.rdbuf());
+            coutResult = runPattern(METHOD_COUT, pattern, messages, burst);
+            cout.rdbuf(console);
+        }
+
+        // Async log into the same file
+        RunResult asyncResult;
+        {
+            FILE* file = fopen(sink.c_str(), "w");
+            if (file == nullptr) {
+                printf("[bench] Could not open %s\n", sink.c_str());
+                return 1;
+            }
+            asyncLogStart(file);
+            asyncResult = runPattern(METHOD_ASYNC, pattern, messages, burst);
+            asyncResult.dropped = asyncLogDropped();
+            asyncLogStop();
+            fclose(file);
+        }
+
+        const char* name = (pattern == PATTERN_PACED) ? "paced" : "burst";
+        const RunResult* results[] = { &coutResult, &asyncResult };
+        const char* methods[] = { "cout", "async" };
+        for (int m = 0; m < 2; m++) {
+            printf("[bench] %-7s %-6s %10.2f %10.2f %10.2f %8llu\n", name, methods[m],
+                   results[m]->p50Ns * 1e-3, results[m]->p99Ns * 1e-3, results[m]->maxNs * 1e-3,
+                   (unsigned long long)results[m]->dropped);
+        }
+
+        if (asyncResult.p99Ns >= coutResult.p99Ns) {
+            pass = false;
+        }
+        if (pattern == PATTERN_PACED && asyncResult.dropped > 0) {
+            pass = false;
+        }
+    }
+
+    printf("result: %s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+/****************************************************************************
+ * AIMLAB - Multirate Rendering Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Haptic-rate stability as the simulation gets more expensive, with and
+ *   without --multirate:
+ *
+ *     single   every 1 kHz haptic tick runs the simulation step, then
+ *              renders its result (updateHaptics() without --multirate)
+ *     multi    a simulation thread runs the step at --sim-rate and
+ *              publishes a LocalContactModel; the 1 kHz haptic thread
+ *              renders the newest model (computeLocalTick())
+ *
+ *   The scene is one 50 mm sphere. The tool slides around it and moves in
+ *   and out of contact. A simulation step finds the contact plane, as
+ *   publishContactModel() does, then busy-waits --loads milliseconds to
+ *   stand in for dynamics or a large scene. Per load and mode the report
+ *   gives the haptic rate, the p99 tick period, the largest force change
+ *   between two ticks (a jolt when the rate collapses) and the RMS error
+ *   against the exact sphere force at the tool position.
+ *
+ *   CHAI3D-free. Fails unless multirate keeps 90% of the haptic rate at
+ *   every load. Give it at least two cores, as the application needs.
+ *
+ * Usage:
+ *   bench-multirate [--seconds S] [--rate HZ] [--sim-rate HZ]
+ *                   [--loads MS,MS,...]
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "HapticClock.h"
+#include "HapticScheduler.h"
+#include "LocalContactModel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+static const double PI = 3.14159265358979323846;
+static const double SPHERE_RADIUS = 0.05;
+static const double TOOL_RADIUS = 0.015;
+static const double STIFFNESS = 1000.0;
+
+//===========================================================================
+// SHARED STATE
+//===========================================================================
+
+static HapticSampleBuffer samples;              // static storage: keeps alignas(64)
+static LocalContactBuffer contactModels;
+static atomic<bool> running(false);
+
+//===========================================================================
+// SCENE
+//===========================================================================
+
+/**
+ * @brief Tool position at a_seconds: 0.5 Hz around the sphere, 3 Hz in and
+ *        out of contact (-3 to +5 mm penetration)
+ */
+static void toolPosition(double a_seconds, double a_pos[3]) {
+    const double angle = 2.0 * PI * 0.5 * a_seconds;
+    const double radius = SPHERE_RADIUS + TOOL_RADIUS - 0.001 -
+                          0.004 * sin(2.0 * PI * 3.0 * a_seconds);
+    a_pos[0] = radius * cos(angle);
+    a_pos[1] = radius * sin(angle);
+    a_pos[2] = 0.0;
+}
+
+static void exactForce(const double a_pos[3], double a_force[3]) {
+    const double distance = sqrt(a_pos[0] * a_pos[0] + a_pos[1] * a_pos[1] + a_pos[2] * a_pos[2]);
+    const double depth = SPHERE_RADIUS + TOOL_RADIUS - distance;
+    for (int k = 0; k < 3; k++) {
+        a_force[k] = (depth > 0.0) ? STIFFNESS * depth * a_pos[k] / distance : 0.0;
+    }
+}
+
+/**
+ * @brief One simulation step: the sphere's tangent plane if the tool is
+ *        within the margin, then a_loadNs of busy work
+ */
+static void simulationStep(const double a_pos[3], uint64_t a_loadNs, uint64_t a_step,
+                           LocalContactModel& a_model) {
+    const uint64_t start = hapticNowNs();
+    const double distance = sqrt(a_pos[0] * a_pos[0] + a_pos[1] * a_pos[1] + a_pos[2] * a_pos[2]);
+    a_model.planeCount = 0;
+    a_model.toolRadius = TOOL_RADIUS;
+    if (distance < SPHERE_RADIUS + TOOL_RADIUS + AIMLAB_LOCAL_MODEL_MARGIN) {
+        const double normal[3] = { a_pos[0] / distance, a_pos[1] / distance, a_pos[2] / distance };
+        const double point[3] = { normal[0] * SPHERE_RADIUS, normal[1] * SPHERE_RADIUS,
+                                  normal[2] * SPHERE_RADIUS };
+        addLocalContactPlane(a_model, point, normal, STIFFNESS);
+    }
+    while (hapticNowNs() - start < a_loadNs) {
+    }
+    a_model.step = a_step;
+    a_model.timestampNs = hapticNowNs();
+}
+
+//===========================================================================
+// RUN
+//===========================================================================
+
+struct RunResult {
+    double rateHz;
+    double periodP99Us;
+    double maxStepN;
+    double rmsErrorN;
+    double simulationHz;
+};
+
+static double percentile(vector<double>& a_values, double a_p) {
+    if (a_values.empty()) {
+        return 0.0;
+    }
+    sort(a_values.begin(), a_values.end());
+    return a_values[min(a_values.size() - 1, (size_t)(a_p * (double)a_values.size()))];
+}
+
+static void simulationThread(double a_rateHz, uint64_t a_loadNs, atomic<uint64_t>* a_steps) {
+    HapticSchedulerConfig config;
+    config.rateHz = a_rateHz;
+    config.spinNs = 0;
+    HapticScheduler scheduler(config);
+    scheduler.start(hapticNowNs());
+
+    uint64_t step = 0;
+    while (running) {
+        scheduler.waitForNextTick();
+        samples.acquire();
+        const HapticSample& sample = samples.readBuffer();
+        simulationStep(sample.position, a_loadNs, ++step, contactModels.writeBuffer());
+        contactModels.publish();
+        a_steps->store(step, memory_order_relaxed);
+    }
+}
+
+static RunResult run(bool a_multirate, double a_seconds, double a_rateHz, double a_simulationHz,
+                     uint64_t a_loadNs) {
+    HapticSchedulerConfig config;
+    config.rateHz = a_rateHz;
+    HapticScheduler scheduler(config);
+
+    // Start both modes from an empty model
+    memset(&contactModels.writeBuffer(), 0, sizeof(LocalContactModel));
+    contactModels.publish();
+    contactModels.acquire();
+
+    running = true;
+    atomic<uint64_t> steps(0);
+    thread simulation;
+    if (a_multirate) {
+        simulation = thread(simulationThread, a_simulationHz, a_loadNs, &steps);
+    }
+
+    LocalContactModel singleRateModel;
+    memset(&singleRateModel, 0, sizeof(singleRateModel));
+    vector<double> periods;
+    periods.reserve((size_t)(a_seconds * a_rateHz) + 16);
+    double previous[3] = { 0.0, 0.0, 0.0 };
+    double maxStep = 0.0, squaredError = 0.0;
+    uint64_t ticks = 0, lastTick = 0;
+
+    const uint64_t start = hapticNowNs();
+    scheduler.start(start);
+    while (true) {
+        scheduler.waitForNextTick();
+        const uint64_t now = hapticNowNs();
+        if (now - start >= (uint64_t)(a_seconds * 1e9)) {
+            break;
+        }
+        if (lastTick != 0) {
+            periods.push_back((double)(now - lastTick) * 1e-3);
+        }
+        lastTick = now;
+
+        double pos[3];
+        toolPosition((double)(now - start) * 1e-9, pos);
+
+        const LocalContactModel* model = &singleRateModel;
+        if (a_multirate) {
+            HapticSample& sample = samples.writeBuffer();
+            memcpy(sample.position, pos, sizeof(pos));
+            samples.publish();
+            contactModels.acquire();
+            model = &contactModels.readBuffer();
+        } else {
+            simulationStep(pos, a_loadNs, ticks + 1, singleRateModel);
+        }
+
+        double force[3], exact[3];
+        computeLocalContactForce(*model, pos, force);
+        exactForce(pos, exact);
+
+        double step = 0.0, error = 0.0;
+        for (int k = 0; k < 3; k++) {
+            step += (force[k] - previous[k]) * (force[k] - previous[k]);
+            error += (force[k] - exact[k]) * (force[k] - exact[k]);
+            previous[k] = force[k];
+        }
+        maxStep = max(maxStep, sqrt(step));
+        squaredError += error;
+        ticks++;
+    }
+    const double elapsed = (double)(hapticNowNs() - start) * 1e-9;
+
+    running = false;
+    if (simulation.joinable()) {
+        simulation.join();
+    }
+
+    RunResult result;
+    result.rateHz = (double)ticks / elapsed;
+    result.periodP99Us = percentile(periods, 0.99);
+    result.maxStepN = maxStep;
+    result.rmsErrorN = (ticks > 0) ? sqrt(squaredError / (double)ticks) : 0.0;
+    result.simulationHz = a_multirate ? (double)steps.load() / elapsed : result.rateHz;
+    return result;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    double seconds = 1.0;
+    double rateHz = 1000.0;
+    double simulationHz = 150.0;
+    vector<double> loadsMs = { 0.0, 0.5, 1.0, 2.0, 5.0, 10.0, 20.0 };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = max(0.1, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--rate") && i + 1 < argc) {
+            rateHz = max(1.0, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--sim-rate") && i + 1 < argc) {
+            simulationHz = max(1.0, atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--loads") && i + 1 < argc) {
+            loadsMs.clear();
+            string list = argv[++i];
+            for (size_t begin = 0; begin <= list.size(); ) {
+                const size_t end = min(list.find(',', begin), list.size());
+                loadsMs.push_back(atof(list.substr(begin, end - begin).c_str()));
+                begin = end + 1;
+            }
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [--rate HZ] [--sim-rate HZ] "
+                    "[--loads MS,MS,...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("multirate rendering (%.0f Hz haptic, %.0f Hz simulation, %.1f s per run, %u cores)\n",
+           rateHz, simulationHz, seconds, thread::hardware_concurrency());
+    printf("  %8s %7s %10s %12s %11s %11s %9s\n", "load ms", "mode", "haptic Hz",
+           "period p99", "max step N", "rms err N", "sim Hz");
+
+    bool pass = true;
+    for (size_t i = 0; i < loadsMs.size(); i++) {
+        const uint64_t loadNs = (uint64_t)(loadsMs[i] * 1e6);
+        for (int multirate = 0; multirate < 2; multirate++) {
+            const RunResult r = run(multirate != 0, seconds, rateHz, simulationHz, loadNs);
+            printf("  %8.1f %7s %10.0f %9.0f us %11.3f %11.4f %9.0f\n", loadsMs[i],
+                   multirate ? "multi" : "single", r.rateHz, r.periodP99Us, r.maxStepN,
+                   r.rmsErrorN, r.simulationHz);
+            if (multirate && r.rateHz < 0.9 * rateHz) {
+                pass = false;
+            }
+        }
+    }
+    printf("  result: %s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,352 @@
+/****************************************************************************
+ * AIMLAB - Primitive Force Kernel Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Per-tick cost of the contact force against every primitive of a
+ *   sphere-cloud scene, from 100 to 100k primitives:
+ *
+ *     object   one object at a time through a virtual call, each in its
+ *              own heap allocation (how CHAI3D visits a world's objects)
+ *     scalar   PrimitiveBatch with the scalar kernel (--no-simd)
+ *     avx2     PrimitiveBatch with the AVX2 kernel (if built and supported)
+ *
+ *   The scene is spheres (5-20 mm), one in ten a rotated box, over a floor
+ *   plane, at a density where the tool touches a few at a time. The tool
+ *   moves along a circle through the cloud, so friction acts. All three
+ *   use the contact law of PrimitiveKernels.h.
+ *
+ *   Fails if a batched force differs from the per-object one by more than
+ *   1e-9 relative, or if the batched p99 exceeds 1 ms at or below
+ *   --budget-objects primitives. CHAI3D-free.
+ *
+ * Usage:
+ *   bench-primitives [--max-objects N] [--ticks N] [--budget-objects N]
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "HapticClock.h"
+#include "PrimitiveBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+static const double PI = 3.14159265358979323846;
+static const double SPACING = 0.03;         // about one primitive per 3 cm cube
+static const double TOOL_RADIUS = 0.015;
+static const double STIFFNESS = 1000.0;
+static const double FRICTION = 0.2;
+static const double TOLERANCE = 1e-9;       // relative to max(1 N, |force|)
+
+//===========================================================================
+// PER-OBJECT REFERENCE
+//===========================================================================
+
+/**
+ * @brief Small deterministic generator, so every run builds the same scene
+ */
+class Random {
+public:
+    explicit Random(uint64_t a_seed) : m_state(a_seed) {}
+    double next() {
+        m_state = m_state * 6364136223846793005ull + 1442695040888963407ull;
+        return (double)(m_state >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+class Primitive {
+public:
+    virtual ~Primitive() {}
+    virtual void addForce(const PrimitiveTool& a_tool, double a_force[3]) const = 0;
+
+protected:
+    static void addContact(double a_depth, const double a_n[3], const PrimitiveTool& a_tool,
+                           double a_force[3]) {
+        const double fn = STIFFNESS * a_depth;
+        const double* v = a_tool.vel;
+        const double vn = v[0] * a_n[0] + v[1] * a_n[1] + v[2] * a_n[2];
+        const double vt[3] = { v[0] - vn * a_n[0], v[1] - vn * a_n[1], v[2] - vn * a_n[2] };
+        const double speed = sqrt(vt[0] * vt[0] + vt[1] * vt[1] + vt[2] * vt[2]);
+        const double ff = FRICTION * fn / max(speed, AIMLAB_PRIMITIVE_STICK_SPEED);
+        for (int k = 0; k < 3; k++) {
+            a_force[k] += fn * a_n[k] - ff * vt[k];
+        }
+    }
+};
+
+class Sphere : public Primitive {
+public:
+    Sphere(const double a_c[3], double a_r) : m_r(a_r) { memcpy(m_c, a_c, sizeof(m_c)); }
+    void addForce(const PrimitiveTool& a_tool, double a_force[3]) const override {
+        const double d[3] = { a_tool.pos[0] - m_c[0], a_tool.pos[1] - m_c[1],
+                              a_tool.pos[2] - m_c[2] };
+        const double dist = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        const double depth = m_r + a_tool.radius - dist;
+        if (depth > 0.0 && dist > 0.0) {
+            const double n[3] = { d[0] / dist, d[1] / dist, d[2] / dist };
+            addContact(depth, n, a_tool, a_force);
+        }
+    }
+
+private:
+    double m_c[3];
+    double m_r;
+};
+
+class Box : public Primitive {
+public:
+    Box(const double a_c[3], const double a_rot[9], const double a_size[3]) {
+        memcpy(m_c, a_c, sizeof(m_c));
+        memcpy(m_rot, a_rot, sizeof(m_rot));
+        for (int k = 0; k < 3; k++) {
+            m_h[k] = 0.5 * a_size[k];
+        }
+    }
+    void addForce(const PrimitiveTool& a_tool, double a_force[3]) const override {
+        const double d[3] = { a_tool.pos[0] - m_c[0], a_tool.pos[1] - m_c[1],
+                              a_tool.pos[2] - m_c[2] };
+        double q[3], diff[3];
+        for (int j = 0; j < 3; j++) {
+            q[j] = m_rot[j] * d[0] + m_rot[3 + j] * d[1] + m_rot[6 + j] * d[2];
+            diff[j] = q[j] - min(max(q[j], -m_h[j]), m_h[j]);
+        }
+        const double dist2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+        double depth, nl[3] = { 0.0, 0.0, 0.0 };
+        if (dist2 > 0.0) {
+            const double dist = sqrt(dist2);
+            depth = a_tool.radius - dist;
+            for (int j = 0; j < 3; j++) {
+                nl[j] = diff[j] / dist;
+            }
+        } else {
+            int axis = 0;
+            for (int j = 1; j < 3; j++) {
+                if (m_h[j] - fabs(q[j]) < m_h[axis] - fabs(q[axis])) {
+                    axis = j;
+                }
+            }
+            depth = a_tool.radius + m_h[axis] - fabs(q[axis]);
+            nl[axis] = (q[axis] < 0.0) ? -1.0 : 1.0;
+        }
+        if (depth > 0.0) {
+            double n[3];
+            for (int i = 0; i < 3; i++) {
+                n[i] = m_rot[3 * i] * nl[0] + m_rot[3 * i + 1] * nl[1] + m_rot[3 * i + 2] * nl[2];
+            }
+            addContact(depth, n, a_tool, a_force);
+        }
+    }
+
+private:
+    double m_c[3];
+    double m_rot[9];
+    double m_h[3];
+};
+
+class Plane : public Primitive {
+public:
+    Plane(const double a_p[3], const double a_n[3]) {
+        memcpy(m_p, a_p, sizeof(m_p));
+        memcpy(m_n, a_n, sizeof(m_n));
+    }
+    void addForce(const PrimitiveTool& a_tool, double a_force[3]) const override {
+        const double dist = m_n[0] * (a_tool.pos[0] - m_p[0]) + m_n[1] * (a_tool.pos[1] - m_p[1]) +
+                            m_n[2] * (a_tool.pos[2] - m_p[2]);
+        if (a_tool.radius - dist > 0.0) {
+            addContact(a_tool.radius - dist, m_n, a_tool, a_force);
+        }
+    }
+
+private:
+    double m_p[3];
+    double m_n[3];
+};
+
+//===========================================================================
+// RUN
+//===========================================================================
+
+struct KernelTimes {
+    double meanUs;
+    double p99Us;
+    double maxError;
+};
+
+struct SceneResult {
+    size_t objects;
+    double contacts;
+    KernelTimes object;
+    KernelTimes scalar;
+    KernelTimes avx2;
+};
+
+static double percentile(vector<double>& a_values, double a_p) {
+    sort(a_values.begin(), a_values.end());
+    return a_values[min(a_values.size() - 1, (size_t)(a_p * (double)a_values.size()))];
+}
+
+static void randomRotation(Random& a_random, double a_rot[9]) {
+    const double a = 2.0 * PI * a_random.next(), b = 2.0 * PI * a_random.next();
+    const double ca = cos(a), sa = sin(a), cb = cos(b), sb = sin(b);
+    const double rot[9] = { ca, -sa * cb, sa * sb,
+                            sa, ca * cb, -ca * sb,
+                            0.0, sb, cb };
+    memcpy(a_rot, rot, sizeof(rot));
+}
+
+static SceneResult runScene(size_t a_objects, int a_ticks, bool a_avx2) {
+    SceneResult result;
+    memset(&result, 0, sizeof(result));
+    result.objects = a_objects;
+    const double side = SPACING * cbrt((double)a_objects);
+
+    // Same scene three ways; the floor plane is the last primitive
+    Random random(777 + a_objects);
+    vector<unique_ptr<Primitive>> objects;
+    PrimitiveBatch batch;
+    for (size_t i = 0; i + 1 < a_objects; i++) {
+        double c[3];
+        for (int k = 0; k < 3; k++) {
+            c[k] = random.next() * side;
+        }
+        if (i % 10 == 9) {
+            double rot[9];
+            randomRotation(random, rot);
+            const double size[3] = { 0.01 + 0.02 * random.next(), 0.01 + 0.02 * random.next(),
+                                     0.01 + 0.02 * random.next() };
+            objects.emplace_back(new Box(c, rot, size));
+            batch.addBox(c, rot, size, STIFFNESS, FRICTION);
+        } else {
+            const double r = 0.005 + 0.015 * random.next();
+            objects.emplace_back(new Sphere(c, r));
+            batch.addSphere(c, r, STIFFNESS, FRICTION);
+        }
+    }
+    const double floorPoint[3] = { 0.0, 0.0, 0.0 }, up[3] = { 0.0, 0.0, 1.0 };
+    objects.emplace_back(new Plane(floorPoint, up));
+    batch.addPlane(floorPoint, up, STIFFNESS, FRICTION);
+
+    vector<double> objectTimes, scalarTimes, avx2Times;
+    double objectNs = 0.0, scalarNs = 0.0, avx2Ns = 0.0, contacts = 0.0;
+    for (int tick = 0; tick < a_ticks; tick++) {
+        // Circle through the cloud, dipping to the floor, 0.5 m/s
+        const double angle = 2.0 * PI * tick / a_ticks;
+        const double centre = 0.5 * side, radius = 0.35 * side;
+        PrimitiveTool tool;
+        tool.pos[0] = centre + radius * cos(angle);
+        tool.pos[1] = centre + radius * sin(angle);
+        tool.pos[2] = centre * (1.0 + sin(angle)) + 0.005;
+        tool.vel[0] = -0.5 * sin(angle);
+        tool.vel[1] = 0.5 * cos(angle);
+        tool.vel[2] = 0.5 * cos(angle) * centre / radius;
+        tool.radius = TOOL_RADIUS;
+
+        uint64_t t0 = hapticNowNs();
+        double reference[3] = { 0.0, 0.0, 0.0 };
+        for (size_t i = 0; i < objects.size(); i++) {
+            objects[i]->addForce(tool, reference);
+        }
+        uint64_t t1 = hapticNowNs();
+        objectNs += (double)(t1 - t0);
+        objectTimes.push_back((double)(t1 - t0) * 1e-3);
+        const double scale = max(1.0, sqrt(reference[0] * reference[0] +
+                                            reference[1] * reference[1] +
+                                            reference[2] * reference[2]));
+
+        for (int kernel = 0; kernel < (a_avx2 ? 2 : 1); kernel++) {
+            batch.setUseSimd(kernel == 1);
+            double force[3];
+            t0 = hapticNowNs();
+            const PrimitiveForceResult contact = batch.computeForce(tool, force);
+            t1 = hapticNowNs();
+
+            KernelTimes& times = (kernel == 1) ? result.avx2 : result.scalar;
+            for (int k = 0; k < 3; k++) {
+                times.maxError = max(times.maxError, fabs(force[k] - reference[k]) / scale);
+            }
+            (kernel == 1 ? avx2Ns : scalarNs) += (double)(t1 - t0);
+            (kernel == 1 ? avx2Times : scalarTimes).push_back((double)(t1 - t0) * 1e-3);
+            if (kernel == 0) {
+                contacts += contact.contacts;
+            }
+        }
+    }
+
+    result.contacts = contacts / a_ticks;
+    result.object.meanUs = objectNs * 1e-3 / a_ticks;
+    result.object.p99Us = percentile(objectTimes, 0.99);
+    result.scalar.meanUs = scalarNs * 1e-3 / a_ticks;
+    result.scalar.p99Us = percentile(scalarTimes, 0.99);
+    if (a_avx2) {
+        result.avx2.meanUs = avx2Ns * 1e-3 / a_ticks;
+        result.avx2.p99Us = percentile(avx2Times, 0.99);
+    }
+    return result;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    size_t maxObjects = 100000;
+    int ticks = 1000;
+    size_t budgetObjects = 10000;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--max-objects") && i + 1 < argc) {
+            maxObjects = max((size_t)100, (size_t)atol(argv[++i]));
+        } else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+            ticks = max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--budget-objects") && i + 1 < argc) {
+            budgetObjects = (size_t)atol(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--max-objects N] [--ticks N] [--budget-objects N]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    const bool avx2 = PrimitiveBatch::simdAvailable();
+    printf("primitive forces (%d ticks per scene, tool radius %.0f mm, AVX2 kernel %s)\n",
+           ticks, TOOL_RADIUS * 1e3, avx2 ? "available" : "not available");
+    printf("  %8s %8s %10s %10s %10s %10s %9s %9s %10s\n", "objects", "contacts", "object us",
+           "scalar us", "avx2 us", "avx2 p99", "speedup", "budget", "max error");
+
+    bool pass = true;
+    for (size_t objects = 100; objects <= maxObjects; objects *= 10) {
+        const SceneResult r = runScene(objects, ticks, avx2);
+        const KernelTimes& best = avx2 ? r.avx2 : r.scalar;
+        const double maxError = max(r.scalar.maxError, r.avx2.maxError);
+        const bool fits = best.p99Us < 1000.0;
+        char avx2Mean[16] = "-", avx2P99[16] = "-";
+        if (avx2) {
+            snprintf(avx2Mean, sizeof(avx2Mean), "%.2f", r.avx2.meanUs);
+            snprintf(avx2P99, sizeof(avx2P99), "%.2f", r.avx2.p99Us);
+        }
+        printf("  %8zu %8.2f %10.2f %10.2f %10s %10s %8.1fx %9s %10.1e\n", r.objects, r.contacts,
+               r.object.meanUs, r.scalar.meanUs, avx2Mean, avx2P99,
+               r.object.meanUs / best.meanUs, fits ? "1 ms ok" : "OVER", maxError);
+        if (maxError > TOLERANCE || (!fits && objects <= budgetObjects)) {
+            pass = false;
+        }
+    }
+    printf("  result: %s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
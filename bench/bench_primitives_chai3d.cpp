@@ -0,0 +1,234 @@
+/****************************************************************************
+ * AIMLAB - Primitive Batch vs CHAI3D Check
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Checks --primitive-batch against what it replaces: CHAI3D's proxy
+ *   algorithm (cToolCursor::computeInteractionForces()) on the same
+ *   object. For a single sphere and a single rotated box, the tool comes
+ *   in from 5 mm outside along a surface normal, stops 0.25, 0.5 or 1 mm
+ *   inside, and is held there until the proxy has settled. The batch force
+ *   (PrimitiveBatch::computeForce(), tool at rest) is then compared with
+ *   the CHAI3D force.
+ *
+ *   Both laws give stiffness * depth along the normal for a shallow
+ *   contact away from edges. CHAI3D keeps its proxy a small epsilon off
+ *   the surface, so they agree to within TOLERANCE_REL of the force plus
+ *   TOLERANCE_ABS. Friction is 0 in both: the batch has no static friction
+ *   and no viscosity (see --primitive-batch in the usage), so only the
+ *   normal force can be compared like for like.
+ *
+ *   Needs CHAI3D; bench-primitives is the CHAI3D-free timing benchmark.
+ *   Fails if any probe is outside the tolerance.
+ *
+ * Usage:
+ *   bench-primitives-chai3d
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial check
+ *
+ ****************************************************************************/
+
+#include "chai3d.h"
+#include "PrimitiveBatch.h"
+#include "ReplayHapticDevice.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+using namespace chai3d;
+using namespace std;
+
+static const double TOOL_RADIUS = 0.005;
+static const double STIFFNESS = 1000.0;
+static const double APPROACH = 0.005;       // m outside the surface at the start
+static const int APPROACH_TICKS = 50;
+static const int SETTLE_TICKS = 50;
+static const double TOLERANCE_REL = 0.02;
+static const double TOLERANCE_ABS = 0.02;   // N
+static const double DEPTHS[] = { 0.00025, 0.0005, 0.001 };
+
+struct Probe {
+    const char* name;
+    double surface[3];                      // point on the object's surface
+    double normal[3];                       // outward unit normal there
+};
+
+//===========================================================================
+// ONE OBJECT
+//===========================================================================
+
+/**
+ * @brief CHAI3D world with one object and a cursor on a scripted device
+ */
+class ProxyWorld {
+public:
+    explicit ProxyWorld(cGenericObject* a_object) {
+        SessionFileHeader header;
+        memset(&header, 0, sizeof(header));
+        strncpy(header.deviceModel, "scripted probe", sizeof(header.deviceModel) - 1);
+        header.device.maxLinearForce = 100.0;
+        header.device.workspaceRadius = 1.0;
+        m_device = std::make_shared<ReplayHapticDevice>(header);
+        memset(&m_sample, 0, sizeof(m_sample));
+        m_sample.rotation[0] = m_sample.rotation[4] = m_sample.rotation[8] = 1.0;
+
+        m_world = new cWorld();
+        a_object->m_material->setStiffness(STIFFNESS);
+        a_object->m_material->setStaticFriction(0.0);
+        a_object->m_material->setDynamicFriction(0.0);
+        a_object->m_material->setViscosity(0.0);
+        m_world->addChild(a_object);
+
+        m_tool = new cToolCursor(m_world);
+        m_world->addChild(m_tool);
+        m_tool->setHapticDevice(m_device);
+        m_tool->setRadius(TOOL_RADIUS);
+        m_tool->setWorkspaceRadius(1.0);    // device metres = world metres
+        m_tool->start();
+        m_world->computeGlobalPositions(true);
+    }
+
+    ~ProxyWorld() {
+        m_tool->stop();
+        delete m_world;
+    }
+
+    /** @brief One haptic tick with the device at a_pos; returns the force */
+    cVector3d tick(const double a_pos[3]) {
+        memcpy(m_sample.position, a_pos, sizeof(m_sample.position));
+        m_device->setSample(m_sample);
+        m_world->computeGlobalPositions(true);
+        m_tool->updateFromDevice();
+        m_tool->computeInteractionForces();
+        return m_tool->getDeviceGlobalForce();
+    }
+
+private:
+    cWorld* m_world;
+    cToolCursor* m_tool;
+    std::shared_ptr<ReplayHapticDevice> m_device;
+    HapticSample m_sample;
+};
+
+/**
+ * @brief Every probe at every depth; returns the number outside the tolerance
+ */
+static int checkObject(const char* a_name, const std::function<cGenericObject*()>& a_newObject,
+                       const PrimitiveBatch& a_batch, const Probe* a_probes, int a_probeCount) {
+    int failed = 0;
+    for (int p = 0; p < a_probeCount; p++) {
+        const Probe& probe = a_probes[p];
+        for (size_t d = 0; d < sizeof(DEPTHS) / sizeof(DEPTHS[0]); d++) {
+            // A fresh world per probe, so no proxy state carries over
+            ProxyWorld world(a_newObject());
+
+            // The tool centre sits one tool radius off the surface at contact
+            cVector3d chai;
+            double pos[3];
+            for (int t = 0; t <= APPROACH_TICKS + SETTLE_TICKS; t++) {
+                const double s = (double)min(t, APPROACH_TICKS) / APPROACH_TICKS;
+                const double offset = TOOL_RADIUS + APPROACH - s * (APPROACH + DEPTHS[d]);
+                for (int k = 0; k < 3; k++) {
+                    pos[k] = probe.surface[k] + probe.normal[k] * offset;
+                }
+                chai = world.tick(pos);
+            }
+
+            PrimitiveTool tool;
+            memcpy(tool.pos, pos, sizeof(tool.pos));
+            memset(tool.vel, 0, sizeof(tool.vel));
+            tool.radius = TOOL_RADIUS;
+            double batch[3];
+            a_batch.computeForce(tool, batch);
+
+            const double diff = sqrt((chai.x() - batch[0]) * (chai.x() - batch[0]) +
+                                     (chai.y() - batch[1]) * (chai.y() - batch[1]) +
+                                     (chai.z() - batch[2]) * (chai.z() - batch[2]));
+            const double magnitude = sqrt(batch[0] * batch[0] + batch[1] * batch[1] +
+                                          batch[2] * batch[2]);
+            const bool ok = diff <= TOLERANCE_REL * magnitude + TOLERANCE_ABS;
+            printf("  %6s %-8s %5.2f mm  chai3d %7.4f N  batch %7.4f N  diff %7.4f N  %s\n",
+                   a_name, probe.name, DEPTHS[d] * 1e3, chai.length(), magnitude, diff,
+                   ok ? "ok" : "FAIL");
+            failed += ok ? 0 : 1;
+        }
+    }
+    return failed;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main() {
+    printf("primitive batch vs CHAI3D proxy (tool radius %.0f mm, stiffness %.0f N/m, "
+           "tolerance %.0f%% + %.2f N)\n", TOOL_RADIUS * 1e3, STIFFNESS, TOLERANCE_REL * 100.0,
+           TOLERANCE_ABS);
+    int failed = 0;
+
+    // Sphere of 20 mm radius at (0.01, -0.02, 0.03)
+    {
+        const double center[3] = { 0.01, -0.02, 0.03 };
+        const double radius = 0.02;
+        PrimitiveBatch batch;
+        batch.addSphere(center, radius, STIFFNESS, 0.0);
+
+        auto newSphere = [&]() -> cGenericObject* {
+            cShapeSphere* sphere = new cShapeSphere(radius);
+            sphere->setLocalPos(center[0], center[1], center[2]);
+            return sphere;
+        };
+
+        const double r = 1.0 / sqrt(3.0);
+        const Probe probes[] = {
+            { "+x",      { center[0] + radius, center[1], center[2] }, { 1, 0, 0 } },
+            { "-z",      { center[0], center[1], center[2] - radius }, { 0, 0, -1 } },
+            { "diag",    { center[0] + radius * r, center[1] + radius * r, center[2] + radius * r },
+                         { r, r, r } },
+        };
+        failed += checkObject("sphere", newSphere, batch, probes, 3);
+    }
+
+    // Box 60 x 40 x 30 mm at (0, 0.01, 0), rotated 30 degrees about z
+    {
+        const double center[3] = { 0.0, 0.01, 0.0 };
+        const double size[3] = { 0.06, 0.04, 0.03 };
+        const double a = 30.0 * 3.14159265358979323846 / 180.0;
+        const double rot[9] = { cos(a), -sin(a), 0.0,
+                                sin(a),  cos(a), 0.0,
+                                0.0,     0.0,    1.0 };
+        PrimitiveBatch batch;
+        batch.addBox(center, rot, size, STIFFNESS, 0.0);
+
+        auto newBox = [&]() -> cGenericObject* {
+            cShapeBox* box = new cShapeBox(size[0], size[1], size[2]);
+            box->setLocalPos(center[0], center[1], center[2]);
+            cMatrix3d boxRot;
+            boxRot.set(rot[0], rot[1], rot[2], rot[3], rot[4], rot[5], rot[6], rot[7], rot[8]);
+            box->setLocalRot(boxRot);
+            return box;
+        };
+
+        // Face centres: local axis i maps to column i of the rotation
+        Probe probes[3] = { { "+x face", {}, {} }, { "-y face", {}, {} }, { "+z face", {}, {} } };
+        const int axis[3] = { 0, 1, 2 };
+        const double sign[3] = { 1.0, -1.0, 1.0 };
+        for (int p = 0; p < 3; p++) {
+            for (int k = 0; k < 3; k++) {
+                probes[p].normal[k] = sign[p] * rot[k * 3 + axis[p]];
+                probes[p].surface[k] = center[k] + probes[p].normal[k] * 0.5 * size[axis[p]];
+            }
+        }
+        failed += checkObject("box", newBox, batch, probes, 3);
+    }
+
+    printf("  result: %s (%d outside the tolerance)\n", failed == 0 ? "PASS" : "FAIL", failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+/****************************************************************************
+ * AIMLAB - Session Recorder Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Drives SessionRecorder from a haptic-style producer thread and
+ *   reports:
+ *
+ *     - cost of record() on the producer (p50/p99/max)
+ *     - sustained write throughput of the writer thread (records/s, MB/s)
+ *     - records dropped because the ring was full
+ *     - heap allocations made by the producer thread while recording
+ *
+ *   Allocations are counted by replacing the global operator new with a
+ *   version that bumps a thread-local counter, so any allocation on the
+ *   producer between open() and close() shows up. The file is then read
+ *   back with SessionReader and every record is checked against what was
+ *   pushed (sequence, dropped gaps, payload).
+ *
+ *   Exits non-zero if the producer allocated or the read-back differs.
+ *   The default is an unpaced producer, which measures the writer's
+ *   ceiling; --rate 1000 reproduces the application's load.
+ *
+ * Usage:
+ *   bench-recorder [--seconds S] [--rate HZ] [--ring N] [--out FILE]
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Pass header fields to SessionRecorder::open()
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "HapticClock.h"
+#include "LatencyHistogram.h"
+#include "SessionReader.h"
+#include "SessionRecorder.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+//===========================================================================
+// ALLOCATION COUNTING
+//===========================================================================
+
+static thread_local uint64_t threadAllocations = 0;
+
+void* operator new(size_t size) {
+    threadAllocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    threadAllocations++;
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+//===========================================================================
+// PRODUCER (haptic thread stand-in)
+//===========================================================================
+
+static SessionRecorder* recorder = nullptr;
+static LatencyHistogram recordCost;
+
+struct ProducerResult {
+    uint64_t pushed;
+    uint64_t allocations;
+};
+
+static void fillRecord(HapticRecord& r, uint64_t seq) {
+    const double s = (double)seq;
+    r.timestampNs = hapticNowNs();
+    for (int k = 0; k < 3; k++) {
+        r.device.position[k]        = s + 0.1 * k;
+        r.device.linearVelocity[k]  = -s - 0.1 * k;
+        r.device.angularVelocity[k] = 0.5 * s;
+        r.proxyPos[k]               = s * 0.25;
+        r.force[k]                  = s * 1e-3 + k;
+        r.torque[k]                 = 0.0;
+    }
+    for (int k = 0; k < 9; k++) {
+        r.device.rotation[k] = (k % 4 == 0) ? 1.0 : 0.0;
+    }
+    r.device.gripperAngle = s;
+    r.device.gripperAngularVelocity = 0.0;
+    r.device.userSwitches = (uint32_t)(seq & 0xFF);
+    r.device.reserved = 0;
+    r.gripperForce = 0.0;
+}
+
+static bool matches(const HapticRecord& r, uint64_t seq) {
+    HapticRecord expected;
+    fillRecord(expected, seq);
+    return memcmp(&r.device, &expected.device, sizeof(HapticSample)) == 0 &&
+           memcmp(r.proxyPos, expected.proxyPos, sizeof(r.proxyPos)) == 0 &&
+           memcmp(r.force, expected.force, sizeof(r.force)) == 0;
+}
+
+static void producer(double seconds, double rateHz, ProducerResult* result) {
+    const uint64_t period = (rateHz > 0.0) ? (uint64_t)(1e9 / rateHz) : 0;
+    const uint64_t end = hapticNowNs() + (uint64_t)(seconds * 1e9);
+    uint64_t next = hapticNowNs();
+    uint64_t seq = 0;
+    HapticRecord r;
+
+    const uint64_t allocationsBefore = threadAllocations;
+    while (hapticNowNs() < end) {
+        fillRecord(r, seq);
+        const uint64_t t0 = hapticNowNs();
+        recorder->record(r);
+        recordCost.record(hapticNowNs() - t0);
+        seq++;
+
+        if (period != 0) {
+            next += period;
+            while (hapticNowNs() < next) {
+            }
+        }
+    }
+    result->pushed = seq;
+    result->allocations = threadAllocations - allocationsBefore;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    double seconds = 3.0;
+    double rateHz = 0.0;            // 0 = as fast as possible
+    size_t ring = 16384;
+    string out = "bench-recorder.aimrec";
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--rate") && i + 1 < argc) {
+            rateHz = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--ring") && i + 1 < argc) {
+            ring = (size_t)atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            out = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [--rate HZ] [--ring N] [--out FILE]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    // Static storage in main's scope keeps the ring's alignas(64) members
+    static SessionRecorder sessionRecorder(ring);
+    recorder = &sessionRecorder;
+
+    SessionFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.nominalRateHz = rateHz;
+    strncpy(header.deviceModel, "bench-recorder", sizeof(header.deviceModel) - 1);
+
+    string error;
+    if (!recorder->open(out, header, error)) {
+        fprintf(stderr, "error: %s\n", error.c_str());
+        return 1;
+    }
+
+    ProducerResult result = { 0, 0 };
+    thread producerThread(producer, seconds, rateHz, &result);
+    producerThread.join();
+
+    const SessionRecorderStats stats = recorder->close();
+
+    // Read back and compare with what was pushed
+    SessionReader reader;
+    if (!reader.open(out, error)) {
+        fprintf(stderr, "error: %s\n", error.c_str());
+        return 1;
+    }
+    HapticRecord r;
+    uint32_t dropped = 0;
+    uint64_t seq = 0, readBack = 0, mismatches = 0, droppedInFile = 0, lastNs = 0;
+    while (reader.next(r, &dropped)) {
+        seq += dropped;
+        droppedInFile += dropped;
+        if (!matches(r, seq) || r.timestampNs < lastNs) {
+            mismatches++;
+        }
+        lastNs = r.timestampNs;
+        seq++;
+        readBack++;
+    }
+
+    unique_ptr<LatencyHistogram::Snapshot> cost(new LatencyHistogram::Snapshot());
+    recordCost.snapshot(*cost);
+
+    const double mb = (double)stats.bytes / (1024.0 * 1024.0);
+    printf("session recorder (%.1f s, %s, ring %zu records)\n", seconds,
+           rateHz > 0.0 ? (to_string((int)rateHz) + " Hz producer").c_str() : "unpaced producer",
+           ring);
+    printf("  pushed        : %llu records\n", (unsigned long long)result.pushed);
+    printf("  record() cost : p50 %.0f  p99 %.0f  p99.9 %.0f  max %.0f ns\n",
+           (double)cost->percentile(0.5), (double)cost->percentile(0.99),
+           (double)cost->percentile(0.999), (double)cost->max);
+    printf("  written       : %llu records, %.1f MB, %llu write calls, %s\n",
+           (unsigned long long)stats.records, mb, (unsigned long long)stats.writeCalls,
+           stats.directIO ? "O_DIRECT" : "buffered");
+    printf("  throughput    : %.0f records/s, %.1f MB/s\n",
+           (double)stats.records / stats.seconds, mb / stats.seconds);
+    printf("  dropped       : %llu (ring full)\n", (unsigned long long)stats.dropped);
+    printf("  producer allocations while recording: %llu\n",
+           (unsigned long long)result.allocations);
+    printf("  read back     : %llu records, %llu dropped gaps, %llu mismatches\n",
+           (unsigned long long)readBack, (unsigned long long)droppedInFile,
+           (unsigned long long)mismatches);
+
+    const bool ok = result.allocations == 0 && mismatches == 0 && !stats.writeError &&
+                    readBack == stats.records && readBack + stats.dropped == result.pushed;
+    printf("  result        : %s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/****************************************************************************
+ * AIMLAB - Scene Load Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Startup cost of a large mesh, cold versus warm:
+ *
+ *     cold   parse the OBJ text, compute vertex normals, build the AABB
+ *            tree (what every launch paid before the cache)
+ *     warm map only
+ *            map the .aimmesh cache and validate it (MeshAsset::load)
+ *     warm startup
+ *            the same, then copy every vertex, normal and triangle into
+ *            mesh arrays and every tree node into a collision tree, as
+ *            fillMesh() and CachedCollisionAABB::adopt() do (page faults
+ *            included). This is what a second launch pays
+ *
+ *   The mesh is a generated torus written as OBJ text, so the benchmark
+ *   needs no assets. The cache is compared byte for byte with the cold
+ *   result; the benchmark exits non-zero if they differ. Warm numbers are
+ *   with the file in the OS page cache, i.e. a second launch.
+ *
+ * Usage:
+ *   bench-scene-load [--triangles N] [--runs N] [--out FILE.obj]
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Warm startup includes copying the mesh out, as fillMesh() does;
+ *                            map-only column labelled as such
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "HapticClock.h"
+#include "MeshCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const double PI = 3.14159265358979323846;
+
+//===========================================================================
+// HELPERS
+//===========================================================================
+
+static double secondsSince(uint64_t a_t0) {
+    return (double)(hapticNowNs() - a_t0) * 1e-9;
+}
+
+static double median(vector<double> a_values) {
+    sort(a_values.begin(), a_values.end());
+    return a_values[a_values.size() / 2];
+}
+
+/**
+ * @brief Write a torus of about a_triangles triangles (quads split in two)
+ */
+static bool writeTorusObj(const string& a_filename, size_t a_triangles) {
+    const int minor = max(3, (int)sqrt((double)a_triangles / 4.0));
+    const int major = max(3, (int)(a_triangles / (2 * (size_t)minor)));
+    const double R = 1.0, r = 0.3;
+
+    FILE* file = fopen(a_filename.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "# bench-scene-load torus %d x %d\n", major, minor);
+    for (int i = 0; i < major; i++) {
+        const double u = 2.0 * PI * i / major;
+        for (int j = 0; j < minor; j++) {
+            const double v = 2.0 * PI * j / minor;
+            fprintf(file, "v %.9f %.9f %.9f\n", (R + r * cos(v)) * cos(u),
+                    (R + r * cos(v)) * sin(u), r * sin(v));
+        }
+    }
+    for (int i = 0; i < major; i++) {
+        for (int j = 0; j < minor; j++) {
+            const int a = i * minor + j + 1;
+            const int b = ((i + 1) % major) * minor + j + 1;
+            const int c = ((i + 1) % major) * minor + (j + 1) % minor + 1;
+            const int d = i * minor + (j + 1) % minor + 1;
+            fprintf(file, "f %d %d %d\nf %d %d %d\n", a, b, c, a, c, d);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+static bool sameBytes(const void* a_a, const void* a_b, size_t a_bytes) {
+    return a_bytes == 0 || memcmp(a_a, a_b, a_bytes) == 0;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    size_t triangles = 1000000;
+    int runs = 5;
+    string objFile = "bench-scene-load.obj";
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--triangles") && i + 1 < argc) {
+            triangles = (size_t)atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            objFile = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--triangles N] [--runs N] [--out FILE.obj]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!writeTorusObj(objFile, triangles)) {
+        fprintf(stderr, "error: cannot write %s\n", objFile.c_str());
+        return 1;
+    }
+    const string cacheFile = meshCacheFile(objFile);
+    remove(cacheFile.c_str());
+
+    // Cold: every stage a launch without the cache runs
+    vector<double> parseTimes, normalTimes, treeTimes, coldTimes;
+    MeshData cold;
+    string error;
+    for (int r = 0; r < runs; r++) {
+        uint64_t t0 = hapticNowNs();
+        if (!parseObjMesh(objFile, 1.0, cold, error)) {
+            fprintf(stderr, "error: %s\n", error.c_str());
+            return 1;
+        }
+        parseTimes.push_back(secondsSince(t0));
+
+        t0 = hapticNowNs();
+        computeMeshNormals(cold);
+        normalTimes.push_back(secondsSince(t0));
+
+        t0 = hapticNowNs();
+        buildMeshAabbTree(cold);
+        treeTimes.push_back(secondsSince(t0));
+
+        coldTimes.push_back(parseTimes.back() + normalTimes.back() + treeTimes.back());
+    }
+
+    uint64_t t0 = hapticNowNs();
+    if (!writeMeshCache(cacheFile, cold, objFile, 1.0, error)) {
+        fprintf(stderr, "error: %s\n", error.c_str());
+        return 1;
+    }
+    const double writeSeconds = secondsSince(t0);
+
+    // Warm: map (what startup pays before building objects), then copy
+    // the arrays out the way SceneBuilder builds the CHAI3D mesh and tree
+    vector<double> warmTimes, startupTimes;
+    double checksum = 0.0;
+    bool identical = true;
+    for (int r = 0; r < runs; r++) {
+        MeshAsset asset;
+        t0 = hapticNowNs();
+        if (!asset.load(objFile, 1.0, true, error) || !asset.fromCache()) {
+            fprintf(stderr, "error: cache not used: %s\n", error.c_str());
+            return 1;
+        }
+        warmTimes.push_back(secondsSince(t0));
+
+        const MeshView& v = asset.view();
+        vector<double> vertices;            // position and normal per vertex, like cVertex
+        vector<uint32_t> triangles;
+        vector<MeshAabbNode> nodes;
+        vertices.reserve((size_t)v.vertexCount * 6);
+        for (uint32_t i = 0; i < v.vertexCount; i++) {
+            vertices.insert(vertices.end(), v.positions + i * 3, v.positions + i * 3 + 3);
+            vertices.insert(vertices.end(), v.normals + i * 3, v.normals + i * 3 + 3);
+        }
+        triangles.assign(v.triangles, v.triangles + (size_t)v.triangleCount * 3);
+        nodes.assign(v.nodes, v.nodes + v.nodeCount);
+        startupTimes.push_back(secondsSince(t0));
+
+        for (size_t i = 0; i < vertices.size(); i++) {
+            checksum += vertices[i];
+        }
+        for (size_t i = 0; i < triangles.size(); i++) {
+            checksum += triangles[i];
+        }
+        for (size_t i = 0; i < nodes.size(); i++) {
+            checksum += nodes[i].max[0] - nodes[i].min[0];
+        }
+
+        if (r == 0) {
+            const MeshView c = cold.view();
+            identical = v.vertexCount == c.vertexCount && v.triangleCount == c.triangleCount &&
+                        v.nodeCount == c.nodeCount && v.rootIndex == c.rootIndex &&
+                        sameBytes(v.positions, c.positions, c.vertexCount * 3 * sizeof(double)) &&
+                        sameBytes(v.normals, c.normals, c.vertexCount * 3 * sizeof(double)) &&
+                        sameBytes(v.triangles, c.triangles, c.triangleCount * 3 * sizeof(uint32_t)) &&
+                        sameBytes(v.nodes, c.nodes, c.nodeCount * sizeof(MeshAabbNode));
+        }
+    }
+
+    FILE* probe = fopen(cacheFile.c_str(), "rb");
+    long cacheBytes = 0;
+    if (probe != nullptr) {
+        fseek(probe, 0, SEEK_END);
+        cacheBytes = ftell(probe);
+        fclose(probe);
+    }
+    probe = fopen(objFile.c_str(), "rb");
+    long objBytes = 0;
+    if (probe != nullptr) {
+        fseek(probe, 0, SEEK_END);
+        objBytes = ftell(probe);
+        fclose(probe);
+    }
+
+    const MeshView c = cold.view();
+    const double coldMs = median(coldTimes) * 1e3;
+    const double warmMs = median(warmTimes) * 1e3;
+    const double startupMs = median(startupTimes) * 1e3;
+    printf("scene load (%u vertices, %u triangles, %u tree nodes; median of %d runs)\n",
+           c.vertexCount, c.triangleCount, c.nodeCount, runs);
+    printf("  source        : %s, %.1f MB OBJ\n", objFile.c_str(), objBytes / 1048576.0);
+    printf("  cache         : %s, %.1f MB, written in %.1f ms\n", cacheFile.c_str(),
+           cacheBytes / 1048576.0, writeSeconds * 1e3);
+    printf("  cold          : %8.1f ms  (parse %.1f, normals %.1f, tree %.1f)\n", coldMs,
+           median(parseTimes) * 1e3, median(normalTimes) * 1e3, median(treeTimes) * 1e3);
+    printf("  warm map only : %8.3f ms  (map and validate; no mesh built)\n", warmMs);
+    printf("  warm startup  : %8.1f ms  (%.0fx faster; map, validate, copy into the mesh)\n",
+           startupMs, coldMs / startupMs);
+    printf("  cache matches cold build: %s  (checksum %.3f)\n", identical ? "yes" : "NO",
+           checksum / runs);
+    printf("  result        : %s\n", identical ? "PASS" : "FAIL");
+    return identical ? 0 : 1;
+}
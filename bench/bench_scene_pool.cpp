@@ -0,0 +1,457 @@
+/****************************************************************************
+ * AIMLAB - Scene Node Pool Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Two checks of the allocation layer in Arena.h.
+ *
+ *   Steady-state allocations: a haptic world is built the way main()
+ *   builds device 0's (buildScene() into node pools, a cToolCursor on a
+ *   simulated device, IncrementalTransformUpdater, HapticBroadPhase with
+ *   its scratch reserved, optionally a PrimitiveBatch) and run for --ticks
+ *   ticks of computeHapticTick()'s calls after 100 warm-up ticks. Global
+ *   operator new is replaced with a counting one; the run fails if a tick
+ *   allocates or the scratch arena needed another block. The tool circles
+ *   through a grid of spheres and boxes, so objects enter and leave the
+ *   broad phase and the proxy makes and breaks contact.
+ *
+ *   Traversal locality: a scene of --objects spheres and boxes is built
+ *   twice, once with the node pools disabled (heap, as --no-scene-pool)
+ *   and once pooled, and the haptic world's full computeGlobalPositions()
+ *   is timed. The report gives the median spacing between consecutive twins
+ *   in memory, ns per object, and L1 data and last-level cache misses per
+ *   object where the kernel exposes hardware counters (Linux
+ *   perf_event_open; "n/a" otherwise, e.g. in most VMs).
+ *
+ *   The traversal half is report only and never fails the run. No
+ *   consistent speed-up of pooled over heap has been measured: in repeated
+ *   runs in a single-CPU VM, pooled ranged from 10% faster to 8% slower
+ *   per object, and without cache counters the miss rates are unknown.
+ *   Pass or fail comes from the allocation half alone.
+ *
+ * Usage:
+ *   bench-scene-pool [--ticks N] [--objects N] [--passes N]
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - State that the traversal half is report only
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "chai3d.h"
+#include "Arena.h"
+#include "HapticBroadPhase.h"
+#include "HapticClock.h"
+#include "IncrementalTransformUpdater.h"
+#include "PrimitiveBatch.h"
+#include "SceneBuilder.h"
+#include "SceneDescription.h"
+#include "SimulatedHapticDevice.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// ALLOCATION COUNTING
+//===========================================================================
+
+static thread_local uint64_t threadAllocations = 0;
+
+void* operator new(size_t size) {
+    threadAllocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    threadAllocations++;
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+//===========================================================================
+// CACHE MISS COUNTERS
+//===========================================================================
+
+/**
+ * @brief L1 data read misses and last-level cache misses of this thread
+ */
+class CacheMissCounters {
+public:
+    CacheMissCounters() {
+        m_fd[0] = m_fd[1] = -1;
+#if defined(__linux__)
+        const uint64_t l1 = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        m_fd[0] = open(PERF_TYPE_HW_CACHE, l1);
+        m_fd[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~CacheMissCounters() {
+#if defined(__linux__)
+        for (int i = 0; i < 2; i++) {
+            if (m_fd[i] >= 0) {
+                close(m_fd[i]);
+            }
+        }
+#endif
+    }
+
+    bool available() const { return m_fd[0] >= 0 && m_fd[1] >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        for (int i = 0; i < 2 && available(); i++) {
+            ioctl(m_fd[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /** @brief Misses since start(): a_l1 and a_llc */
+    void stop(uint64_t& a_l1, uint64_t& a_llc) {
+        uint64_t counts[2] = { 0, 0 };
+#if defined(__linux__)
+        for (int i = 0; i < 2 && available(); i++) {
+            ioctl(m_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fd[i], &counts[i], sizeof(counts[i])) != (ssize_t)sizeof(counts[i])) {
+                counts[i] = 0;
+            }
+        }
+#endif
+        a_l1 = counts[0];
+        a_llc = counts[1];
+    }
+
+private:
+#if defined(__linux__)
+    static int open(uint32_t a_type, uint64_t a_config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = a_type;
+        attr.size = sizeof(attr);
+        attr.config = a_config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+
+    int m_fd[2];
+};
+
+//===========================================================================
+// SCENE
+//===========================================================================
+
+static const double toolRadius = 0.015;         // main.cpp's cursor
+static const int warmupTicks = 100;
+
+/**
+ * @brief a_objects alternating spheres and boxes, 3 cm apart in the z = 0
+ *        plane around the origin (the tool circles through the middle)
+ */
+static SceneDescription gridScene(int a_objects) {
+    SceneDescription scene = defaultSceneDescription();
+    const SceneObjectDesc prototype = scene.objects[0];
+    scene.objects.clear();
+    const int side = (int)ceil(sqrt((double)a_objects));
+    for (int i = 0; i < a_objects; i++) {
+        SceneObjectDesc object = prototype;
+        object.name = "object" + to_string(i);
+        object.position[0] = 0.03 * (i % side - side / 2);
+        object.position[1] = 0.03 * (i / side - side / 2);
+        object.position[2] = 0.0;
+        if (i % 2 == 0) {
+            object.type = SCENE_OBJECT_SPHERE;
+            object.radius = 0.01;
+        } else {
+            object.type = SCENE_OBJECT_BOX;
+            object.size[0] = object.size[1] = object.size[2] = 0.016;
+        }
+        scene.objects.push_back(object);
+    }
+    return scene;
+}
+
+//===========================================================================
+// STEADY-STATE ALLOCATIONS
+//===========================================================================
+
+struct AllocationResult {
+    uint64_t allocations;
+    uint64_t scratchBlocks;             // blocks the scratch arena added while ticking
+    size_t scratchBytes;
+    bool ok;
+};
+
+/**
+ * @brief Run a_ticks haptic ticks on a fresh world and count allocations
+ */
+static AllocationResult runTicks(int a_objects, bool a_primitiveBatch, int a_ticks) {
+    AllocationResult result = { 0, 0, 0, false };
+    SceneNodePool renderNodes;
+    SceneNodePool nodes;
+    Arena scratch;
+
+    const SceneDescription scene = gridScene(a_objects);
+    cWorld* renderWorld = new (renderNodes) PooledNode<cWorld>();
+    cWorld* world = new (nodes) PooledNode<cWorld>();
+    vector<cGenericObject*> renderObjects, objects;
+    vector<ObjectBounds> bounds;
+    string error;
+    if (!buildScene(scene, false, renderWorld, world, renderNodes, nodes, renderObjects, objects,
+                    bounds, error)) {
+        printf("[bench] Could not build the scene: %s\n", error.c_str());
+        return result;
+    }
+
+    SimulatedDeviceConfig config;
+    config.clock = SIM_CLOCK_STEP;
+    std::shared_ptr<SimulatedHapticDevice> device = std::make_shared<SimulatedHapticDevice>(config);
+    device->open();
+
+    cToolCursor* tool = new (nodes) PooledNode<cToolCursor>(world);
+    world->addChild(tool);
+    tool->setHapticDevice(device);
+    tool->setRadius(toolRadius);
+    tool->setWorkspaceRadius(1.0);
+    tool->enableDynamicObjects(true);
+    tool->start();
+
+    std::unique_ptr<IncrementalTransformUpdater> updater(new IncrementalTransformUpdater(world));
+    updater->markAlwaysDirty(tool);
+
+    std::unique_ptr<PrimitiveBatch> primitives;
+    vector<PrimitiveHandle> primitiveOf;
+    if (a_primitiveBatch) {
+        primitives.reset(new PrimitiveBatch());
+        buildPrimitiveBatch(scene, objects, *primitives, primitiveOf);
+    }
+
+    vector<bool> haptic;
+    for (size_t i = 0; i < scene.objects.size(); i++) {
+        haptic.push_back(scene.objects[i].haptic &&
+                         !(primitives != nullptr && primitiveOf[i].kind != PRIMITIVE_NONE));
+    }
+    std::unique_ptr<HapticBroadPhase> broadPhase(
+        new HapticBroadPhase(world, objects, bounds, haptic, 2.0 * toolRadius, 0.0));
+    scratch.reserve(broadPhase->scratchBytes());
+
+    uint64_t blocks = 0;
+    for (int t = -warmupTicks; t < a_ticks; t++) {
+        if (t == 0) {
+            blocks = scratch.blockAllocations();
+            result.allocations = threadAllocations;
+        }
+
+        // computeHapticTick()
+        updater->update();
+        tool->updateFromDevice();
+        broadPhase->update(tool->getDeviceGlobalPos(), tool->m_hapticPoint->getGlobalPosProxy(),
+                           scratch);
+        tool->computeInteractionForces();
+        if (primitives != nullptr) {
+            const cVector3d pos = tool->getDeviceGlobalPos();
+            const cVector3d vel = tool->getDeviceGlobalLinVel();
+            PrimitiveTool probe = { { pos.x(), pos.y(), pos.z() }, { vel.x(), vel.y(), vel.z() },
+                                    toolRadius };
+            double force[3];
+            primitives->computeForce(probe, force);
+            tool->addDeviceGlobalForce(cVector3d(force[0], force[1], force[2]));
+        }
+        tool->applyToDevice();
+        result.scratchBytes = std::max(result.scratchBytes, scratch.bytesUsed());
+        scratch.reset();
+    }
+    result.allocations = threadAllocations - result.allocations;
+    result.scratchBlocks = scratch.blockAllocations() - blocks;
+    result.ok = true;
+
+    tool->stop();
+    broadPhase.reset();                 // Reattaches the objects before the world goes
+    delete world;
+    delete renderWorld;
+    return result;
+}
+
+//===========================================================================
+// TRAVERSAL LOCALITY
+//===========================================================================
+
+struct TraversalResult {
+    double spacingBytes;                // median |address difference| of consecutive twins
+    double nsPerObject;                 // median pass
+    double l1PerObject;                 // median pass, -1 = no counters
+    double llcPerObject;
+};
+
+static double median(vector<double>& a_values) {
+    std::sort(a_values.begin(), a_values.end());
+    return a_values[a_values.size() / 2];
+}
+
+/**
+ * @brief Build a_objects objects with or without pools and time full
+ *        traversals of the haptic world
+ */
+static TraversalResult runTraversal(int a_objects, bool a_pooled, int a_passes,
+                                    CacheMissCounters& a_counters) {
+    TraversalResult result = { 0.0, 0.0, -1.0, -1.0 };
+    SceneNodePool renderNodes;
+    SceneNodePool nodes;
+    renderNodes.setEnabled(a_pooled);
+    nodes.setEnabled(a_pooled);
+
+    const SceneDescription scene = gridScene(a_objects);
+    cWorld* renderWorld = new (renderNodes) PooledNode<cWorld>();
+    cWorld* world = new (nodes) PooledNode<cWorld>();
+    vector<cGenericObject*> renderObjects, objects;
+    vector<ObjectBounds> bounds;
+    string error;
+    if (!buildScene(scene, false, renderWorld, world, renderNodes, nodes, renderObjects, objects,
+                    bounds, error)) {
+        printf("[bench] Could not build the scene: %s\n", error.c_str());
+        return result;
+    }
+
+    vector<double> spacing;
+    for (size_t i = 1; i < objects.size(); i++) {
+        const intptr_t a = reinterpret_cast<intptr_t>(objects[i - 1]);
+        const intptr_t b = reinterpret_cast<intptr_t>(objects[i]);
+        spacing.push_back((double)(a > b ? a - b : b - a));
+    }
+    result.spacingBytes = median(spacing);
+
+    vector<double> ns, l1, llc;
+    world->computeGlobalPositions(true);
+    for (int p = 0; p < a_passes; p++) {
+        a_counters.start();
+        const uint64_t t0 = hapticNowNs();
+        world->computeGlobalPositions(true);
+        const uint64_t elapsed = hapticNowNs() - t0;
+        uint64_t l1Misses, llcMisses;
+        a_counters.stop(l1Misses, llcMisses);
+
+        ns.push_back((double)elapsed / a_objects);
+        l1.push_back((double)l1Misses / a_objects);
+        llc.push_back((double)llcMisses / a_objects);
+    }
+    result.nsPerObject = median(ns);
+    if (a_counters.available()) {
+        result.l1PerObject = median(l1);
+        result.llcPerObject = median(llc);
+    }
+
+    delete world;
+    delete renderWorld;
+    return result;
+}
+
+static void printMisses(double a_value) {
+    if (a_value < 0.0) {
+        printf(" %9s", "n/a");
+    } else {
+        printf(" %9.2f", a_value);
+    }
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    int ticks = 20000;
+    int objects = 50000;
+    int passes = 200;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+            ticks = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--objects") && i + 1 < argc) {
+            objects = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--passes") && i + 1 < argc) {
+            passes = atoi(argv[++i]);
+        } else {
+            printf("Usage: bench-scene-pool [--ticks N] [--objects N] [--passes N]\n");
+            return 1;
+        }
+    }
+    if (ticks <= 0 || objects <= 1 || passes <= 0) {
+        printf("--ticks and --passes must be positive, --objects at least 2\n");
+        return 1;
+    }
+
+    bool pass = true;
+
+    printf("[bench] Steady-state haptic ticks: %d after %d warm-up ticks\n", ticks, warmupTicks);
+    printf("[bench] %8s %-8s %12s %14s %12s\n", "objects", "forces", "allocations",
+           "scratch blocks", "scratch KB");
+    const int sizes[] = { 1, 1000, 10000 };
+    for (int size : sizes) {
+        for (int batched = 0; batched < 2; batched++) {
+            const AllocationResult r = runTicks(size, batched != 0, ticks);
+            printf("[bench] %8d %-8s %12llu %14llu %12.1f\n", size, batched ? "batched" : "chai3d",
+                   (unsigned long long)r.allocations, (unsigned long long)r.scratchBlocks,
+                   r.scratchBytes / 1024.0);
+            if (!r.ok || r.allocations > 0 || r.scratchBlocks > 0) {
+                pass = false;
+            }
+        }
+    }
+
+    CacheMissCounters counters;
+    printf("[bench] Full traversal of %d haptic twins, median of %d passes%s\n", objects, passes,
+           counters.available() ? "" : " (no hardware cache counters)");
+    printf("[bench] %-6s %12s %10s %9s %9s\n", "nodes", "spacing B", "ns/object", "L1D/obj",
+           "LLC/obj");
+    for (int pooled = 0; pooled < 2; pooled++) {
+        const TraversalResult r = runTraversal(objects, pooled != 0, passes, counters);
+        printf("[bench] %-6s %12.0f %10.2f", pooled ? "pooled" : "heap", r.spacingBytes,
+               r.nsPerObject);
+        printMisses(r.l1PerObject);
+        printMisses(r.llcPerObject);
+        printf("\n");
+    }
+    printf("[bench] Traversal is reported only: pooled is not required to be faster\n");
+
+    printf("result: %s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+/****************************************************************************
+ * AIMLAB - Scene Snapshot Stress Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Runs a haptic-style writer and a render-style reader against the
+ *   SceneSnapshot triple buffer used between updateHaptics() and
+ *   updateGraphics().
+ *
+ *   The writer fills every field of each snapshot from its tick number;
+ *   the reader checks that every acquired snapshot is internally
+ *   consistent (no mix of two ticks) and that ticks never go backwards.
+ *   Every Nth frame the reader stalls to model a long render frame; the
+ *   writer's publish cost should not change when it does.
+ *
+ *   Built with -DAIMLAB_ENABLE_TSAN=ON this doubles as the race check for
+ *   the haptic/render hand-off. Exits non-zero on any inconsistency.
+ *
+ * Usage:
+ *   bench-snapshot-stress [--seconds S] [--rate HZ] [--slow-every N]
+ *                         [--slow-ms MS]
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Unsigned object loop counters
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "HapticClock.h"
+#include "LatencyHistogram.h"
+#include "SceneSnapshot.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+//===========================================================================
+// SHARED STATE
+//===========================================================================
+
+static SceneSnapshotBuffer snapshots;           // static storage: keeps alignas(64)
+static LatencyHistogram publishCost;
+static atomic<bool> running(true);
+
+static double fieldValue(uint64_t tick, int index) {
+    return (double)tick + 1e-3 * (double)index;
+}
+
+//===========================================================================
+// WRITER (haptic thread stand-in)
+//===========================================================================
+
+static void writer(double rateHz, uint64_t* publishedOut) {
+    const uint64_t period = (rateHz > 0.0) ? (uint64_t)(1e9 / rateHz) : 0;
+    uint64_t next = hapticNowNs();
+    uint64_t tick = 0;
+
+    while (running.load(memory_order_relaxed)) {
+        tick++;
+        const uint64_t t0 = hapticNowNs();
+
+        SceneSnapshot& s = snapshots.writeBuffer();
+        int field = 0;
+        for (int k = 0; k < 3; k++) {
+            s.devicePos[k] = fieldValue(tick, field++);
+            s.proxyPos[k]  = fieldValue(tick, field++);
+            s.goalPos[k]   = fieldValue(tick, field++);
+            s.force[k]     = fieldValue(tick, field++);
+        }
+        s.objectCount = SCENE_SNAPSHOT_MAX_OBJECTS;
+        for (uint32_t i = 0; i < SCENE_SNAPSHOT_MAX_OBJECTS; i++) {
+            for (int k = 0; k < 3; k++) {
+                s.objects[i].pos[k] = fieldValue(tick, field++);
+            }
+            for (int k = 0; k < 9; k++) {
+                s.objects[i].rot[k] = fieldValue(tick, field++);
+            }
+        }
+        s.tick = tick;
+        s.timestampNs = hapticNowNs();
+        snapshots.publish();
+
+        publishCost.record(hapticNowNs() - t0);
+
+        if (period != 0) {
+            next += period;
+            while (hapticNowNs() < next) {
+            }
+        }
+    }
+    *publishedOut = tick;
+}
+
+//===========================================================================
+// READER (render thread stand-in)
+//===========================================================================
+
+static bool consistent(const SceneSnapshot& s) {
+    int field = 0;
+    for (int k = 0; k < 3; k++) {
+        if (s.devicePos[k] != fieldValue(s.tick, field++)) return false;
+        if (s.proxyPos[k]  != fieldValue(s.tick, field++)) return false;
+        if (s.goalPos[k]   != fieldValue(s.tick, field++)) return false;
+        if (s.force[k]     != fieldValue(s.tick, field++)) return false;
+    }
+    if (s.objectCount != SCENE_SNAPSHOT_MAX_OBJECTS) return false;
+    for (uint32_t i = 0; i < SCENE_SNAPSHOT_MAX_OBJECTS; i++) {
+        for (int k = 0; k < 3; k++) {
+            if (s.objects[i].pos[k] != fieldValue(s.tick, field++)) return false;
+        }
+        for (int k = 0; k < 9; k++) {
+            if (s.objects[i].rot[k] != fieldValue(s.tick, field++)) return false;
+        }
+    }
+    return true;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    double seconds = 3.0;
+    double rateHz = 0.0;            // 0 = as fast as possible
+    int slowEvery = 10;
+    int slowMs = 30;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--rate") && i + 1 < argc) {
+            rateHz = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--slow-every") && i + 1 < argc) {
+            slowEvery = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--slow-ms") && i + 1 < argc) {
+            slowMs = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [--rate HZ] [--slow-every N] [--slow-ms MS]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    uint64_t published = 0;
+    thread writerThread(writer, rateHz, &published);
+
+    unique_ptr<LatencyHistogram> age(new LatencyHistogram());
+    uint64_t frames = 0, fresh = 0, torn = 0, backwards = 0, lastTick = 0;
+    const uint64_t end = hapticNowNs() + (uint64_t)(seconds * 1e9);
+
+    while (hapticNowNs() < end) {
+        if (snapshots.acquire()) {
+            const SceneSnapshot& s = snapshots.readBuffer();
+            fresh++;
+            if (!consistent(s)) {
+                torn++;
+            }
+            if (s.tick < lastTick) {
+                backwards++;
+            }
+            lastTick = s.tick;
+            age->record(hapticNowNs() - s.timestampNs);
+        }
+
+        frames++;
+        if (slowEvery > 0 && frames % slowEvery == 0) {
+            this_thread::sleep_for(chrono::milliseconds(slowMs));     // long frame
+        } else {
+            this_thread::sleep_for(chrono::microseconds(500));
+        }
+    }
+
+    running.store(false, memory_order_relaxed);
+    writerThread.join();
+
+    unique_ptr<LatencyHistogram::Snapshot> cost(new LatencyHistogram::Snapshot());
+    unique_ptr<LatencyHistogram::Snapshot> ages(new LatencyHistogram::Snapshot());
+    publishCost.snapshot(*cost);
+    age->snapshot(*ages);
+
+    printf("snapshot triple buffer (%.1f s, %s, slow frame %d ms every %d)\n", seconds,
+           rateHz > 0.0 ? "paced writer" : "free-running writer", slowMs, slowEvery);
+    printf("  published    : %llu snapshots (%zu bytes each)\n",
+           (unsigned long long)published, sizeof(SceneSnapshot));
+    printf("  publish cost : p50 %.0f  p99 %.0f  p99.9 %.0f  max %.0f ns\n",
+           (double)cost->percentile(0.5), (double)cost->percentile(0.99),
+           (double)cost->percentile(0.999), (double)cost->max);
+    printf("  reader       : %llu frames, %llu new snapshots\n",
+           (unsigned long long)frames, (unsigned long long)fresh);
+    printf("  age at read  : p50 %.1f  p99 %.1f us\n",
+           ages->percentile(0.5) * 1e-3, ages->percentile(0.99) * 1e-3);
+    printf("  torn         : %llu\n", (unsigned long long)torn);
+    printf("  backwards    : %llu\n", (unsigned long long)backwards);
+
+    return (torn == 0 && backwards == 0 && fresh > 0) ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/****************************************************************************
+ * AIMLAB - Network Stream Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Loopback run of the --stream path. A producer thread ticks at 1 kHz
+ *   like a haptic thread, asks sampleDue() and publish()es a sample when
+ *   it says so; a HapticStreamPublisher sends to 127.0.0.1 and a
+ *   HapticStreamSubscriber on another thread receives. Three settings:
+ *
+ *     1000 Hz, 1 sample per datagram     every tick, one datagram each
+ *     1000 Hz, 4 samples per datagram    every tick, batched
+ *      250 Hz, 4 samples per datagram    the application default
+ *
+ *   For each the report gives the datagrams and samples received, the
+ *   datagrams lost (sequence gaps plus those never received), end-to-end
+ *   sample latency (tick timestamp to receive, p50/p99/max; includes the
+ *   batching wait) and the p99 time the producer spent in sampleDue() +
+ *   publish(). Both ends share one clock, so latencies are exact.
+ *   CHAI3D-free.
+ *   Fails if a datagram is lost, a sample is dropped, or the p99 sample
+ *   is older than two batch periods plus 5 ms when it arrives. The max
+ *   is reported but not gated: one scheduling hiccup on a busy or
+ *   single-CPU machine would fail the run.
+ *
+ * Usage:
+ *   bench-stream [--seconds S] [--port N]
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Latency gate on p99; max is reported only
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "HapticClock.h"
+#include "HapticStreamPublisher.h"
+#include "HapticStreamSubscriber.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Over-aligned rings: static storage (see HapticStreamPublisher.h)
+static HapticStreamPublisher publisher;
+
+struct StreamSetting {
+    double rateHz;
+    int batch;
+};
+
+static uint64_t percentile(vector<uint64_t>& a_values, int a_percent) {
+    if (a_values.empty()) {
+        return 0;
+    }
+    std::sort(a_values.begin(), a_values.end());
+    return a_values[std::min(a_values.size() - 1, a_values.size() * a_percent / 100)];
+}
+
+//===========================================================================
+// ONE RUN
+//===========================================================================
+
+/**
+ * @brief Stream for a_seconds with one setting; print one report line
+ *
+ * @return false if the run failed its checks
+ */
+static bool runSetting(const StreamSetting& a_setting, uint16_t a_port, double a_seconds) {
+    string error;
+    HapticStreamSubscriber subscriber;
+    if (!subscriber.open(a_port, error, "127.0.0.1")) {
+        printf("[bench] Could not open subscriber: %s\n", error.c_str());
+        return false;
+    }
+
+    HapticStreamConfig config;
+    config.host = "127.0.0.1";
+    config.port = a_port;
+    config.rateHz = a_setting.rateHz;
+    config.batch = a_setting.batch;
+    if (!publisher.open(config, error)) {
+        printf("[bench] Could not open publisher: %s\n", error.c_str());
+        return false;
+    }
+
+    // Receiver: latency of every sample, until the producer is done and
+    // the line has been quiet for 200 ms
+    std::atomic<bool> producing(true);
+    vector<uint64_t> latencies;
+    latencies.reserve((size_t)(a_setting.rateHz * a_seconds) + 64);
+    uint64_t lastTick = 0;
+    bool ordered = true;
+    std::thread receiver([&]() {
+        HapticStreamPacket packet;
+        for (;;) {
+            if (subscriber.receive(packet, 200)) {
+                for (int i = 0; i < packet.header.sampleCount; i++) {
+                    const HapticStreamSample& sample = packet.samples[i];
+                    latencies.push_back(packet.receiveNs - sample.timestampNs);
+                    if (sample.tick <= lastTick) {
+                        ordered = false;
+                    }
+                    lastTick = sample.tick;
+                }
+            } else if (!producing.load(std::memory_order_acquire)) {
+                break;
+            }
+        }
+    });
+
+    // Producer: 1 kHz ticks, the haptic thread's side of the stream
+    const int ticks = (int)(a_seconds * 1000.0);
+    vector<uint64_t> callNs;
+    callNs.reserve(ticks);
+    uint64_t published = 0;
+    std::thread producer([&]() {
+        uint64_t next = hapticNowNs();
+        for (int tick = 1; tick <= ticks; tick++) {
+            next += 1000000ull;
+            while (hapticNowNs() < next) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+
+            const uint64_t t0 = hapticNowNs();
+            if (publisher.sampleDue(0, t0)) {
+                HapticStreamSample sample;
+                sample.timestampNs = t0;
+                sample.tick = (uint64_t)tick;
+                for (int k = 0; k < 3; k++) {
+                    sample.devicePos[k] = 0.001f * (float)k;
+                    sample.proxyPos[k] = sample.devicePos[k];
+                    sample.force[k] = 0.0f;
+                }
+                const double identity[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+                hapticStreamSetRotation(sample, identity);
+                publisher.publish(0, sample);
+                published++;
+            }
+            callNs.push_back(hapticNowNs() - t0);
+        }
+    });
+    producer.join();
+
+    const HapticStreamPublisherStats sent = publisher.close();
+    producing.store(false, std::memory_order_release);
+    receiver.join();
+    subscriber.close();
+
+    const HapticStreamSubscriberStats& received = subscriber.stats();
+    const uint64_t lost = received.lost + (sent.datagrams - std::min(sent.datagrams,
+                                                                     received.datagrams + received.lost));
+    const uint64_t p50 = percentile(latencies, 50);
+    const uint64_t p99 = percentile(latencies, 99);
+    const uint64_t maxNs = latencies.empty() ? 0 : latencies.back();
+    const uint64_t callP99 = percentile(callNs, 99);
+
+    printf("[bench] %6.0f %5d %9llu %9llu %9llu %5llu %9.2f %9.2f %9.2f %9.2f\n",
+           a_setting.rateHz, a_setting.batch, (unsigned long long)published,
+           (unsigned long long)received.datagrams, (unsigned long long)received.samples,
+           (unsigned long long)lost, p50 * 1e-3, p99 * 1e-3, maxNs * 1e-3, callP99 * 1e-3);
+
+    // A sample waits up to one batch period for the batch to fill, up to
+    // one more for the I/O thread's 1 ms pass, plus scheduling
+    const double batchPeriodNs = 1e9 * a_setting.batch / a_setting.rateHz;
+    const uint64_t limitNs = (uint64_t)(2.0 * batchPeriodNs) + 5000000ull;
+
+    bool pass = true;
+    if (lost > 0 || sent.dropped > 0 || sent.sendErrors > 0 || received.malformed > 0) {
+        pass = false;
+    }
+    if (received.samples != published || !ordered || p99 > limitNs) {
+        pass = false;
+    }
+    return pass;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    double seconds = 3.0;
+    int port = AIMLAB_STREAM_DEFAULT_PORT + 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else {
+            printf("Usage: bench-stream [--seconds S] [--port N]\n");
+            return 1;
+        }
+    }
+    if (seconds <= 0.0 || port < 1 || port > 65535) {
+        printf("--seconds must be positive and --port 1..65535\n");
+        return 1;
+    }
+
+    printf("[bench] Loopback stream, 1 kHz producer, %.1f s per setting, port %d\n", seconds, port);
+    printf("[bench] %6s %5s %9s %9s %9s %5s %9s %9s %9s %9s\n", "Hz", "batch", "published",
+           "datagrams", "samples", "lost", "p50 us", "p99 us", "max us", "call us");
+
+    const StreamSetting settings[] = { { 1000.0, 1 }, { 1000.0, 4 }, { 250.0, 4 } };
+    bool pass = true;
+    for (const StreamSetting& setting : settings) {
+        if (!runSetting(setting, (uint16_t)port, seconds)) {
+            pass = false;
+        }
+    }
+
+    printf("result: %s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
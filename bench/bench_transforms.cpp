@@ -0,0 +1,165 @@
+/****************************************************************************
+ * AIMLAB - Global Transform Update Benchmark
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Per-tick cost of world->computeGlobalPositions(true) (full traversal)
+ *   versus IncrementalTransformUpdater as the scene grows to 10k objects.
+ *
+ *   Scene: the world holds N/4 spheres, each with three child spheres,
+ *   plus a tool stand-in with two children that moves every tick (like
+ *   cToolCursor and its proxy/goal spheres). --moving sets how many
+ *   top-level spheres are moved per tick in addition to the tool, as the
+ *   Unity bridge would.
+ *
+ *   After timing, both paths are run on the same motion and their global
+ *   positions compared to check the incremental result is exact.
+ *
+ * Usage:
+ *   bench-transforms [--ticks N] [--moving K]
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial benchmark
+ *
+ ****************************************************************************/
+
+#include "chai3d.h"
+#include "HapticClock.h"
+#include "IncrementalTransformUpdater.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// SCENE
+//===========================================================================
+
+struct Scene {
+    cWorld* world;
+    cGenericObject* tool;
+    vector<cGenericObject*> movable;        // top-level spheres
+    vector<cGenericObject*> all;
+};
+
+static Scene buildScene(int objectCount) {
+    Scene scene;
+    scene.world = new cWorld();
+
+    for (int i = 0; i < objectCount / 4; i++) {
+        cShapeSphere* parent = new cShapeSphere(0.01);
+        parent->setLocalPos(0.001 * (i % 100), 0.001 * ((i / 100) % 100), 0.001 * (i / 10000));
+        scene.world->addChild(parent);
+        scene.movable.push_back(parent);
+        scene.all.push_back(parent);
+
+        for (int c = 0; c < 3; c++) {
+            cShapeSphere* child = new cShapeSphere(0.002);
+            child->setLocalPos(0.005 * (c + 1), 0.0, 0.0);
+            parent->addChild(child);
+            scene.all.push_back(child);
+        }
+    }
+
+    scene.tool = new cShapeSphere(0.015);
+    scene.world->addChild(scene.tool);
+    for (int c = 0; c < 2; c++) {
+        cShapeSphere* child = new cShapeSphere(0.01);
+        scene.tool->addChild(child);
+        scene.all.push_back(child);
+    }
+    scene.all.push_back(scene.tool);
+    return scene;
+}
+
+static void moveScene(Scene& scene, int tick, int moving, IncrementalTransformUpdater* updater) {
+    const double a = 0.001 * tick;
+    scene.tool->setLocalPos(0.01 * cos(a), 0.01 * sin(a), 0.0);
+
+    for (int k = 0; k < moving && !scene.movable.empty(); k++) {
+        cGenericObject* object = scene.movable[(tick * 7919 + k * 104729) % scene.movable.size()];
+        cVector3d pos = object->getLocalPos();
+        pos.z() = 0.0001 * ((tick + k) % 50);
+        object->setLocalPos(pos);
+        if (updater != nullptr) {
+            updater->markDirty(object);
+        }
+    }
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    int ticks = 5000;
+    int moving = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+            ticks = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--moving") && i + 1 < argc) {
+            moving = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--ticks N] [--moving K]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("global transform update (%d ticks, tool + %d moving objects per tick)\n", ticks, moving);
+    printf("  %8s  %14s  %14s  %8s  %s\n", "objects", "full ns/tick", "incr ns/tick", "speedup", "check");
+
+    const int sizes[] = { 10, 100, 1000, 10000 };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        Scene full = buildScene(sizes[s]);
+        Scene incr = buildScene(sizes[s]);
+        IncrementalTransformUpdater updater(incr.world, 1024);
+        updater.markAlwaysDirty(incr.tool);
+        full.world->computeGlobalPositions(true);
+        updater.update();
+
+        // Full traversal
+        uint64_t fullNs = 0;
+        for (int t = 0; t < ticks; t++) {
+            moveScene(full, t, moving, nullptr);
+            const uint64_t t0 = hapticNowNs();
+            full.world->computeGlobalPositions(true);
+            fullNs += hapticNowNs() - t0;
+        }
+
+        // Incremental
+        uint64_t incrNs = 0;
+        for (int t = 0; t < ticks; t++) {
+            moveScene(incr, t, moving, &updater);
+            const uint64_t t0 = hapticNowNs();
+            updater.update();
+            incrNs += hapticNowNs() - t0;
+        }
+
+        // Both scenes saw identical motion; global transforms must match
+        double maxError = 0.0;
+        for (size_t i = 0; i < full.all.size(); i++) {
+            const cVector3d d = full.all[i]->getGlobalPos() - incr.all[i]->getGlobalPos();
+            maxError = fmax(maxError, d.length());
+        }
+
+        const double fullPerTick = (double)fullNs / ticks;
+        const double incrPerTick = (double)incrNs / ticks;
+        printf("  %8d  %14.1f  %14.1f  %7.1fx  %s\n", sizes[s], fullPerTick, incrPerTick,
+               incrPerTick > 0.0 ? fullPerTick / incrPerTick : 0.0,
+               maxError == 0.0 ? "exact" : "MISMATCH");
+
+        delete full.world;
+        delete incr.world;
+    }
+
+    return 0;
+}
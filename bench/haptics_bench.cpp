@@ -0,0 +1,509 @@
+/****************************************************************************
+ * AIMLAB - Haptic Loop Micro-Benchmarks
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.2
+ *
+ * Description:
+ *   Google Benchmark suite for the haptic hot path, for tracking
+ *   regressions between versions. Each benchmark builds a haptic world the
+ *   way main() does (buildScene(), a cToolCursor on a simulated device,
+ *   IncrementalTransformUpdater, HapticBroadPhase) and runs one haptic
+ *   tick per iteration, the same calls in the same order as
+ *   computeHapticTick():
+ *
+ *     haptics/<stage>/N        one stage of the tick, timed on its own
+ *                              (the rest of the tick runs untimed, so the
+ *                              stage sees the state it sees in the app)
+ *     haptics/tick/N           the whole tick
+ *     haptics/tickBatched/N    the whole tick with --primitive-batch
+ *     noBroadPhase/<stage>/N   the stages with --no-broadphase
+ *     traversal/full/N         world->computeGlobalPositions(true)
+ *     traversal/incremental/N  IncrementalTransformUpdater::update()
+ *
+ *   HapticBroadPhase detaches every object from the haptic world and
+ *   reattaches only those near the tool, so with it a traversal walks the
+ *   tool and a few candidates whatever N is. The noBroadPhase and
+ *   traversal benchmarks therefore build the world without it, with every
+ *   object attached, and measure what the traversal costs per object.
+ *   Before the benchmarks run, a check times a full traversal of 100 and
+ *   of 10000 attached objects and exits with an error unless the larger
+ *   world takes at least 10 times as long, so a world that has lost its
+ *   objects cannot produce flat traversal numbers unnoticed.
+ *
+ *   N = 1 is main()'s built-in scene (one sphere); larger N is a grid of
+ *   spheres and boxes the tool's circle passes through. The simulated
+ *   device uses the step clock, so every run sees the same motion.
+ *
+ *   Besides the mean time per tick, every benchmark reports p50_ns,
+ *   p99_ns and max_ns of the timed section, and allocs_per_tick: heap
+ *   allocations made in the timed section (global operator new is
+ *   replaced with a counting one). The haptic loop should allocate
+ *   nothing once warm; 32 warm-up ticks run before timing.
+ *
+ *   Machine-readable output is Google Benchmark's own:
+ *     haptics-bench --benchmark_out=haptics-bench.json --benchmark_out_format=json
+ *   and two such files compare with Google Benchmark's tools/compare.py.
+ *   The haptics-bench-json target writes haptics-bench.json.
+ *
+ * Usage:
+ *   haptics-bench [--benchmark_filter=REGEX] [Google Benchmark options]
+ *
+ * Changelog:
+ *   v1.2 - 16 October 2026 - Traversal and noBroadPhase benchmarks on fully attached
+ *                            worlds; traversal growth check
+ *   v1.1 - 16 October 2026 - Scene node pools and per-tick scratch, as in main()
+ *   v1.0 - 16 October 2026 - Initial benchmark suite
+ *
+ ****************************************************************************/
+
+#include "chai3d.h"
+#include "Arena.h"
+#include "HapticBroadPhase.h"
+#include "HapticClock.h"
+#include "HapticLoopStats.h"
+#include "IncrementalTransformUpdater.h"
+#include "LatencyHistogram.h"
+#include "PrimitiveBatch.h"
+#include "SceneBuilder.h"
+#include "SceneDescription.h"
+#include "SimulatedHapticDevice.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// ALLOCATION COUNTING
+//===========================================================================
+
+static thread_local uint64_t threadAllocations = 0;
+
+void* operator new(size_t size) {
+    threadAllocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    threadAllocations++;
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+//===========================================================================
+// HAPTIC WORLD (as in main())
+//===========================================================================
+
+static const double toolRadius = 0.015;         // main.cpp's cursor
+static const int warmupTicks = 32;
+static const int growthSmall = 100;             // traversal growth check: objects
+static const int growthLarge = 10000;
+static const double growthMinRatio = 10.0;      // of the median times, for 100x the objects
+static const int growthRuns = 201;
+
+/**
+ * @brief main()'s scene for 1 object, else a grid of spheres and boxes
+ *
+ * The grid is centred on the origin in the z = 0 plane with 3 cm spacing,
+ * so the tool's 4 cm circle (0.4 cm device circle, workspace scale 10)
+ * crosses a handful of objects and leaves the rest to the broad phase.
+ */
+static SceneDescription benchScene(int a_objects) {
+    SceneDescription scene = defaultSceneDescription();
+    if (a_objects <= 1) {
+        return scene;
+    }
+
+    const SceneObjectDesc prototype = scene.objects[0];
+    scene.objects.clear();
+    const int side = (int)ceil(sqrt((double)a_objects));
+    for (int i = 0; i < a_objects; i++) {
+        SceneObjectDesc object = prototype;
+        object.name = "object" + to_string(i);
+        object.position[0] = 0.03 * (i % side - side / 2);
+        object.position[1] = 0.03 * (i / side - side / 2);
+        object.position[2] = 0.0;
+        if (i % 2 == 0) {
+            object.type = SCENE_OBJECT_SPHERE;
+            object.radius = 0.01;
+        } else {
+            object.type = SCENE_OBJECT_BOX;
+            object.size[0] = object.size[1] = object.size[2] = 0.016;
+        }
+        scene.objects.push_back(object);
+    }
+    return scene;
+}
+
+/**
+ * @brief Time and heap allocations of each stage of one tick
+ */
+struct TickSample {
+    uint64_t ns[STAGE_COUNT];
+    uint64_t allocations[STAGE_COUNT];
+};
+
+/**
+ * @brief One device's haptic world, set up like setupDeviceLoop()
+ *
+ * Without a broad phase (--no-broadphase) every object stays attached to
+ * the haptic world and the tool tests them all.
+ */
+class BenchWorld {
+public:
+    BenchWorld(int a_objects, bool a_primitiveBatch, bool a_broadPhase)
+        : m_renderWorld(new (m_renderNodes) PooledNode<cWorld>()),
+          m_world(new (m_nodes) PooledNode<cWorld>()),
+          m_tool(nullptr),
+          m_transformUpdater(nullptr),
+          m_broadPhase(nullptr),
+          m_ok(false) {
+        const SceneDescription scene = benchScene(a_objects);
+        vector<cGenericObject*> renderObjects;
+        vector<ObjectBounds> bounds;
+        string error;
+        if (!buildScene(scene, false, m_renderWorld, m_world, m_renderNodes, m_nodes, renderObjects,
+                        m_objects, bounds, error)) {
+            m_error = error;
+            return;
+        }
+
+        SimulatedDeviceConfig config;
+        config.clock = SIM_CLOCK_STEP;
+        m_device = std::make_shared<SimulatedHapticDevice>(config);
+        m_device->open();
+
+        m_tool = new (m_nodes) PooledNode<cToolCursor>(m_world);
+        m_world->addChild(m_tool);
+        m_tool->setHapticDevice(m_device);
+        m_tool->setRadius(toolRadius);
+        m_tool->setWorkspaceRadius(1.0);
+        m_tool->enableDynamicObjects(true);
+        m_tool->start();
+
+        m_transformUpdater = new IncrementalTransformUpdater(m_world);
+        m_transformUpdater->markAlwaysDirty(m_tool);
+
+        if (a_primitiveBatch) {
+            m_primitives.reset(new PrimitiveBatch());
+            buildPrimitiveBatch(scene, m_objects, *m_primitives, m_primitiveOf);
+        }
+
+        vector<bool> haptic;
+        for (size_t i = 0; i < scene.objects.size(); i++) {
+            const bool batched = m_primitives != nullptr &&
+                                 m_primitiveOf[i].kind != PRIMITIVE_NONE;
+            haptic.push_back(scene.objects[i].haptic && !batched);
+        }
+        if (a_broadPhase) {
+            m_broadPhase = new HapticBroadPhase(m_world, m_objects, bounds, haptic, 2.0 * toolRadius,
+                                                0.0);
+            m_scratch.reserve(m_broadPhase->scratchBytes());
+        }
+
+        for (int i = 0; i < warmupTicks; i++) {
+            TickSample sample;
+            tick(sample);
+        }
+        m_ok = true;
+    }
+
+    ~BenchWorld() {
+        if (m_tool != nullptr) {
+            m_tool->stop();
+        }
+        delete m_transformUpdater;
+        delete m_broadPhase;                // Reattaches objects before the world goes
+        delete m_world;
+        delete m_renderWorld;
+    }
+
+    BenchWorld(const BenchWorld&) = delete;
+    BenchWorld& operator=(const BenchWorld&) = delete;
+
+    bool ok() const { return m_ok; }
+    const string& error() const { return m_error; }
+    cWorld* world() { return m_world; }
+    IncrementalTransformUpdater& transformUpdater() { return *m_transformUpdater; }
+
+    /**
+     * @brief One computeHapticTick(); a_sample receives each stage's time
+     *        and allocations (STAGE_GLOBAL_POSITIONS .. STAGE_APPLY_TO_DEVICE,
+     *        and STAGE_TICK for the whole tick)
+     */
+    void tick(TickSample& a_sample) {
+        uint64_t a[7];
+        a[0] = threadAllocations;
+        const uint64_t t0 = hapticNowNs();
+        m_transformUpdater->update();
+        const uint64_t t1 = hapticNowNs();
+        a[1] = threadAllocations;
+        m_tool->updateFromDevice();
+        const uint64_t t2 = hapticNowNs();
+        a[2] = threadAllocations;
+        if (m_broadPhase != nullptr) {
+            m_broadPhase->update(m_tool->getDeviceGlobalPos(),
+                                 m_tool->m_hapticPoint->getGlobalPosProxy(), m_scratch);
+        }
+        const uint64_t t3 = hapticNowNs();
+        a[3] = threadAllocations;
+        m_tool->computeInteractionForces();
+        const uint64_t t4 = hapticNowNs();
+        a[4] = threadAllocations;
+        if (m_primitives != nullptr) {
+            const cVector3d pos = m_tool->getDeviceGlobalPos();
+            const cVector3d vel = m_tool->getDeviceGlobalLinVel();
+            PrimitiveTool probe = { { pos.x(), pos.y(), pos.z() }, { vel.x(), vel.y(), vel.z() },
+                                    toolRadius };
+            double force[3];
+            m_primitives->computeForce(probe, force);
+            m_tool->addDeviceGlobalForce(cVector3d(force[0], force[1], force[2]));
+        }
+        const uint64_t t5 = hapticNowNs();
+        a[5] = threadAllocations;
+        m_tool->applyToDevice();
+        const uint64_t t6 = hapticNowNs();
+        a[6] = threadAllocations;
+
+        a_sample.ns[STAGE_GLOBAL_POSITIONS]   = t1 - t0;
+        a_sample.ns[STAGE_UPDATE_FROM_DEVICE] = t2 - t1;
+        a_sample.ns[STAGE_BROAD_PHASE]        = t3 - t2;
+        a_sample.ns[STAGE_INTERACTION_FORCES] = t4 - t3;
+        a_sample.ns[STAGE_PRIMITIVES]         = t5 - t4;
+        a_sample.ns[STAGE_APPLY_TO_DEVICE]    = t6 - t5;
+        a_sample.ns[STAGE_TICK]               = t6 - t0;
+        for (int s = STAGE_GLOBAL_POSITIONS; s <= STAGE_APPLY_TO_DEVICE; s++) {
+            a_sample.allocations[s] = a[s + 1] - a[s];
+        }
+        a_sample.allocations[STAGE_TICK] = a[6] - a[0];
+        m_scratch.reset();
+    }
+
+    /**
+     * @brief Move the tool's device one sample on without a tick, so
+     *        traversal benchmarks see the tool move as it does in the app
+     */
+    void moveTool() {
+        m_tool->updateFromDevice();
+    }
+
+private:
+    SceneNodePool m_renderNodes;            // Before the worlds: they are created in these
+    SceneNodePool m_nodes;
+    Arena m_scratch;
+    cWorld* m_renderWorld;
+    cWorld* m_world;
+    cToolCursor* m_tool;
+    std::shared_ptr<SimulatedHapticDevice> m_device;
+    vector<cGenericObject*> m_objects;
+    IncrementalTransformUpdater* m_transformUpdater;
+    HapticBroadPhase* m_broadPhase;
+    std::unique_ptr<PrimitiveBatch> m_primitives;
+    vector<PrimitiveHandle> m_primitiveOf;
+    bool m_ok;
+    string m_error;
+};
+
+//===========================================================================
+// BENCHMARKS
+//===========================================================================
+
+/**
+ * @brief Distribution and allocation counters of the timed sections
+ */
+static void reportCounters(benchmark::State& a_state, const LatencyHistogram& a_times,
+                           uint64_t a_allocations) {
+    std::unique_ptr<LatencyHistogram::Snapshot> s(new LatencyHistogram::Snapshot());
+    a_times.snapshot(*s);
+    a_state.counters["p50_ns"] = (double)s->percentile(0.5);
+    a_state.counters["p99_ns"] = (double)s->percentile(0.99);
+    a_state.counters["max_ns"] = (double)s->max;
+    a_state.counters["allocs_per_tick"] =
+        benchmark::Counter((double)a_allocations, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief One stage (or STAGE_TICK for all of them) of a full haptic tick
+ */
+static void benchStage(benchmark::State& a_state, HapticStage a_stage, int a_objects,
+                       bool a_primitiveBatch, bool a_broadPhase) {
+    BenchWorld world(a_objects, a_primitiveBatch, a_broadPhase);
+    if (!world.ok()) {
+        a_state.SkipWithError(world.error().c_str());
+        return;
+    }
+
+    std::unique_ptr<LatencyHistogram> times(new LatencyHistogram());
+    uint64_t allocations = 0;
+    TickSample sample;
+    for (auto _ : a_state) {
+        world.tick(sample);
+        allocations += sample.allocations[a_stage];
+        times->record(sample.ns[a_stage]);
+        a_state.SetIterationTime((double)sample.ns[a_stage] * 1e-9);
+    }
+    reportCounters(a_state, *times, allocations);
+}
+
+/**
+ * @brief Global transform update, full traversal or incremental, with
+ *        every object attached
+ */
+static void benchTraversal(benchmark::State& a_state, bool a_incremental, int a_objects) {
+    BenchWorld world(a_objects, false, false);
+    if (!world.ok()) {
+        a_state.SkipWithError(world.error().c_str());
+        return;
+    }
+
+    std::unique_ptr<LatencyHistogram> times(new LatencyHistogram());
+    uint64_t allocations = 0;
+    for (auto _ : a_state) {
+        world.moveTool();
+
+        const uint64_t before = threadAllocations;
+        const uint64_t t0 = hapticNowNs();
+        if (a_incremental) {
+            world.transformUpdater().update();
+        } else {
+            world.world()->computeGlobalPositions(true);
+        }
+        const uint64_t elapsed = hapticNowNs() - t0;
+        allocations += threadAllocations - before;
+
+        times->record(elapsed);
+        a_state.SetIterationTime((double)elapsed * 1e-9);
+    }
+    reportCounters(a_state, *times, allocations);
+}
+
+/**
+ * @brief Register every benchmark for every scene size
+ *
+ * Iteration counts are fixed: with manual timing of a short stage, Google
+ * Benchmark's automatic count would run millions of (untimed) full ticks.
+ */
+static void registerBenchmarks() {
+    const int sizes[] = { 1, 100, 1000, 10000 };
+    const HapticStage stages[] = { STAGE_GLOBAL_POSITIONS, STAGE_UPDATE_FROM_DEVICE,
+                                   STAGE_BROAD_PHASE, STAGE_INTERACTION_FORCES,
+                                   STAGE_APPLY_TO_DEVICE, STAGE_TICK };
+
+    for (int objects : sizes) {
+        const int64_t ticks = (objects >= 10000) ? 2000 : 10000;
+        const string n = "/" + to_string(objects);
+
+        for (HapticStage stage : stages) {
+            const string name = string("haptics/") + HapticLoopStats::stageName(stage) + n;
+            benchmark::RegisterBenchmark(name.c_str(), benchStage, stage, objects, false, true)
+                ->UseManualTime()->Iterations(ticks)->Unit(benchmark::kMicrosecond);
+        }
+        benchmark::RegisterBenchmark(("haptics/primitives" + n).c_str(), benchStage,
+                                     STAGE_PRIMITIVES, objects, true, true)
+            ->UseManualTime()->Iterations(ticks)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("haptics/tickBatched" + n).c_str(), benchStage,
+                                     STAGE_TICK, objects, true, true)
+            ->UseManualTime()->Iterations(ticks)->Unit(benchmark::kMicrosecond);
+
+        for (HapticStage stage : stages) {
+            if (stage == STAGE_BROAD_PHASE) {
+                continue;
+            }
+            const string name = string("noBroadPhase/") + HapticLoopStats::stageName(stage) + n;
+            benchmark::RegisterBenchmark(name.c_str(), benchStage, stage, objects, false, false)
+                ->UseManualTime()->Iterations(ticks)->Unit(benchmark::kMicrosecond);
+        }
+
+        benchmark::RegisterBenchmark(("traversal/full" + n).c_str(), benchTraversal, false, objects)
+            ->UseManualTime()->Iterations(ticks)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("traversal/incremental" + n).c_str(), benchTraversal, true,
+                                     objects)
+            ->UseManualTime()->Iterations(ticks)->Unit(benchmark::kMicrosecond);
+    }
+}
+
+/**
+ * @brief Median full traversal of a fully attached world (ns), 0 on error
+ */
+static uint64_t medianFullTraversal(int a_objects) {
+    BenchWorld world(a_objects, false, false);
+    if (!world.ok()) {
+        fprintf(stderr, "traversal check: %s\n", world.error().c_str());
+        return 0;
+    }
+    vector<uint64_t> times(growthRuns);
+    for (int i = 0; i < growthRuns; i++) {
+        world.moveTool();
+        const uint64_t t0 = hapticNowNs();
+        world.world()->computeGlobalPositions(true);
+        times[i] = hapticNowNs() - t0;
+    }
+    std::nth_element(times.begin(), times.begin() + growthRuns / 2, times.end());
+    return times[growthRuns / 2];
+}
+
+/**
+ * @brief Check that a full traversal gets dearer with the object count
+ *
+ * Printed to stderr, so JSON on stdout stays valid.
+ *
+ * @return true if the larger world is at least growthMinRatio times dearer
+ */
+static bool checkTraversalGrowth() {
+    const uint64_t small = medianFullTraversal(growthSmall);
+    const uint64_t large = medianFullTraversal(growthLarge);
+    if (small == 0 || large == 0) {
+        return false;
+    }
+    const double ratio = (double)large / (double)small;
+    const bool ok = ratio >= growthMinRatio;
+    fprintf(stderr, "traversal check: full traversal %d objects %.1f us, %d objects %.1f us, "
+            "%.1fx (need %.0fx): %s\n", growthSmall, small * 1e-3, growthLarge, large * 1e-3, ratio,
+            growthMinRatio, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    if (!checkTraversalGrowth()) {
+        return 1;
+    }
+    registerBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,474 @@
+/****************************************************************************
+ * AIMLAB - Command-Line Options
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.18
+ *
+ * Description:
+ *   Implementation of parseAppOptions(). See AppOptions.h.
+ *
+ * Changelog:
+ *   v1.18 - 16 October 2026 - --device-filter help states the measured stable limit
+ *   v1.17 - 16 October 2026 - --primitive-batch help notes the dropped friction terms
+ *   v1.16 - 16 October 2026 - --devices help notes that replicas do not share object state
+ *   v1.15 - 16 October 2026 - --device-filter and its settings
+ *   v1.14 - 16 October 2026 - --no-scene-pool
+ *   v1.13 - 16 October 2026 - --restart-cycles (pipeline stop/start stress run)
+ *   v1.12 - 16 October 2026 - --stream, --stream-rate and --stream-batch
+ *   v1.11 - 16 October 2026 - --primitive-batch and --no-simd
+ *   v1.10 - 16 October 2026 - --multirate (simulation thread + local contact model)
+ *   v1.9 - 16 October 2026 - --no-broadphase and --broadphase-cell
+ *   v1.8 - 16 October 2026 - --devices (one haptic thread per device)
+ *   v1.7 - 16 October 2026 - --scene and --no-mesh-cache
+ *   v1.6 - 16 October 2026 - Session replay and scene material options
+ *   v1.5 - 16 October 2026 - --record session recording
+ *   v1.4 - 16 October 2026 - Headless rendering, frame cap and frame benchmark
+ *   v1.3 - 16 October 2026 - --full-transforms
+ *   v1.2 - 16 October 2026 - Fixed-rate haptic scheduler options
+ *   v1.1 - 16 October 2026 - Haptic loop statistics options
+ *   v1.0 - 16 October 2026 - Device selection, simulated device, graphics-free runs
+ *
+ ****************************************************************************/
+
+#include "AppOptions.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+//===========================================================================
+// HELPERS
+//===========================================================================
+
+static bool readDouble(int argc, char* argv[], int& i, double& value) {
+    if (i + 1 >= argc) {
+        return false;
+    }
+    char* end = nullptr;
+    value = strtod(argv[++i], &end);
+    return end != argv[i] && *end == '\0';
+}
+
+static bool readInt(int argc, char* argv[], int& i, int& value) {
+    if (i + 1 >= argc) {
+        return false;
+    }
+    char* end = nullptr;
+    value = (int)strtol(argv[++i], &end, 10);
+    return end != argv[i] && *end == '\0';
+}
+
+static bool readString(int argc, char* argv[], int& i, string& value) {
+    if (i + 1 >= argc) {
+        return false;
+    }
+    value = argv[++i];
+    return true;
+}
+
+/**
+ * @brief Split HOST[:PORT] into the stream configuration
+ */
+static bool parseStreamTarget(const string& target, HapticStreamConfig& config) {
+    const size_t colon = target.rfind(':');
+    config.host = target.substr(0, colon);
+    if (colon != string::npos) {
+        char* end = nullptr;
+        const long port = strtol(target.c_str() + colon + 1, &end, 10);
+        if (*end != '\0' || port < 1 || port > 65535) {
+            return false;
+        }
+        config.port = (uint16_t)port;
+    }
+    return !config.host.empty();
+}
+
+//===========================================================================
+// PARSER
+//===========================================================================
+
+bool parseAppOptions(int argc, char* argv[], AppOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool ok = true;
+        string text;
+
+        if (!strcmp(arg, "--help") || !strcmp(arg, "-h")) {
+            printAppUsage(argv[0]);
+            exit(0);
+
+        } else if (!strcmp(arg, "--device")) {
+            ok = readString(argc, argv, i, text) && (text == "auto" || text == "sim");
+            options.useSimulatedDevice = (text == "sim");
+
+        } else if (!strcmp(arg, "--devices")) {
+            ok = readInt(argc, argv, i, options.deviceCount) && options.deviceCount >= 1 &&
+                 options.deviceCount <= AIMLAB_MAX_HAPTIC_DEVICES;
+
+        } else if (!strcmp(arg, "--sim-motion")) {
+            ok = readString(argc, argv, i, text);
+            if (text == "circle") {
+                options.simulated.motion = SIM_MOTION_CIRCLE;
+            } else if (text == "hand") {
+                options.simulated.motion = SIM_MOTION_HAND;
+            } else if (text.compare(0, 5, "file:") == 0 && text.size() > 5) {
+                options.simulated.motion = SIM_MOTION_FILE;
+                options.simulated.trajectoryFile = text.substr(5);
+            } else {
+                ok = false;
+            }
+
+        } else if (!strcmp(arg, "--sim-rate")) {
+            ok = readDouble(argc, argv, i, options.simulated.sampleRateHz) &&
+                 options.simulated.sampleRateHz > 0.0;
+
+        } else if (!strcmp(arg, "--sim-clock")) {
+            ok = readString(argc, argv, i, text) && (text == "wall" || text == "step");
+            options.simulated.clock = (text == "step") ? SIM_CLOCK_STEP : SIM_CLOCK_WALL;
+
+        } else if (!strcmp(arg, "--sim-radius")) {
+            ok = readDouble(argc, argv, i, options.simulated.circleRadius);
+
+        } else if (!strcmp(arg, "--sim-frequency")) {
+            ok = readDouble(argc, argv, i, options.simulated.circleFrequencyHz);
+
+        } else if (!strcmp(arg, "--device-filter")) {
+            options.deviceFilter.enabled = true;
+
+        } else if (!strcmp(arg, "--filter-window")) {
+            options.deviceFilter.enabled = true;
+            ok = readInt(argc, argv, i, options.deviceFilter.window) &&
+                 options.deviceFilter.window >= 2 &&
+                 options.deviceFilter.window <= AIMLAB_FILTER_MAX_WINDOW;
+
+        } else if (!strcmp(arg, "--filter-horizon-ms")) {
+            double horizonMs = 0.0;
+            options.deviceFilter.enabled = true;
+            ok = readDouble(argc, argv, i, horizonMs) && horizonMs >= 0.0 && horizonMs <= 100.0;
+            options.deviceFilter.horizonS = horizonMs * 1e-3;
+
+        } else if (!strcmp(arg, "--filter-cutoff")) {
+            options.deviceFilter.enabled = true;
+            ok = readDouble(argc, argv, i, options.deviceFilter.cutoffHz) &&
+                 options.deviceFilter.cutoffHz >= 0.0;
+
+        } else if (!strcmp(arg, "--filter-damping")) {
+            options.deviceFilter.enabled = true;
+            ok = readDouble(argc, argv, i, options.deviceFilter.maxDamping) &&
+                 options.deviceFilter.maxDamping >= 0.0;
+
+        } else if (!strcmp(arg, "--no-passivity")) {
+            options.deviceFilter.enabled = true;
+            options.deviceFilter.passivity = false;
+
+        } else if (!strcmp(arg, "--no-graphics")) {
+            options.graphicsEnabled = false;
+
+        } else if (!strcmp(arg, "--headless")) {
+            options.headless = true;
+
+        } else if (!strcmp(arg, "--size")) {
+            ok = readString(argc, argv, i, text) &&
+                 sscanf(text.c_str(), "%dx%d", &options.framebufferWidth,
+                        &options.framebufferHeight) == 2 &&
+                 options.framebufferWidth > 0 && options.framebufferHeight > 0;
+
+        } else if (!strcmp(arg, "--max-fps")) {
+            ok = readDouble(argc, argv, i, options.maxFps) && options.maxFps >= 0.0;
+
+        } else if (!strcmp(arg, "--bench-frames")) {
+            ok = readInt(argc, argv, i, options.benchFrames) && options.benchFrames > 0;
+            options.headless = true;
+
+        } else if (!strcmp(arg, "--bench-out")) {
+            ok = readString(argc, argv, i, options.benchOutputFile);
+
+        } else if (!strcmp(arg, "--duration")) {
+            ok = readDouble(argc, argv, i, options.durationSeconds) &&
+                 options.durationSeconds >= 0.0;
+
+        } else if (!strcmp(arg, "--restart-cycles")) {
+            ok = readInt(argc, argv, i, options.restartCycles) && options.restartCycles > 0;
+
+        } else if (!strcmp(arg, "--rate")) {
+            ok = readDouble(argc, argv, i, options.scheduler.rateHz) &&
+                 options.scheduler.rateHz >= 0.0 && options.scheduler.rateHz <= 20000.0;
+
+        } else if (!strcmp(arg, "--spin-us")) {
+            double spinUs = 0.0;
+            ok = readDouble(argc, argv, i, spinUs) && spinUs >= 0.0;
+            options.scheduler.spinNs = (uint64_t)(spinUs * 1000.0);
+
+        } else if (!strcmp(arg, "--overrun")) {
+            ok = readString(argc, argv, i, text) &&
+                 parseOverrunPolicy(text, options.scheduler.overrun);
+
+        } else if (!strcmp(arg, "--fifo")) {
+            options.scheduler.realtime = true;
+
+        } else if (!strcmp(arg, "--fifo-priority")) {
+            options.scheduler.realtime = true;
+            ok = readInt(argc, argv, i, options.scheduler.realtimePriority) &&
+                 options.scheduler.realtimePriority >= 1 &&
+                 options.scheduler.realtimePriority <= 99;
+
+        } else if (!strcmp(arg, "--cpu")) {
+            ok = readInt(argc, argv, i, options.scheduler.cpu) && options.scheduler.cpu >= 0;
+
+        } else if (!strcmp(arg, "--full-transforms")) {
+            options.incrementalTransforms = false;
+
+        } else if (!strcmp(arg, "--no-broadphase")) {
+            options.broadPhase = false;
+
+        } else if (!strcmp(arg, "--multirate")) {
+            ok = readDouble(argc, argv, i, options.multirateHz) &&
+                 options.multirateHz >= 0.0 && options.multirateHz <= 1000.0;
+
+        } else if (!strcmp(arg, "--primitive-batch")) {
+            options.primitiveBatch = true;
+
+        } else if (!strcmp(arg, "--no-simd")) {
+            options.primitiveSimd = false;
+
+        } else if (!strcmp(arg, "--broadphase-cell")) {
+            ok = readDouble(argc, argv, i, options.broadPhaseCellSize) &&
+                 options.broadPhaseCellSize >= 0.0;
+
+        } else if (!strcmp(arg, "--stats-interval")) {
+            ok = readDouble(argc, argv, i, options.statsIntervalSeconds) &&
+                 options.statsIntervalSeconds >= 0.0;
+
+        } else if (!strcmp(arg, "--deadline-us")) {
+            ok = readDouble(argc, argv, i, options.deadlineMicroseconds) &&
+                 options.deadlineMicroseconds >= 0.0;
+
+        } else if (!strcmp(arg, "--stats-out")) {
+            ok = readString(argc, argv, i, options.statsOutputFile);
+
+        } else if (!strcmp(arg, "--record")) {
+            ok = readString(argc, argv, i, options.recordFile);
+
+        } else if (!strcmp(arg, "--scene")) {
+            ok = readString(argc, argv, i, options.sceneFile);
+
+        } else if (!strcmp(arg, "--no-mesh-cache")) {
+            options.meshCache = false;
+
+        } else if (!strcmp(arg, "--no-scene-pool")) {
+            options.scenePool = false;
+
+        } else if (!strcmp(arg, "--replay")) {
+            ok = readString(argc, argv, i, options.replayFile);
+
+        } else if (!strcmp(arg, "--replay-tolerance")) {
+            ok = readDouble(argc, argv, i, options.replayTolerance) &&
+                 options.replayTolerance >= 0.0;
+
+        } else if (!strcmp(arg, "--replay-diff")) {
+            ok = readString(argc, argv, i, options.replayDiffFile);
+
+        } else if (!strcmp(arg, "--stiffness")) {
+            ok = readDouble(argc, argv, i, options.stiffness) && options.stiffness >= 0.0;
+
+        } else if (!strcmp(arg, "--static-friction")) {
+            ok = readDouble(argc, argv, i, options.staticFriction) && options.staticFriction >= 0.0;
+
+        } else if (!strcmp(arg, "--dynamic-friction")) {
+            ok = readDouble(argc, argv, i, options.dynamicFriction) && options.dynamicFriction >= 0.0;
+
+        } else if (!strcmp(arg, "--viscosity")) {
+            ok = readDouble(argc, argv, i, options.viscosity) && options.viscosity >= 0.0;
+
+        } else if (!strcmp(arg, "--bridge")) {
+            ok = readString(argc, argv, i, options.bridgeName);
+            options.bridgeEnabled = true;
+
+        } else if (!strcmp(arg, "--no-bridge")) {
+            options.bridgeEnabled = false;
+
+        } else if (!strcmp(arg, "--stream")) {
+            string target;
+            ok = readString(argc, argv, i, target) && parseStreamTarget(target, options.stream);
+            options.streamEnabled = true;
+
+        } else if (!strcmp(arg, "--stream-rate")) {
+            ok = readDouble(argc, argv, i, options.stream.rateHz) &&
+                 options.stream.rateHz > 0.0 && options.stream.rateHz <= 10000.0;
+
+        } else if (!strcmp(arg, "--stream-batch")) {
+            ok = readInt(argc, argv, i, options.stream.batch) &&
+                 options.stream.batch >= 1 && options.stream.batch <= AIMLAB_STREAM_MAX_BATCH;
+
+        } else if (!strncmp(arg, "--", 2)) {
+            cout << "Unknown option: " << arg << endl;
+            ok = false;
+        }
+        // Anything else (single-dash GLUT options) is left for glutInit()
+
+        if (!ok) {
+            cout << "Invalid value for option " << arg << endl << endl;
+            printAppUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (options.headless && !options.graphicsEnabled) {
+        cout << "--headless and --no-graphics are mutually exclusive." << endl;
+        return false;
+    }
+
+    // Replay runs the pipeline on the main thread as fast as it can; there
+    // is nothing to draw and no device or Unity to talk to
+    if (!options.replayFile.empty()) {
+        if (options.headless) {
+            cout << "--replay and --headless are mutually exclusive." << endl;
+            return false;
+        }
+        if (options.multirateHz > 0.0) {
+            cout << "--replay and --multirate are mutually exclusive." << endl;
+            return false;
+        }
+        if (options.restartCycles > 0) {
+            cout << "--replay and --restart-cycles are mutually exclusive." << endl;
+            return false;
+        }
+        options.graphicsEnabled = false;
+        options.bridgeEnabled = false;
+        options.streamEnabled = false;
+        options.useSimulatedDevice = false;
+        options.deviceCount = 1;
+        return true;
+    }
+
+    // A recording holds what one tool read and commanded per tick; with
+    // --multirate the haptic thread renders without a tool
+    if (!options.recordFile.empty() && options.multirateHz > 0.0) {
+        cout << "--record and --multirate are mutually exclusive." << endl;
+        return false;
+    }
+
+    // The local contact model only holds planes from CHAI3D's contact
+    // events; batched primitives produce none
+    if (options.primitiveBatch && options.multirateHz > 0.0) {
+        cout << "--primitive-batch and --multirate are mutually exclusive." << endl;
+        return false;
+    }
+
+    // The stress run drives the pipeline from the main thread, without a window
+    if (options.restartCycles > 0) {
+        if (options.headless) {
+            cout << "--restart-cycles and --headless are mutually exclusive." << endl;
+            return false;
+        }
+        options.graphicsEnabled = false;
+        return true;
+    }
+
+    if (!options.graphicsEnabled && options.durationSeconds <= 0.0) {
+        cout << "Note: --no-graphics without --duration runs until interrupted." << endl;
+    }
+
+    return true;
+}
+
+void printAppUsage(const char* program) {
+    cout << "Usage: " << program << " [options]" << endl;
+    cout << endl;
+    cout << "Device:" << endl;
+    cout << "  --device auto|sim        Hardware device (default) or simulated device" << endl;
+    cout << "  --devices N              Drive N devices, one haptic thread each (1-"
+         << AIMLAB_MAX_HAPTIC_DEVICES << ";" << endl;
+    cout << "                           default: every detected device, or one simulated)." << endl;
+    cout << "                           Each device has its own replica of the scene: an object" << endl;
+    cout << "                           moved or deformed by one tool is not seen by the others" << endl;
+    cout << "                           (Unity transforms reach every replica)" << endl;
+    cout << "  --sim-motion MODE        circle | hand | file:PATH (CSV t,x,y,z)" << endl;
+    cout << "  --sim-rate HZ            Simulated transport rate (default 1000)" << endl;
+    cout << "  --sim-clock wall|step    Real time, or one sample per haptic tick" << endl;
+    cout << "  --sim-radius M           Scripted circle radius in device meters" << endl;
+    cout << "  --sim-frequency HZ       Scripted circle frequency" << endl;
+    cout << "  --device-filter          Extrapolate device samples, estimate velocity and smooth" << endl;
+    cout << "                           forces with a passivity controller (slow or jittery" << endl;
+    cout << "                           devices; the filter options below imply it). On a" << endl;
+    cout << "                           100 Hz device it holds walls up to about 500 N/m," << endl;
+    cout << "                           below the default 1000 N/m (bench-device-filter)" << endl;
+    cout << "  --filter-window N        Samples in the least-squares velocity fit (2-"
+         << AIMLAB_FILTER_MAX_WINDOW << ", 4)" << endl;
+    cout << "  --filter-horizon-ms MS   Longest extrapolation (20; 0 = hold the newest sample)" << endl;
+    cout << "  --filter-cutoff HZ       Force low-pass cutoff (150; 0 = off)" << endl;
+    cout << "  --filter-damping NSM     Passivity controller damping limit in N.s/m" << endl;
+    cout << "                           (0 = the device's maximum)" << endl;
+    cout << "  --no-passivity           Filter without the passivity controller" << endl;
+    cout << endl;
+    cout << "Run mode:" << endl;
+    cout << "  --no-graphics            Run the haptic loop without a GLUT window" << endl;
+    cout << "  --headless               Render offscreen (EGL, no window or X server)" << endl;
+    cout << "  --size WxH               Headless framebuffer size (1024x768)" << endl;
+    cout << "  --max-fps FPS            Frame cap for window or headless (0 = uncapped)" << endl;
+    cout << "  --duration S             Quit after S seconds (0 = until quit)" << endl;
+    cout << "  --restart-cycles N       Stop and restart the haptic pipeline N times, print" << endl;
+    cout << "                           the stop/start latency and quit (implies --no-graphics)" << endl;
+    cout << endl;
+    cout << "Frame benchmark:" << endl;
+    cout << "  --bench-frames N         Render N headless frames, print frame-time percentiles" << endl;
+    cout << "  --bench-out FILE         Also write the frame-time report as JSON" << endl;
+    cout << endl;
+    cout << "Haptic scheduler:" << endl;
+    cout << "  --rate HZ                Fixed haptic rate, e.g. 1000, 2000, 4000 (0 = busy loop)" << endl;
+    cout << "  --spin-us US             Busy-wait before each deadline (50)" << endl;
+    cout << "  --overrun skip|catch-up  What to do after a tick overruns (skip)" << endl;
+    cout << "  --fifo                   SCHED_FIFO / TIME_CRITICAL haptic thread" << endl;
+    cout << "  --fifo-priority N        SCHED_FIFO priority 1-99 (80), implies --fifo" << endl;
+    cout << "  --cpu N                  Pin the haptic thread to core N (device i: N + i)" << endl;
+    cout << "  --full-transforms        Recompute every global transform each tick" << endl;
+    cout << "  --no-broadphase          Let the tool test every object each tick" << endl;
+    cout << "  --broadphase-cell M      Broad-phase grid cell size (0 = automatic)" << endl;
+    cout << "  --multirate HZ           Run the CHAI3D pipeline in a simulation thread at HZ" << endl;
+    cout << "                           (100-200); the haptic thread renders its local" << endl;
+    cout << "                           contact planes at --rate (0 = off)" << endl;
+    cout << "  --primitive-batch        Render haptic spheres and boxes with the batched" << endl;
+    cout << "                           (AVX2 when available) penalty kernel, not CHAI3D;" << endl;
+    cout << "                           dynamic friction only, static friction and" << endl;
+    cout << "                           viscosity are ignored" << endl;
+    cout << "  --no-simd                Use the scalar kernel for --primitive-batch" << endl;
+    cout << endl;
+    cout << "Statistics:" << endl;
+    cout << "  --stats-interval S       Print loop statistics every S seconds (0 = off)" << endl;
+    cout << "  --deadline-us US         Tick period counted as missed (1.5x --rate period, or 1000)" << endl;
+    cout << "  --stats-out FILE         Export statistics at exit (.json or .csv)" << endl;
+    cout << endl;
+    cout << "Scene:" << endl;
+    cout << "  --scene FILE             Load objects, meshes and camera from a scene file" << endl;
+    cout << "                           (default: one sphere; see src/SceneDescription.h)" << endl;
+    cout << "  --no-mesh-cache          Parse meshes instead of using their .aimmesh cache" << endl;
+    cout << "  --no-scene-pool          Allocate scene objects on the heap, not in node pools" << endl;
+    cout << endl;
+    cout << "Session recording and replay:" << endl;
+    cout << "  --record FILE            Record every haptic tick to FILE (.aimrec);" << endl;
+    cout << "                           convert with aimlab-recording csv|columns" << endl;
+    cout << "  --replay FILE            Run a recording through the pipeline faster than real" << endl;
+    cout << "                           time; exit 1 if forces differ from the recorded ones" << endl;
+    cout << "                           (uses the recorded --scene unless one is given)" << endl;
+    cout << "  --replay-tolerance N     Allowed force difference in N (0 = bit-identical)" << endl;
+    cout << "  --replay-diff FILE       Write recorded vs replayed force per tick (CSV)" << endl;
+    cout << endl;
+    cout << "Scene material (first object; default: scene value, or recorded with --replay):" << endl;
+    cout << "  --stiffness N            Stiffness in N/m (1000)" << endl;
+    cout << "  --static-friction MU     Static friction (0.3)" << endl;
+    cout << "  --dynamic-friction MU    Dynamic friction (0.2)" << endl;
+    cout << "  --viscosity B            Viscosity (0.1)" << endl;
+    cout << endl;
+    cout << "Unity bridge:" << endl;
+    cout << "  --bridge NAME            Shared-memory segment name" << endl;
+    cout << "  --no-bridge              Do not create the shared-memory segment" << endl;
+    cout << endl;
+    cout << "Network stream (UDP, format in src/HapticStream.h):" << endl;
+    cout << "  --stream HOST[:PORT]     Send tool pose, proxy and force to HOST (port 27300)" << endl;
+    cout << "  --stream-rate HZ         Samples per second per device (250)" << endl;
+    cout << "  --stream-batch N         Samples per datagram, 1-16 (4)" << endl;
+}
@@ -0,0 +1,122 @@
+/****************************************************************************
+ * AIMLAB - Command-Line Options
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.15
+ *
+ * Description:
+ *   Command-line configuration for aimlab-haptics. Every option has a
+ *   default matching the original hard-coded behaviour, so running the
+ *   application without arguments is unchanged.
+ *
+ * Changelog:
+ *   v1.15 - 16 October 2026 - --device-filter and its settings
+ *   v1.14 - 16 October 2026 - --no-scene-pool
+ *   v1.13 - 16 October 2026 - --restart-cycles (pipeline stop/start stress run)
+ *   v1.12 - 16 October 2026 - --stream, --stream-rate and --stream-batch
+ *   v1.11 - 16 October 2026 - --primitive-batch and --no-simd
+ *   v1.10 - 16 October 2026 - --multirate (simulation thread + local contact model)
+ *   v1.9 - 16 October 2026 - --no-broadphase and --broadphase-cell
+ *   v1.8 - 16 October 2026 - --devices (one haptic thread per device)
+ *   v1.7 - 16 October 2026 - --scene and --no-mesh-cache
+ *   v1.6 - 16 October 2026 - Session replay and scene material options
+ *   v1.5 - 16 October 2026 - --record session recording
+ *   v1.4 - 16 October 2026 - Headless rendering, frame cap and frame benchmark
+ *   v1.3 - 16 October 2026 - --full-transforms
+ *   v1.2 - 16 October 2026 - Fixed-rate haptic scheduler options
+ *   v1.1 - 16 October 2026 - Haptic loop statistics options
+ *   v1.0 - 16 October 2026 - Device selection, simulated device, graphics-free runs
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_APP_OPTIONS_H
+#define AIMLAB_APP_OPTIONS_H
+
+#include "DeviceFilter.h"
+#include "HapticScheduler.h"
+#include "HapticStream.h"
+#include "SimulatedHapticDevice.h"
+
+#include <string>
+
+#define AIMLAB_MAX_HAPTIC_DEVICES   4       // haptic threads (one per device)
+
+struct AppOptions {
+    // Device
+    bool useSimulatedDevice = false;        // --device sim
+    SimulatedDeviceConfig simulated;
+    int deviceCount = 0;                    // --devices N: 0 = every detected device
+                                            // (one simulated device with --device sim)
+    DeviceFilterConfig deviceFilter;        // --device-filter: extrapolation, velocity, force smoothing
+
+    // Graphics
+    bool graphicsEnabled = true;            // --no-graphics disables GLUT entirely
+    double durationSeconds = 0.0;           // --duration, 0 = run until quit
+    int restartCycles = 0;                  // --restart-cycles N: stop/start the pipeline N times, quit
+    bool headless = false;                  // --headless: EGL offscreen instead of GLUT
+    int framebufferWidth = 1024;            // --size WxH (headless framebuffer)
+    int framebufferHeight = 768;
+    double maxFps = 0.0;                    // --max-fps, 0 = uncapped
+    int benchFrames = 0;                    // --bench-frames N (implies --headless)
+    std::string benchOutputFile;            // --bench-out: frame-time JSON
+
+    // Haptic scheduler
+    HapticSchedulerConfig scheduler;        // rateHz 0 = free-running busy loop
+    bool incrementalTransforms = true;      // --full-transforms restores the full traversal
+    bool broadPhase = true;                 // --no-broadphase keeps every object in the haptic world
+    double broadPhaseCellSize = 0.0;        // --broadphase-cell M, 0 = automatic
+    double multirateHz = 0.0;               // --multirate HZ: simulation thread rate, 0 = off
+    bool primitiveBatch = false;            // --primitive-batch: spheres and boxes in a PrimitiveBatch
+    bool primitiveSimd = true;              // --no-simd forces the scalar primitive kernel
+
+    // Haptic loop statistics
+    double statsIntervalSeconds = 1.0;      // periodic console summary, 0 = off
+    double deadlineMicroseconds = 0.0;      // missed-deadline period, 0 = auto
+    std::string statsOutputFile;            // .json or .csv export at exit, empty = none
+
+    // Scene
+    std::string sceneFile;                  // --scene: .scene description, empty = built-in sphere
+    bool meshCache = true;                  // --no-mesh-cache parses meshes on every launch
+    bool scenePool = true;                  // --no-scene-pool allocates scene nodes on the heap
+
+    // Session recording and replay
+    std::string recordFile;                 // --record: .aimrec of every haptic tick, empty = off
+    std::string replayFile;                 // --replay: run a recording through the pipeline
+    double replayTolerance = 0.0;           // --replay-tolerance N, 0 = bit-identical forces
+    std::string replayDiffFile;             // --replay-diff: per-tick force comparison CSV
+
+    // Haptic material of the first scene object (< 0 = scene value, or the
+    // recorded value with --replay)
+    double stiffness = -1.0;                // --stiffness N/m
+    double staticFriction = -1.0;           // --static-friction
+    double dynamicFriction = -1.0;          // --dynamic-friction
+    double viscosity = -1.0;                // --viscosity
+
+    // Unity bridge
+    bool bridgeEnabled = true;
+    std::string bridgeName;                 // empty = AIMLAB_BRIDGE_DEFAULT_NAME
+
+    // Network stream of the tool state (UDP)
+    bool streamEnabled = false;             // --stream HOST[:PORT]
+    HapticStreamConfig stream;              // --stream-rate, --stream-batch
+};
+
+/**
+ * @brief Parse command-line arguments
+ *
+ * Unknown arguments are left for glutInit() (e.g. -display, -geometry).
+ *
+ * @param argc    Argument count
+ * @param argv    Argument vector
+ * @param options Receives the parsed options
+ * @return false if an option was malformed (usage has been printed)
+ */
+bool parseAppOptions(int argc, char* argv[], AppOptions& options);
+
+/**
+ * @brief Print command-line usage to stdout
+ */
+void printAppUsage(const char* program);
+
+#endif // AIMLAB_APP_OPTIONS_H
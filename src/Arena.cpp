@@ -0,0 +1,173 @@
+/****************************************************************************
+ * AIMLAB - Arena Allocation
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of Arena and SceneNodePool. See Arena.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "Arena.h"
+
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+//===========================================================================
+// ARENA
+//===========================================================================
+
+Arena::Arena(size_t a_blockBytes)
+    : m_blockBytes(max(a_blockBytes, (size_t)256)),
+      m_first(nullptr),
+      m_current(nullptr),
+      m_cursor(nullptr),
+      m_end(nullptr),
+      m_used(0),
+      m_capacity(0),
+      m_blockAllocations(0) {
+}
+
+Arena::~Arena() {
+    release();
+}
+
+Arena::Block* Arena::newBlock(size_t a_size) {
+    Block* block = static_cast<Block*>(::operator new(sizeof(Block) + a_size));
+    block->next = nullptr;
+    block->size = a_size;
+    m_capacity += a_size;
+    m_blockAllocations++;
+    return block;
+}
+
+void Arena::enter(Block* a_block) {
+    m_current = a_block;
+    m_cursor = begin(a_block);
+    m_end = m_cursor + a_block->size;
+}
+
+void* Arena::allocate(size_t a_bytes, size_t a_align) {
+    char* p = alignUp(m_cursor, a_align);
+    if (m_current == nullptr || p + a_bytes > m_end) {
+        // Next kept block if it fits, else a new one linked in after the
+        // current block (the blocks after it stay for later)
+        const size_t needed = a_bytes + a_align;
+        Block* next = (m_current != nullptr) ? m_current->next : m_first;
+        if (next == nullptr || next->size < needed) {
+            Block* block = newBlock(max(m_blockBytes, needed));
+            block->next = next;
+            if (m_current != nullptr) {
+                m_current->next = block;
+            } else {
+                m_first = block;
+            }
+            next = block;
+        }
+        m_used += (size_t)(m_end - m_cursor);   // tail of the block left behind
+        enter(next);
+        p = alignUp(m_cursor, a_align);
+    }
+
+    m_used += (size_t)(p + a_bytes - m_cursor);
+    m_cursor = p + a_bytes;
+    return p;
+}
+
+void Arena::reserve(size_t a_bytes) {
+    if (m_first != nullptr && m_first->size >= a_bytes) {
+        return;
+    }
+    Block* block = newBlock(max(m_blockBytes, a_bytes));
+    block->next = m_first;
+    m_first = block;
+    reset();
+}
+
+void Arena::reset() {
+    m_used = 0;
+    if (m_first != nullptr) {
+        enter(m_first);
+    } else {
+        m_current = nullptr;
+        m_cursor = m_end = nullptr;
+    }
+}
+
+void Arena::release() {
+    Block* block = m_first;
+    while (block != nullptr) {
+        Block* next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+    m_first = m_current = nullptr;
+    m_cursor = m_end = nullptr;
+    m_used = 0;
+    m_capacity = 0;
+}
+
+void Arena::abandon() {
+    m_first = m_current = nullptr;
+    m_cursor = m_end = nullptr;
+    m_used = 0;
+    m_capacity = 0;
+}
+
+//===========================================================================
+// SCENE NODE POOL
+//===========================================================================
+
+// Written in front of every node: the pool it came from, nullptr = heap
+struct SceneNodeHeader {
+    SceneNodePool* pool;
+};
+
+static_assert(sizeof(SceneNodeHeader) <= AIMLAB_SCENE_NODE_ALIGN, "node header too large");
+
+SceneNodePool::SceneNodePool(size_t a_blockBytes)
+    : m_arena(a_blockBytes),
+      m_live(0),
+      m_enabled(true) {
+}
+
+SceneNodePool::~SceneNodePool() {
+    // Nodes still alive (worlds are not deleted at exit) keep their blocks
+    if (m_live > 0) {
+        m_arena.abandon();
+    }
+}
+
+void* SceneNodePool::allocate(size_t a_bytes) {
+    const size_t bytes = AIMLAB_SCENE_NODE_ALIGN + a_bytes;
+    char* p = m_enabled ? static_cast<char*>(m_arena.allocate(bytes, AIMLAB_SCENE_NODE_ALIGN))
+                        : static_cast<char*>(::operator new(bytes));
+    reinterpret_cast<SceneNodeHeader*>(p)->pool = m_enabled ? this : nullptr;
+    if (m_enabled) {
+        m_live++;
+    }
+    return p + AIMLAB_SCENE_NODE_ALIGN;
+}
+
+void SceneNodePool::release(void* a_node) {
+    if (a_node == nullptr) {
+        return;
+    }
+    char* p = static_cast<char*>(a_node) - AIMLAB_SCENE_NODE_ALIGN;
+    SceneNodePool* pool = reinterpret_cast<SceneNodeHeader*>(p)->pool;
+    if (pool == nullptr) {
+        ::operator delete(p);
+        return;
+    }
+    // The last node out rewinds the pool for the next scene
+    if (--pool->m_live == 0) {
+        pool->m_arena.reset();
+    }
+}
@@ -0,0 +1,187 @@
+/****************************************************************************
+ * AIMLAB - Arena Allocation
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Two allocators that keep the haptic thread off malloc and its data
+ *   close together.
+ *
+ *   Arena is a bump allocator over a chain of blocks. allocate() moves a
+ *   cursor; reset() rewinds to the first block and keeps every block, so
+ *   once the largest working set has been seen (or reserve()d up front)
+ *   nothing is allocated again. Each device loop has one as per-tick
+ *   scratch: computeHapticTick() takes the broad phase's candidate list
+ *   from it and resets it when the tick ends. Memory is not constructed or
+ *   destroyed, so only trivially destructible types belong in it.
+ *
+ *   SceneNodePool places CHAI3D scene nodes in an Arena, so a world's
+ *   nodes sit next to each other in creation order instead of between the
+ *   names, materials and vertex arrays allocated along with them. The
+ *   render world and each haptic world get their own pool, so a haptic
+ *   thread's traversal stays within its own blocks. Nodes are created as
+ *   PooledNode<T>, a T with its own operator new and delete:
+ *
+ *     cShapeSphere* sphere = new (pool) PooledNode<cShapeSphere>(radius);
+ *
+ *   CHAI3D deletes children with plain delete through the virtual
+ *   destructor, which ends in PooledNode's operator delete, so worlds own
+ *   their pooled children as usual. Each node records its pool in a
+ *   16-byte header. Freed nodes are not reused one by one; when the last
+ *   node of a pool is deleted the pool rewinds. With the pool disabled
+ *   (--no-scene-pool) nodes come from the heap, through the same header.
+ *
+ *   Neither type is thread-safe. Scratch arenas belong to the thread that
+ *   runs the tick; scene pools to the main thread, while the pipeline is
+ *   stopped. No CHAI3D dependency.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_ARENA_H
+#define AIMLAB_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#define AIMLAB_ARENA_BLOCK_BYTES        (64 * 1024)
+#define AIMLAB_SCENE_POOL_BLOCK_BYTES   (1024 * 1024)
+#define AIMLAB_SCENE_NODE_ALIGN         16      // header size; covers every CHAI3D node
+
+class Arena {
+public:
+    /**
+     * @param a_blockBytes Size of each block (larger requests get a block
+     *                     of their own size)
+     */
+    explicit Arena(size_t a_blockBytes = AIMLAB_ARENA_BLOCK_BYTES);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief a_bytes of uninitialized memory, valid until reset()
+     *
+     * @param a_align Power of two
+     */
+    void* allocate(size_t a_bytes, size_t a_align);
+
+    /** @brief Room for a_count T (trivially destructible, not constructed) */
+    template <class T>
+    T* allocateArray(size_t a_count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+        return static_cast<T*>(allocate(a_count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Make sure a_bytes fit after reset() without a new block
+     *
+     * Call before the hot path starts; it allocates at most one block.
+     */
+    void reserve(size_t a_bytes);
+
+    /** @brief Forget every allocation; blocks are kept for reuse */
+    void reset();
+
+    /** @brief Free every block */
+    void release();
+
+    /** @brief Forget every block without freeing it (still in use elsewhere) */
+    void abandon();
+
+    size_t bytesUsed() const { return m_used; }
+    size_t capacity() const { return m_capacity; }
+
+    /** @brief Blocks obtained from the heap so far (constant in steady state) */
+    uint64_t blockAllocations() const { return m_blockAllocations; }
+
+private:
+    struct Block {
+        Block* next;
+        size_t size;                    // bytes after the header
+    };
+
+    static char* begin(Block* a_block) { return reinterpret_cast<char*>(a_block + 1); }
+    static char* alignUp(char* a_pointer, size_t a_align) {
+        const uintptr_t p = reinterpret_cast<uintptr_t>(a_pointer);
+        return a_pointer + ((a_align - (p & (a_align - 1))) & (a_align - 1));
+    }
+
+    void enter(Block* a_block);
+    Block* newBlock(size_t a_size);
+
+    size_t m_blockBytes;
+    Block* m_first;
+    Block* m_current;
+    char* m_cursor;
+    char* m_end;
+    size_t m_used;                      // bytes handed out since reset(), with padding
+    size_t m_capacity;
+    uint64_t m_blockAllocations;
+};
+
+//===========================================================================
+// SCENE NODES
+//===========================================================================
+
+class SceneNodePool {
+public:
+    explicit SceneNodePool(size_t a_blockBytes = AIMLAB_SCENE_POOL_BLOCK_BYTES);
+    ~SceneNodePool();
+
+    SceneNodePool(const SceneNodePool&) = delete;
+    SceneNodePool& operator=(const SceneNodePool&) = delete;
+
+    /** @brief false: later nodes come from the heap (--no-scene-pool) */
+    void setEnabled(bool a_enabled) { m_enabled = a_enabled; }
+    bool enabled() const { return m_enabled; }
+
+    /** @brief Memory for one node; used by PooledNode's operator new */
+    void* allocate(size_t a_bytes);
+
+    /** @brief Give back a node from allocate() of any pool */
+    static void release(void* a_node);
+
+    /** @brief Pooled nodes not yet deleted (heap nodes are not counted) */
+    size_t liveNodes() const { return m_live; }
+    const Arena& arena() const { return m_arena; }
+
+private:
+    Arena m_arena;
+    size_t m_live;
+    bool m_enabled;
+};
+
+/**
+ * @brief A T that lives in a SceneNodePool
+ *
+ * Takes T's constructors. Only placement new with a pool compiles, so a
+ * pooled type cannot end up on the heap by accident.
+ */
+template <class T>
+class PooledNode : public T {
+public:
+    using T::T;
+
+    static void* operator new(size_t a_bytes, SceneNodePool& a_pool) {
+        static_assert(alignof(T) <= AIMLAB_SCENE_NODE_ALIGN, "node needs a larger header");
+        return a_pool.allocate(a_bytes);
+    }
+
+    static void operator delete(void* a_node) {
+        SceneNodePool::release(a_node);
+    }
+
+    // Called if a constructor throws
+    static void operator delete(void* a_node, SceneNodePool&) {
+        SceneNodePool::release(a_node);
+    }
+};
+
+#endif // AIMLAB_ARENA_H
@@ -0,0 +1,375 @@
+/****************************************************************************
+ * AIMLAB - Asynchronous Log
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Per-thread rings, the log thread and deferred formatting. See
+ *   AsyncLog.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "AsyncLog.h"
+#include "SpscRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//===========================================================================
+// PER-THREAD RINGS
+//===========================================================================
+
+enum SlotState {
+    SLOT_FREE,
+    SLOT_OWNED,                     // a live thread produces into it
+    SLOT_RETIRED                    // its thread exited; free once drained
+};
+
+struct AsyncLogSlot {
+    AsyncLogSlot() : ring(AIMLAB_LOG_QUEUE_RECORDS), state(SLOT_FREE) {}
+
+    SpscRing<AsyncLogRecord> ring;
+    std::atomic<int> state;
+};
+
+// Static storage: the rings are over-aligned (see TripleBuffer.h)
+static AsyncLogSlot slots[AIMLAB_LOG_MAX_THREADS];
+
+/**
+ * @brief The calling thread's slot; retires it when the thread exits
+ */
+struct AsyncLogThreadSlot {
+    int index = -1;
+    bool exhausted = false;         // no slot was free; do not search again
+
+    ~AsyncLogThreadSlot() {
+        if (index >= 0) {
+            slots[index].state.store(SLOT_RETIRED, std::memory_order_release);
+        }
+    }
+};
+
+static thread_local AsyncLogThreadSlot threadSlot;
+
+static AsyncLogSlot* acquireThreadSlot() {
+    if (threadSlot.index >= 0) {
+        return &slots[threadSlot.index];
+    }
+    if (threadSlot.exhausted) {
+        return nullptr;
+    }
+    for (int i = 0; i < AIMLAB_LOG_MAX_THREADS; i++) {
+        int expected = SLOT_FREE;
+        if (slots[i].state.compare_exchange_strong(expected, SLOT_OWNED,
+                                                   std::memory_order_acquire)) {
+            threadSlot.index = i;
+            return &slots[i];
+        }
+    }
+    threadSlot.exhausted = true;
+    return nullptr;
+}
+
+//===========================================================================
+// FORMATTING
+//===========================================================================
+
+/**
+ * @brief Append one record, as printf would print it plus a newline
+ *
+ * Conversions are re-issued one at a time with the length modifier of the
+ * stored type, so "%d" with a size_t and "%zu" with an int both print.
+ */
+static void formatRecord(const AsyncLogRecord& a_record, string& a_out) {
+    const char* p = a_record.format;
+    int arg = 0;
+    char spec[32];
+    char value[512];
+
+    while (*p != '\0') {
+        const char* percent = strchr(p, '%');
+        if (percent == nullptr) {
+            a_out.append(p);
+            break;
+        }
+        a_out.append(p, percent - p);
+        p = percent + 1;
+        if (*p == '%') {
+            a_out.push_back('%');
+            p++;
+            continue;
+        }
+
+        // Flags, width and precision are kept; length modifiers are replaced
+        size_t length = 0;
+        spec[length++] = '%';
+        while (*p != '\0' && strchr("-+ #0123456789.", *p) != nullptr && length < sizeof(spec) - 4) {
+            spec[length++] = *p++;
+        }
+        while (*p != '\0' && strchr("hljztL", *p) != nullptr) {
+            p++;
+        }
+        const char conversion = *p;
+        if (conversion == '\0') {
+            break;
+        }
+        p++;
+
+        if (arg >= a_record.argCount) {
+            a_out.append("<?>");
+            continue;
+        }
+        const uint8_t type = a_record.types[arg];
+        const auto& data = a_record.args[arg++];
+        long long asInt = 0;
+        unsigned long long asUint = 0;
+        double asDouble = 0.0;
+        switch (type) {
+        case ASYNC_LOG_INT:
+            asInt = data.i;
+            asUint = (unsigned long long)data.i;
+            asDouble = (double)data.i;
+            break;
+        case ASYNC_LOG_UINT:
+        case ASYNC_LOG_POINTER:
+            asInt = (long long)data.u;
+            asUint = data.u;
+            asDouble = (double)data.u;
+            break;
+        case ASYNC_LOG_DOUBLE:
+            asInt = (long long)data.d;
+            asUint = (unsigned long long)data.d;
+            asDouble = data.d;
+            break;
+        default:
+            break;
+        }
+
+        int n = 0;
+        switch (conversion) {
+        case 'd': case 'i':
+            spec[length++] = 'l'; spec[length++] = 'l'; spec[length++] = conversion; spec[length] = '\0';
+            n = snprintf(value, sizeof(value), spec, asInt);
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            spec[length++] = 'l'; spec[length++] = 'l'; spec[length++] = conversion; spec[length] = '\0';
+            n = snprintf(value, sizeof(value), spec, asUint);
+            break;
+        case 'c':
+            spec[length++] = 'c'; spec[length] = '\0';
+            n = snprintf(value, sizeof(value), spec, (int)asInt);
+            break;
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+            spec[length++] = conversion; spec[length] = '\0';
+            n = snprintf(value, sizeof(value), spec, asDouble);
+            break;
+        case 's':
+            spec[length++] = 's'; spec[length] = '\0';
+            n = snprintf(value, sizeof(value), spec,
+                         type == ASYNC_LOG_TEXT ? a_record.text + data.text : "<?>");
+            break;
+        case 'p':
+            spec[length++] = 'p'; spec[length] = '\0';
+            n = snprintf(value, sizeof(value), spec, (void*)(uintptr_t)asUint);
+            break;
+        default:
+            break;          // %n and unknown conversions print nothing
+        }
+        if (n > 0) {
+            a_out.append(value, std::min((size_t)n, sizeof(value) - 1));
+        }
+    }
+    a_out.push_back('\n');
+}
+
+//===========================================================================
+// LOG THREAD
+//===========================================================================
+
+class AsyncLogger {
+public:
+    AsyncLogger() : m_sink(stdout), m_running(false), m_dropped(0), m_stop(false) {}
+
+    ~AsyncLogger() {
+        stop();
+    }
+
+    void start(FILE* a_sink) {
+        lock_guard<mutex> lock(m_lifecycle);
+        if (m_running.load(std::memory_order_relaxed)) {
+            return;
+        }
+        {
+            lock_guard<mutex> drain(m_drain);
+            m_sink = a_sink;
+        }
+        m_dropped.store(0, std::memory_order_relaxed);
+        m_stop = false;
+        m_running.store(true, std::memory_order_release);
+        m_thread = std::thread(&AsyncLogger::run, this);
+    }
+
+    void stop() {
+        lock_guard<mutex> lock(m_lifecycle);
+        if (!m_running.load(std::memory_order_relaxed)) {
+            return;
+        }
+        {
+            lock_guard<mutex> wake(m_wakeMutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+
+        // Callers from here on write synchronously; drain what they queued before
+        m_running.store(false, std::memory_order_seq_cst);
+        drain();
+        const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped > 0) {
+            lock_guard<mutex> drainLock(m_drain);
+            fprintf(m_sink, "[log] WARNING: %llu messages dropped (queue full)\n",
+                    (unsigned long long)dropped);
+            fflush(m_sink);
+        }
+    }
+
+    void flush() {
+        drain();
+    }
+
+    void push(const AsyncLogRecord& a_record) {
+        if (!m_running.load(std::memory_order_acquire)) {
+            writeNow(a_record);
+            return;
+        }
+        AsyncLogSlot* slot = acquireThreadSlot();
+        if (slot == nullptr || !slot->ring.tryPush(a_record)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t dropped() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run() {
+        unique_lock<mutex> lock(m_wakeMutex);
+        while (!m_stop) {
+            m_wake.wait_for(lock, std::chrono::milliseconds(AIMLAB_LOG_DRAIN_MS));
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+    /**
+     * @brief Pop every ring, order by timestamp, write once
+     *
+     * The drain mutex makes whoever holds it the single consumer of every
+     * ring (the log thread, or a caller of flush()).
+     */
+    void drain() {
+        lock_guard<mutex> lock(m_drain);
+        m_pending.clear();
+        for (int i = 0; i < AIMLAB_LOG_MAX_THREADS; i++) {
+            AsyncLogSlot& slot = slots[i];
+            const int state = slot.state.load(std::memory_order_acquire);
+            if (state == SLOT_FREE) {
+                continue;
+            }
+            m_pending.emplace_back();
+            while (slot.ring.tryPop(m_pending.back())) {
+                m_pending.emplace_back();
+            }
+            m_pending.pop_back();
+
+            // A retired thread pushes nothing more; reuse its ring
+            if (state == SLOT_RETIRED && slot.ring.size() == 0) {
+                slot.state.store(SLOT_FREE, std::memory_order_release);
+            }
+        }
+        if (m_pending.empty()) {
+            return;
+        }
+
+        // Per-thread order is already by time; stable keeps it for equal stamps
+        m_order.resize(m_pending.size());
+        for (size_t i = 0; i < m_order.size(); i++) {
+            m_order[i] = (uint32_t)i;
+        }
+        std::stable_sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) {
+            return m_pending[a].timestampNs < m_pending[b].timestampNs;
+        });
+
+        m_text.clear();
+        for (uint32_t index : m_order) {
+            formatRecord(m_pending[index], m_text);
+        }
+        fwrite(m_text.data(), 1, m_text.size(), m_sink);
+        fflush(m_sink);
+    }
+
+    void writeNow(const AsyncLogRecord& a_record) {
+        lock_guard<mutex> lock(m_drain);
+        m_text.clear();
+        formatRecord(a_record, m_text);
+        fwrite(m_text.data(), 1, m_text.size(), m_sink);
+        fflush(m_sink);
+    }
+
+    FILE* m_sink;
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_dropped;
+
+    std::thread m_thread;
+    mutex m_lifecycle;                      // start() / stop()
+    mutex m_wakeMutex;
+    condition_variable m_wake;
+    bool m_stop;                            // guarded by m_wakeMutex
+
+    mutex m_drain;                          // ring consumer side, sink and buffers below
+    vector<AsyncLogRecord> m_pending;
+    vector<uint32_t> m_order;
+    string m_text;
+};
+
+// After slots[] so it is destroyed (and drains) first
+static AsyncLogger logger;
+
+//===========================================================================
+// PUBLIC INTERFACE
+//===========================================================================
+
+void asyncLogStart(FILE* a_sink) {
+    logger.start(a_sink);
+}
+
+void asyncLogStop() {
+    logger.stop();
+}
+
+void asyncLogFlush() {
+    logger.flush();
+}
+
+uint64_t asyncLogDropped() {
+    return logger.dropped();
+}
+
+void asyncLogPush(const AsyncLogRecord& a_record) {
+    logger.push(a_record);
+}
@@ -0,0 +1,242 @@
+/****************************************************************************
+ * AIMLAB - Asynchronous Log
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Console messages without console I/O on the calling thread. A
+ *   printf-style call does not format anything. It copies the format
+ *   pointer, the arguments and a timestamp into a fixed-size record,
+ *   pushes the record into that thread's SpscRing and returns. There is
+ *   no lock, no allocation and no system call. A background thread drains
+ *   the rings every AIMLAB_LOG_DRAIN_MS, merges them by timestamp, formats
+ *   each record with snprintf and writes the batch with a single fwrite
+ *   and flush. If a ring is full the message is dropped and counted; the
+ *   caller never waits.
+ *
+ *     AIMLAB_LOG_INFO("[init] Device found: %s", info.m_modelName.c_str());
+ *
+ *   The format must be a string literal; the record keeps only its
+ *   address. The log adds the newline. Arguments are printf types:
+ *   integers, floating point, pointers and C strings. Strings are copied
+ *   into the record, up to AIMLAB_LOG_TEXT_BYTES per message, and
+ *   truncated beyond that. GCC and Clang check the format against the
+ *   arguments at compile time.
+ *
+ *   Levels are filtered at compile time. A message below AIMLAB_LOG_LEVEL
+ *   (CMake cache variable AIMLAB_LOG_LEVEL, default INFO) compiles to
+ *   nothing, and its arguments are not evaluated.
+ *
+ *   Each thread takes one of AIMLAB_LOG_MAX_THREADS rings on its first
+ *   message. It gives the ring back when it exits, once the background
+ *   thread has drained it. If no ring is free, the message is dropped.
+ *   Before asyncLogStart() and after asyncLogStop(), messages are
+ *   formatted and written on the caller's thread under a mutex. That
+ *   covers option parsing and the exit report.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_ASYNC_LOG_H
+#define AIMLAB_ASYNC_LOG_H
+
+#include "HapticClock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#define AIMLAB_LOG_LEVEL_DEBUG      0
+#define AIMLAB_LOG_LEVEL_INFO       1
+#define AIMLAB_LOG_LEVEL_WARN       2
+#define AIMLAB_LOG_LEVEL_ERROR      3
+
+#ifndef AIMLAB_LOG_LEVEL
+#define AIMLAB_LOG_LEVEL            AIMLAB_LOG_LEVEL_INFO
+#endif
+
+#define AIMLAB_LOG_MAX_ARGS         8
+#define AIMLAB_LOG_TEXT_BYTES       416     // string arguments of one message, terminators included
+#define AIMLAB_LOG_MAX_THREADS      16
+#define AIMLAB_LOG_QUEUE_RECORDS    256     // per thread
+#define AIMLAB_LOG_DRAIN_MS         5
+
+enum AsyncLogArgType {
+    ASYNC_LOG_INT,
+    ASYNC_LOG_UINT,
+    ASYNC_LOG_DOUBLE,
+    ASYNC_LOG_TEXT,
+    ASYNC_LOG_POINTER
+};
+
+/**
+ * @brief One queued message (512 bytes), formatted on the log thread
+ */
+struct AsyncLogRecord {
+    uint64_t timestampNs;               // hapticNowNs() at the call; merge order
+    const char* format;                 // string literal
+    uint8_t level;
+    uint8_t argCount;
+    uint16_t textUsed;                  // bytes of text[] in use
+    uint8_t types[AIMLAB_LOG_MAX_ARGS]; // AsyncLogArgType
+    union {
+        int64_t i;
+        uint64_t u;                     // also ASYNC_LOG_POINTER
+        double d;
+        uint32_t text;                  // ASYNC_LOG_TEXT: offset into text[]
+    } args[AIMLAB_LOG_MAX_ARGS];
+    char text[AIMLAB_LOG_TEXT_BYTES];
+};
+
+/**
+ * @brief Start the log thread
+ *
+ * @param a_sink Where messages go (stdout by default); must outlive the log
+ */
+void asyncLogStart(FILE* a_sink = stdout);
+
+/**
+ * @brief Write everything queued, then stop the log thread
+ *
+ * Later messages are written synchronously. Also runs at program exit.
+ */
+void asyncLogStop();
+
+/**
+ * @brief Write everything queued so far before returning
+ */
+void asyncLogFlush();
+
+/**
+ * @brief Messages lost to a full ring or no free ring since start
+ */
+uint64_t asyncLogDropped();
+
+/**
+ * @brief Queue a filled record (the AIMLAB_LOG_* macros call this)
+ */
+void asyncLogPush(const AsyncLogRecord& a_record);
+
+//===========================================================================
+// RECORD ENCODING
+//===========================================================================
+
+inline void asyncLogPut(AsyncLogRecord& a_record, long long a_value) {
+    a_record.types[a_record.argCount] = ASYNC_LOG_INT;
+    a_record.args[a_record.argCount++].i = a_value;
+}
+
+inline void asyncLogPut(AsyncLogRecord& a_record, unsigned long long a_value) {
+    a_record.types[a_record.argCount] = ASYNC_LOG_UINT;
+    a_record.args[a_record.argCount++].u = a_value;
+}
+
+inline void asyncLogPut(AsyncLogRecord& a_record, int a_value) { asyncLogPut(a_record, (long long)a_value); }
+inline void asyncLogPut(AsyncLogRecord& a_record, long a_value) { asyncLogPut(a_record, (long long)a_value); }
+inline void asyncLogPut(AsyncLogRecord& a_record, unsigned int a_value) {
+    asyncLogPut(a_record, (unsigned long long)a_value);
+}
+inline void asyncLogPut(AsyncLogRecord& a_record, unsigned long a_value) {
+    asyncLogPut(a_record, (unsigned long long)a_value);
+}
+
+inline void asyncLogPut(AsyncLogRecord& a_record, double a_value) {
+    a_record.types[a_record.argCount] = ASYNC_LOG_DOUBLE;
+    a_record.args[a_record.argCount++].d = a_value;
+}
+
+inline void asyncLogPut(AsyncLogRecord& a_record, const void* a_value) {
+    a_record.types[a_record.argCount] = ASYNC_LOG_POINTER;
+    a_record.args[a_record.argCount++].u = (uint64_t)(uintptr_t)a_value;
+}
+
+/** @brief Copy a C string into the record, truncated to the space left */
+inline void asyncLogPut(AsyncLogRecord& a_record, const char* a_value) {
+    if (a_value == nullptr) {
+        a_value = "(null)";
+    }
+    size_t offset = a_record.textUsed;
+    if (offset >= AIMLAB_LOG_TEXT_BYTES) {
+        offset = AIMLAB_LOG_TEXT_BYTES - 1;     // share the last terminator
+    } else {
+        size_t length = strlen(a_value);
+        if (length > AIMLAB_LOG_TEXT_BYTES - 1 - offset) {
+            length = AIMLAB_LOG_TEXT_BYTES - 1 - offset;
+        }
+        memcpy(a_record.text + offset, a_value, length);
+        a_record.text[offset + length] = '\0';
+        a_record.textUsed = (uint16_t)(offset + length + 1);
+    }
+    a_record.types[a_record.argCount] = ASYNC_LOG_TEXT;
+    a_record.args[a_record.argCount++].text = (uint32_t)offset;
+}
+
+inline void asyncLogPut(AsyncLogRecord& a_record, char* a_value) {
+    asyncLogPut(a_record, (const char*)a_value);
+}
+
+/**
+ * @brief Never called; gives the macros printf format checking
+ */
+#if defined(__GNUC__)
+__attribute__((format(printf, 1, 2)))
+#endif
+inline void asyncLogCheckFormat(const char*, ...) {}
+
+template <typename... Args>
+inline void asyncLogWrite(int a_level, const char* a_format, const Args&... a_args) {
+    static_assert(sizeof...(Args) <= AIMLAB_LOG_MAX_ARGS, "too many log arguments");
+    AsyncLogRecord record;
+    record.timestampNs = hapticNowNs();
+    record.format = a_format;
+    record.level = (uint8_t)a_level;
+    record.argCount = 0;
+    record.textUsed = 0;
+    record.text[AIMLAB_LOG_TEXT_BYTES - 1] = '\0';
+    const int expand[] = { 0, (asyncLogPut(record, a_args), 0)... };
+    (void)expand;
+    asyncLogPush(record);
+}
+
+//===========================================================================
+// LOGGING MACROS
+//===========================================================================
+
+#define AIMLAB_LOG_AT(a_level, a_format, ...)                                   \
+    do {                                                                        \
+        if (false) {                                                            \
+            asyncLogCheckFormat(a_format, ##__VA_ARGS__);                       \
+        }                                                                       \
+        asyncLogWrite(a_level, "" a_format, ##__VA_ARGS__);                     \
+    } while (0)
+
+#if AIMLAB_LOG_LEVEL <= AIMLAB_LOG_LEVEL_DEBUG
+#define AIMLAB_LOG_DEBUG(a_format, ...) AIMLAB_LOG_AT(AIMLAB_LOG_LEVEL_DEBUG, a_format, ##__VA_ARGS__)
+#else
+#define AIMLAB_LOG_DEBUG(a_format, ...) ((void)0)
+#endif
+
+#if AIMLAB_LOG_LEVEL <= AIMLAB_LOG_LEVEL_INFO
+#define AIMLAB_LOG_INFO(a_format, ...) AIMLAB_LOG_AT(AIMLAB_LOG_LEVEL_INFO, a_format, ##__VA_ARGS__)
+#else
+#define AIMLAB_LOG_INFO(a_format, ...) ((void)0)
+#endif
+
+#if AIMLAB_LOG_LEVEL <= AIMLAB_LOG_LEVEL_WARN
+#define AIMLAB_LOG_WARN(a_format, ...) AIMLAB_LOG_AT(AIMLAB_LOG_LEVEL_WARN, a_format, ##__VA_ARGS__)
+#else
+#define AIMLAB_LOG_WARN(a_format, ...) ((void)0)
+#endif
+
+#if AIMLAB_LOG_LEVEL <= AIMLAB_LOG_LEVEL_ERROR
+#define AIMLAB_LOG_ERROR(a_format, ...) AIMLAB_LOG_AT(AIMLAB_LOG_LEVEL_ERROR, a_format, ##__VA_ARGS__)
+#else
+#define AIMLAB_LOG_ERROR(a_format, ...) ((void)0)
+#endif
+
+#endif // AIMLAB_ASYNC_LOG_H
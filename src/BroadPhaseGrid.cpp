@@ -0,0 +1,235 @@
+/****************************************************************************
+ * AIMLAB - Broad-Phase Uniform Grid
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of BroadPhaseGrid. See BroadPhaseGrid.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - query() into a caller's array
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "BroadPhaseGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+BroadPhaseGrid::BroadPhaseGrid(double a_cellSize, size_t a_expectedBoxes)
+    : m_cellSize(a_cellSize > 0.0 ? a_cellSize : 1.0),
+      m_inverseCellSize(1.0 / m_cellSize),
+      m_bucketMask(0),
+      m_stamp(0),
+      m_live(0),
+      m_lastCells(0),
+      m_lastTested(0) {
+    size_t buckets = 1024;
+    while (buckets < 2 * a_expectedBoxes) {
+        buckets *= 2;
+    }
+    m_buckets.resize(buckets);
+    m_bucketMask = buckets - 1;
+    m_boxes.reserve(a_expectedBoxes);
+}
+
+//===========================================================================
+// HELPERS
+//===========================================================================
+
+void BroadPhaseGrid::cellRange(const double a_min[3], const double a_max[3],
+                               int32_t a_cellMin[3], int32_t a_cellMax[3]) const {
+    for (int k = 0; k < 3; k++) {
+        a_cellMin[k] = (int32_t)floor(a_min[k] * m_inverseCellSize);
+        a_cellMax[k] = (int32_t)floor(a_max[k] * m_inverseCellSize);
+    }
+}
+
+size_t BroadPhaseGrid::bucketOf(int32_t a_x, int32_t a_y, int32_t a_z) const {
+    // Teschner et al. spatial hash
+    const uint32_t h = ((uint32_t)a_x * 73856093u) ^ ((uint32_t)a_y * 19349663u) ^
+                       ((uint32_t)a_z * 83492791u);
+    return h & m_bucketMask;
+}
+
+void BroadPhaseGrid::link(uint32_t a_handle) {
+    Box& box = m_boxes[a_handle];
+    cellRange(box.min, box.max, box.cellMin, box.cellMax);
+
+    const int64_t cells = (int64_t)(box.cellMax[0] - box.cellMin[0] + 1) *
+                          (box.cellMax[1] - box.cellMin[1] + 1) *
+                          (box.cellMax[2] - box.cellMin[2] + 1);
+    box.large = cells > AIMLAB_GRID_MAX_CELLS;
+    if (box.large) {
+        m_large.push_back(a_handle);
+        return;
+    }
+
+    for (int32_t x = box.cellMin[0]; x <= box.cellMax[0]; x++) {
+        for (int32_t y = box.cellMin[1]; y <= box.cellMax[1]; y++) {
+            for (int32_t z = box.cellMin[2]; z <= box.cellMax[2]; z++) {
+                vector<uint32_t>& bucket = m_buckets[bucketOf(x, y, z)];
+                // Cells of one box can share a bucket; list it there once
+                if (find(bucket.begin(), bucket.end(), a_handle) == bucket.end()) {
+                    bucket.push_back(a_handle);
+                }
+            }
+        }
+    }
+}
+
+void BroadPhaseGrid::unlink(uint32_t a_handle) {
+    const Box& box = m_boxes[a_handle];
+    if (box.large) {
+        m_large.erase(find(m_large.begin(), m_large.end(), a_handle));
+        return;
+    }
+
+    for (int32_t x = box.cellMin[0]; x <= box.cellMax[0]; x++) {
+        for (int32_t y = box.cellMin[1]; y <= box.cellMax[1]; y++) {
+            for (int32_t z = box.cellMin[2]; z <= box.cellMax[2]; z++) {
+                vector<uint32_t>& bucket = m_buckets[bucketOf(x, y, z)];
+                vector<uint32_t>::iterator it = find(bucket.begin(), bucket.end(), a_handle);
+                if (it != bucket.end()) {
+                    // Order inside a bucket does not matter
+                    *it = bucket.back();
+                    bucket.pop_back();
+                }
+            }
+        }
+    }
+}
+
+//===========================================================================
+// BOXES
+//===========================================================================
+
+uint32_t BroadPhaseGrid::insert(const double a_min[3], const double a_max[3]) {
+    Box box;
+    for (int k = 0; k < 3; k++) {
+        box.min[k] = a_min[k];
+        box.max[k] = a_max[k];
+    }
+    box.stamp = m_stamp;
+    box.live = true;
+    box.large = false;
+
+    const uint32_t handle = (uint32_t)m_boxes.size();
+    m_boxes.push_back(box);
+    link(handle);
+    m_live++;
+    return handle;
+}
+
+void BroadPhaseGrid::update(uint32_t a_handle, const double a_min[3], const double a_max[3]) {
+    Box& box = m_boxes[a_handle];
+    if (!box.live) {
+        return;
+    }
+    for (int k = 0; k < 3; k++) {
+        box.min[k] = a_min[k];
+        box.max[k] = a_max[k];
+    }
+
+    int32_t cellMin[3], cellMax[3];
+    cellRange(a_min, a_max, cellMin, cellMax);
+    if (equal(cellMin, cellMin + 3, box.cellMin) && equal(cellMax, cellMax + 3, box.cellMax)) {
+        return;     // same cells: the new extent is all that changed
+    }
+    unlink(a_handle);
+    link(a_handle);
+}
+
+void BroadPhaseGrid::remove(uint32_t a_handle) {
+    Box& box = m_boxes[a_handle];
+    if (!box.live) {
+        return;
+    }
+    unlink(a_handle);
+    box.live = false;
+    m_live--;
+}
+
+//===========================================================================
+// QUERY
+//===========================================================================
+
+void BroadPhaseGrid::query(const double a_min[3], const double a_max[3], vector<uint32_t>& a_out) {
+    collect(a_min, a_max, [&a_out](uint32_t a_handle) { a_out.push_back(a_handle); });
+}
+
+size_t BroadPhaseGrid::query(const double a_min[3], const double a_max[3], uint32_t* a_out) {
+    size_t count = 0;
+    collect(a_min, a_max, [a_out, &count](uint32_t a_handle) { a_out[count++] = a_handle; });
+    return count;
+}
+
+template <class Emit>
+void BroadPhaseGrid::collect(const double a_min[3], const double a_max[3], Emit a_emit) {
+    if (++m_stamp == 0) {
+        // Stamp wrapped: clear them so no box looks already tested
+        for (size_t i = 0; i < m_boxes.size(); i++) {
+            m_boxes[i].stamp = 0;
+        }
+        m_stamp = 1;
+    }
+
+    size_t cells = 0, tested = 0;
+    int32_t cellMin[3], cellMax[3];
+    cellRange(a_min, a_max, cellMin, cellMax);
+
+    // A query box covering more cells than there are boxes: test them all
+    const double queryCells = (double)(cellMax[0] - cellMin[0] + 1) *
+                              (cellMax[1] - cellMin[1] + 1) * (cellMax[2] - cellMin[2] + 1);
+    if (queryCells > (double)m_boxes.size()) {
+        for (uint32_t h = 0; h < (uint32_t)m_boxes.size(); h++) {
+            const Box& box = m_boxes[h];
+            if (box.live && overlaps(box, a_min, a_max)) {
+                a_emit(h);
+            }
+        }
+        m_lastCells = 0;
+        m_lastTested = m_boxes.size();
+        return;
+    }
+
+    for (int32_t x = cellMin[0]; x <= cellMax[0]; x++) {
+        for (int32_t y = cellMin[1]; y <= cellMax[1]; y++) {
+            for (int32_t z = cellMin[2]; z <= cellMax[2]; z++) {
+                const vector<uint32_t>& bucket = m_buckets[bucketOf(x, y, z)];
+                cells++;
+                for (size_t i = 0; i < bucket.size(); i++) {
+                    Box& box = m_boxes[bucket[i]];
+                    if (box.stamp == m_stamp) {
+                        continue;
+                    }
+                    box.stamp = m_stamp;
+                    tested++;
+                    if (overlaps(box, a_min, a_max)) {
+                        a_emit(bucket[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_large.size(); i++) {
+        const Box& box = m_boxes[m_large[i]];
+        tested++;
+        if (overlaps(box, a_min, a_max)) {
+            a_emit(m_large[i]);
+        }
+    }
+
+    m_lastCells = cells;
+    m_lastTested = tested;
+}
@@ -0,0 +1,123 @@
+/****************************************************************************
+ * AIMLAB - Broad-Phase Uniform Grid
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Hashed uniform grid over axis-aligned boxes, for finding the few scene
+ *   objects near the haptic tool without visiting all of them. Each box
+ *   is listed in every cell it overlaps. Cells hash into a fixed bucket
+ *   table, and a hash collision only adds a candidate that the final box
+ *   test drops. A box that would span more than AIMLAB_GRID_MAX_CELLS
+ *   cells (a floor, a wall) goes into a short list that every query tests
+ *   instead.
+ *
+ *   update() only touches the buckets when the box's cell range changed,
+ *   so an object moving inside its cells costs a few stores. query()
+ *   visits the cells of the query box, tests each candidate once (a
+ *   per-query stamp) and appends the overlapping handles. Its cost
+ *   depends on the objects near the query box, not on the scene size.
+ *   A query box covering more cells than there are boxes tests every box.
+ *
+ *   No CHAI3D dependency; HapticBroadPhase feeds it the haptic objects.
+ *   Single-threaded. After construction, only a bucket that grows beyond
+ *   its largest size so far allocates; query() never allocates if the
+ *   output vector has the capacity, and the array form never does.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - query() into a caller's array (per-tick scratch)
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_BROAD_PHASE_GRID_H
+#define AIMLAB_BROAD_PHASE_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define AIMLAB_GRID_MAX_CELLS   64      // larger boxes skip the grid
+
+class BroadPhaseGrid {
+public:
+    /**
+     * @param a_cellSize     Cell edge length (world units)
+     * @param a_expectedBoxes Sizes the bucket table (about two buckets per box)
+     */
+    BroadPhaseGrid(double a_cellSize, size_t a_expectedBoxes);
+
+    /**
+     * @brief Add a box
+     *
+     * @return Handle for update(), remove() and query results (dense, from 0)
+     */
+    uint32_t insert(const double a_min[3], const double a_max[3]);
+
+    /** @brief Move or resize a box */
+    void update(uint32_t a_handle, const double a_min[3], const double a_max[3]);
+
+    /** @brief Take a box out; its handle is not reused */
+    void remove(uint32_t a_handle);
+
+    /**
+     * @brief Append every box overlapping [a_min, a_max] to a_out, each once
+     */
+    void query(const double a_min[3], const double a_max[3], std::vector<uint32_t>& a_out);
+
+    /**
+     * @brief Write every box overlapping [a_min, a_max] to a_out, each once
+     *
+     * @param a_out Room for boxCount() handles
+     * @return Number of handles written
+     */
+    size_t query(const double a_min[3], const double a_max[3], uint32_t* a_out);
+
+    double cellSize() const { return m_cellSize; }
+    size_t boxCount() const { return m_live; }
+
+    /** @brief Cells visited and candidates tested by the last query() */
+    size_t lastCellsVisited() const { return m_lastCells; }
+    size_t lastCandidatesTested() const { return m_lastTested; }
+
+private:
+    struct Box {
+        double min[3];
+        double max[3];
+        int32_t cellMin[3];
+        int32_t cellMax[3];
+        uint32_t stamp;                 // last query that tested this box
+        bool live;
+        bool large;                     // in m_large instead of the buckets
+    };
+
+    static bool overlaps(const Box& a_box, const double a_min[3], const double a_max[3]) {
+        return a_box.min[0] <= a_max[0] && a_box.max[0] >= a_min[0] &&
+               a_box.min[1] <= a_max[1] && a_box.max[1] >= a_min[1] &&
+               a_box.min[2] <= a_max[2] && a_box.max[2] >= a_min[2];
+    }
+
+    template <class Emit>
+    void collect(const double a_min[3], const double a_max[3], Emit a_emit);
+
+    void cellRange(const double a_min[3], const double a_max[3],
+                   int32_t a_cellMin[3], int32_t a_cellMax[3]) const;
+    size_t bucketOf(int32_t a_x, int32_t a_y, int32_t a_z) const;
+    void link(uint32_t a_handle);
+    void unlink(uint32_t a_handle);
+
+    double m_cellSize;
+    double m_inverseCellSize;
+    std::vector<Box> m_boxes;
+    std::vector<std::vector<uint32_t> > m_buckets;
+    size_t m_bucketMask;
+    std::vector<uint32_t> m_large;
+    uint32_t m_stamp;
+    size_t m_live;
+    size_t m_lastCells;
+    size_t m_lastTested;
+};
+
+#endif // AIMLAB_BROAD_PHASE_GRID_H
@@ -0,0 +1,234 @@
+/****************************************************************************
+ * AIMLAB - Device State Filter
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of DeviceFilter. See DeviceFilter.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - sampleAgeNs() renamed timeSinceChangeNs()
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "DeviceFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+static const double PI = 3.14159265358979323846;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+DeviceFilter::DeviceFilter(const DeviceFilterConfig& a_config, double a_maxDamping)
+    : m_config(a_config) {
+    m_config.window = max(2, min(m_config.window, AIMLAB_FILTER_MAX_WINDOW));
+    m_maxDamping = (m_config.maxDamping > 0.0) ? m_config.maxDamping : max(a_maxDamping, 0.0);
+    m_horizonNs = (uint64_t)(max(m_config.horizonS, 0.0) * 1e9);
+
+    // Without extrapolation a repeated reading still has to count at some point
+    m_holdNs = (m_horizonNs > 0) ? m_horizonNs
+                                 : (uint64_t)(DeviceFilterConfig().horizonS * 1e9);
+
+    m_samples = 0;
+    m_dampedTicks = 0;
+    m_dissipated = 0.0;
+    reset();
+}
+
+void DeviceFilter::reset() {
+    m_count = 0;
+    m_newest = 0;
+    memset(m_raw, 0, sizeof(m_raw));
+    memset(m_velocity, 0, sizeof(m_velocity));
+    m_nowNs = 0;
+    m_lastTickNs = 0;
+    m_ticked = false;
+    m_dt = 0.0;
+    memset(m_smoothed, 0, sizeof(m_smoothed));
+    memset(m_lastForce, 0, sizeof(m_lastForce));
+    m_hasForce = false;
+    memset(m_impulse, 0, sizeof(m_impulse));
+    m_energy = 0.0;
+    m_damping = 0.0;
+}
+
+//===========================================================================
+// SAMPLES
+//===========================================================================
+
+void DeviceFilter::beginTick(uint64_t a_nowNs) {
+    // A pipeline restart or a stalled replay: the history says nothing
+    // about where the device is now
+    if (m_ticked && (a_nowNs < m_lastTickNs ||
+                     a_nowNs - m_lastTickNs > AIMLAB_FILTER_RESET_GAP_NS)) {
+        reset();
+    }
+    m_dt = m_ticked ? (double)(a_nowNs - m_lastTickNs) * 1e-9 : 0.0;
+    m_lastTickNs = a_nowNs;
+    m_ticked = true;
+    m_nowNs = a_nowNs;
+
+    // The previous tick's force acted until now
+    for (int k = 0; k < 3; k++) {
+        m_impulse[k] += m_lastForce[k] * m_dt;
+    }
+}
+
+bool DeviceFilter::addReading(const double a_position[3]) {
+    const bool changed = m_count == 0 || memcmp(a_position, m_raw, sizeof(m_raw)) != 0;
+    if (!changed && m_nowNs - m_timeNs[m_newest] <= m_holdNs) {
+        return false;
+    }
+
+    if (m_count > 0 && m_config.passivity) {
+        observe(a_position);
+    }
+    memset(m_impulse, 0, sizeof(m_impulse));
+
+    memcpy(m_raw, a_position, sizeof(m_raw));
+    m_newest = (m_count == 0) ? 0 : (m_newest + 1) % m_config.window;
+    memcpy(m_position[m_newest], a_position, sizeof(m_raw));
+    m_timeNs[m_newest] = m_nowNs;
+    m_count = min(m_count + 1, m_config.window);
+    m_samples++;
+
+    fitVelocity();
+    if (m_config.passivity) {
+        updateDamping();
+    }
+    return true;
+}
+
+void DeviceFilter::observe(const double a_position[3]) {
+    // Work the force did on the hand between the newest sample and this
+    // one: the mean force sent in between times the distance moved. A
+    // force computed from an old sample while the hand moves shows up
+    // here, whatever produced it
+    const double span = (double)(m_nowNs - m_timeNs[m_newest]) * 1e-9;
+    if (span <= 0.0) {
+        return;
+    }
+    double work = 0.0;
+    for (int k = 0; k < 3; k++) {
+        work += m_impulse[k] / span * (a_position[k] - m_position[m_newest][k]);
+    }
+    // Energy banked by a long viscous contact is capped so it cannot pay
+    // for later buzz
+    m_energy = min(m_energy - work, AIMLAB_FILTER_MAX_ENERGY);
+}
+
+void DeviceFilter::updateDamping() {
+    // Enough damping to dissipate the deficit by the next sample, at the
+    // current velocity and sample period
+    const int oldest = (m_count < m_config.window) ? 0 : (m_newest + 1) % m_config.window;
+    const double period = (m_count > 1)
+                        ? (double)(m_timeNs[m_newest] - m_timeNs[oldest]) * 1e-9 / (m_count - 1)
+                        : 0.0;
+    const double v2 = m_velocity[0] * m_velocity[0] + m_velocity[1] * m_velocity[1] +
+                      m_velocity[2] * m_velocity[2];
+    m_damping = (m_energy < 0.0 && period > 0.0 && v2 > 1e-12)
+              ? min(-m_energy / (period * v2), m_maxDamping) : 0.0;
+}
+
+void DeviceFilter::fitVelocity() {
+    const uint64_t t0 = m_timeNs[m_newest];
+    if (m_count < 3) {
+        // Two samples: their difference is all there is
+        const int previous = (m_newest + m_config.window - 1) % m_config.window;
+        const double span = (double)(t0 - m_timeNs[previous]) * 1e-9;
+        for (int k = 0; k < 3; k++) {
+            m_velocity[k] = (m_count == 2 && span > 0.0)
+                          ? (m_position[m_newest][k] - m_position[previous][k]) / span : 0.0;
+        }
+        return;
+    }
+
+    // Least-squares parabola p = a + b.t + c.t^2 through the window, with t
+    // in ms before the newest sample so the sums stay well conditioned.
+    // Its slope at t = 0 is the velocity now rather than at the middle of
+    // the window, which is what a straight line would give
+    double s[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    double r[3][3] = { { 0.0 } };
+    for (int i = 0; i < m_count; i++) {
+        const double t = -(double)(t0 - m_timeNs[i]) * 1e-6;
+        double tn = 1.0;
+        for (int n = 0; n < 5; n++) {
+            s[n] += tn;
+            tn *= t;
+        }
+        for (int k = 0; k < 3; k++) {
+            const double p = m_position[i][k] - m_position[m_newest][k];
+            r[k][0] += p;
+            r[k][1] += p * t;
+            r[k][2] += p * t * t;
+        }
+    }
+
+    // Normal equations by Cramer's rule; only b is needed
+    const double det = s[0] * (s[2] * s[4] - s[3] * s[3]) -
+                       s[1] * (s[1] * s[4] - s[3] * s[2]) +
+                       s[2] * (s[1] * s[3] - s[2] * s[2]);
+    for (int k = 0; k < 3; k++) {
+        const double numerator = s[0] * (r[k][1] * s[4] - s[3] * r[k][2]) -
+                                 r[k][0] * (s[1] * s[4] - s[3] * s[2]) +
+                                 s[2] * (s[1] * r[k][2] - r[k][1] * s[2]);
+        m_velocity[k] = (fabs(det) > 1e-12) ? numerator / det * 1e3 : 0.0;
+    }
+}
+
+void DeviceFilter::getPosition(double a_position[3]) const {
+    if (m_count == 0) {
+        memcpy(a_position, m_raw, sizeof(m_raw));
+        return;
+    }
+    const double lead = (double)min(m_nowNs - m_timeNs[m_newest], m_horizonNs) * 1e-9;
+    for (int k = 0; k < 3; k++) {
+        a_position[k] = m_position[m_newest][k] + m_velocity[k] * lead;
+    }
+}
+
+void DeviceFilter::getVelocity(double a_velocity[3]) const {
+    memcpy(a_velocity, m_velocity, sizeof(m_velocity));
+}
+
+uint64_t DeviceFilter::timeSinceChangeNs() const {
+    return (m_count > 0) ? m_nowNs - m_timeNs[m_newest] : 0;
+}
+
+//===========================================================================
+// FORCE
+//===========================================================================
+
+void DeviceFilter::filterForce(const double a_force[3], double a_out[3]) {
+    // One-pole low-pass, exact for the tick's length
+    if (m_config.cutoffHz > 0.0 && m_hasForce) {
+        const double a = 1.0 - exp(-2.0 * PI * m_config.cutoffHz * m_dt);
+        for (int k = 0; k < 3; k++) {
+            m_smoothed[k] += a * (a_force[k] - m_smoothed[k]);
+        }
+    } else {
+        memcpy(m_smoothed, a_force, sizeof(m_smoothed));
+    }
+
+    // Controller damping, set when the newest sample arrived
+    const double* v = m_velocity;
+    for (int k = 0; k < 3; k++) {
+        a_out[k] = m_smoothed[k] - m_damping * v[k];
+    }
+    if (m_damping > 0.0) {
+        m_dissipated += m_damping * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]) * m_dt;
+        m_dampedTicks++;
+    }
+
+    memcpy(m_lastForce, a_out, sizeof(m_lastForce));
+    m_hasForce = true;
+}
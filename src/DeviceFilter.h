@@ -0,0 +1,172 @@
+/****************************************************************************
+ * AIMLAB - Device State Filter
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Estimation stage between a slow or jittery device and the haptic tick
+ *   (--device-filter). Serial devices such as the Pantograph deliver
+ *   positions well below the haptic rate, so most ticks see the same
+ *   sample again. A stiff material then pushes on a position that is
+ *   already out of date, puts energy into the user's hand and buzzes.
+ *   Each tick the filter:
+ *
+ *     1. Takes the raw position. A reading that differs from the last one
+ *        is a new sample, stamped with the tick time. A reading unchanged
+ *        for longer than the horizon is taken as a new sample too (the
+ *        device is at rest), so the estimate settles.
+ *     2. Fits a parabola through the last `window` samples by least
+ *        squares; its slope at the newest sample is the velocity.
+ *        Quantised or jittery samples average out instead of turning into
+ *        velocity spikes, and unlike a straight-line fit the estimate does
+ *        not lag by half the window.
+ *     3. Extrapolates the newest sample to the tick time with that
+ *        velocity, for at most `horizon` seconds.
+ *     4. Smooths the commanded force with a one-pole low-pass (`cutoff`),
+ *        then runs a passivity observer: at each new sample, the work the
+ *        forces sent since the previous sample did on the user (their
+ *        mean times the distance the device moved). When the running
+ *        total goes negative (extrapolation errors, the low-pass lag or
+ *        the stale samples have generated energy) the passivity
+ *        controller adds the damping that dissipates the excess before
+ *        the next sample, up to `maxDamping`.
+ *
+ *   In bench-device-filter's 100 Hz device with 2 ms latency, the filter
+ *   renders a wall stably up to 500 N/m, twice raw sampling, and no higher
+ *   than extrapolation alone: the low-pass and the passivity controller do
+ *   not raise the stable limit, they only cut the energy above it. The
+ *   default scene material (1000 N/m) is above that limit.
+ *
+ *   Time is whatever beginTick() is given, so a replay that passes the
+ *   recorded tick times reproduces every force bit for bit. Positions,
+ *   velocities and forces are in the device frame (m, m/s, N).
+ *
+ *   Haptic thread only; no locking, no allocation. No CHAI3D dependency;
+ *   FilteredHapticDevice puts it in front of a cGenericHapticDevice.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - sampleAgeNs() renamed timeSinceChangeNs(); measured stable limit
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_DEVICE_FILTER_H
+#define AIMLAB_DEVICE_FILTER_H
+
+#include <cstdint>
+
+#define AIMLAB_FILTER_MAX_WINDOW        32          // samples in the velocity fit
+#define AIMLAB_FILTER_RESET_GAP_NS      100000000   // a longer pause between ticks starts over
+#define AIMLAB_FILTER_MAX_ENERGY        0.05        // J the observer may bank for later
+
+struct DeviceFilterConfig {
+    bool enabled = false;               // --device-filter
+    int window = 4;                     // samples in the velocity fit (2 to AIMLAB_FILTER_MAX_WINDOW)
+    double horizonS = 0.02;             // longest extrapolation, 0 = hold the newest sample
+    double cutoffHz = 150.0;            // force low-pass, 0 = off
+    bool passivity = true;              // passivity observer and controller
+    double maxDamping = 0.0;            // N.s/m the controller may add, 0 = device maximum
+};
+
+class DeviceFilter {
+public:
+    /**
+     * @param a_config      Settings (enabled is not looked at)
+     * @param a_maxDamping  Controller limit when a_config.maxDamping is 0
+     *                      (the device's maximum linear damping)
+     */
+    DeviceFilter(const DeviceFilterConfig& a_config, double a_maxDamping);
+
+    /** @brief Forget every sample and the observed energy */
+    void reset();
+
+    //-----------------------------------------------------------------------
+    // Haptic thread, in this order each tick
+    //-----------------------------------------------------------------------
+
+    /** @brief Time of the tick about to read the device */
+    void beginTick(uint64_t a_nowNs);
+
+    /**
+     * @brief Feed the raw device position
+     *
+     * @return true if it was taken as a new sample
+     */
+    bool addReading(const double a_position[3]);
+
+    /** @brief Newest sample extrapolated to the tick time */
+    void getPosition(double a_position[3]) const;
+
+    /** @brief Least-squares velocity at the newest sample (0 with one sample) */
+    void getVelocity(double a_velocity[3]) const;
+
+    /** @brief Smoothed, passivity-controlled force for this tick */
+    void filterForce(const double a_force[3], double a_out[3]);
+
+    //-----------------------------------------------------------------------
+    // Statistics (haptic thread, or any thread while it is stopped)
+    //-----------------------------------------------------------------------
+
+    /**
+     * @brief Time from the newest sample to the tick time (ns)
+     *
+     * The device does not say when it measured, so this is the time since
+     * the reading last changed, not the age of the measurement. A device
+     * at rest keeps reporting the same reading, which is taken again only
+     * after the horizon (the hold), so at rest this climbs to the hold
+     * (20 ms by default) and starts over.
+     */
+    uint64_t timeSinceChangeNs() const;
+
+    /** @brief Samples taken since construction */
+    uint64_t samples() const { return m_samples; }
+
+    /** @brief Ticks on which the passivity controller added damping */
+    uint64_t dampedTicks() const { return m_dampedTicks; }
+
+    /** @brief Energy the passivity controller has dissipated (J) */
+    double dissipatedEnergy() const { return m_dissipated; }
+
+    const DeviceFilterConfig& config() const { return m_config; }
+    double maxDamping() const { return m_maxDamping; }
+
+private:
+    void fitVelocity();
+    void observe(const double a_position[3]);
+    void updateDamping();
+
+    DeviceFilterConfig m_config;
+    double m_maxDamping;
+    uint64_t m_holdNs;                  // unchanged this long = new sample
+    uint64_t m_horizonNs;
+
+    // Samples, oldest overwritten first
+    double m_position[AIMLAB_FILTER_MAX_WINDOW][3];
+    uint64_t m_timeNs[AIMLAB_FILTER_MAX_WINDOW];
+    int m_count;
+    int m_newest;
+    double m_raw[3];                    // last reading, new or not
+    double m_velocity[3];
+
+    // Tick
+    uint64_t m_nowNs;
+    uint64_t m_lastTickNs;
+    bool m_ticked;                      // m_lastTickNs is valid
+    double m_dt;                        // s since the previous tick
+
+    // Force
+    double m_smoothed[3];
+    double m_lastForce[3];              // sent on the previous tick
+    bool m_hasForce;
+    double m_impulse[3];                // N.s sent since the newest sample
+    double m_energy;                    // J taken from the user (observer)
+    double m_damping;                   // N.s/m the controller adds until the next sample
+
+    uint64_t m_samples;
+    uint64_t m_dampedTicks;
+    double m_dissipated;
+};
+
+#endif // AIMLAB_DEVICE_FILTER_H
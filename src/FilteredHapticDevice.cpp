@@ -0,0 +1,112 @@
+/****************************************************************************
+ * AIMLAB - Filtered Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of FilteredHapticDevice. See FilteredHapticDevice.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - A failed device read is not fed to the filter
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "FilteredHapticDevice.h"
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+FilteredHapticDevice::FilteredHapticDevice(cGenericHapticDevicePtr a_inner,
+                                           const DeviceFilterConfig& a_config)
+    : cGenericHapticDevice(0),
+      m_inner(a_inner),
+      m_filter(a_config, a_inner->getSpecifications().m_maxLinearDamping) {
+    // The tool scales its workspace from these
+    m_specifications = m_inner->getSpecifications();
+    m_deviceAvailable = true;
+    m_deviceReady = true;
+}
+
+FilteredHapticDevice::~FilteredHapticDevice() {
+}
+
+//===========================================================================
+// DEVICE INTERFACE
+//===========================================================================
+
+bool FilteredHapticDevice::open() {
+    return m_inner->open();
+}
+
+bool FilteredHapticDevice::close() {
+    return m_inner->close();
+}
+
+bool FilteredHapticDevice::calibrate(bool a_forceCalibration) {
+    return m_inner->calibrate(a_forceCalibration);
+}
+
+bool FilteredHapticDevice::getPosition(cVector3d& a_position) {
+    cVector3d raw;
+    const bool result = m_inner->getPosition(raw);
+
+    // A failed read is no sample; the estimate carries on from the last one
+    if (result) {
+        const double reading[3] = { raw.x(), raw.y(), raw.z() };
+        m_filter.addReading(reading);
+    }
+
+    double position[3];
+    m_filter.getPosition(position);
+    a_position.set(position[0], position[1], position[2]);
+    return result;
+}
+
+bool FilteredHapticDevice::getRotation(cMatrix3d& a_rotation) {
+    return m_inner->getRotation(a_rotation);
+}
+
+bool FilteredHapticDevice::getLinearVelocity(cVector3d& a_linearVelocity) {
+    // The inner device is still asked, for devices that sample on every read
+    cVector3d raw;
+    const bool result = m_inner->getLinearVelocity(raw);
+
+    double velocity[3];
+    m_filter.getVelocity(velocity);
+    a_linearVelocity.set(velocity[0], velocity[1], velocity[2]);
+    m_linearVelocity = a_linearVelocity;
+    return result;
+}
+
+bool FilteredHapticDevice::getAngularVelocity(cVector3d& a_angularVelocity) {
+    return m_inner->getAngularVelocity(a_angularVelocity);
+}
+
+bool FilteredHapticDevice::getGripperAngleRad(double& a_angle) {
+    return m_inner->getGripperAngleRad(a_angle);
+}
+
+bool FilteredHapticDevice::getGripperAngularVelocity(double& a_gripperAngularVelocity) {
+    return m_inner->getGripperAngularVelocity(a_gripperAngularVelocity);
+}
+
+bool FilteredHapticDevice::getUserSwitches(unsigned int& a_userSwitches) {
+    return m_inner->getUserSwitches(a_userSwitches);
+}
+
+bool FilteredHapticDevice::setForceAndTorqueAndGripperForce(const cVector3d& a_force,
+                                                            const cVector3d& a_torque,
+                                                            double a_gripperForce) {
+    const double force[3] = { a_force.x(), a_force.y(), a_force.z() };
+    double out[3];
+    m_filter.filterForce(force, out);
+    return m_inner->setForceAndTorqueAndGripperForce(cVector3d(out[0], out[1], out[2]),
+                                                     a_torque, a_gripperForce);
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+ * AIMLAB - Filtered Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Pass-through cGenericHapticDevice that runs a DeviceFilter between an
+ *   inner device and the tool (--device-filter). getPosition() returns the
+ *   newest sample extrapolated to the tick time, getLinearVelocity() the
+ *   least-squares estimate, and setForceAndTorqueAndGripperForce() sends
+ *   the smoothed, passivity-controlled force. Rotation, gripper, switches,
+ *   torque and gripper force pass through unchanged.
+ *
+ *   Call beginTick() before each updateFromDevice(). Device 0's chain
+ *   with --record is tool -> filter -> tap -> device, so the recording
+ *   holds the raw samples and the filtered force, and a replay through a
+ *   filter with the same settings and the recorded tick times reproduces
+ *   it exactly.
+ *
+ *   The application keeps opening, calibrating and closing the inner
+ *   device itself. Haptic thread only; no locking, no allocation.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_FILTERED_HAPTIC_DEVICE_H
+#define AIMLAB_FILTERED_HAPTIC_DEVICE_H
+
+#include "chai3d.h"
+#include "DeviceFilter.h"
+
+class FilteredHapticDevice : public chai3d::cGenericHapticDevice {
+public:
+    FilteredHapticDevice(chai3d::cGenericHapticDevicePtr a_inner, const DeviceFilterConfig& a_config);
+    virtual ~FilteredHapticDevice();
+
+    //-----------------------------------------------------------------------
+    // cGenericHapticDevice interface
+    //-----------------------------------------------------------------------
+    virtual bool open();
+    virtual bool close();
+    virtual bool calibrate(bool a_forceCalibration = false);
+    virtual bool getPosition(chai3d::cVector3d& a_position);
+    virtual bool getRotation(chai3d::cMatrix3d& a_rotation);
+    virtual bool getLinearVelocity(chai3d::cVector3d& a_linearVelocity);
+    virtual bool getAngularVelocity(chai3d::cVector3d& a_angularVelocity);
+    virtual bool getGripperAngleRad(double& a_angle);
+    virtual bool getGripperAngularVelocity(double& a_gripperAngularVelocity);
+    virtual bool getUserSwitches(unsigned int& a_userSwitches);
+    virtual bool setForceAndTorqueAndGripperForce(const chai3d::cVector3d& a_force,
+                                                  const chai3d::cVector3d& a_torque,
+                                                  double a_gripperForce);
+
+    //-----------------------------------------------------------------------
+    // Filter
+    //-----------------------------------------------------------------------
+
+    /** @brief Time of the tick about to read the device (hapticNowNs() or recorded) */
+    void beginTick(uint64_t a_nowNs) { m_filter.beginTick(a_nowNs); }
+
+    const DeviceFilter& getFilter() const { return m_filter; }
+    chai3d::cGenericHapticDevicePtr getInner() const { return m_inner; }
+
+private:
+    chai3d::cGenericHapticDevicePtr m_inner;
+    DeviceFilter m_filter;
+};
+
+#endif // AIMLAB_FILTERED_HAPTIC_DEVICE_H
@@ -0,0 +1,172 @@
+/****************************************************************************
+ * AIMLAB - Haptic Broad Phase
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of HapticBroadPhase. See HapticBroadPhase.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Candidate list in the tick's scratch arena
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "HapticBroadPhase.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace chai3d;
+using namespace std;
+
+static const uint32_t NOT_IN_GRID = 0xFFFFFFFFu;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+double HapticBroadPhase::medianExtent(const vector<cGenericObject*>& a_objects,
+                                      const vector<ObjectBounds>& a_localBounds,
+                                      const vector<bool>& a_haptic) {
+    vector<double> extents;
+    for (size_t i = 0; i < a_objects.size() && i < a_localBounds.size(); i++) {
+        if (!a_haptic[i]) {
+            continue;
+        }
+        const ObjectBounds& b = a_localBounds[i];
+        extents.push_back(max(b.max[0] - b.min[0], max(b.max[1] - b.min[1], b.max[2] - b.min[2])));
+    }
+    if (extents.empty()) {
+        return 0.0;
+    }
+    nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+    return extents[extents.size() / 2];
+}
+
+HapticBroadPhase::HapticBroadPhase(cWorld* a_world,
+                                   const vector<cGenericObject*>& a_objects,
+                                   const vector<ObjectBounds>& a_localBounds,
+                                   const vector<bool>& a_haptic,
+                                   double a_queryRadius, double a_cellSize)
+    : m_world(a_world),
+      m_objects(a_objects),
+      m_localBounds(a_localBounds),
+      m_queryRadius(a_queryRadius),
+      m_grid(a_cellSize > 0.0 ? a_cellSize
+                              : max(medianExtent(a_objects, a_localBounds, a_haptic),
+                                    2.0 * a_queryRadius),
+             a_objects.size()),
+      m_handleOf(a_objects.size(), NOT_IN_GRID),
+      m_seen(a_objects.size(), 0),
+      m_active(a_objects.size(), 0),
+      m_stamp(0) {
+    // Global transforms first: detached objects only get them from objectMoved()
+    m_world->computeGlobalPositions(true);
+
+    for (size_t i = 0; i < m_objects.size(); i++) {
+        m_world->removeChild(m_objects[i]);
+        if (i < m_localBounds.size() && a_haptic[i]) {
+            double min[3], max[3];
+            worldBox(i, min, max);
+            m_handleOf[i] = m_grid.insert(min, max);
+            m_objectOf.push_back((uint32_t)i);
+        }
+    }
+    m_activeList.reserve(m_objects.size());
+}
+
+HapticBroadPhase::~HapticBroadPhase() {
+    for (size_t i = 0; i < m_objects.size(); i++) {
+        if (!m_active[i]) {
+            m_world->addChild(m_objects[i]);
+        }
+    }
+}
+
+//===========================================================================
+// OBJECTS
+//===========================================================================
+
+void HapticBroadPhase::worldBox(size_t a_index, double a_min[3], double a_max[3]) const {
+    // Rotated box: centre moves with the frame, half extents grow by |R|
+    const ObjectBounds& b = m_localBounds[a_index];
+    const cVector3d& pos = m_objects[a_index]->getGlobalPos();
+    const cMatrix3d& rot = m_objects[a_index]->getGlobalRot();
+
+    double center[3], half[3];
+    for (int k = 0; k < 3; k++) {
+        center[k] = 0.5 * (b.min[k] + b.max[k]);
+        half[k] = 0.5 * (b.max[k] - b.min[k]);
+    }
+    for (int r = 0; r < 3; r++) {
+        double c = pos(r), h = 0.0;
+        for (int k = 0; k < 3; k++) {
+            c += rot(r, k) * center[k];
+            h += fabs(rot(r, k)) * half[k];
+        }
+        a_min[r] = c - h;
+        a_max[r] = c + h;
+    }
+}
+
+void HapticBroadPhase::objectMoved(size_t a_index) {
+    if (a_index >= m_objects.size()) {
+        return;
+    }
+    // The world frame is the identity, so this is the object's global pose
+    m_objects[a_index]->computeGlobalPositions(true);
+
+    if (m_handleOf[a_index] != NOT_IN_GRID) {
+        double min[3], max[3];
+        worldBox(a_index, min, max);
+        m_grid.update(m_handleOf[a_index], min, max);
+    }
+}
+
+//===========================================================================
+// UPDATE
+//===========================================================================
+
+void HapticBroadPhase::update(const cVector3d& a_devicePos, const cVector3d& a_proxyPos,
+                              Arena& a_scratch) {
+    double min[3], max[3];
+    for (int k = 0; k < 3; k++) {
+        min[k] = std::min(a_devicePos(k), a_proxyPos(k)) - m_queryRadius;
+        max[k] = std::max(a_devicePos(k), a_proxyPos(k)) + m_queryRadius;
+    }
+
+    uint32_t* candidates = a_scratch.allocateArray<uint32_t>(m_grid.boxCount());
+    const size_t candidateCount = m_grid.query(min, max, candidates);
+
+    if (++m_stamp == 0) {
+        fill(m_seen.begin(), m_seen.end(), 0);
+        m_stamp = 1;
+    }
+    for (size_t i = 0; i < candidateCount; i++) {
+        m_seen[m_objectOf[candidates[i]]] = m_stamp;
+    }
+
+    // Detach what left the box
+    for (size_t i = m_activeList.size(); i-- > 0; ) {
+        const uint32_t object = m_activeList[i];
+        if (m_seen[object] != m_stamp) {
+            m_world->removeChild(m_objects[object]);
+            m_active[object] = 0;
+            m_activeList[i] = m_activeList.back();
+            m_activeList.pop_back();
+        }
+    }
+
+    // Attach what entered it (its global transform is already current)
+    for (size_t i = 0; i < candidateCount; i++) {
+        const uint32_t object = m_objectOf[candidates[i]];
+        if (!m_active[object]) {
+            m_world->addChild(m_objects[object]);
+            m_active[object] = 1;
+            m_activeList.push_back(object);
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ * AIMLAB - Haptic Broad Phase
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Keeps tool->computeInteractionForces() from visiting every object in
+ *   the haptic world. CHAI3D's interaction pass walks the whole world
+ *   tree, so the only way to make it skip an object is to take the object
+ *   out of the tree. HapticBroadPhase detaches every scene object from
+ *   its haptic world. Each tick it attaches only the objects whose boxes
+ *   overlap a box around the device and proxy positions, found through a
+ *   BroadPhaseGrid. Attaching and detaching are a child-list insert and
+ *   removal and only happen when an object enters or leaves that box.
+ *
+ *   Detached objects are not reached by the world's transform update, so
+ *   objectMoved() recomputes an object's global transform as well as its
+ *   grid box when the bridge moves it. The scene objects are direct
+ *   children of the world, whose frame is the identity. Objects that are
+ *   not haptic-enabled stay detached.
+ *
+ *   The candidate list of each update() comes from the caller's per-tick
+ *   scratch arena; reserve scratchBytes() in it so update() never
+ *   allocates.
+ *
+ *   One instance per haptic world; haptic thread only.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Candidate list in the tick's scratch arena
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_BROAD_PHASE_H
+#define AIMLAB_HAPTIC_BROAD_PHASE_H
+
+#include "chai3d.h"
+#include "Arena.h"
+#include "BroadPhaseGrid.h"
+#include "SceneBuilder.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class HapticBroadPhase {
+public:
+    /**
+     * @param a_world        Haptic world; a_objects must be its direct children
+     * @param a_objects      Scene objects, index = object_id
+     * @param a_localBounds  Their local boxes (from buildScene()), same order
+     * @param a_haptic       Which objects take part (haptic-enabled), same order
+     * @param a_queryRadius  Added around the device and proxy positions
+     *                       (tool radius plus a margin)
+     * @param a_cellSize     Grid cell edge; 0 = the median object size, but
+     *                       at least 2 * a_queryRadius (a query then visits
+     *                       a few cells)
+     */
+    HapticBroadPhase(chai3d::cWorld* a_world,
+                     const std::vector<chai3d::cGenericObject*>& a_objects,
+                     const std::vector<ObjectBounds>& a_localBounds,
+                     const std::vector<bool>& a_haptic,
+                     double a_queryRadius, double a_cellSize);
+
+    /** @brief Gives detached objects back to the world, which deletes its children */
+    ~HapticBroadPhase();
+
+    HapticBroadPhase(const HapticBroadPhase&) = delete;
+    HapticBroadPhase& operator=(const HapticBroadPhase&) = delete;
+
+    /** @brief Object a_index's local transform was set */
+    void objectMoved(size_t a_index);
+
+    /**
+     * @brief Attach the objects near the tool and detach the others
+     *
+     * Call after updateFromDevice() and before computeInteractionForces().
+     *
+     * @param a_scratch Holds the candidate list until the caller resets it
+     */
+    void update(const chai3d::cVector3d& a_devicePos, const chai3d::cVector3d& a_proxyPos,
+                Arena& a_scratch);
+
+    /** @brief Scratch one update() takes at most */
+    size_t scratchBytes() const { return m_grid.boxCount() * sizeof(uint32_t) + alignof(uint32_t); }
+
+    size_t activeCount() const { return m_activeList.size(); }
+    double cellSize() const { return m_grid.cellSize(); }
+    const BroadPhaseGrid& grid() const { return m_grid; }
+
+private:
+    void worldBox(size_t a_index, double a_min[3], double a_max[3]) const;
+    static double medianExtent(const std::vector<chai3d::cGenericObject*>& a_objects,
+                               const std::vector<ObjectBounds>& a_localBounds,
+                               const std::vector<bool>& a_haptic);
+
+    chai3d::cWorld* m_world;
+    std::vector<chai3d::cGenericObject*> m_objects;
+    std::vector<ObjectBounds> m_localBounds;
+    double m_queryRadius;
+    BroadPhaseGrid m_grid;
+    std::vector<uint32_t> m_handleOf;       // object -> grid handle (UINT32_MAX = not haptic)
+    std::vector<uint32_t> m_objectOf;       // grid handle -> object
+    std::vector<uint32_t> m_activeList;     // attached objects
+    std::vector<uint32_t> m_seen;           // object -> last update() that found it
+    std::vector<uint8_t> m_active;
+    uint32_t m_stamp;
+};
+
+#endif // AIMLAB_HAPTIC_BROAD_PHASE_H
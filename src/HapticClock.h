@@ -0,0 +1,33 @@
+/****************************************************************************
+ * AIMLAB - Haptic Clock
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Monotonic nanosecond timestamps for the haptic pipeline. steady_clock
+ *   maps to CLOCK_MONOTONIC on Linux and QueryPerformanceCounter on
+ *   Windows (both vDSO/user-mode reads), the same clock the Unity bridge
+ *   uses for aimlab_bridge_now_ns().
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_CLOCK_H
+#define AIMLAB_HAPTIC_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Current monotonic time in nanoseconds
+ */
+inline uint64_t hapticNowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // AIMLAB_HAPTIC_CLOCK_H
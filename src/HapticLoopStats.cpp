@@ -0,0 +1,174 @@
+/****************************************************************************
+ * AIMLAB - Haptic Loop Rate and Jitter Statistics
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.6
+ *
+ * Description:
+ *   Implementation of HapticLoopStats. See HapticLoopStats.h.
+ *
+ * Changelog:
+ *   v1.6 - 16 October 2026 - Sample age stage renamed sinceChange
+ *   v1.5 - 16 October 2026 - Device sample age stage
+ *   v1.4 - 16 October 2026 - Batched primitive force stage
+ *   v1.3 - 16 October 2026 - Local contact model age stage
+ *   v1.2 - 16 October 2026 - Broad-phase stage
+ *   v1.1 - 16 October 2026 - Scheduler wake-up lateness stage
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "HapticLoopStats.h"
+#include "HapticClock.h"
+
+#include <cstdio>
+#include <memory>
+
+//===========================================================================
+// REPORT
+//===========================================================================
+
+void HapticLoopStats::Report::subtract(const Report& older) {
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        stages[i].subtract(older.stages[i]);
+    }
+    ticks -= older.ticks;
+    missedDeadlines -= older.missedDeadlines;
+    startNs = older.endNs;
+}
+
+double HapticLoopStats::Report::seconds() const {
+    return (endNs > startNs) ? (double)(endNs - startNs) * 1e-9 : 0.0;
+}
+
+//===========================================================================
+// STATS
+//===========================================================================
+
+HapticLoopStats::HapticLoopStats(uint64_t a_deadlineNs)
+    : m_deadlineNs(a_deadlineNs) {
+    reset();
+}
+
+void HapticLoopStats::reset() {
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        m_histograms[i].reset();
+    }
+    m_ticks.store(0, std::memory_order_relaxed);
+    m_missed.store(0, std::memory_order_relaxed);
+    m_firstTickStart.store(0, std::memory_order_relaxed);
+    m_lastTickStart = 0;
+}
+
+void HapticLoopStats::snapshot(Report& a_report) const {
+    a_report.endNs = hapticNowNs();
+    a_report.startNs = m_firstTickStart.load(std::memory_order_relaxed);
+    a_report.ticks = m_ticks.load(std::memory_order_relaxed);
+    a_report.missedDeadlines = m_missed.load(std::memory_order_relaxed);
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        m_histograms[i].snapshot(a_report.stages[i]);
+    }
+}
+
+const char* HapticLoopStats::stageName(HapticStage a_stage) {
+    switch (a_stage) {
+        case STAGE_GLOBAL_POSITIONS:    return "globalPositions";
+        case STAGE_UPDATE_FROM_DEVICE:  return "updateFromDevice";
+        case STAGE_BROAD_PHASE:         return "broadPhase";
+        case STAGE_INTERACTION_FORCES:  return "interactionForces";
+        case STAGE_PRIMITIVES:          return "primitives";
+        case STAGE_APPLY_TO_DEVICE:     return "applyToDevice";
+        case STAGE_TICK:                return "tick";
+        case STAGE_PERIOD:              return "period";
+        case STAGE_WAKE_LATENESS:       return "wakeLateness";
+        case STAGE_MODEL_AGE:           return "modelAge";
+        case STAGE_SINCE_CHANGE:        return "sinceChange";
+        default:                        return "unknown";
+    }
+}
+
+//===========================================================================
+// FORMATTING
+//===========================================================================
+
+size_t HapticLoopStats::formatSummary(const Report& a_report, char* a_buffer, size_t a_size) {
+    size_t used = 0;
+    const double seconds = a_report.seconds();
+    const double rate = (seconds > 0.0) ? (double)a_report.ticks / seconds : 0.0;
+
+    int n = snprintf(a_buffer, a_size,
+                     "[stats] %.0f Hz, %llu ticks, %llu missed deadlines\n",
+                     rate,
+                     (unsigned long long)a_report.ticks,
+                     (unsigned long long)a_report.missedDeadlines);
+    used = (n > 0) ? (size_t)n : 0;
+
+    for (int i = 0; i < STAGE_COUNT && used < a_size; i++) {
+        const LatencyHistogram::Snapshot& h = a_report.stages[i];
+        n = snprintf(a_buffer + used, a_size - used,
+                     "[stats]   %-18s p50 %8.2f  p99 %8.2f  p99.9 %8.2f  max %9.2f us\n",
+                     stageName((HapticStage)i),
+                     h.percentile(0.5) * 1e-3,
+                     h.percentile(0.99) * 1e-3,
+                     h.percentile(0.999) * 1e-3,
+                     h.max * 1e-3);
+        used += (n > 0) ? (size_t)n : 0;
+    }
+
+    return (used < a_size) ? used : a_size - 1;
+}
+
+//===========================================================================
+// EXPORT
+//===========================================================================
+
+bool HapticLoopStats::exportToFile(const std::string& a_filename) const {
+    std::unique_ptr<Report> report(new Report());
+    snapshot(*report);
+
+    FILE* file = fopen(a_filename.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    const bool json = a_filename.size() >= 5 &&
+                      a_filename.compare(a_filename.size() - 5, 5, ".json") == 0;
+    const double seconds = report->seconds();
+    const double rate = (seconds > 0.0) ? (double)report->ticks / seconds : 0.0;
+
+    if (json) {
+        fprintf(file, "{\n");
+        fprintf(file, "  \"ticks\": %llu,\n", (unsigned long long)report->ticks);
+        fprintf(file, "  \"seconds\": %.6f,\n", seconds);
+        fprintf(file, "  \"rate_hz\": %.3f,\n", rate);
+        fprintf(file, "  \"deadline_us\": %.3f,\n", m_deadlineNs * 1e-3);
+        fprintf(file, "  \"missed_deadlines\": %llu,\n", (unsigned long long)report->missedDeadlines);
+        fprintf(file, "  \"stages\": {\n");
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            const LatencyHistogram::Snapshot& h = report->stages[i];
+            fprintf(file,
+                    "    \"%s\": { \"count\": %llu, \"mean_us\": %.3f, \"p50_us\": %.3f, "
+                    "\"p99_us\": %.3f, \"p999_us\": %.3f, \"max_us\": %.3f }%s\n",
+                    stageName((HapticStage)i), (unsigned long long)h.count, h.mean() * 1e-3,
+                    h.percentile(0.5) * 1e-3, h.percentile(0.99) * 1e-3,
+                    h.percentile(0.999) * 1e-3, h.max * 1e-3,
+                    (i + 1 < STAGE_COUNT) ? "," : "");
+        }
+        fprintf(file, "  }\n}\n");
+    } else {
+        fprintf(file, "# ticks=%llu seconds=%.6f rate_hz=%.3f deadline_us=%.3f missed_deadlines=%llu\n",
+                (unsigned long long)report->ticks, seconds, rate, m_deadlineNs * 1e-3,
+                (unsigned long long)report->missedDeadlines);
+        fprintf(file, "stage,count,mean_us,p50_us,p99_us,p999_us,max_us\n");
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            const LatencyHistogram::Snapshot& h = report->stages[i];
+            fprintf(file, "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                    stageName((HapticStage)i), (unsigned long long)h.count, h.mean() * 1e-3,
+                    h.percentile(0.5) * 1e-3, h.percentile(0.99) * 1e-3,
+                    h.percentile(0.999) * 1e-3, h.max * 1e-3);
+        }
+    }
+
+    return fclose(file) == 0;
+}
@@ -0,0 +1,158 @@
+/****************************************************************************
+ * AIMLAB - Haptic Loop Rate and Jitter Statistics
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.7
+ *
+ * Description:
+ *   Per-stage timing of updateHaptics(). The haptic thread timestamps each
+ *   of the four pipeline calls plus the whole tick and the tick-to-tick
+ *   period, and feeds them into lock-free LatencyHistograms. Ticks whose
+ *   period exceeds the deadline (1 ms for a 1 kHz target by default) are
+ *   counted as missed.
+ *
+ *   Any other thread may take a snapshot at any time to print a windowed
+ *   summary (p50 / p99 / p99.9 / max) or export lifetime totals as CSV or
+ *   JSON. The haptic thread never waits on a reader.
+ *
+ * Changelog:
+ *   v1.7 - 16 October 2026 - Sample age stage renamed sinceChange (time since the reading changed)
+ *   v1.6 - 16 October 2026 - Device sample age stage
+ *   v1.5 - 16 October 2026 - markRestart(): no period across a pipeline restart
+ *   v1.4 - 16 October 2026 - Batched primitive force stage
+ *   v1.3 - 16 October 2026 - Local contact model age stage
+ *   v1.2 - 16 October 2026 - Broad-phase stage
+ *   v1.1 - 16 October 2026 - Scheduler wake-up lateness stage
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_LOOP_STATS_H
+#define AIMLAB_HAPTIC_LOOP_STATS_H
+
+#include "LatencyHistogram.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum HapticStage {
+    STAGE_GLOBAL_POSITIONS = 0,     // world->computeGlobalPositions()
+    STAGE_UPDATE_FROM_DEVICE,       // tool->updateFromDevice()
+    STAGE_BROAD_PHASE,              // HapticBroadPhase::update() (0 when disabled)
+    STAGE_INTERACTION_FORCES,       // tool->computeInteractionForces()
+    STAGE_PRIMITIVES,               // PrimitiveBatch::computeForce() (0 without --primitive-batch)
+    STAGE_APPLY_TO_DEVICE,          // tool->applyToDevice()
+    STAGE_TICK,                     // whole tick, including bridge I/O
+    STAGE_PERIOD,                   // start-to-start interval between ticks
+    STAGE_WAKE_LATENESS,            // scheduler wake-up after the deadline (fixed rate only)
+    STAGE_MODEL_AGE,                // age of the rendered local contact model (--multirate only)
+    STAGE_SINCE_CHANGE,             // time since the device reading changed (--device-filter only)
+    STAGE_COUNT
+};
+
+class HapticLoopStats {
+public:
+    /**
+     * @brief Point-in-time copy of every histogram and counter
+     */
+    struct Report {
+        LatencyHistogram::Snapshot stages[STAGE_COUNT];
+        uint64_t ticks;
+        uint64_t missedDeadlines;
+        uint64_t startNs;           // first tick (or end of the older report)
+        uint64_t endNs;             // when the snapshot was taken
+
+        /** @brief Convert into the delta since an older report */
+        void subtract(const Report& older);
+
+        /** @brief Wall time covered by this report (s) */
+        double seconds() const;
+    };
+
+    explicit HapticLoopStats(uint64_t a_deadlineNs = 1000000);
+
+    //-----------------------------------------------------------------------
+    // Haptic thread
+    //-----------------------------------------------------------------------
+
+    /** @brief Mark the start of a tick; records the period and deadline misses */
+    void beginTick(uint64_t a_nowNs) {
+        if (m_lastTickStart != 0) {
+            const uint64_t period = a_nowNs - m_lastTickStart;
+            m_histograms[STAGE_PERIOD].record(period);
+            if (period > m_deadlineNs) {
+                m_missed.store(m_missed.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+            }
+        } else if (m_firstTickStart.load(std::memory_order_relaxed) == 0) {
+            m_firstTickStart.store(a_nowNs, std::memory_order_relaxed);
+        }
+        m_lastTickStart = a_nowNs;
+    }
+
+    /** @brief Record the duration of one pipeline stage */
+    void recordStage(HapticStage a_stage, uint64_t a_durationNs) {
+        m_histograms[a_stage].record(a_durationNs);
+    }
+
+    /** @brief Mark the end of a tick */
+    void endTick(uint64_t a_nowNs) {
+        m_histograms[STAGE_TICK].record(a_nowNs - m_lastTickStart);
+        m_ticks.store(m_ticks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    //-----------------------------------------------------------------------
+    // Any thread
+    //-----------------------------------------------------------------------
+
+    void snapshot(Report& a_report) const;
+
+    uint64_t ticks() const { return m_ticks.load(std::memory_order_relaxed); }
+    uint64_t missedDeadlines() const { return m_missed.load(std::memory_order_relaxed); }
+    uint64_t deadlineNs() const { return m_deadlineNs; }
+
+    /** @brief Change the deadline (only while the haptic thread is stopped) */
+    void setDeadlineNs(uint64_t a_deadlineNs) { m_deadlineNs = a_deadlineNs; }
+
+    /** @brief Zero everything (only while the haptic thread is stopped) */
+    void reset();
+
+    /**
+     * @brief Keep the totals, but do not count the time until the next
+     *        beginTick() as a period (only while the haptic thread is stopped)
+     */
+    void markRestart() { m_lastTickStart = 0; }
+
+    /**
+     * @brief One-line-per-stage text summary of a (windowed) report
+     *
+     * @param a_report Report to format
+     * @param a_buffer Destination buffer
+     * @param a_size   Buffer size
+     * @return Number of characters written
+     */
+    static size_t formatSummary(const Report& a_report, char* a_buffer, size_t a_size);
+
+    /**
+     * @brief Export lifetime statistics; format chosen from the extension
+     *
+     * @param a_filename Path ending in .json (JSON) or anything else (CSV)
+     * @return true on success
+     */
+    bool exportToFile(const std::string& a_filename) const;
+
+    static const char* stageName(HapticStage a_stage);
+
+private:
+    LatencyHistogram m_histograms[STAGE_COUNT];
+    std::atomic<uint64_t> m_ticks;
+    std::atomic<uint64_t> m_missed;
+    std::atomic<uint64_t> m_firstTickStart;
+    uint64_t m_lastTickStart;       // haptic thread only
+    uint64_t m_deadlineNs;
+};
+
+#endif // AIMLAB_HAPTIC_LOOP_STATS_H
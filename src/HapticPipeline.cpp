@@ -0,0 +1,122 @@
+/****************************************************************************
+ * AIMLAB - Haptic Pipeline Lifecycle
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of HapticPipeline. See HapticPipeline.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - HAPTIC_THREAD_PRIORITY_HIGH raises the priority on POSIX too
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "HapticPipeline.h"
+#include "HapticClock.h"
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+using namespace std;
+
+HapticPipeline::HapticPipeline()
+    : m_count(0),
+      m_running(false),
+      m_starts(0),
+      m_enteredCount(0) {
+}
+
+HapticPipeline::~HapticPipeline() {
+    stop();
+}
+
+bool HapticPipeline::addThread(HapticThreadFunction a_function, void* a_arg,
+                               HapticScheduler* a_scheduler, HapticThreadPriority a_priority) {
+    if (isRunning() || m_count == AIMLAB_PIPELINE_MAX_THREADS) {
+        return false;
+    }
+    Entry& entry = m_threads[m_count++];
+    entry.function = a_function;
+    entry.arg = a_arg;
+    entry.scheduler = a_scheduler;
+    entry.priority = a_priority;
+    return true;
+}
+
+void HapticPipeline::clearThreads() {
+    if (!isRunning()) {
+        m_count = 0;
+    }
+}
+
+uint64_t HapticPipeline::start() {
+    const uint64_t t0 = hapticNowNs();
+    if (isRunning()) {
+        return 0;
+    }
+
+    m_starts++;
+    m_enteredCount = 0;
+    m_running.store(true, std::memory_order_release);
+    for (int i = 0; i < m_count; i++) {
+        m_threads[i].thread = std::thread(&HapticPipeline::enter, this, i);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_entered.wait(lock, [this]() { return m_enteredCount == m_count; });
+    return hapticNowNs() - t0;
+}
+
+uint64_t HapticPipeline::stop() {
+    const uint64_t t0 = hapticNowNs();
+    if (!isRunning()) {
+        return 0;
+    }
+
+    // Clear the flag before waking the schedulers (all sequentially
+    // consistent): a thread that starts its scheduler after the wake-up
+    // still sees the flag before it first waits
+    m_running.store(false);
+    for (int i = 0; i < m_count; i++) {
+        if (m_threads[i].scheduler != nullptr) {
+            m_threads[i].scheduler->requestStop();
+        }
+    }
+    for (int i = 0; i < m_count; i++) {
+        m_threads[i].thread.join();
+    }
+    return hapticNowNs() - t0;
+}
+
+void HapticPipeline::enter(int a_index) {
+    const Entry& entry = m_threads[a_index];
+#if defined(_WIN32)
+    if (entry.priority == HAPTIC_THREAD_PRIORITY_HIGH) {
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+    }
+#else
+    if (entry.priority == HAPTIC_THREAD_PRIORITY_HIGH) {
+        // What cThread does for CTHREAD_PRIORITY_HAPTICS; without the
+        // privilege (EPERM) the thread keeps normal priority
+        sched_param param;
+        param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enteredCount++;
+    }
+    m_entered.notify_one();
+
+    entry.function(entry.arg);
+}
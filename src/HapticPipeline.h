@@ -0,0 +1,123 @@
+/****************************************************************************
+ * AIMLAB - Haptic Pipeline Lifecycle
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Starts and stops the haptic and simulation threads as one unit, so
+ *   the application can stop the pipeline, change what it runs (device,
+ *   scene, options) and start it again in place between study trials.
+ *
+ *   Threads are registered once with addThread(). start() spawns every
+ *   registered thread and returns once each one has entered its function.
+ *   Thread functions loop while isRunning() is true. stop() clears that
+ *   flag, calls requestStop() on each thread's HapticScheduler so a
+ *   sleeping thread wakes at once instead of at its next deadline, and
+ *   joins every thread. Both calls return how long they took, so stopping
+ *   costs about one tick plus thread exit, not a polling interval.
+ *
+ *   Threads are std::threads (cThread cannot be joined). A thread added
+ *   with HAPTIC_THREAD_PRIORITY_HIGH gets what cThread's
+ *   CTHREAD_PRIORITY_HAPTICS gave it: THREAD_PRIORITY_HIGHEST on Windows,
+ *   SCHED_FIFO at the highest priority elsewhere. Without the privilege
+ *   for that (EPERM) it silently keeps normal priority, as with cThread.
+ *   An explicit priority and core affinity stay with
+ *   HapticScheduler::configureCurrentThread() (--fifo, --cpu), which runs
+ *   afterwards and overrides this.
+ *
+ *   start(), stop() and addThread() belong to one controlling thread.
+ *   No CHAI3D dependency.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - High priority on POSIX too, as cThread gave the haptic thread
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_PIPELINE_H
+#define AIMLAB_HAPTIC_PIPELINE_H
+
+#include "HapticScheduler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#define AIMLAB_PIPELINE_MAX_THREADS     8       // haptic + simulation thread per device
+
+typedef void (*HapticThreadFunction)(void* a_arg);
+
+enum HapticThreadPriority {
+    HAPTIC_THREAD_PRIORITY_NORMAL = 0,
+    HAPTIC_THREAD_PRIORITY_HIGH
+};
+
+class HapticPipeline {
+public:
+    HapticPipeline();
+    ~HapticPipeline();
+
+    HapticPipeline(const HapticPipeline&) = delete;
+    HapticPipeline& operator=(const HapticPipeline&) = delete;
+
+    /**
+     * @brief Register a thread to run on every start() (only while stopped)
+     *
+     * @param a_scheduler Woken by stop(); nullptr if the thread never sleeps
+     * @return false if the pipeline is running or full
+     */
+    bool addThread(HapticThreadFunction a_function, void* a_arg, HapticScheduler* a_scheduler,
+                   HapticThreadPriority a_priority);
+
+    /** @brief Forget every registered thread (only while stopped) */
+    void clearThreads();
+
+    int threadCount() const { return m_count; }
+
+    /**
+     * @brief Spawn every registered thread
+     *
+     * @return Nanoseconds until the last thread entered its function
+     */
+    uint64_t start();
+
+    /**
+     * @brief Make every thread return and join it; no-op while stopped
+     *
+     * @return Nanoseconds until the last thread was joined
+     */
+    uint64_t stop();
+
+    /** @brief Thread functions keep looping while this is true */
+    bool isRunning() const { return m_running.load(); }
+
+    /** @brief Number of start() calls so far (1 during the first run) */
+    uint64_t starts() const { return m_starts; }
+
+private:
+    void enter(int a_index);
+
+    struct Entry {
+        HapticThreadFunction function = nullptr;
+        void* arg = nullptr;
+        HapticScheduler* scheduler = nullptr;
+        HapticThreadPriority priority = HAPTIC_THREAD_PRIORITY_NORMAL;
+        std::thread thread;
+    };
+
+    Entry m_threads[AIMLAB_PIPELINE_MAX_THREADS];
+    int m_count;
+    std::atomic<bool> m_running;
+    uint64_t m_starts;
+
+    // start() waits on this until every thread has entered
+    std::mutex m_mutex;
+    std::condition_variable m_entered;
+    int m_enteredCount;
+};
+
+#endif // AIMLAB_HAPTIC_PIPELINE_H
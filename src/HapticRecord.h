@@ -0,0 +1,182 @@
+/****************************************************************************
+ * AIMLAB - Haptic Session Recording Format
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.4
+ *
+ * Description:
+ *   Types shared by SessionRecorder (writes), SessionReader (reads) and
+ *   the aimlab-recording tool.
+ *
+ *   File layout (.aimrec, native little-endian):
+ *
+ *     [0, 4096)      SessionFileHeader, zero padded to one 4 KiB block
+ *     [4096, ...)    HapticRecordDisk[recordCount], 256 bytes each
+ *
+ *   Each record holds everything cGenericTool::updateFromDevice() reads
+ *   from the device (HapticSample, full double precision so a replay is
+ *   bit-identical) plus the pipeline outputs for that tick: proxy
+ *   position and the force / torque / gripper force commanded to the
+ *   device. Timestamps are delta-encoded: each record stores nanoseconds
+ *   since the previous one (the first since header.startNs).
+ *
+ *   The header also stores what a replay needs to rebuild the pipeline:
+ *   the device specifications the tool scaled with, the scene file and
+ *   the haptic material of the first scene object, and the --device-filter
+ *   settings the recorded forces went through.
+ *
+ *   Version history:
+ *     1 - Initial format
+ *     2 - Flags, device specifications and scene material in the header
+ *     3 - Scene file path in the header
+ *     4 - Device filter settings in the header
+ *
+ * Changelog:
+ *   v1.4 - 16 October 2026 - Format version 4 (device filter)
+ *   v1.3 - 16 October 2026 - Primitive batch flag
+ *   v1.2 - 16 October 2026 - Format version 3 (scene file)
+ *   v1.1 - 16 October 2026 - Format version 2 (replay information in the header)
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_RECORD_H
+#define AIMLAB_HAPTIC_RECORD_H
+
+#include <cstdint>
+
+#define AIMLAB_REC_MAGIC            "AIMLREC"       // 8 bytes including '\0'
+#define AIMLAB_REC_VERSION          4
+#define AIMLAB_REC_HEADER_BYTES     4096
+#define AIMLAB_REC_BLOCK_BYTES      4096
+
+/**
+ * @brief Raw device state as read by one updateFromDevice() call
+ */
+struct HapticSample {
+    double position[3];                 // getPosition()            (device frame, m)
+    double rotation[9];                 // getRotation()            (row-major)
+    double linearVelocity[3];           // getLinearVelocity()      (m/s)
+    double angularVelocity[3];          // getAngularVelocity()     (rad/s)
+    double gripperAngle;                // getGripperAngleRad()
+    double gripperAngularVelocity;      // getGripperAngularVelocity()
+    uint32_t userSwitches;              // getUserSwitches()
+    uint32_t reserved;
+};
+
+/**
+ * @brief One haptic tick in memory (absolute timestamp)
+ */
+struct HapticRecord {
+    uint64_t timestampNs;               // hapticNowNs() when updateFromDevice() started
+    HapticSample device;
+    double proxyPos[3];                 // tool proxy (world frame)
+    double force[3];                    // setForceAndTorqueAndGripperForce() arguments
+    double torque[3];
+    double gripperForce;
+};
+
+/**
+ * @brief One haptic tick on disk (delta timestamp)
+ */
+struct HapticRecordDisk {
+    uint32_t deltaNs;                   // since previous record, saturates at 4.29 s
+    uint32_t dropped;                   // records lost to a full ring just before this one
+    HapticSample device;
+    double proxyPos[3];
+    double force[3];
+    double torque[3];
+    double gripperForce;
+};
+
+static_assert(sizeof(HapticRecordDisk) == 256, "HapticRecordDisk must stay 256 bytes");
+static_assert(AIMLAB_REC_BLOCK_BYTES % sizeof(HapticRecordDisk) == 0, "records must tile blocks");
+
+// SessionFileHeader::flags
+#define AIMLAB_REC_FLAG_BRIDGE_MOVED 0x1u            // Unity moved objects (motion not recorded)
+#define AIMLAB_REC_FLAG_PRIMITIVE_BATCH 0x2u         // --primitive-batch (replay turns it on)
+#define AIMLAB_REC_FLAG_DEVICE_FILTER 0x4u           // --device-filter (replay uses header.filter)
+
+// SessionDeviceSpec::capabilities
+#define AIMLAB_REC_SENSED_POSITION      0x01u
+#define AIMLAB_REC_SENSED_ROTATION      0x02u
+#define AIMLAB_REC_SENSED_GRIPPER       0x04u
+#define AIMLAB_REC_ACTUATED_POSITION    0x08u
+#define AIMLAB_REC_ACTUATED_ROTATION    0x10u
+#define AIMLAB_REC_ACTUATED_GRIPPER     0x20u
+#define AIMLAB_REC_LEFT_HAND            0x40u
+#define AIMLAB_REC_RIGHT_HAND           0x80u
+
+/**
+ * @brief Recorded device's cHapticDeviceInfo (numeric fields)
+ */
+struct SessionDeviceSpec {
+    double workspaceRadius;
+    double maxLinearForce;
+    double maxAngularTorque;
+    double maxGripperForce;
+    double maxLinearStiffness;
+    double maxAngularStiffness;
+    double maxGripperLinearStiffness;
+    double maxLinearDamping;
+    double maxAngularDamping;
+    double maxGripperAngularDamping;
+    double gripperMaxAngleRad;
+    uint32_t capabilities;              // AIMLAB_REC_SENSED_* | AIMLAB_REC_ACTUATED_* | hands
+    int32_t model;                      // cHapticDeviceModel
+};
+
+/**
+ * @brief Haptic material of the first scene object while recording
+ */
+struct SessionMaterial {
+    double stiffness;                   // N/m
+    double staticFriction;
+    double dynamicFriction;
+    double viscosity;
+};
+
+/**
+ * @brief --device-filter settings while recording (AIMLAB_REC_FLAG_DEVICE_FILTER)
+ *
+ * The device sample in each record is the raw one; the force is the
+ * filtered one.
+ */
+struct SessionFilterSpec {
+    int32_t window;                     // samples in the velocity fit
+    uint32_t passivity;                 // 1 = passivity controller on
+    double horizonS;                    // longest extrapolation
+    double cutoffHz;                    // force low-pass
+    double maxDamping;                  // N.s/m, 0 = the recorded device's maximum
+};
+
+/**
+ * @brief File header (first bytes of the 4 KiB header block)
+ */
+struct SessionFileHeader {
+    char magic[8];                      // AIMLAB_REC_MAGIC
+    uint32_t version;                   // AIMLAB_REC_VERSION
+    uint32_t headerBytes;               // offset of the first record
+    uint32_t recordBytes;               // sizeof(HapticRecordDisk)
+    uint32_t reserved;
+    uint64_t startNs;                   // hapticNowNs() when recording began
+    double nominalRateHz;               // haptic rate (0 = free-running)
+    char deviceModel[64];               // cHapticDeviceInfo::m_modelName
+
+    // Version 2
+    uint32_t flags;                     // AIMLAB_REC_FLAG_*
+    uint32_t reserved2;
+    SessionDeviceSpec device;
+    SessionMaterial material;
+
+    // Version 3
+    char sceneFile[256];                // --scene path as given (empty = built-in scene)
+
+    // Version 4
+    SessionFilterSpec filter;           // valid with AIMLAB_REC_FLAG_DEVICE_FILTER
+};
+
+static_assert(sizeof(SessionFileHeader) <= AIMLAB_REC_HEADER_BYTES, "header must fit its block");
+
+#endif // AIMLAB_HAPTIC_RECORD_H
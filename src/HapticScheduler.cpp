@@ -0,0 +1,245 @@
+/****************************************************************************
+ * AIMLAB - Fixed-Rate Haptic Scheduler
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.2
+ *
+ * Description:
+ *   Implementation of HapticScheduler. See HapticScheduler.h.
+ *
+ * Changelog:
+ *   v1.2 - 16 October 2026 - Overrun and skip counts span restarts
+ *   v1.1 - 16 October 2026 - requestStop() and sliced sleep for bounded shutdown
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "HapticScheduler.h"
+#include "HapticClock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <time.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+using namespace std;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+HapticScheduler::HapticScheduler(const HapticSchedulerConfig& a_config)
+    : m_config(a_config),
+      m_periodNs(0),
+      m_nextDeadlineNs(0),
+      m_overruns(0),
+      m_skipped(0),
+      m_stopRequested(false),
+      m_timer(nullptr) {
+    if (m_config.rateHz > 0.0) {
+        m_periodNs = (uint64_t)(1e9 / m_config.rateHz + 0.5);
+    }
+    if (m_config.spinNs > m_periodNs) {
+        m_config.spinNs = m_periodNs;
+    }
+    if (m_config.maxCatchUpTicks < 1) {
+        m_config.maxCatchUpTicks = 1;
+    }
+}
+
+HapticScheduler::~HapticScheduler() {
+#if defined(_WIN32)
+    if (m_timer != nullptr) {
+        CloseHandle((HANDLE)m_timer);
+    }
+#endif
+}
+
+bool parseOverrunPolicy(const string& a_text, HapticOverrunPolicy& a_policy) {
+    if (a_text == "skip") {
+        a_policy = OVERRUN_SKIP;
+        return true;
+    }
+    if (a_text == "catch-up") {
+        a_policy = OVERRUN_CATCH_UP;
+        return true;
+    }
+    return false;
+}
+
+//===========================================================================
+// THREAD CONFIGURATION
+//===========================================================================
+
+bool HapticScheduler::configureCurrentThread(string& a_message) {
+    bool ok = true;
+    char text[256];
+    int used = 0;
+
+    if (isFreeRunning()) {
+        used = snprintf(text, sizeof(text), "free-running");
+    } else {
+        used = snprintf(text, sizeof(text), "%.0f Hz (%s, spin %llu us)",
+                        m_config.rateHz,
+                        (m_config.overrun == OVERRUN_SKIP) ? "skip" : "catch-up",
+                        (unsigned long long)(m_config.spinNs / 1000));
+    }
+
+#if defined(_WIN32)
+    if (m_config.realtime) {
+        if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+            used += snprintf(text + used, sizeof(text) - used, ", TIME_CRITICAL");
+        } else {
+            used += snprintf(text + used, sizeof(text) - used, ", TIME_CRITICAL failed");
+            ok = false;
+        }
+    }
+    if (m_config.cpu >= 0) {
+        const DWORD_PTR mask = (DWORD_PTR)1 << m_config.cpu;
+        if (m_config.cpu < (int)(sizeof(DWORD_PTR) * 8) &&
+            SetThreadAffinityMask(GetCurrentThread(), mask) != 0) {
+            used += snprintf(text + used, sizeof(text) - used, ", pinned to CPU %d", m_config.cpu);
+        } else {
+            used += snprintf(text + used, sizeof(text) - used, ", CPU %d affinity failed", m_config.cpu);
+            ok = false;
+        }
+    }
+#else
+    if (m_config.realtime) {
+        sched_param param;
+        param.sched_priority = m_config.realtimePriority;
+        const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err == 0) {
+            used += snprintf(text + used, sizeof(text) - used, ", SCHED_FIFO %d",
+                             m_config.realtimePriority);
+        } else {
+            used += snprintf(text + used, sizeof(text) - used, ", SCHED_FIFO failed (%s)",
+                             strerror(err));
+            ok = false;
+        }
+    }
+#if defined(__linux__)
+    if (m_config.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(m_config.cpu, &set);
+        const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err == 0) {
+            used += snprintf(text + used, sizeof(text) - used, ", pinned to CPU %d", m_config.cpu);
+        } else {
+            used += snprintf(text + used, sizeof(text) - used, ", CPU %d affinity failed (%s)",
+                             m_config.cpu, strerror(err));
+            ok = false;
+        }
+    }
+#else
+    if (m_config.cpu >= 0) {
+        used += snprintf(text + used, sizeof(text) - used, ", CPU affinity unsupported");
+        ok = false;
+    }
+#endif
+#endif
+
+    a_message = text;
+    return ok;
+}
+
+//===========================================================================
+// PACING
+//===========================================================================
+
+void HapticScheduler::start(uint64_t a_nowNs) {
+    m_nextDeadlineNs = a_nowNs;
+    m_stopRequested.store(false);
+}
+
+void HapticScheduler::sleepUntil(uint64_t a_deadlineNs) {
+#if defined(__linux__)
+    // hapticNowNs() is steady_clock, i.e. CLOCK_MONOTONIC
+    timespec ts;
+    ts.tv_sec = (time_t)(a_deadlineNs / 1000000000ull);
+    ts.tv_nsec = (long)(a_deadlineNs % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#elif defined(_WIN32)
+    // High-resolution waitable timer (Windows 10 1803+); Sleep() granularity
+    // is ~1 ms, so without it leave the remainder to the spin
+    const uint64_t now = hapticNowNs();
+    if (a_deadlineNs <= now) {
+        return;
+    }
+    if (m_timer == nullptr) {
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0x00000002 /* HIGH_RESOLUTION */,
+                                         TIMER_ALL_ACCESS);
+    }
+    if (m_timer != nullptr) {
+        LARGE_INTEGER due;
+        due.QuadPart = -(LONGLONG)((a_deadlineNs - now) / 100);     // relative, 100 ns units
+        if (SetWaitableTimer((HANDLE)m_timer, &due, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject((HANDLE)m_timer, INFINITE);
+        }
+    } else if (a_deadlineNs - now > 2000000) {
+        Sleep((DWORD)((a_deadlineNs - now) / 1000000) - 1);
+    }
+#else
+    const uint64_t now = hapticNowNs();
+    if (a_deadlineNs > now) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(a_deadlineNs - now));
+    }
+#endif
+}
+
+uint64_t HapticScheduler::waitForNextTick() {
+    if (isFreeRunning()) {
+        return 0;
+    }
+
+    uint64_t now = hapticNowNs();
+    const uint64_t deadline = m_nextDeadlineNs;
+
+    if (now < deadline) {
+        // Coarse sleep in slices (so requestStop() is seen), then spin the
+        // last stretch
+        const uint64_t wake = deadline - m_config.spinNs;
+        while (now < wake) {
+            if (m_stopRequested.load(std::memory_order_acquire)) {
+                return 0;
+            }
+            sleepUntil(std::min(wake, now + (uint64_t)AIMLAB_SCHEDULER_SLEEP_SLICE_NS));
+            now = hapticNowNs();
+        }
+        do {
+            now = hapticNowNs();
+        } while (now < deadline);
+        m_nextDeadlineNs = deadline + m_periodNs;
+        return now - deadline;
+    }
+
+    // Previous tick ran past this deadline
+    const uint64_t behind = (now - deadline) / m_periodNs;
+    if (behind > 0) {
+        m_overruns++;
+    }
+
+    if (m_config.overrun == OVERRUN_CATCH_UP && behind < (uint64_t)m_config.maxCatchUpTicks) {
+        // Run immediately; following deadlines stay on the original grid
+        m_nextDeadlineNs = deadline + m_periodNs;
+    } else {
+        // Drop missed deadlines and re-align to the grid
+        m_skipped += behind;
+        m_nextDeadlineNs = deadline + (behind + 1) * m_periodNs;
+    }
+    return now - deadline;
+}
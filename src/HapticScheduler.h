@@ -0,0 +1,138 @@
+/****************************************************************************
+ * AIMLAB - Fixed-Rate Haptic Scheduler
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.2
+ *
+ * Description:
+ *   Paces the haptic thread at a fixed rate (typically 1, 2 or 4 kHz)
+ *   instead of letting it spin as fast as the machine allows.
+ *
+ *   Each tick has an absolute deadline (start + n * period). The thread
+ *   sleeps until shortly before the deadline (clock_nanosleep with
+ *   TIMER_ABSTIME on Linux) and then spins for the final spinNs to absorb
+ *   the OS wake-up latency. Absolute deadlines mean sleep error does not
+ *   accumulate into drift.
+ *
+ *   When a tick runs past the next deadline the overrun policy decides:
+ *     - SKIP:     drop the missed deadlines and re-align to the next one
+ *                 in the future (constant rate, lost ticks)
+ *     - CATCH_UP: run the missed ticks back-to-back until the schedule is
+ *                 met again (constant tick count, burst after a stall),
+ *                 bounded by maxCatchUpTicks before re-aligning
+ *
+ *   Optionally the haptic thread is moved to SCHED_FIFO and/or pinned to
+ *   one core (Linux), or given TIME_CRITICAL priority and an affinity
+ *   mask (Windows).
+ *
+ *   rateHz = 0 keeps the original free-running busy loop.
+ *
+ *   requestStop() (any thread) makes a pending waitForNextTick() return
+ *   early. The coarse sleep is taken in slices of at most
+ *   AIMLAB_SCHEDULER_SLEEP_SLICE_NS so a slow loop (e.g. a 150 Hz
+ *   simulation thread) sees the request within about a millisecond; at
+ *   1 kHz and above the sleep is shorter than one slice anyway.
+ *
+ * Changelog:
+ *   v1.2 - 16 October 2026 - Overrun and skip counts span restarts
+ *   v1.1 - 16 October 2026 - requestStop() and sliced sleep for bounded shutdown
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_SCHEDULER_H
+#define AIMLAB_HAPTIC_SCHEDULER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#define AIMLAB_SCHEDULER_SLEEP_SLICE_NS     1000000     // longest uninterrupted sleep
+
+enum HapticOverrunPolicy {
+    OVERRUN_SKIP = 0,
+    OVERRUN_CATCH_UP
+};
+
+struct HapticSchedulerConfig {
+    double rateHz = 0.0;                    // 0 = free-running busy loop
+    uint64_t spinNs = 50000;                // final busy-wait before each deadline
+    HapticOverrunPolicy overrun = OVERRUN_SKIP;
+    int maxCatchUpTicks = 10;               // CATCH_UP backlog before re-aligning
+    bool realtime = false;                  // SCHED_FIFO / TIME_CRITICAL
+    int realtimePriority = 80;              // SCHED_FIFO priority (1-99)
+    int cpu = -1;                           // core to pin to, -1 = no affinity
+};
+
+class HapticScheduler {
+public:
+    explicit HapticScheduler(const HapticSchedulerConfig& a_config = HapticSchedulerConfig());
+    ~HapticScheduler();
+
+    HapticScheduler(const HapticScheduler&) = delete;
+    HapticScheduler& operator=(const HapticScheduler&) = delete;
+
+    /**
+     * @brief Apply real-time priority and core affinity to the calling thread
+     *
+     * Call once from the haptic thread before the loop. Failures (e.g. no
+     * CAP_SYS_NICE for SCHED_FIFO) are reported in a_message and are not
+     * fatal: the loop still runs with normal scheduling.
+     *
+     * @param a_message Receives a one-line description of what was applied
+     * @return false if any requested setting could not be applied
+     */
+    bool configureCurrentThread(std::string& a_message);
+
+    /**
+     * @brief Set the first deadline and clear requestStop(); call right
+     *        before entering the loop
+     */
+    void start(uint64_t a_nowNs);
+
+    /**
+     * @brief Block until the next tick's deadline
+     *
+     * Returns immediately in free-running mode, and early (with 0) once
+     * requestStop() has been called; the caller checks its own run flag.
+     *
+     * @return Wake-up lateness (ns after the deadline the call returned)
+     */
+    uint64_t waitForNextTick();
+
+    /**
+     * @brief Make the current and every later waitForNextTick() return
+     *        at once, until the next start() (any thread)
+     */
+    void requestStop() { m_stopRequested.store(true); }
+
+    bool isFreeRunning() const { return m_periodNs == 0; }
+    uint64_t periodNs() const { return m_periodNs; }
+
+    /** @brief Ticks that finished after the following deadline (every start) */
+    uint64_t overruns() const { return m_overruns; }
+
+    /** @brief Deadlines dropped by SKIP or CATCH_UP re-alignment (every start) */
+    uint64_t skippedTicks() const { return m_skipped; }
+
+    const HapticSchedulerConfig& getConfig() const { return m_config; }
+
+private:
+    void sleepUntil(uint64_t a_deadlineNs);
+
+    HapticSchedulerConfig m_config;
+    uint64_t m_periodNs;
+    uint64_t m_nextDeadlineNs;
+    uint64_t m_overruns;
+    uint64_t m_skipped;
+    std::atomic<bool> m_stopRequested;
+    void* m_timer;                  // Windows waitable timer handle
+};
+
+/**
+ * @brief Parse "skip" / "catch-up"
+ */
+bool parseOverrunPolicy(const std::string& a_text, HapticOverrunPolicy& a_policy);
+
+#endif // AIMLAB_HAPTIC_SCHEDULER_H
@@ -0,0 +1,247 @@
+/****************************************************************************
+ * AIMLAB - Haptic Stream Wire Format
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Sample helpers and the UdpSocket wrapper. See HapticStream.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - sendto() result compared without a const cast
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "HapticStream.h"
+
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <sys/select.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+static_assert(sizeof(sockaddr_in) <= 16, "sockaddr_in does not fit UdpSocket::m_address");
+
+//===========================================================================
+// SAMPLES
+//===========================================================================
+
+void hapticStreamSetRotation(HapticStreamSample& a_sample, const double a_rot[9]) {
+    // Shepperd's method: divide by the largest of the four components
+    const double m00 = a_rot[0], m01 = a_rot[1], m02 = a_rot[2];
+    const double m10 = a_rot[3], m11 = a_rot[4], m12 = a_rot[5];
+    const double m20 = a_rot[6], m21 = a_rot[7], m22 = a_rot[8];
+    const double trace = m00 + m11 + m22;
+    double w, x, y, z;
+    if (trace > 0.0) {
+        const double s = 2.0 * sqrt(trace + 1.0);
+        w = 0.25 * s;
+        x = (m21 - m12) / s;
+        y = (m02 - m20) / s;
+        z = (m10 - m01) / s;
+    } else if (m00 > m11 && m00 > m22) {
+        const double s = 2.0 * sqrt(1.0 + m00 - m11 - m22);
+        w = (m21 - m12) / s;
+        x = 0.25 * s;
+        y = (m01 + m10) / s;
+        z = (m02 + m20) / s;
+    } else if (m11 > m22) {
+        const double s = 2.0 * sqrt(1.0 + m11 - m00 - m22);
+        w = (m02 - m20) / s;
+        x = (m01 + m10) / s;
+        y = 0.25 * s;
+        z = (m12 + m21) / s;
+    } else {
+        const double s = 2.0 * sqrt(1.0 + m22 - m00 - m11);
+        w = (m10 - m01) / s;
+        x = (m02 + m20) / s;
+        y = (m12 + m21) / s;
+        z = 0.25 * s;
+    }
+    a_sample.deviceRot[0] = (float)w;
+    a_sample.deviceRot[1] = (float)x;
+    a_sample.deviceRot[2] = (float)y;
+    a_sample.deviceRot[3] = (float)z;
+}
+
+int hapticStreamValidate(const void* a_data, size_t a_bytes) {
+    if (a_bytes < sizeof(HapticStreamHeader)) {
+        return -1;
+    }
+    HapticStreamHeader header;
+    memcpy(&header, a_data, sizeof(header));
+    if (header.magic != AIMLAB_STREAM_MAGIC || header.version != AIMLAB_STREAM_VERSION ||
+        header.sampleCount == 0 || header.sampleCount > AIMLAB_STREAM_MAX_BATCH ||
+        a_bytes != sizeof(header) + header.sampleCount * sizeof(HapticStreamSample)) {
+        return -1;
+    }
+    return header.sampleCount;
+}
+
+//===========================================================================
+// UDP SOCKET
+//===========================================================================
+
+#ifdef _WIN32
+/**
+ * @brief Winsock must be started once per process before any socket call
+ */
+static bool startWinsock() {
+    static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+
+static void closeSocket(intptr_t a_socket) {
+    closesocket((SOCKET)a_socket);
+}
+#else
+static void closeSocket(intptr_t a_socket) {
+    ::close((int)a_socket);
+}
+#endif
+
+/**
+ * @brief Resolve an IPv4 address or host name
+ */
+static bool resolveIpv4(const string& a_host, uint16_t a_port, sockaddr_in& a_address,
+                        string& a_error) {
+    memset(&a_address, 0, sizeof(a_address));
+    a_address.sin_family = AF_INET;
+    a_address.sin_port = htons(a_port);
+    if (inet_pton(AF_INET, a_host.c_str(), &a_address.sin_addr) == 1) {
+        return true;
+    }
+
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(a_host.c_str(), nullptr, &hints, &result) != 0 || result == nullptr) {
+        a_error = "cannot resolve " + a_host;
+        return false;
+    }
+    a_address.sin_addr = ((const sockaddr_in*)result->ai_addr)->sin_addr;
+    freeaddrinfo(result);
+    return true;
+}
+
+UdpSocket::UdpSocket()
+    : m_socket(INVALID) {
+    memset(m_address, 0, sizeof(m_address));
+}
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+bool UdpSocket::openSender(const string& a_host, uint16_t a_port, string& a_error) {
+    close();
+#ifdef _WIN32
+    if (!startWinsock()) {
+        a_error = "WSAStartup failed";
+        return false;
+    }
+#endif
+    sockaddr_in address;
+    if (!resolveIpv4(a_host, a_port, address, a_error)) {
+        return false;
+    }
+    m_socket = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_socket == INVALID) {
+        a_error = "cannot create a UDP socket";
+        return false;
+    }
+    memcpy(m_address, &address, sizeof(address));
+    return true;
+}
+
+bool UdpSocket::openReceiver(const string& a_bindAddress, uint16_t a_port, string& a_error) {
+    close();
+#ifdef _WIN32
+    if (!startWinsock()) {
+        a_error = "WSAStartup failed";
+        return false;
+    }
+#endif
+    sockaddr_in address;
+    if (!resolveIpv4(a_bindAddress, a_port, address, a_error)) {
+        return false;
+    }
+    m_socket = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_socket == INVALID) {
+        a_error = "cannot create a UDP socket";
+        return false;
+    }
+
+    // Room for bursts while the reader is descheduled
+    const int bufferBytes = 1 << 20;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, (const char*)&bufferBytes, sizeof(bufferBytes));
+
+    if (bind(m_socket, (const sockaddr*)&address, sizeof(address)) != 0) {
+        a_error = "cannot bind UDP port " + to_string(a_port) + " on " + a_bindAddress;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void UdpSocket::close() {
+    if (m_socket != INVALID) {
+        closeSocket(m_socket);
+        m_socket = INVALID;
+    }
+}
+
+bool UdpSocket::send(const void* a_data, size_t a_bytes) {
+    if (m_socket == INVALID) {
+        return false;
+    }
+#ifdef _WIN32
+    const int sent = sendto(m_socket, (const char*)a_data, (int)a_bytes, 0,
+                            (const sockaddr*)m_address, sizeof(sockaddr_in));
+    return sent == (int)a_bytes;
+#else
+    const ssize_t sent = sendto(m_socket, (const char*)a_data, (int)a_bytes, 0,
+                                (const sockaddr*)m_address, sizeof(sockaddr_in));
+    return sent == (ssize_t)a_bytes;
+#endif
+}
+
+int UdpSocket::receive(void* a_buffer, size_t a_size, int a_timeoutMs) {
+    if (m_socket == INVALID) {
+        return -1;
+    }
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(m_socket, &readable);
+    timeval timeout;
+    timeout.tv_sec = a_timeoutMs / 1000;
+    timeout.tv_usec = (a_timeoutMs % 1000) * 1000;
+    const int ready = select((int)m_socket + 1, &readable, nullptr, nullptr, &timeout);
+    if (ready < 0) {
+        return -1;
+    }
+    if (ready == 0) {
+        return 0;
+    }
+    const auto received = recv(m_socket, (char*)a_buffer, (int)a_size, 0);
+    return (received < 0) ? -1 : (int)received;
+}
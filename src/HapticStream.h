@@ -0,0 +1,146 @@
+/****************************************************************************
+ * AIMLAB - Haptic Stream Wire Format
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   UDP datagrams carrying tool state to a remote machine (--stream).
+ *   The shared-memory bridge only reaches Unity on the same host; this
+ *   stream reaches it anywhere on the network. Each datagram is one
+ *   HapticStreamHeader followed by sampleCount HapticStreamSample
+ *   records, packed back to back with no padding between them. At most
+ *   AIMLAB_STREAM_MAX_BATCH samples fit in one datagram, and the largest
+ *   datagram (1176 bytes) fits an Ethernet MTU without IP fragmentation.
+ *
+ *   The layout is fixed: little-endian (every supported target), IEEE
+ *   float/double, and offsets asserted below, so a C# reader can take the
+ *   bytes as they are. sequence counts datagrams per publisher; a
+ *   subscriber counts the gaps as lost datagrams. Timestamps are the
+ *   sender's hapticNowNs() (monotonic). They compare with the receiver's
+ *   clock only on the same host.
+ *
+ *   UdpSocket is the small IPv4 socket wrapper the publisher and the
+ *   subscriber share (POSIX sockets or Winsock).
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_STREAM_H
+#define AIMLAB_HAPTIC_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define AIMLAB_STREAM_MAGIC         0x534D4941u     // "AIMS" little-endian
+#define AIMLAB_STREAM_VERSION       1u
+#define AIMLAB_STREAM_MAX_BATCH     16              // samples per datagram
+#define AIMLAB_STREAM_DEFAULT_PORT  27300
+
+/**
+ * @brief Where and how often HapticStreamPublisher sends (--stream options)
+ */
+struct HapticStreamConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = AIMLAB_STREAM_DEFAULT_PORT;
+    double rateHz = 250.0;                  // samples per second per device
+    int batch = 4;                          // samples per datagram (1..AIMLAB_STREAM_MAX_BATCH)
+};
+
+/**
+ * @brief Start of every datagram (24 bytes)
+ */
+struct HapticStreamHeader {
+    uint32_t magic;                     // AIMLAB_STREAM_MAGIC
+    uint16_t version;                   // AIMLAB_STREAM_VERSION
+    uint16_t sampleCount;               // 1..AIMLAB_STREAM_MAX_BATCH
+    uint32_t sequence;                  // datagram number, +1 per datagram from 0
+    uint32_t dropped;                   // samples the publisher lost to a full queue so far
+    uint64_t sendNs;                    // sender's hapticNowNs() just before sending
+};
+
+/**
+ * @brief Tool state of one haptic tick (72 bytes)
+ */
+struct HapticStreamSample {
+    uint64_t timestampNs;               // sender's hapticNowNs() at the tick
+    uint64_t tick;                      // the device's haptic tick number
+    float devicePos[3];                 // world frame (m)
+    float deviceRot[4];                 // device orientation, unit quaternion w, x, y, z
+    float proxyPos[3];                  // world frame (m)
+    float force[3];                     // world frame (N)
+    uint16_t device;                    // device index (--devices)
+    uint16_t reserved;                  // 0
+};
+
+static_assert(sizeof(HapticStreamHeader) == 24, "stream header layout changed");
+static_assert(sizeof(HapticStreamSample) == 72, "stream sample layout changed");
+static_assert(offsetof(HapticStreamSample, devicePos) == 16, "stream sample layout changed");
+static_assert(offsetof(HapticStreamSample, device) == 68, "stream sample layout changed");
+
+#define AIMLAB_STREAM_MAX_DATAGRAM \
+    (sizeof(HapticStreamHeader) + AIMLAB_STREAM_MAX_BATCH * sizeof(HapticStreamSample))
+
+/**
+ * @brief Fill a sample's orientation from a row-major rotation matrix
+ */
+void hapticStreamSetRotation(HapticStreamSample& a_sample, const double a_rot[9]);
+
+/**
+ * @brief Check a received datagram
+ *
+ * @return Number of samples, or -1 if the bytes are not a valid datagram
+ */
+int hapticStreamValidate(const void* a_data, size_t a_bytes);
+
+//===========================================================================
+// UDP SOCKET
+//===========================================================================
+
+class UdpSocket {
+public:
+    UdpSocket();
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    /**
+     * @brief Create a socket that sends to a_host:a_port
+     *
+     * @param a_host IPv4 address or host name
+     */
+    bool openSender(const std::string& a_host, uint16_t a_port, std::string& a_error);
+
+    /**
+     * @brief Create a socket bound to a_bindAddress:a_port
+     *
+     * @param a_bindAddress IPv4 address, "0.0.0.0" for every interface
+     */
+    bool openReceiver(const std::string& a_bindAddress, uint16_t a_port, std::string& a_error);
+
+    void close();
+    bool isOpen() const { return m_socket != INVALID; }
+
+    /** @brief Send one datagram to the openSender() address; false on error */
+    bool send(const void* a_data, size_t a_bytes);
+
+    /**
+     * @brief Wait up to a_timeoutMs for one datagram
+     *
+     * @return Bytes received, 0 on timeout, -1 on error
+     */
+    int receive(void* a_buffer, size_t a_size, int a_timeoutMs);
+
+private:
+    static const intptr_t INVALID = -1;
+
+    intptr_t m_socket;                  // int on POSIX, SOCKET on Windows
+    unsigned char m_address[16];        // sockaddr_in of the destination
+};
+
+#endif // AIMLAB_HAPTIC_STREAM_H
@@ -0,0 +1,142 @@
+/****************************************************************************
+ * AIMLAB - Haptic Stream Publisher
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of HapticStreamPublisher. See HapticStreamPublisher.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "HapticStreamPublisher.h"
+#include "HapticClock.h"
+
+#include <chrono>
+#include <cstring>
+
+using namespace std;
+
+HapticStreamPublisher::HapticStreamPublisher()
+    : m_dropped(0),
+      m_periodNs(0),
+      m_running(false),
+      m_stop(false),
+      m_pending(0),
+      m_oldestNs(0),
+      m_sequence(0),
+      m_startNs(0) {
+}
+
+HapticStreamPublisher::~HapticStreamPublisher() {
+    close();
+}
+
+bool HapticStreamPublisher::open(const HapticStreamConfig& a_config, string& a_error) {
+    close();
+
+    if (a_config.rateHz <= 0.0 || a_config.batch < 1 || a_config.batch > AIMLAB_STREAM_MAX_BATCH) {
+        a_error = "invalid stream rate or batch size";
+        return false;
+    }
+    if (!m_socket.openSender(a_config.host, a_config.port, a_error)) {
+        return false;
+    }
+
+    m_config = a_config;
+    m_periodNs = (uint64_t)(1e9 / a_config.rateHz);
+    for (int i = 0; i < AIMLAB_STREAM_MAX_DEVICES; i++) {
+        m_queues[i].nextDueNs = 0;
+    }
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_pending = 0;
+    m_sequence = 0;
+    m_stats = HapticStreamPublisherStats();
+    m_startNs = hapticNowNs();
+
+    m_stop.store(false, std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&HapticStreamPublisher::run, this);
+    return true;
+}
+
+const HapticStreamPublisherStats& HapticStreamPublisher::close() {
+    if (!m_running.load(std::memory_order_acquire)) {
+        return m_stats;
+    }
+    m_stop.store(true, std::memory_order_release);
+    m_thread.join();
+    m_running.store(false, std::memory_order_release);
+    m_socket.close();
+
+    m_stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    m_stats.seconds = (double)(hapticNowNs() - m_startNs) * 1e-9;
+    return m_stats;
+}
+
+void HapticStreamPublisher::publish(int a_device, HapticStreamSample& a_sample) {
+    a_sample.device = (uint16_t)a_device;
+    a_sample.reserved = 0;
+    if (!m_queues[a_device].ring.tryPush(a_sample)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//===========================================================================
+// I/O THREAD
+//===========================================================================
+
+void HapticStreamPublisher::run() {
+    const uint64_t maxWaitNs = (uint64_t)m_config.batch * m_periodNs;
+    HapticStreamSample* samples = (HapticStreamSample*)(m_datagram + sizeof(HapticStreamHeader));
+
+    for (;;) {
+        // Read the flag before draining, so the last pass sees every sample
+        const bool stopping = m_stop.load(std::memory_order_acquire);
+
+        for (int i = 0; i < AIMLAB_STREAM_MAX_DEVICES; i++) {
+            HapticStreamSample sample;
+            while (m_queues[i].ring.tryPop(sample)) {
+                if (m_pending == 0) {
+                    m_oldestNs = sample.timestampNs;
+                }
+                memcpy(&samples[m_pending++], &sample, sizeof(sample));
+                if (m_pending == m_config.batch) {
+                    sendBatch();
+                }
+            }
+        }
+
+        if (m_pending > 0 && (stopping || hapticNowNs() - m_oldestNs >= maxWaitNs)) {
+            sendBatch();
+        }
+        if (stopping) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void HapticStreamPublisher::sendBatch() {
+    HapticStreamHeader header;
+    header.magic = AIMLAB_STREAM_MAGIC;
+    header.version = AIMLAB_STREAM_VERSION;
+    header.sampleCount = (uint16_t)m_pending;
+    header.sequence = m_sequence++;
+    header.dropped = (uint32_t)m_dropped.load(std::memory_order_relaxed);
+    header.sendNs = hapticNowNs();
+    memcpy(m_datagram, &header, sizeof(header));
+
+    const size_t bytes = sizeof(header) + (size_t)m_pending * sizeof(HapticStreamSample);
+    if (m_socket.send(m_datagram, bytes)) {
+        m_stats.datagrams++;
+        m_stats.samples += (uint64_t)m_pending;
+    } else {
+        m_stats.sendErrors++;
+    }
+    m_pending = 0;
+}
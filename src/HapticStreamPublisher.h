@@ -0,0 +1,135 @@
+/****************************************************************************
+ * AIMLAB - Haptic Stream Publisher
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Streams tool state over UDP (format in HapticStream.h) without a
+ *   system call on the haptic thread.
+ *
+ *   Each haptic thread asks sampleDue() every tick. That returns true at
+ *   the stream rate (--stream-rate), independent of the haptic rate. When
+ *   it does, the thread fills a HapticStreamSample and publish()es it into
+ *   its device's SpscRing; both calls only touch memory. An I/O thread
+ *   wakes every millisecond, moves queued samples into a datagram and
+ *   sends it once it holds --stream-batch samples, or once its oldest
+ *   sample has waited a full batch period (so a partial batch still goes
+ *   out if the haptic loop stalls). A full ring drops the sample; the
+ *   count goes out in every datagram header.
+ *
+ *   The per-device rings are over-aligned, so the publisher lives in
+ *   static storage like SessionRecorder. sampleDue() and publish() for
+ *   device i belong to device i's haptic thread; open() and close() to
+ *   the thread that owns the publisher.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_STREAM_PUBLISHER_H
+#define AIMLAB_HAPTIC_STREAM_PUBLISHER_H
+
+#include "HapticStream.h"
+#include "SpscRing.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#define AIMLAB_STREAM_MAX_DEVICES       4       // matches AIMLAB_MAX_HAPTIC_DEVICES
+#define AIMLAB_STREAM_QUEUE_SAMPLES     1024    // per device, about 1 s at 1 kHz
+
+/**
+ * @brief Totals reported by HapticStreamPublisher::close()
+ */
+struct HapticStreamPublisherStats {
+    uint64_t samples = 0;                   // samples sent
+    uint64_t datagrams = 0;
+    uint64_t dropped = 0;                   // samples lost to a full ring
+    uint64_t sendErrors = 0;                // datagrams the socket refused
+    double seconds = 0.0;                   // open() to close()
+};
+
+class HapticStreamPublisher {
+public:
+    HapticStreamPublisher();
+    ~HapticStreamPublisher();
+
+    HapticStreamPublisher(const HapticStreamPublisher&) = delete;
+    HapticStreamPublisher& operator=(const HapticStreamPublisher&) = delete;
+
+    /**
+     * @brief Create the socket and start the I/O thread
+     */
+    bool open(const HapticStreamConfig& a_config, std::string& a_error);
+
+    /**
+     * @brief Send what is queued, stop the I/O thread and close the socket
+     */
+    const HapticStreamPublisherStats& close();
+
+    bool isOpen() const { return m_running.load(std::memory_order_acquire); }
+    const HapticStreamConfig& config() const { return m_config; }
+
+    //-----------------------------------------------------------------------
+    // Haptic thread of device a_device
+    //-----------------------------------------------------------------------
+
+    /**
+     * @brief true if the device should publish a sample at this tick
+     *
+     * Advances the device's next due time by one stream period (or to
+     * a_nowNs after a stall, without a burst of catch-up samples).
+     */
+    bool sampleDue(int a_device, uint64_t a_nowNs) {
+        DeviceQueue& queue = m_queues[a_device];
+        if (!isOpen() || a_nowNs < queue.nextDueNs) {
+            return false;
+        }
+        queue.nextDueNs += m_periodNs;
+        if (queue.nextDueNs <= a_nowNs) {
+            queue.nextDueNs = a_nowNs + m_periodNs;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Queue one sample (sets its device field); never blocks
+     */
+    void publish(int a_device, HapticStreamSample& a_sample);
+
+private:
+    void run();
+    void sendBatch();
+
+    struct DeviceQueue {
+        DeviceQueue() : ring(AIMLAB_STREAM_QUEUE_SAMPLES) {}
+
+        SpscRing<HapticStreamSample> ring;
+        uint64_t nextDueNs = 0;             // producer only
+    };
+
+    DeviceQueue m_queues[AIMLAB_STREAM_MAX_DEVICES];
+    std::atomic<uint64_t> m_dropped;
+
+    HapticStreamConfig m_config;
+    uint64_t m_periodNs;
+    UdpSocket m_socket;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_stop;
+
+    // I/O thread only
+    alignas(8) unsigned char m_datagram[AIMLAB_STREAM_MAX_DATAGRAM];
+    int m_pending;                          // samples in m_datagram
+    uint64_t m_oldestNs;                    // timestamp of its first sample
+    uint32_t m_sequence;
+
+    uint64_t m_startNs;
+    HapticStreamPublisherStats m_stats;
+};
+
+#endif // AIMLAB_HAPTIC_STREAM_PUBLISHER_H
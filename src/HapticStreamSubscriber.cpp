@@ -0,0 +1,85 @@
+/****************************************************************************
+ * AIMLAB - Haptic Stream Subscriber
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of HapticStreamSubscriber. See HapticStreamSubscriber.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Loss accounting starts at the first datagram received
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "HapticStreamSubscriber.h"
+#include "HapticClock.h"
+
+#include <cstring>
+
+using namespace std;
+
+HapticStreamSubscriber::HapticStreamSubscriber()
+    : m_haveSequence(false),
+      m_nextSequence(0) {
+}
+
+bool HapticStreamSubscriber::open(uint16_t a_port, string& a_error, const string& a_bindAddress) {
+    m_haveSequence = false;
+    m_nextSequence = 0;
+    m_stats = HapticStreamSubscriberStats();
+    return m_socket.openReceiver(a_bindAddress, a_port, a_error);
+}
+
+void HapticStreamSubscriber::close() {
+    m_socket.close();
+}
+
+bool HapticStreamSubscriber::receive(HapticStreamPacket& a_packet, int a_timeoutMs) {
+    alignas(8) unsigned char datagram[AIMLAB_STREAM_MAX_DATAGRAM + 1];     // +1: oversize shows
+
+    for (;;) {
+        const int bytes = m_socket.receive(datagram, sizeof(datagram), a_timeoutMs);
+        if (bytes <= 0) {
+            return false;
+        }
+        const uint64_t receiveNs = hapticNowNs();
+        const int count = hapticStreamValidate(datagram, (size_t)bytes);
+        if (count < 0) {
+            m_stats.malformed++;
+            continue;
+        }
+
+        memcpy(&a_packet.header, datagram, sizeof(a_packet.header));
+        memcpy(a_packet.samples, datagram + sizeof(a_packet.header),
+               (size_t)count * sizeof(HapticStreamSample));
+        a_packet.receiveNs = receiveNs;
+
+        // Signed distance survives the 32-bit wrap
+        const uint32_t sequence = a_packet.header.sequence;
+        if (!m_haveSequence) {
+            // Counting starts here: a subscriber that joins a running
+            // stream has not lost the datagrams sent before it
+            m_haveSequence = true;
+            m_nextSequence = sequence + 1;
+        } else {
+            const int32_t ahead = (int32_t)(sequence - m_nextSequence);
+            if (ahead >= 0) {
+                m_stats.lost += (uint64_t)ahead;
+                m_nextSequence = sequence + 1;
+            } else {
+                m_stats.reordered++;
+                if (m_stats.lost > 0) {
+                    m_stats.lost--;             // counted as lost when it was skipped
+                }
+            }
+        }
+
+        m_stats.datagrams++;
+        m_stats.samples += (uint64_t)count;
+        m_stats.publisherDropped = a_packet.header.dropped;
+        return true;
+    }
+}
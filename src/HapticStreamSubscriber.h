@@ -0,0 +1,82 @@
+/****************************************************************************
+ * AIMLAB - Haptic Stream Subscriber
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Receiving end of the --stream datagrams (format in HapticStream.h),
+ *   for C++ clients and bench-stream. receive() waits for one datagram,
+ *   rejects anything malformed and keeps loss statistics from the
+ *   datagram sequence numbers, from the first datagram received on: a
+ *   jump forward counts the skipped datagrams as lost, and an older
+ *   number counts as reordered (its samples are still returned; the
+ *   caller decides).
+ *
+ *   One thread at a time. No CHAI3D dependency.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Loss accounting starts at the first datagram received
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HAPTIC_STREAM_SUBSCRIBER_H
+#define AIMLAB_HAPTIC_STREAM_SUBSCRIBER_H
+
+#include "HapticStream.h"
+
+#include <string>
+
+/**
+ * @brief One received datagram
+ */
+struct HapticStreamPacket {
+    HapticStreamHeader header;
+    HapticStreamSample samples[AIMLAB_STREAM_MAX_BATCH];    // header.sampleCount valid
+    uint64_t receiveNs;                 // hapticNowNs() when receive() got it
+};
+
+struct HapticStreamSubscriberStats {
+    uint64_t datagrams = 0;             // valid datagrams received
+    uint64_t samples = 0;
+    uint64_t lost = 0;                  // datagrams skipped in the sequence
+    uint64_t reordered = 0;             // datagrams older than one already received
+    uint64_t malformed = 0;             // rejected by hapticStreamValidate()
+    uint32_t publisherDropped = 0;      // latest header.dropped
+};
+
+class HapticStreamSubscriber {
+public:
+    HapticStreamSubscriber();
+
+    HapticStreamSubscriber(const HapticStreamSubscriber&) = delete;
+    HapticStreamSubscriber& operator=(const HapticStreamSubscriber&) = delete;
+
+    /**
+     * @param a_bindAddress Local IPv4 address, "0.0.0.0" for every interface
+     */
+    bool open(uint16_t a_port, std::string& a_error,
+              const std::string& a_bindAddress = "0.0.0.0");
+
+    void close();
+    bool isOpen() const { return m_socket.isOpen(); }
+
+    /**
+     * @brief Wait up to a_timeoutMs for the next valid datagram
+     *
+     * @return false on timeout or socket error
+     */
+    bool receive(HapticStreamPacket& a_packet, int a_timeoutMs);
+
+    const HapticStreamSubscriberStats& stats() const { return m_stats; }
+
+private:
+    UdpSocket m_socket;
+    bool m_haveSequence;
+    uint32_t m_nextSequence;            // expected next header.sequence
+    HapticStreamSubscriberStats m_stats;
+};
+
+#endif // AIMLAB_HAPTIC_STREAM_SUBSCRIBER_H
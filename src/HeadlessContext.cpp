@@ -0,0 +1,157 @@
+/****************************************************************************
+ * AIMLAB - Headless OpenGL Context
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of HeadlessContext. See HeadlessContext.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "chai3d.h"
+#include "HeadlessContext.h"
+
+#ifdef AIMLAB_HAVE_EGL
+    #include <EGL/egl.h>
+    #include <EGL/eglext.h>
+    #include <cstring>
+#endif
+
+using namespace std;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+HeadlessContext::HeadlessContext()
+    : m_display(nullptr),
+      m_context(nullptr) {
+}
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+//===========================================================================
+// CONTEXT
+//===========================================================================
+
+#ifdef AIMLAB_HAVE_EGL
+
+static EGLDisplay openDisplay() {
+    // Surfaceless platform: no window system, works on llvmpipe
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (extensions != nullptr && strstr(extensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay != nullptr) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                                    EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) {
+                return display;
+            }
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool HeadlessContext::create(string& a_error) {
+    destroy();
+
+    EGLDisplay display = openDisplay();
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        a_error = "no EGL display";
+        return false;
+    }
+    m_display = display;
+
+    // Surfaceless rendering needs EGL_KHR_surfaceless_context
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (extensions == nullptr || strstr(extensions, "EGL_KHR_surfaceless_context") == nullptr) {
+        a_error = "EGL_KHR_surfaceless_context not supported";
+        destroy();
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        a_error = "desktop OpenGL not available through EGL";
+        destroy();
+        return false;
+    }
+
+    // EGL_SURFACE_TYPE defaults to EGL_WINDOW_BIT, which surfaceless displays lack
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        a_error = "no EGL config with OpenGL support";
+        destroy();
+        return false;
+    }
+
+    // Compatibility profile: CHAI3D renders with the fixed-function pipeline
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+    if (context == EGL_NO_CONTEXT) {
+        a_error = "eglCreateContext failed";
+        destroy();
+        return false;
+    }
+    m_context = context;
+
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        a_error = "eglMakeCurrent failed";
+        destroy();
+        return false;
+    }
+
+#ifdef GLEW_VERSION
+    // cFrameBuffer reaches the FBO entry points through GLEW
+    glewExperimental = GL_TRUE;
+    glewInit();
+#endif
+
+    return true;
+}
+
+void HeadlessContext::destroy() {
+    if (m_display == nullptr) {
+        return;
+    }
+    EGLDisplay display = (EGLDisplay)m_display;
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_context != nullptr) {
+        eglDestroyContext(display, (EGLContext)m_context);
+    }
+    eglTerminate(display);
+    m_context = nullptr;
+    m_display = nullptr;
+}
+
+#else
+
+bool HeadlessContext::create(string& a_error) {
+    a_error = "built without EGL (headless rendering needs Linux + libEGL)";
+    return false;
+}
+
+void HeadlessContext::destroy() {
+}
+
+#endif
+
+string HeadlessContext::getRenderer() const {
+    if (m_context == nullptr) {
+        return string();
+    }
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    return renderer ? string((const char*)renderer) : string();
+}
@@ -0,0 +1,57 @@
+/****************************************************************************
+ * AIMLAB - Headless OpenGL Context
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Window-less OpenGL context for render-farm nodes and CI. Uses EGL with
+ *   the Mesa surfaceless platform (EGL_MESA_platform_surfaceless), which
+ *   works without X11, Wayland or a GPU (llvmpipe), and falls back to the
+ *   default EGL display. There is no default framebuffer; the application
+ *   renders through a cFrameBuffer (FBO) instead of glutSwapBuffers().
+ *
+ *   Available when built with EGL (AIMLAB_HAVE_EGL, Linux). Elsewhere
+ *   create() fails with a message and the caller falls back.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_HEADLESS_CONTEXT_H
+#define AIMLAB_HEADLESS_CONTEXT_H
+
+#include <string>
+
+class HeadlessContext {
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    /**
+     * @brief Create a desktop OpenGL context and make it current
+     *
+     * @param a_error Receives the reason on failure
+     * @return true if a context is current on the calling thread
+     */
+    bool create(std::string& a_error);
+
+    /** @brief Release the context (also done by the destructor) */
+    void destroy();
+
+    bool isCreated() const { return m_context != nullptr; }
+
+    /** @brief GL_RENDERER of the current context (e.g. "llvmpipe") */
+    std::string getRenderer() const;
+
+private:
+    void* m_display;                // EGLDisplay
+    void* m_context;                // EGLContext
+};
+
+#endif // AIMLAB_HEADLESS_CONTEXT_H
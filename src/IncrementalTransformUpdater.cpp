@@ -0,0 +1,96 @@
+/****************************************************************************
+ * AIMLAB - Incremental Scene Graph Transform Update
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of IncrementalTransformUpdater.
+ *   See IncrementalTransformUpdater.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "IncrementalTransformUpdater.h"
+
+#include <algorithm>
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+IncrementalTransformUpdater::IncrementalTransformUpdater(cGenericObject* a_root, size_t a_capacity)
+    : m_root(a_root),
+      m_fullPending(true),
+      m_lastCount(0),
+      m_fullUpdates(0) {
+    m_dirty.reserve(a_capacity > 0 ? a_capacity : 1);
+}
+
+void IncrementalTransformUpdater::markAlwaysDirty(cGenericObject* a_object) {
+    if (find(m_alwaysDirty.begin(), m_alwaysDirty.end(), a_object) == m_alwaysDirty.end()) {
+        m_alwaysDirty.push_back(a_object);
+    }
+}
+
+//===========================================================================
+// UPDATE
+//===========================================================================
+
+bool IncrementalTransformUpdater::hasDirtyAncestor(const cGenericObject* a_object) const {
+    // m_dirty is sorted; scene depth is small, so walking up is cheap
+    for (cGenericObject* p = a_object->getParent(); p != nullptr; p = p->getParent()) {
+        if (binary_search(m_dirty.begin(), m_dirty.end(), p)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t IncrementalTransformUpdater::update() {
+    if (m_fullPending) {
+        m_root->computeGlobalPositions(true);
+        m_dirty.clear();
+        m_fullPending = false;
+        m_fullUpdates++;
+        m_lastCount = 1;
+        return m_lastCount;
+    }
+
+    for (size_t i = 0; i < m_alwaysDirty.size(); i++) {
+        markDirty(m_alwaysDirty[i]);
+    }
+    if (m_fullPending) {
+        return update();
+    }
+
+    // Deduplicate, then recompute only the top-most dirty subtrees
+    sort(m_dirty.begin(), m_dirty.end());
+    m_dirty.erase(unique(m_dirty.begin(), m_dirty.end()), m_dirty.end());
+
+    size_t count = 0;
+    for (size_t i = 0; i < m_dirty.size(); i++) {
+        cGenericObject* object = m_dirty[i];
+        if (hasDirtyAncestor(object)) {
+            continue;
+        }
+
+        cGenericObject* parent = object->getParent();
+        if (parent != nullptr) {
+            object->computeGlobalPositions(true, parent->getGlobalPos(), parent->getGlobalRot());
+        } else {
+            object->computeGlobalPositions(true);
+        }
+        count++;
+    }
+
+    m_dirty.clear();
+    m_lastCount = count;
+    return count;
+}
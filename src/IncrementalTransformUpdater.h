@@ -0,0 +1,92 @@
+/****************************************************************************
+ * AIMLAB - Incremental Scene Graph Transform Update
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Drop-in replacement for world->computeGlobalPositions(true) in the
+ *   haptic loop that only recomputes subtrees whose local transform
+ *   changed since the last tick.
+ *
+ *   CHAI3D objects carry no dirty flag and setLocalPos()/setLocalRot() are
+ *   not observable, so code that moves an object calls markDirty() next to
+ *   the setter. Objects that move every tick (the tool, whose children are
+ *   the proxy/goal spheres) are registered once with markAlwaysDirty().
+ *
+ *   update() sorts the dirty list, drops entries already covered by a
+ *   dirty ancestor, and calls the stock CHAI3D
+ *     obj->computeGlobalPositions(true, parent->getGlobalPos(), parent->getGlobalRot())
+ *   on each remaining subtree root, so the result is identical to a full
+ *   traversal. Cost is O(dirty subtrees) instead of O(scene size).
+ *
+ *   The dirty list has a fixed capacity and never allocates after
+ *   construction; if it overflows, the next update() falls back to one
+ *   full traversal. Single-threaded: mark and update from the haptic thread.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_INCREMENTAL_TRANSFORM_UPDATER_H
+#define AIMLAB_INCREMENTAL_TRANSFORM_UPDATER_H
+
+#include "chai3d.h"
+
+#include <cstddef>
+#include <vector>
+
+class IncrementalTransformUpdater {
+public:
+    /**
+     * @brief Create an updater for the scene graph rooted at a_root
+     *
+     * The first update() is always a full traversal.
+     *
+     * @param a_root     Scene root (normally the cWorld)
+     * @param a_capacity Dirty objects per tick before falling back to a full pass
+     */
+    explicit IncrementalTransformUpdater(chai3d::cGenericObject* a_root, size_t a_capacity = 256);
+
+    /** @brief Object's local transform changed; recompute it and its subtree next update() */
+    void markDirty(chai3d::cGenericObject* a_object) {
+        if (m_dirty.size() < m_dirty.capacity()) {
+            m_dirty.push_back(a_object);
+        } else {
+            m_fullPending = true;
+        }
+    }
+
+    /** @brief Recompute this subtree on every update() (e.g. the tool) */
+    void markAlwaysDirty(chai3d::cGenericObject* a_object);
+
+    /** @brief Force a full traversal on the next update() (scene structure changed) */
+    void invalidateAll() { m_fullPending = true; }
+
+    /**
+     * @brief Bring global transforms up to date
+     *
+     * @return Number of subtrees recomputed (1 for a full traversal)
+     */
+    size_t update();
+
+    /** @brief Subtrees recomputed by the most recent update() */
+    size_t lastSubtreeCount() const { return m_lastCount; }
+
+    /** @brief Full traversals performed (first tick, overflow, invalidateAll) */
+    unsigned long long fullUpdates() const { return m_fullUpdates; }
+
+private:
+    bool hasDirtyAncestor(const chai3d::cGenericObject* a_object) const;
+
+    chai3d::cGenericObject* m_root;
+    std::vector<chai3d::cGenericObject*> m_dirty;        // reserved once, reused
+    std::vector<chai3d::cGenericObject*> m_alwaysDirty;
+    bool m_fullPending;
+    size_t m_lastCount;
+    unsigned long long m_fullUpdates;
+};
+
+#endif // AIMLAB_INCREMENTAL_TRANSFORM_UPDATER_H
@@ -0,0 +1,133 @@
+/****************************************************************************
+ * AIMLAB - Lock-Free Latency Histogram
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of LatencyHistogram. See LatencyHistogram.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "LatencyHistogram.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+//===========================================================================
+// BUCKET MAPPING
+//===========================================================================
+
+static inline int highestBit(uint64_t v) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(v);
+#endif
+}
+
+int LatencyHistogram::bucketIndex(uint64_t ns) {
+    if (ns < (1u << EXACT_BITS)) {
+        return (int)ns;
+    }
+
+    // Keep the top EXACT_BITS bits: mantissa in [32, 64), exponent >= 1
+    int exponent = highestBit(ns) - (EXACT_BITS - 1);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    const int mantissa = (int)(ns >> exponent);
+    return (1 << EXACT_BITS) + (exponent - 1) * SUB_BUCKETS + (mantissa - SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < (1 << EXACT_BITS)) {
+        return (uint64_t)index;
+    }
+
+    const int offset = index - (1 << EXACT_BITS);
+    const int exponent = offset / SUB_BUCKETS + 1;
+    const uint64_t mantissa = (uint64_t)(offset % SUB_BUCKETS + SUB_BUCKETS);
+    return ((mantissa + 1) << exponent) - 1;
+}
+
+//===========================================================================
+// HISTOGRAM
+//===========================================================================
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        m_counts[i].store(0, std::memory_order_relaxed);
+    }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::snapshot(Snapshot& out) const {
+    out.count = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        out.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        out.count += out.counts[i];
+    }
+    out.sum = m_sum.load(std::memory_order_relaxed);
+    out.max = m_max.load(std::memory_order_relaxed);
+}
+
+//===========================================================================
+// SNAPSHOT
+//===========================================================================
+
+uint64_t LatencyHistogram::Snapshot::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    if (q <= 0.0) {
+        q = 0.0;
+    }
+
+    uint64_t rank = (uint64_t)(q * (double)count);
+    if (rank >= count) {
+        rank = count - 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (seen > rank) {
+            const uint64_t upper = bucketUpperBound(i);
+            return (upper < max) ? upper : max;
+        }
+    }
+    return max;
+}
+
+void LatencyHistogram::Snapshot::subtract(const Snapshot& older) {
+    int highest = -1;
+    count = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] -= older.counts[i];
+        count += counts[i];
+        if (counts[i] != 0) {
+            highest = i;
+        }
+    }
+    sum -= older.sum;
+
+    if (highest >= 0) {
+        const uint64_t upper = bucketUpperBound(highest);
+        max = (upper < max) ? upper : max;
+    } else {
+        max = 0;
+    }
+}
@@ -0,0 +1,94 @@
+/****************************************************************************
+ * AIMLAB - Lock-Free Latency Histogram
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   HDR-style log-linear histogram of nanosecond durations. Values below
+ *   64 ns are stored exactly; above that every power-of-two range is split
+ *   into 32 linear sub-buckets, bounding the relative error to ~3% from
+ *   nanoseconds up to ~18 minutes in under 10 KB of counters.
+ *
+ *   Single writer, any number of readers: record() performs only relaxed
+ *   atomic loads/stores (no lock prefix, no allocation), and readers take
+ *   snapshots at any time. Windowed statistics are obtained by
+ *   subtracting an older snapshot from a newer one.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_LATENCY_HISTOGRAM_H
+#define AIMLAB_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+
+class LatencyHistogram {
+public:
+    static const int EXACT_BITS = 6;                            // exact below 64 ns
+    static const int SUB_BUCKETS = 1 << (EXACT_BITS - 1);       // 32 per octave
+    static const int MAX_EXPONENT = 35;                         // up to 2^41 ns
+    static const int BUCKET_COUNT = (1 << EXACT_BITS) + MAX_EXPONENT * SUB_BUCKETS;
+
+    /**
+     * @brief Immutable copy of the histogram state, safe to inspect at leisure
+     */
+    struct Snapshot {
+        uint64_t counts[BUCKET_COUNT];
+        uint64_t count;
+        uint64_t sum;
+        uint64_t max;
+
+        /** @brief Value at quantile q in [0,1] (upper edge of its bucket, ns) */
+        uint64_t percentile(double q) const;
+
+        /** @brief Arithmetic mean (ns) */
+        double mean() const { return count ? (double)sum / (double)count : 0.0; }
+
+        /**
+         * @brief Turn this snapshot into the delta since an older one
+         *
+         * The window max cannot be recovered exactly from counts, so it is
+         * taken from the highest non-empty bucket (clamped to the lifetime max).
+         */
+        void subtract(const Snapshot& older);
+    };
+
+    LatencyHistogram();
+
+    /**
+     * @brief Record one duration (writer thread only)
+     *
+     * Performance Notes:
+     *   - A handful of relaxed loads/stores; no atomic read-modify-write
+     */
+    void record(uint64_t ns) {
+        const int index = bucketIndex(ns);
+        m_counts[index].store(m_counts[index].load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+        m_sum.store(m_sum.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns > m_max.load(std::memory_order_relaxed)) {
+            m_max.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief Copy the current state (any thread) */
+    void snapshot(Snapshot& out) const;
+
+    /** @brief Zero all counters (only while the writer is stopped) */
+    void reset();
+
+    static int bucketIndex(uint64_t ns);
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    std::atomic<uint64_t> m_counts[BUCKET_COUNT];
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+#endif // AIMLAB_LATENCY_HISTOGRAM_H
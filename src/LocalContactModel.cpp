@@ -0,0 +1,75 @@
+/****************************************************************************
+ * AIMLAB - Local Contact Model
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of the local contact model functions. See
+ *   LocalContactModel.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "LocalContactModel.h"
+
+#include <cmath>
+
+//===========================================================================
+// PLANES
+//===========================================================================
+
+bool addLocalContactPlane(LocalContactModel& a_model, const double a_point[3],
+                          const double a_normal[3], double a_stiffness) {
+    const double length = sqrt(a_normal[0] * a_normal[0] + a_normal[1] * a_normal[1] +
+                               a_normal[2] * a_normal[2]);
+    if (length <= 0.0 || a_model.planeCount >= AIMLAB_LOCAL_MAX_PLANES) {
+        return false;
+    }
+    const double normal[3] = { a_normal[0] / length, a_normal[1] / length, a_normal[2] / length };
+    const double offset = normal[0] * a_point[0] + normal[1] * a_point[1] + normal[2] * a_point[2];
+
+    // Two events on one face (a triangle and its neighbour) are one plane
+    for (uint32_t i = 0; i < a_model.planeCount; i++) {
+        const LocalContactPlane& p = a_model.planes[i];
+        const double cosine = p.normal[0] * normal[0] + p.normal[1] * normal[1] +
+                              p.normal[2] * normal[2];
+        const double otherOffset = p.normal[0] * p.point[0] + p.normal[1] * p.point[1] +
+                                   p.normal[2] * p.point[2];
+        if (cosine > 0.9999 && fabs(offset - otherOffset) < 1e-6) {
+            return false;
+        }
+    }
+
+    LocalContactPlane& plane = a_model.planes[a_model.planeCount++];
+    for (int k = 0; k < 3; k++) {
+        plane.point[k] = a_point[k];
+        plane.normal[k] = normal[k];
+    }
+    plane.stiffness = a_stiffness;
+    return true;
+}
+
+//===========================================================================
+// FORCE
+//===========================================================================
+
+void computeLocalContactForce(const LocalContactModel& a_model, const double a_pos[3],
+                              double a_force[3]) {
+    a_force[0] = a_force[1] = a_force[2] = 0.0;
+    for (uint32_t i = 0; i < a_model.planeCount; i++) {
+        const LocalContactPlane& p = a_model.planes[i];
+        const double distance = p.normal[0] * (a_pos[0] - p.point[0]) +
+                                p.normal[1] * (a_pos[1] - p.point[1]) +
+                                p.normal[2] * (a_pos[2] - p.point[2]);
+        const double depth = a_model.toolRadius - distance;
+        if (depth > 0.0) {
+            for (int k = 0; k < 3; k++) {
+                a_force[k] += p.stiffness * depth * p.normal[k];
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/****************************************************************************
+ * AIMLAB - Local Contact Model
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Intermediate representation for multirate haptic rendering
+ *   (--multirate). The simulation thread runs the full CHAI3D pipeline at
+ *   100-200 Hz and reduces the contacts it found near the tool to a few
+ *   planes. The haptic thread renders a penalty force against those planes
+ *   at full rate. The force stays continuous when a simulation step is
+ *   slow, because the haptic thread only ever evaluates planes, which
+ *   costs the same whatever the scene holds.
+ *
+ *   A plane is a point on the surface, the outward normal and the
+ *   material stiffness. The simulation detects contacts with its contact
+ *   radius grown by AIMLAB_LOCAL_MODEL_MARGIN, so a plane is already there
+ *   when the tool reaches the surface between two simulation steps.
+ *
+ *   Both directions use a TripleBuffer: device samples go from the haptic
+ *   thread to the simulation thread, and models go back. Neither thread
+ *   ever waits for the other. No CHAI3D dependency.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_LOCAL_CONTACT_MODEL_H
+#define AIMLAB_LOCAL_CONTACT_MODEL_H
+
+#include "HapticRecord.h"
+#include "TripleBuffer.h"
+
+#include <cstdint>
+
+#define AIMLAB_LOCAL_MAX_PLANES     4
+#define AIMLAB_LOCAL_MODEL_MARGIN   0.01    // m added to the simulation's contact radius
+
+struct LocalContactPlane {
+    double point[3];            // on the surface (world frame, m)
+    double normal[3];           // unit, out of the surface
+    double stiffness;           // N/m
+};
+
+struct LocalContactModel {
+    uint64_t step;              // simulation step that produced it, 0 = none yet
+    uint64_t timestampNs;       // hapticNowNs() at publish
+    double toolRadius;          // radius the haptic thread renders with (m)
+    double proxyPos[3];         // simulation proxy, for display and the bridge
+    uint32_t planeCount;
+    LocalContactPlane planes[AIMLAB_LOCAL_MAX_PLANES];
+};
+
+typedef TripleBuffer<LocalContactModel> LocalContactBuffer;    // simulation -> haptic
+typedef TripleBuffer<HapticSample> HapticSampleBuffer;         // haptic -> simulation
+
+/**
+ * @brief Add a plane unless the model has the same one or is full
+ *
+ * @param a_normal Need not be unit length; a zero normal is ignored
+ * @return true if the plane was added
+ */
+bool addLocalContactPlane(LocalContactModel& a_model, const double a_point[3],
+                          const double a_normal[3], double a_stiffness);
+
+/**
+ * @brief Penalty force on a tool sphere centred at a_pos
+ *
+ * Each plane the sphere penetrates pushes along its normal with
+ * stiffness * depth; the contributions add up (an edge or a corner
+ * pushes along both normals).
+ */
+void computeLocalContactForce(const LocalContactModel& a_model, const double a_pos[3],
+                              double a_force[3]);
+
+#endif // AIMLAB_LOCAL_CONTACT_MODEL_H
@@ -0,0 +1,635 @@
+/****************************************************************************
+ * AIMLAB - Binary Mesh Cache
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of the OBJ parser, AABB tree builder and mesh cache.
+ *   See MeshCache.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Mapped caches check triangle and tree indices
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "MeshCache.h"
+#include "HapticClock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <process.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+static uint64_t alignUp(uint64_t a_value) {
+    return (a_value + AIMLAB_MESH_ALIGN - 1) & ~(uint64_t)(AIMLAB_MESH_ALIGN - 1);
+}
+
+/**
+ * @brief Size and modification time of a file
+ */
+static bool statFile(const string& a_filename, uint64_t& a_bytes, int64_t& a_mtime) {
+    struct stat st;
+    if (stat(a_filename.c_str(), &st) != 0) {
+        return false;
+    }
+    a_bytes = (uint64_t)st.st_size;
+    a_mtime = (int64_t)st.st_mtime;
+    return true;
+}
+
+MeshView MeshData::view() const {
+    MeshView v;
+    v.vertexCount = (uint32_t)(positions.size() / 3);
+    v.triangleCount = (uint32_t)(triangles.size() / 3);
+    v.nodeCount = (uint32_t)nodes.size();
+    v.rootIndex = rootIndex;
+    v.positions = positions.data();
+    v.normals = normals.data();
+    v.triangles = triangles.data();
+    v.nodes = nodes.data();
+    return v;
+}
+
+string meshCacheFile(const string& a_meshFile) {
+    return a_meshFile + AIMLAB_MESH_EXTENSION;
+}
+
+//===========================================================================
+// OBJ PARSER
+//===========================================================================
+
+/**
+ * @brief Resolve a 1-based (or negative, relative) OBJ vertex reference
+ */
+static bool resolveIndex(long a_index, size_t a_vertexCount, uint32_t& a_out) {
+    if (a_index > 0 && (size_t)a_index <= a_vertexCount) {
+        a_out = (uint32_t)(a_index - 1);
+        return true;
+    }
+    if (a_index < 0 && (size_t)(-a_index) <= a_vertexCount) {
+        a_out = (uint32_t)(a_vertexCount + a_index);
+        return true;
+    }
+    return false;
+}
+
+bool parseObjMesh(const string& a_filename, double a_scale, MeshData& a_mesh, string& a_error) {
+    FILE* file = fopen(a_filename.c_str(), "rb");
+    if (file == nullptr) {
+        a_error = "cannot open mesh " + a_filename;
+        return false;
+    }
+    string text;
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    text.resize(size > 0 ? (size_t)size : 0);
+    const size_t read = text.empty() ? 0 : fread(&text[0], 1, text.size(), file);
+    fclose(file);
+    if (read != text.size()) {
+        a_error = "cannot read mesh " + a_filename;
+        return false;
+    }
+
+    a_mesh = MeshData();
+    vector<uint32_t> face;
+    const char* p = text.c_str();
+    const char* const end = p + text.size();
+    size_t lineNumber = 0;
+
+    while (p < end) {
+        const char* lineEnd = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        lineNumber++;
+
+        if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+            char* next = nullptr;
+            double v[3];
+            const char* q = p + 2;
+            for (int k = 0; k < 3; k++) {
+                v[k] = strtod(q, &next);
+                if (next == q || next > lineEnd) {
+                    a_error = a_filename + ":" + to_string(lineNumber) + ": bad vertex";
+                    return false;
+                }
+                q = next;
+            }
+            a_mesh.positions.push_back(v[0] * a_scale);
+            a_mesh.positions.push_back(v[1] * a_scale);
+            a_mesh.positions.push_back(v[2] * a_scale);
+
+        } else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            // "f a b c ...", each reference "v", "v/vt", "v//vn" or "v/vt/vn"
+            face.clear();
+            const char* q = p + 2;
+            const size_t vertexCount = a_mesh.positions.size() / 3;
+            while (q < lineEnd) {
+                while (q < lineEnd && (*q == ' ' || *q == '\t' || *q == '\r')) {
+                    q++;
+                }
+                if (q >= lineEnd) {
+                    break;
+                }
+                char* next = nullptr;
+                const long index = strtol(q, &next, 10);
+                uint32_t vertex = 0;
+                if (next == q || !resolveIndex(index, vertexCount, vertex)) {
+                    a_error = a_filename + ":" + to_string(lineNumber) + ": bad face index";
+                    return false;
+                }
+                face.push_back(vertex);
+                q = next;
+                while (q < lineEnd && *q != ' ' && *q != '\t' && *q != '\r') {
+                    q++;
+                }
+            }
+            for (size_t k = 2; k < face.size(); k++) {
+                a_mesh.triangles.push_back(face[0]);
+                a_mesh.triangles.push_back(face[k - 1]);
+                a_mesh.triangles.push_back(face[k]);
+            }
+        }
+        // Normals, texture coordinates, groups and materials are not used
+
+        p = lineEnd + 1;
+    }
+
+    if (a_mesh.triangles.empty()) {
+        a_error = a_filename + ": no faces";
+        return false;
+    }
+    if (a_mesh.triangles.size() / 3 > (size_t)INT32_MAX / 2) {
+        a_error = a_filename + ": too many triangles";
+        return false;
+    }
+    return true;
+}
+
+//===========================================================================
+// NORMALS
+//===========================================================================
+
+void computeMeshNormals(MeshData& a_mesh) {
+    const size_t vertexCount = a_mesh.positions.size() / 3;
+    a_mesh.normals.assign(vertexCount * 3, 0.0);
+
+    const double* pos = a_mesh.positions.data();
+    double* nrm = a_mesh.normals.data();
+    for (size_t t = 0; t + 2 < a_mesh.triangles.size(); t += 3) {
+        const uint32_t i0 = a_mesh.triangles[t];
+        const uint32_t i1 = a_mesh.triangles[t + 1];
+        const uint32_t i2 = a_mesh.triangles[t + 2];
+        double e1[3], e2[3];
+        for (int k = 0; k < 3; k++) {
+            e1[k] = pos[i1 * 3 + k] - pos[i0 * 3 + k];
+            e2[k] = pos[i2 * 3 + k] - pos[i0 * 3 + k];
+        }
+        // Unnormalized cross product: weights each face by twice its area
+        const double n[3] = { e1[1] * e2[2] - e1[2] * e2[1],
+                              e1[2] * e2[0] - e1[0] * e2[2],
+                              e1[0] * e2[1] - e1[1] * e2[0] };
+        for (int k = 0; k < 3; k++) {
+            nrm[i0 * 3 + k] += n[k];
+            nrm[i1 * 3 + k] += n[k];
+            nrm[i2 * 3 + k] += n[k];
+        }
+    }
+
+    for (size_t v = 0; v < vertexCount; v++) {
+        double* n = nrm + v * 3;
+        const double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length > 0.0) {
+            n[0] /= length;
+            n[1] /= length;
+            n[2] /= length;
+        } else {
+            n[0] = 1.0;                 // CHAI3D's default vertex normal
+        }
+    }
+}
+
+//===========================================================================
+// AABB TREE
+//===========================================================================
+
+namespace {
+
+struct TreeBuilder {
+    const MeshData* mesh;
+    vector<uint32_t> order;             // triangle of each leaf slot
+    vector<double> centroids;           // xyz per triangle
+    vector<MeshAabbNode> nodes;
+
+    void triangleBox(uint32_t a_triangle, MeshAabbNode& a_node) const {
+        const uint32_t* tri = &mesh->triangles[a_triangle * 3];
+        for (int k = 0; k < 3; k++) {
+            a_node.min[k] = a_node.max[k] = mesh->positions[tri[0] * 3 + k];
+        }
+        for (int c = 1; c < 3; c++) {
+            for (int k = 0; k < 3; k++) {
+                const double v = mesh->positions[tri[c] * 3 + k];
+                a_node.min[k] = min(a_node.min[k], v);
+                a_node.max[k] = max(a_node.max[k], v);
+            }
+        }
+    }
+
+    /**
+     * @brief Build the subtree over leaf slots [a_first, a_last) and return its node
+     *
+     * Leaf slot i is node i; internal nodes are appended after both
+     * children, so the root ends up last.
+     */
+    int32_t build(uint32_t a_first, uint32_t a_last, int32_t a_depth) {
+        if (a_last - a_first == 1) {
+            MeshAabbNode& leaf = nodes[a_first];
+            triangleBox(order[a_first], leaf);
+            leaf.left = (int32_t)order[a_first];
+            leaf.right = -1;
+            leaf.depth = a_depth;
+            leaf.leaf = 1;
+            return (int32_t)a_first;
+        }
+
+        // Split at the median centroid along the longest axis of the centroids
+        double lo[3] = { HUGE_VAL, HUGE_VAL, HUGE_VAL };
+        double hi[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+        for (uint32_t i = a_first; i < a_last; i++) {
+            const double* c = &centroids[order[i] * 3];
+            for (int k = 0; k < 3; k++) {
+                lo[k] = min(lo[k], c[k]);
+                hi[k] = max(hi[k], c[k]);
+            }
+        }
+        int axis = 0;
+        if (hi[1] - lo[1] > hi[axis] - lo[axis]) axis = 1;
+        if (hi[2] - lo[2] > hi[axis] - lo[axis]) axis = 2;
+
+        const uint32_t mid = a_first + (a_last - a_first) / 2;
+        const double* cen = centroids.data();
+        nth_element(order.begin() + a_first, order.begin() + mid, order.begin() + a_last,
+                    [cen, axis](uint32_t a, uint32_t b) {
+                        return cen[a * 3 + axis] < cen[b * 3 + axis];
+                    });
+
+        const int32_t left = build(a_first, mid, a_depth + 1);
+        const int32_t right = build(mid, a_last, a_depth + 1);
+
+        MeshAabbNode node;
+        for (int k = 0; k < 3; k++) {
+            node.min[k] = min(nodes[left].min[k], nodes[right].min[k]);
+            node.max[k] = max(nodes[left].max[k], nodes[right].max[k]);
+        }
+        node.left = left;
+        node.right = right;
+        node.depth = a_depth;
+        node.leaf = 0;
+        nodes.push_back(node);
+        return (int32_t)(nodes.size() - 1);
+    }
+};
+
+} // namespace
+
+void buildMeshAabbTree(MeshData& a_mesh) {
+    const uint32_t triangleCount = (uint32_t)(a_mesh.triangles.size() / 3);
+    a_mesh.nodes.clear();
+    a_mesh.rootIndex = -1;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    TreeBuilder builder;
+    builder.mesh = &a_mesh;
+    builder.order.resize(triangleCount);
+    builder.centroids.resize((size_t)triangleCount * 3);
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        builder.order[t] = t;
+        const uint32_t* tri = &a_mesh.triangles[t * 3];
+        for (int k = 0; k < 3; k++) {
+            builder.centroids[t * 3 + k] = (a_mesh.positions[tri[0] * 3 + k] +
+                                            a_mesh.positions[tri[1] * 3 + k] +
+                                            a_mesh.positions[tri[2] * 3 + k]) / 3.0;
+        }
+    }
+    builder.nodes.resize(triangleCount);
+    builder.nodes.reserve((size_t)triangleCount * 2 - 1);
+
+    a_mesh.rootIndex = builder.build(0, triangleCount, 0);
+    a_mesh.nodes.swap(builder.nodes);
+}
+
+//===========================================================================
+// CACHE WRITER
+//===========================================================================
+
+static bool writeSection(FILE* a_file, const void* a_data, size_t a_bytes, uint64_t a_offset) {
+    static const unsigned char zeros[AIMLAB_MESH_ALIGN] = { 0 };
+    const long position = ftell(a_file);
+    if (position < 0 || (uint64_t)position > a_offset) {
+        return false;
+    }
+    const size_t padding = (size_t)(a_offset - (uint64_t)position);
+    if (padding > 0 && fwrite(zeros, 1, padding, a_file) != padding) {
+        return false;
+    }
+    return a_bytes == 0 || fwrite(a_data, 1, a_bytes, a_file) == a_bytes;
+}
+
+bool writeMeshCache(const string& a_cacheFile, const MeshData& a_mesh,
+                    const string& a_sourceFile, double a_scale, string& a_error) {
+    MeshCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, AIMLAB_MESH_MAGIC, sizeof(header.magic));
+    header.version = AIMLAB_MESH_VERSION;
+    header.headerBytes = sizeof(MeshCacheHeader);
+    if (!statFile(a_sourceFile, header.sourceBytes, header.sourceMtime)) {
+        a_error = "cannot stat " + a_sourceFile;
+        return false;
+    }
+    header.scale = a_scale;
+
+    const MeshView view = a_mesh.view();
+    header.vertexCount = view.vertexCount;
+    header.triangleCount = view.triangleCount;
+    header.nodeCount = view.nodeCount;
+    header.rootIndex = view.rootIndex;
+
+    const uint64_t positionBytes = (uint64_t)view.vertexCount * 3 * sizeof(double);
+    const uint64_t triangleBytes = (uint64_t)view.triangleCount * 3 * sizeof(uint32_t);
+    const uint64_t nodeBytes = (uint64_t)view.nodeCount * sizeof(MeshAabbNode);
+    header.positionsOffset = alignUp(sizeof(MeshCacheHeader));
+    header.normalsOffset = alignUp(header.positionsOffset + positionBytes);
+    header.trianglesOffset = alignUp(header.normalsOffset + positionBytes);
+    header.nodesOffset = alignUp(header.trianglesOffset + triangleBytes);
+    header.fileBytes = header.nodesOffset + nodeBytes;
+
+    // Write next to the target, then rename over it
+#ifdef _WIN32
+    const string tempFile = a_cacheFile + ".tmp" + to_string(_getpid());
+#else
+    const string tempFile = a_cacheFile + ".tmp" + to_string(getpid());
+#endif
+    FILE* file = fopen(tempFile.c_str(), "wb");
+    if (file == nullptr) {
+        a_error = "cannot create " + tempFile;
+        return false;
+    }
+    const bool ok = writeSection(file, &header, sizeof(header), 0) &&
+                    writeSection(file, view.positions, (size_t)positionBytes, header.positionsOffset) &&
+                    writeSection(file, view.normals, (size_t)positionBytes, header.normalsOffset) &&
+                    writeSection(file, view.triangles, (size_t)triangleBytes, header.trianglesOffset) &&
+                    writeSection(file, view.nodes, (size_t)nodeBytes, header.nodesOffset);
+    if (fclose(file) != 0 || !ok) {
+        remove(tempFile.c_str());
+        a_error = "cannot write " + tempFile;
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(a_cacheFile.c_str());        // rename() does not replace on Windows
+#endif
+    if (rename(tempFile.c_str(), a_cacheFile.c_str()) != 0) {
+        remove(tempFile.c_str());
+        a_error = "cannot rename " + tempFile + " to " + a_cacheFile;
+        return false;
+    }
+    return true;
+}
+
+//===========================================================================
+// MAPPED CACHE
+//===========================================================================
+
+MappedMeshCache::MappedMeshCache()
+    : m_data(nullptr),
+      m_bytes(0),
+      m_header(nullptr)
+#ifdef _WIN32
+      , m_file(INVALID_HANDLE_VALUE),
+      m_mapping(nullptr)
+#endif
+{
+}
+
+MappedMeshCache::~MappedMeshCache() {
+    close();
+}
+
+bool MappedMeshCache::open(const string& a_cacheFile, string& a_error) {
+    close();
+
+#ifdef _WIN32
+    m_file = CreateFileA(a_cacheFile.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        a_error = "cannot open " + a_cacheFile;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart < (LONGLONG)sizeof(MeshCacheHeader)) {
+        a_error = a_cacheFile + " is truncated";
+        close();
+        return false;
+    }
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_data = (m_mapping != nullptr)
+           ? (const unsigned char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    m_bytes = (size_t)size.QuadPart;
+#else
+    const int fd = ::open(a_cacheFile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        a_error = "cannot open " + a_cacheFile;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(MeshCacheHeader)) {
+        ::close(fd);
+        a_error = a_cacheFile + " is truncated";
+        return false;
+    }
+    m_bytes = (size_t)st.st_size;
+    void* data = mmap(nullptr, m_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);                        // the mapping keeps the file referenced
+    m_data = (data != MAP_FAILED) ? (const unsigned char*)data : nullptr;
+#endif
+    if (m_data == nullptr) {
+        a_error = "cannot map " + a_cacheFile;
+        close();
+        return false;
+    }
+
+    // Header and section bounds first, then every index the arrays hold
+    m_header = (const MeshCacheHeader*)m_data;
+    const MeshCacheHeader& h = *m_header;
+    const uint64_t positionBytes = (uint64_t)h.vertexCount * 3 * sizeof(double);
+    const uint64_t triangleBytes = (uint64_t)h.triangleCount * 3 * sizeof(uint32_t);
+    const uint64_t nodeBytes = (uint64_t)h.nodeCount * sizeof(MeshAabbNode);
+    const bool valid =
+        memcmp(h.magic, AIMLAB_MESH_MAGIC, sizeof(h.magic)) == 0 &&
+        h.version == AIMLAB_MESH_VERSION &&
+        h.headerBytes == sizeof(MeshCacheHeader) &&
+        h.fileBytes == m_bytes &&
+        h.positionsOffset % AIMLAB_MESH_ALIGN == 0 && h.normalsOffset % AIMLAB_MESH_ALIGN == 0 &&
+        h.trianglesOffset % AIMLAB_MESH_ALIGN == 0 && h.nodesOffset % AIMLAB_MESH_ALIGN == 0 &&
+        h.positionsOffset + positionBytes <= h.normalsOffset &&
+        h.normalsOffset + positionBytes <= h.trianglesOffset &&
+        h.trianglesOffset + triangleBytes <= h.nodesOffset &&
+        h.nodesOffset + nodeBytes <= m_bytes &&
+        (h.triangleCount == 0 ? h.nodeCount == 0
+                              : h.nodeCount == 2 * h.triangleCount - 1 &&
+                                h.rootIndex >= 0 && (uint32_t)h.rootIndex < h.nodeCount);
+    if (!valid || !indicesValid(view())) {
+        a_error = a_cacheFile + " is not a valid mesh cache (version " +
+                  to_string(AIMLAB_MESH_VERSION) + ")";
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedMeshCache::indicesValid(const MeshView& a_view) {
+    // A stale or edited cache must not index out of bounds in fillMesh()
+    // or in collision on the haptic thread. Children come before their
+    // parent, so a tree that passes cannot loop either
+    for (uint64_t i = 0; i < (uint64_t)a_view.triangleCount * 3; i++) {
+        if (a_view.triangles[i] >= a_view.vertexCount) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < a_view.nodeCount; i++) {
+        const MeshAabbNode& node = a_view.nodes[i];
+        const bool ok = node.leaf
+                      ? node.left >= 0 && (uint32_t)node.left < a_view.triangleCount
+                      : node.left >= 0 && (uint32_t)node.left < i &&
+                        node.right >= 0 && (uint32_t)node.right < i;
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MappedMeshCache::close() {
+#ifdef _WIN32
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_data != nullptr) {
+        munmap((void*)m_data, m_bytes);
+    }
+#endif
+    m_data = nullptr;
+    m_bytes = 0;
+    m_header = nullptr;
+}
+
+MeshView MappedMeshCache::view() const {
+    MeshView v;
+    if (m_header == nullptr) {
+        return v;
+    }
+    const MeshCacheHeader& h = *m_header;
+    v.vertexCount = h.vertexCount;
+    v.triangleCount = h.triangleCount;
+    v.nodeCount = h.nodeCount;
+    v.rootIndex = h.rootIndex;
+    v.positions = (const double*)(m_data + h.positionsOffset);
+    v.normals = (const double*)(m_data + h.normalsOffset);
+    v.triangles = (const uint32_t*)(m_data + h.trianglesOffset);
+    v.nodes = (const MeshAabbNode*)(m_data + h.nodesOffset);
+    return v;
+}
+
+//===========================================================================
+// MESH ASSET
+//===========================================================================
+
+MeshAsset::MeshAsset()
+    : m_fromCache(false),
+      m_cacheWritten(false),
+      m_loadSeconds(0.0) {
+}
+
+bool MeshAsset::load(const string& a_meshFile, double a_scale, bool a_useCache,
+                     string& a_error) {
+    const uint64_t t0 = hapticNowNs();
+    m_cache.close();
+    m_data = MeshData();
+    m_fromCache = false;
+    m_cacheWritten = false;
+    m_cacheWarning.clear();
+
+    uint64_t sourceBytes = 0;
+    int64_t sourceMtime = 0;
+    if (!statFile(a_meshFile, sourceBytes, sourceMtime)) {
+        a_error = "cannot open mesh " + a_meshFile;
+        return false;
+    }
+
+    // Warm: the cache matches the source file and scale
+    const string cacheFile = meshCacheFile(a_meshFile);
+    string cacheError;
+    if (a_useCache && m_cache.open(cacheFile, cacheError)) {
+        const MeshCacheHeader& h = m_cache.header();
+        if (h.sourceBytes == sourceBytes && h.sourceMtime == sourceMtime && h.scale == a_scale) {
+            m_view = m_cache.view();
+            m_fromCache = true;
+            m_loadSeconds = (double)(hapticNowNs() - t0) * 1e-9;
+            return true;
+        }
+        m_cache.close();
+    }
+
+    // Cold: parse and compile, then cache and map the result
+    if (!parseObjMesh(a_meshFile, a_scale, m_data, a_error)) {
+        return false;
+    }
+    computeMeshNormals(m_data);
+    buildMeshAabbTree(m_data);
+    m_view = m_data.view();
+
+    if (a_useCache) {
+        if (writeMeshCache(cacheFile, m_data, a_meshFile, a_scale, cacheError) &&
+            m_cache.open(cacheFile, cacheError)) {
+            m_cacheWritten = true;
+            m_view = m_cache.view();
+            m_data = MeshData();
+        } else {
+            m_cacheWarning = cacheError;
+        }
+    }
+
+    m_loadSeconds = (double)(hapticNowNs() - t0) * 1e-9;
+    return true;
+}
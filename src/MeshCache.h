@@ -0,0 +1,213 @@
+/****************************************************************************
+ * AIMLAB - Binary Mesh Cache
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Compiles a Wavefront OBJ mesh once into a memory-mappable binary file
+ *   (<mesh>.aimmesh next to the source) that holds everything startup
+ *   would otherwise recompute: scaled vertex positions, vertex normals,
+ *   triangles and the AABB collision tree. Later launches map the file
+ *   and use it in place, so a large mesh costs page faults instead of
+ *   text parsing, normal computation and a tree build.
+ *
+ *   Cache layout (native little-endian, every section 64-byte aligned):
+ *
+ *     MeshCacheHeader
+ *     positions   double[3 * vertexCount]
+ *     normals     double[3 * vertexCount]
+ *     triangles   uint32_t[3 * triangleCount]
+ *     nodes       MeshAabbNode[nodeCount]
+ *
+ *   A cache is rebuilt when its format version, the source file's size or
+ *   modification time, or the scale differs. It is written to a temporary
+ *   file and renamed, so a crash never leaves a torn cache behind.
+ *
+ *   The tree uses CHAI3D's cCollisionAABB layout: one leaf per triangle
+ *   first, internal nodes after their children, root last. No CHAI3D
+ *   dependency here; SceneBuilder hands the nodes to the collision
+ *   detector.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Mapped caches check triangle and tree indices
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_MESH_CACHE_H
+#define AIMLAB_MESH_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define AIMLAB_MESH_MAGIC       "AIMMESH"       // 8 bytes including '\0'
+#define AIMLAB_MESH_VERSION     1
+#define AIMLAB_MESH_ALIGN       64
+#define AIMLAB_MESH_EXTENSION   ".aimmesh"
+
+/**
+ * @brief One AABB tree node (tight box; the collision radius is added on load)
+ */
+struct MeshAabbNode {
+    double min[3];
+    double max[3];
+    int32_t left;                       // internal: child node; leaf: triangle index
+    int32_t right;                      // internal: child node; leaf: -1
+    int32_t depth;                      // root = 0
+    uint32_t leaf;                      // 1 = leaf
+};
+
+static_assert(sizeof(MeshAabbNode) == 64, "MeshAabbNode must stay 64 bytes");
+
+struct MeshCacheHeader {
+    char magic[8];                      // AIMLAB_MESH_MAGIC
+    uint32_t version;                   // AIMLAB_MESH_VERSION
+    uint32_t headerBytes;               // sizeof(MeshCacheHeader)
+    uint64_t sourceBytes;               // source file size when compiled
+    int64_t sourceMtime;                // source modification time (s since epoch)
+    double scale;                       // applied to positions
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+    uint32_t nodeCount;
+    int32_t rootIndex;                  // -1 for an empty mesh
+    uint64_t positionsOffset;
+    uint64_t normalsOffset;
+    uint64_t trianglesOffset;
+    uint64_t nodesOffset;
+    uint64_t fileBytes;
+};
+
+/**
+ * @brief Read-only view of mesh arrays, in memory or in a mapped cache
+ */
+struct MeshView {
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+    uint32_t nodeCount = 0;
+    int32_t rootIndex = -1;
+    const double* positions = nullptr;  // xyz per vertex
+    const double* normals = nullptr;    // xyz per vertex
+    const uint32_t* triangles = nullptr;// three vertex indices per triangle
+    const MeshAabbNode* nodes = nullptr;
+};
+
+/**
+ * @brief Mesh arrays owned in memory (the cold path, before caching)
+ */
+struct MeshData {
+    std::vector<double> positions;
+    std::vector<double> normals;
+    std::vector<uint32_t> triangles;
+    std::vector<MeshAabbNode> nodes;
+    int32_t rootIndex = -1;
+
+    MeshView view() const;
+};
+
+//===========================================================================
+// COLD PATH
+//===========================================================================
+
+/**
+ * @brief Parse vertices and faces of an OBJ file (polygons are fan-triangulated)
+ *
+ * @param a_scale Multiplies every position
+ */
+bool parseObjMesh(const std::string& a_filename, double a_scale, MeshData& a_mesh,
+                  std::string& a_error);
+
+/** @brief Area-weighted vertex normals */
+void computeMeshNormals(MeshData& a_mesh);
+
+/** @brief Median-split AABB tree over the triangles */
+void buildMeshAabbTree(MeshData& a_mesh);
+
+/**
+ * @brief Write a_mesh as a cache stamped with its source file's size and time
+ */
+bool writeMeshCache(const std::string& a_cacheFile, const MeshData& a_mesh,
+                    const std::string& a_sourceFile, double a_scale, std::string& a_error);
+
+//===========================================================================
+// WARM PATH
+//===========================================================================
+
+/**
+ * @brief A cache file mapped read-only into memory
+ */
+class MappedMeshCache {
+public:
+    MappedMeshCache();
+    ~MappedMeshCache();
+
+    MappedMeshCache(const MappedMeshCache&) = delete;
+    MappedMeshCache& operator=(const MappedMeshCache&) = delete;
+
+    /** @brief Map a cache and check its header and section bounds */
+    bool open(const std::string& a_cacheFile, std::string& a_error);
+
+    void close();
+
+    const MeshCacheHeader& header() const { return *m_header; }
+
+    /** @brief Arrays point into the mapping; valid until close() */
+    MeshView view() const;
+
+private:
+    /** @brief Every triangle and tree index in range, children before parents */
+    static bool indicesValid(const MeshView& a_view);
+
+    const unsigned char* m_data;
+    size_t m_bytes;
+    const MeshCacheHeader* m_header;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#endif
+};
+
+//===========================================================================
+// LOADING
+//===========================================================================
+
+/**
+ * @brief A mesh ready to build CHAI3D objects from: mapped from its cache,
+ *        or parsed and compiled (then cached) when the cache is missing or stale
+ */
+class MeshAsset {
+public:
+    MeshAsset();
+
+    /**
+     * @param a_meshFile  .obj file
+     * @param a_scale     Multiplies every position
+     * @param a_useCache  false parses the source and leaves the cache alone
+     */
+    bool load(const std::string& a_meshFile, double a_scale, bool a_useCache,
+              std::string& a_error);
+
+    const MeshView& view() const { return m_view; }
+
+    bool fromCache() const { return m_fromCache; }      // warm load
+    bool cacheWritten() const { return m_cacheWritten; }
+    double loadSeconds() const { return m_loadSeconds; }
+    const std::string& cacheWarning() const { return m_cacheWarning; }
+
+private:
+    MappedMeshCache m_cache;
+    MeshData m_data;                    // only used when the cache cannot be mapped
+    MeshView m_view;
+    bool m_fromCache;
+    bool m_cacheWritten;
+    double m_loadSeconds;
+    std::string m_cacheWarning;
+};
+
+/** @brief Cache file used for a mesh */
+std::string meshCacheFile(const std::string& a_meshFile);
+
+#endif // AIMLAB_MESH_CACHE_H
@@ -0,0 +1,332 @@
+/****************************************************************************
+ * AIMLAB - Primitive Batch
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of PrimitiveBatch and the scalar primitive kernel. See
+ *   PrimitiveBatch.h and PrimitiveKernels.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "PrimitiveBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+// Pad entries: far away, so the tool never reaches them
+static const double FAR_AWAY = 1e30;
+static const double SPHERE_PAD[] = { FAR_AWAY, FAR_AWAY, FAR_AWAY, 0.0, 0.0, 0.0 };
+static const double BOX_PAD[] = { FAR_AWAY, FAR_AWAY, FAR_AWAY,
+                                  1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0,
+                                  0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+static const double PLANE_PAD[] = { 0.0, 0.0, -FAR_AWAY, 0.0, 0.0, 1.0, 0.0, 0.0,
+                                    0.0, 0.0, 1.0 };
+
+//===========================================================================
+// SCALAR KERNEL
+//===========================================================================
+
+/**
+ * @brief Add one contact's force; the AVX2 kernel does the same per lane
+ */
+static inline void addContact(double a_depth, double a_nx, double a_ny, double a_nz,
+                              double a_stiffness, double a_friction, const PrimitiveTool& a_tool,
+                              double a_force[3], PrimitiveForceResult& a_result) {
+    const double fn = a_stiffness * a_depth;
+    const double vn = a_tool.vel[0] * a_nx + a_tool.vel[1] * a_ny + a_tool.vel[2] * a_nz;
+    const double vtx = a_tool.vel[0] - vn * a_nx;
+    const double vty = a_tool.vel[1] - vn * a_ny;
+    const double vtz = a_tool.vel[2] - vn * a_nz;
+    const double speed = sqrt(vtx * vtx + vty * vty + vtz * vtz);
+    const double ff = (a_friction * fn) / (speed > AIMLAB_PRIMITIVE_STICK_SPEED
+                                           ? speed : AIMLAB_PRIMITIVE_STICK_SPEED);
+    a_force[0] += fn * a_nx - ff * vtx;
+    a_force[1] += fn * a_ny - ff * vty;
+    a_force[2] += fn * a_nz - ff * vtz;
+    a_result.contacts++;
+    a_result.maxDepth = max(a_result.maxDepth, a_depth);
+}
+
+PrimitiveForceResult computePrimitiveForcesScalar(const PrimitiveSpheres& a_spheres,
+                                                  const PrimitiveBoxes& a_boxes,
+                                                  const PrimitivePlanes& a_planes,
+                                                  const PrimitiveTool& a_tool,
+                                                  double a_force[3]) {
+    PrimitiveForceResult result = { 0, 0.0 };
+    a_force[0] = a_force[1] = a_force[2] = 0.0;
+    const double px = a_tool.pos[0], py = a_tool.pos[1], pz = a_tool.pos[2];
+    const double r = a_tool.radius;
+
+    for (size_t i = 0; i < a_spheres.count; i++) {
+        const double dx = px - a_spheres.x[i];
+        const double dy = py - a_spheres.y[i];
+        const double dz = pz - a_spheres.z[i];
+        const double dist2 = dx * dx + dy * dy + dz * dz;
+        const double reach = a_spheres.radius[i] + r;
+        if (!(dist2 < reach * reach && dist2 > 0.0)) {
+            continue;
+        }
+        const double dist = sqrt(dist2);
+        const double depth = reach - dist;
+        if (depth > 0.0) {
+            addContact(depth, dx / dist, dy / dist, dz / dist, a_spheres.stiffness[i],
+                       a_spheres.friction[i], a_tool, a_force, result);
+        }
+    }
+
+    for (size_t i = 0; i < a_boxes.count; i++) {
+        const double* const* R = a_boxes.rot;
+        const double dx = px - a_boxes.x[i];
+        const double dy = py - a_boxes.y[i];
+        const double dz = pz - a_boxes.z[i];
+        const double reach = a_boxes.bound[i] + r;
+        if (!(dx * dx + dy * dy + dz * dz < reach * reach)) {
+            continue;
+        }
+
+        // Tool centre in the box frame, and the closest point of the box
+        const double q[3] = { R[0][i] * dx + R[3][i] * dy + R[6][i] * dz,
+                              R[1][i] * dx + R[4][i] * dy + R[7][i] * dz,
+                              R[2][i] * dx + R[5][i] * dy + R[8][i] * dz };
+        const double h[3] = { a_boxes.halfX[i], a_boxes.halfY[i], a_boxes.halfZ[i] };
+        double diff[3];
+        for (int k = 0; k < 3; k++) {
+            diff[k] = q[k] - min(max(q[k], -h[k]), h[k]);
+        }
+        const double dist2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+
+        double depth, nl[3];
+        if (dist2 > 0.0) {
+            // Outside: away from the closest point
+            const double dist = sqrt(dist2);
+            depth = r - dist;
+            nl[0] = diff[0] / dist;
+            nl[1] = diff[1] / dist;
+            nl[2] = diff[2] / dist;
+        } else {
+            // Inside: out through the nearest face
+            const double e[3] = { h[0] - fabs(q[0]), h[1] - fabs(q[1]), h[2] - fabs(q[2]) };
+            const int axis = (e[0] <= e[1] && e[0] <= e[2]) ? 0 : (e[1] <= e[2] ? 1 : 2);
+            depth = r + e[axis];
+            nl[0] = nl[1] = nl[2] = 0.0;
+            nl[axis] = (q[axis] < 0.0) ? -1.0 : 1.0;
+        }
+        if (depth > 0.0) {
+            addContact(depth,
+                       R[0][i] * nl[0] + R[1][i] * nl[1] + R[2][i] * nl[2],
+                       R[3][i] * nl[0] + R[4][i] * nl[1] + R[5][i] * nl[2],
+                       R[6][i] * nl[0] + R[7][i] * nl[1] + R[8][i] * nl[2],
+                       a_boxes.stiffness[i], a_boxes.friction[i], a_tool, a_force, result);
+        }
+    }
+
+    for (size_t i = 0; i < a_planes.count; i++) {
+        const double nx = a_planes.normalX[i], ny = a_planes.normalY[i], nz = a_planes.normalZ[i];
+        const double dist = nx * (px - a_planes.x[i]) + ny * (py - a_planes.y[i]) +
+                            nz * (pz - a_planes.z[i]);
+        const double depth = r - dist;
+        if (depth > 0.0) {
+            addContact(depth, nx, ny, nz, a_planes.stiffness[i], a_planes.friction[i], a_tool,
+                       a_force, result);
+        }
+    }
+    return result;
+}
+
+//===========================================================================
+// CPU DETECTION
+//===========================================================================
+
+static bool cpuHasAvx2() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // AVX needs OS support for the YMM registers (OSXSAVE, XCR0 bits 1-2)
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool PrimitiveBatch::simdAvailable() {
+    static const bool available = primitiveKernelAvx2() != nullptr && cpuHasAvx2();
+    return available;
+}
+
+//===========================================================================
+// BATCH
+//===========================================================================
+
+PrimitiveBatch::PrimitiveBatch()
+    : m_sphereCount(0), m_boxCount(0), m_planeCount(0), m_kernel(computePrimitiveForcesScalar) {
+    setUseSimd(true);
+    refreshViews();
+}
+
+void PrimitiveBatch::setUseSimd(bool a_useSimd) {
+    m_kernel = (a_useSimd && simdAvailable()) ? primitiveKernelAvx2()
+                                              : computePrimitiveForcesScalar;
+}
+
+uint32_t PrimitiveBatch::append(vector<double>* a_fields, size_t a_fieldCount,
+                                const double* a_pad, size_t& a_count) {
+    // Grow by a whole group of pad entries; a new primitive takes the first
+    if (a_count == a_fields[0].size()) {
+        for (size_t f = 0; f < a_fieldCount; f++) {
+            a_fields[f].insert(a_fields[f].end(), AIMLAB_PRIMITIVE_LANES, a_pad[f]);
+        }
+    }
+    return (uint32_t)a_count++;
+}
+
+PrimitiveHandle PrimitiveBatch::addSphere(const double a_center[3], double a_radius,
+                                          double a_stiffness, double a_friction) {
+    const uint32_t i = append(m_spheres, SPHERE_FIELDS, SPHERE_PAD, m_sphereCount);
+    m_spheres[SX][i] = a_center[0];
+    m_spheres[SY][i] = a_center[1];
+    m_spheres[SZ][i] = a_center[2];
+    m_spheres[SRADIUS][i] = a_radius;
+    m_spheres[SSTIFFNESS][i] = a_stiffness;
+    m_spheres[SFRICTION][i] = a_friction;
+    refreshViews();
+    PrimitiveHandle handle = { PRIMITIVE_SPHERE, i };
+    return handle;
+}
+
+PrimitiveHandle PrimitiveBatch::addBox(const double a_center[3], const double a_rot[9],
+                                       const double a_size[3], double a_stiffness,
+                                       double a_friction) {
+    const uint32_t i = append(m_boxes, BOX_FIELDS, BOX_PAD, m_boxCount);
+    m_boxes[BHALFX][i] = 0.5 * a_size[0];
+    m_boxes[BHALFY][i] = 0.5 * a_size[1];
+    m_boxes[BHALFZ][i] = 0.5 * a_size[2];
+    m_boxes[BBOUND][i] = 0.5 * sqrt(a_size[0] * a_size[0] + a_size[1] * a_size[1] +
+                                    a_size[2] * a_size[2]);
+    m_boxes[BSTIFFNESS][i] = a_stiffness;
+    m_boxes[BFRICTION][i] = a_friction;
+    refreshViews();
+    PrimitiveHandle handle = { PRIMITIVE_BOX, i };
+    setPose(handle, a_center, a_rot);
+    return handle;
+}
+
+PrimitiveHandle PrimitiveBatch::addPlane(const double a_point[3], const double a_normal[3],
+                                         double a_stiffness, double a_friction) {
+    const double length = sqrt(a_normal[0] * a_normal[0] + a_normal[1] * a_normal[1] +
+                               a_normal[2] * a_normal[2]);
+    const uint32_t i = append(m_planes, PLANE_FIELDS, PLANE_PAD, m_planeCount);
+    for (int k = 0; k < 3; k++) {
+        m_planes[PLOCALX + k][i] = (length > 0.0) ? a_normal[k] / length : (k == 2 ? 1.0 : 0.0);
+    }
+    m_planes[PSTIFFNESS][i] = a_stiffness;
+    m_planes[PFRICTION][i] = a_friction;
+    refreshViews();
+    static const double IDENTITY[9] = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+    PrimitiveHandle handle = { PRIMITIVE_PLANE, i };
+    setPose(handle, a_point, IDENTITY);
+    return handle;
+}
+
+void PrimitiveBatch::setPose(PrimitiveHandle a_handle, const double a_pos[3],
+                             const double a_rot[9]) {
+    const uint32_t i = a_handle.index;
+    switch (a_handle.kind) {
+    case PRIMITIVE_SPHERE:
+        if (i < m_sphereCount) {
+            for (int k = 0; k < 3; k++) {
+                m_spheres[SX + k][i] = a_pos[k];
+            }
+        }
+        break;
+    case PRIMITIVE_BOX:
+        if (i < m_boxCount) {
+            for (int k = 0; k < 3; k++) {
+                m_boxes[BX + k][i] = a_pos[k];
+            }
+            for (int k = 0; k < 9; k++) {
+                m_boxes[BR0 + k][i] = a_rot[k];
+            }
+        }
+        break;
+    case PRIMITIVE_PLANE:
+        if (i < m_planeCount) {
+            const double local[3] = { m_planes[PLOCALX][i], m_planes[PLOCALY][i],
+                                      m_planes[PLOCALZ][i] };
+            for (int k = 0; k < 3; k++) {
+                m_planes[PX + k][i] = a_pos[k];
+                m_planes[PNX + k][i] = a_rot[3 * k] * local[0] + a_rot[3 * k + 1] * local[1] +
+                                       a_rot[3 * k + 2] * local[2];
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void PrimitiveBatch::refreshViews() {
+    m_sphereView.count = m_spheres[SX].size();
+    m_sphereView.x = m_spheres[SX].data();
+    m_sphereView.y = m_spheres[SY].data();
+    m_sphereView.z = m_spheres[SZ].data();
+    m_sphereView.radius = m_spheres[SRADIUS].data();
+    m_sphereView.stiffness = m_spheres[SSTIFFNESS].data();
+    m_sphereView.friction = m_spheres[SFRICTION].data();
+
+    m_boxView.count = m_boxes[BX].size();
+    m_boxView.x = m_boxes[BX].data();
+    m_boxView.y = m_boxes[BY].data();
+    m_boxView.z = m_boxes[BZ].data();
+    for (int k = 0; k < 9; k++) {
+        m_boxView.rot[k] = m_boxes[BR0 + k].data();
+    }
+    m_boxView.halfX = m_boxes[BHALFX].data();
+    m_boxView.halfY = m_boxes[BHALFY].data();
+    m_boxView.halfZ = m_boxes[BHALFZ].data();
+    m_boxView.bound = m_boxes[BBOUND].data();
+    m_boxView.stiffness = m_boxes[BSTIFFNESS].data();
+    m_boxView.friction = m_boxes[BFRICTION].data();
+
+    m_planeView.count = m_planes[PX].size();
+    m_planeView.x = m_planes[PX].data();
+    m_planeView.y = m_planes[PY].data();
+    m_planeView.z = m_planes[PZ].data();
+    m_planeView.normalX = m_planes[PNX].data();
+    m_planeView.normalY = m_planes[PNY].data();
+    m_planeView.normalZ = m_planes[PNZ].data();
+    m_planeView.stiffness = m_planes[PSTIFFNESS].data();
+    m_planeView.friction = m_planes[PFRICTION].data();
+}
+
+//===========================================================================
+// FORCE
+//===========================================================================
+
+PrimitiveForceResult PrimitiveBatch::computeForce(const PrimitiveTool& a_tool,
+                                                  double a_force[3]) const {
+    return m_kernel(m_sphereView, m_boxView, m_planeView, a_tool, a_force);
+}
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * AIMLAB - Primitive Force Kernels
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Contact force of a spherical tool against arrays of spheres, boxes and
+ *   planes stored as structure of arrays, one array per field. Every array
+ *   has the same padded length, a multiple of AIMLAB_PRIMITIVE_LANES. Pad
+ *   entries sit far away and never touch the tool, so a kernel can process
+ *   four primitives at a time without a remainder loop.
+ *
+ *   Contact law, per primitive the tool penetrates by depth > 0 along the
+ *   outward normal n:
+ *
+ *     fn = stiffness * depth
+ *     vt = v - (v . n) n                      tangential tool velocity
+ *     F  = fn n - friction * fn * vt / max(|vt|, AIMLAB_PRIMITIVE_STICK_SPEED)
+ *
+ *   Friction opposes sliding with dynamic friction * fn. It fades out
+ *   linearly below the stick speed instead of switching direction at
+ *   rest. The kernels keep no state, so there is no static friction.
+ *
+ *   Two implementations, same operations in the same order per primitive:
+ *   computePrimitiveForcesScalar() (PrimitiveBatch.cpp) and an AVX2 kernel
+ *   (PrimitiveKernelsAvx2.cpp, the only file built with AVX2 enabled). Only
+ *   the order of the final summation differs between them. Both reject a
+ *   primitive on its squared distance first; the square root and the rest
+ *   only run for primitives within reach. This header
+ *   must stay free of inline code, so the AVX2 file emits no function
+ *   that other files could link against.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_PRIMITIVE_KERNELS_H
+#define AIMLAB_PRIMITIVE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define AIMLAB_PRIMITIVE_LANES          4       // doubles per AVX2 register
+#define AIMLAB_PRIMITIVE_STICK_SPEED    0.01    // m/s: friction fades out below this
+
+struct PrimitiveSpheres {
+    size_t count;                           // padded
+    const double* x;                        // centre (world frame, m)
+    const double* y;
+    const double* z;
+    const double* radius;
+    const double* stiffness;                // N/m
+    const double* friction;                 // dynamic friction coefficient
+};
+
+struct PrimitiveBoxes {
+    size_t count;                           // padded
+    const double* x;                        // centre (world frame, m)
+    const double* y;
+    const double* z;
+    const double* rot[9];                   // local -> world, row-major
+    const double* halfX;                    // half edge lengths (m)
+    const double* halfY;
+    const double* halfZ;
+    const double* bound;                    // half diagonal: farther than bound + tool radius, no contact
+    const double* stiffness;
+    const double* friction;
+};
+
+struct PrimitivePlanes {
+    size_t count;                           // padded
+    const double* x;                        // point on the plane (world frame, m)
+    const double* y;
+    const double* z;
+    const double* normalX;                  // unit, towards the free side
+    const double* normalY;
+    const double* normalZ;
+    const double* stiffness;
+    const double* friction;
+};
+
+struct PrimitiveTool {
+    double pos[3];                          // centre (world frame, m)
+    double vel[3];                          // m/s
+    double radius;                          // m
+};
+
+struct PrimitiveForceResult {
+    uint32_t contacts;                      // primitives the tool penetrates
+    double maxDepth;                        // deepest penetration (m), 0 without contact
+};
+
+typedef PrimitiveForceResult (*PrimitiveKernel)(const PrimitiveSpheres& a_spheres,
+                                                const PrimitiveBoxes& a_boxes,
+                                                const PrimitivePlanes& a_planes,
+                                                const PrimitiveTool& a_tool,
+                                                double a_force[3]);
+
+/**
+ * @brief Sum the contact forces of every primitive on the tool, one at a time
+ */
+PrimitiveForceResult computePrimitiveForcesScalar(const PrimitiveSpheres& a_spheres,
+                                                  const PrimitiveBoxes& a_boxes,
+                                                  const PrimitivePlanes& a_planes,
+                                                  const PrimitiveTool& a_tool,
+                                                  double a_force[3]);
+
+/**
+ * @brief The AVX2 kernel, or nullptr if this build has none
+ *
+ * Does not check the CPU; see PrimitiveBatch::simdAvailable().
+ */
+PrimitiveKernel primitiveKernelAvx2();
+
+#endif // AIMLAB_PRIMITIVE_KERNELS_H
@@ -0,0 +1,177 @@
+/****************************************************************************
+ * AIMLAB - Replay Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of ReplayHapticDevice. See ReplayHapticDevice.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Unnamed unused calibrate() parameter
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "ReplayHapticDevice.h"
+
+#include <cstring>
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// SPECIFICATIONS
+//===========================================================================
+
+void captureDeviceSpec(const cHapticDeviceInfo& a_info, SessionDeviceSpec& a_spec) {
+    memset(&a_spec, 0, sizeof(a_spec));
+    a_spec.workspaceRadius           = a_info.m_workspaceRadius;
+    a_spec.maxLinearForce            = a_info.m_maxLinearForce;
+    a_spec.maxAngularTorque          = a_info.m_maxAngularTorque;
+    a_spec.maxGripperForce           = a_info.m_maxGripperForce;
+    a_spec.maxLinearStiffness        = a_info.m_maxLinearStiffness;
+    a_spec.maxAngularStiffness       = a_info.m_maxAngularStiffness;
+    a_spec.maxGripperLinearStiffness = a_info.m_maxGripperLinearStiffness;
+    a_spec.maxLinearDamping          = a_info.m_maxLinearDamping;
+    a_spec.maxAngularDamping         = a_info.m_maxAngularDamping;
+    a_spec.maxGripperAngularDamping  = a_info.m_maxGripperAngularDamping;
+    a_spec.gripperMaxAngleRad        = a_info.m_gripperMaxAngleRad;
+    a_spec.model                     = (int32_t)a_info.m_model;
+
+    uint32_t caps = 0;
+    if (a_info.m_sensedPosition)   caps |= AIMLAB_REC_SENSED_POSITION;
+    if (a_info.m_sensedRotation)   caps |= AIMLAB_REC_SENSED_ROTATION;
+    if (a_info.m_sensedGripper)    caps |= AIMLAB_REC_SENSED_GRIPPER;
+    if (a_info.m_actuatedPosition) caps |= AIMLAB_REC_ACTUATED_POSITION;
+    if (a_info.m_actuatedRotation) caps |= AIMLAB_REC_ACTUATED_ROTATION;
+    if (a_info.m_actuatedGripper)  caps |= AIMLAB_REC_ACTUATED_GRIPPER;
+    if (a_info.m_leftHand)         caps |= AIMLAB_REC_LEFT_HAND;
+    if (a_info.m_rightHand)        caps |= AIMLAB_REC_RIGHT_HAND;
+    a_spec.capabilities = caps;
+}
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+ReplayHapticDevice::ReplayHapticDevice(const SessionFileHeader& a_header)
+    : cGenericHapticDevice(0),
+      m_gripperForce(0.0) {
+    memset(&m_sample, 0, sizeof(m_sample));
+    memset(m_force, 0, sizeof(m_force));
+    memset(m_torque, 0, sizeof(m_torque));
+    m_sample.rotation[0] = m_sample.rotation[4] = m_sample.rotation[8] = 1.0;
+
+    const SessionDeviceSpec& spec = a_header.device;
+    const uint32_t caps = spec.capabilities;
+    m_specifications.m_model                      = (cHapticDeviceModel)spec.model;
+    m_specifications.m_modelName                  = a_header.deviceModel;
+    m_specifications.m_manufacturerName           = "AIMLAB replay";
+    m_specifications.m_maxLinearForce             = spec.maxLinearForce;
+    m_specifications.m_maxAngularTorque           = spec.maxAngularTorque;
+    m_specifications.m_maxGripperForce            = spec.maxGripperForce;
+    m_specifications.m_maxLinearStiffness         = spec.maxLinearStiffness;
+    m_specifications.m_maxAngularStiffness        = spec.maxAngularStiffness;
+    m_specifications.m_maxGripperLinearStiffness  = spec.maxGripperLinearStiffness;
+    m_specifications.m_maxLinearDamping           = spec.maxLinearDamping;
+    m_specifications.m_maxAngularDamping          = spec.maxAngularDamping;
+    m_specifications.m_maxGripperAngularDamping   = spec.maxGripperAngularDamping;
+    m_specifications.m_workspaceRadius            = spec.workspaceRadius;
+    m_specifications.m_gripperMaxAngleRad         = spec.gripperMaxAngleRad;
+    m_specifications.m_sensedPosition             = (caps & AIMLAB_REC_SENSED_POSITION) != 0;
+    m_specifications.m_sensedRotation             = (caps & AIMLAB_REC_SENSED_ROTATION) != 0;
+    m_specifications.m_sensedGripper              = (caps & AIMLAB_REC_SENSED_GRIPPER) != 0;
+    m_specifications.m_actuatedPosition           = (caps & AIMLAB_REC_ACTUATED_POSITION) != 0;
+    m_specifications.m_actuatedRotation           = (caps & AIMLAB_REC_ACTUATED_ROTATION) != 0;
+    m_specifications.m_actuatedGripper            = (caps & AIMLAB_REC_ACTUATED_GRIPPER) != 0;
+    m_specifications.m_leftHand                   = (caps & AIMLAB_REC_LEFT_HAND) != 0;
+    m_specifications.m_rightHand                  = (caps & AIMLAB_REC_RIGHT_HAND) != 0;
+
+    m_deviceAvailable = true;
+    m_deviceReady = false;
+}
+
+ReplayHapticDevice::~ReplayHapticDevice() {
+}
+
+//===========================================================================
+// DEVICE INTERFACE
+//===========================================================================
+
+bool ReplayHapticDevice::open() {
+    m_deviceReady = true;
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::close() {
+    m_deviceReady = false;
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::calibrate(bool /*a_forceCalibration*/) {
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::getPosition(cVector3d& a_position) {
+    a_position.set(m_sample.position[0], m_sample.position[1], m_sample.position[2]);
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::getRotation(cMatrix3d& a_rotation) {
+    const double* r = m_sample.rotation;
+    a_rotation.set(r[0], r[1], r[2],
+                   r[3], r[4], r[5],
+                   r[6], r[7], r[8]);
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::getLinearVelocity(cVector3d& a_linearVelocity) {
+    a_linearVelocity.set(m_sample.linearVelocity[0], m_sample.linearVelocity[1],
+                         m_sample.linearVelocity[2]);
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::getAngularVelocity(cVector3d& a_angularVelocity) {
+    a_angularVelocity.set(m_sample.angularVelocity[0], m_sample.angularVelocity[1],
+                          m_sample.angularVelocity[2]);
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::getGripperAngleRad(double& a_angle) {
+    a_angle = m_sample.gripperAngle;
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::getGripperAngularVelocity(double& a_gripperAngularVelocity) {
+    a_gripperAngularVelocity = m_sample.gripperAngularVelocity;
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::getUserSwitches(unsigned int& a_userSwitches) {
+    a_userSwitches = m_sample.userSwitches;
+    return C_SUCCESS;
+}
+
+bool ReplayHapticDevice::setForceAndTorqueAndGripperForce(const cVector3d& a_force,
+                                                          const cVector3d& a_torque,
+                                                          double a_gripperForce) {
+    m_force[0]  = a_force.x();  m_force[1]  = a_force.y();  m_force[2]  = a_force.z();
+    m_torque[0] = a_torque.x(); m_torque[1] = a_torque.y(); m_torque[2] = a_torque.z();
+    m_gripperForce = a_gripperForce;
+    return C_SUCCESS;
+}
+
+//===========================================================================
+// REPLAY
+//===========================================================================
+
+void ReplayHapticDevice::getCommand(double a_force[3], double a_torque[3],
+                                    double& a_gripperForce) const {
+    for (int k = 0; k < 3; k++) {
+        a_force[k]  = m_force[k];
+        a_torque[k] = m_torque[k];
+    }
+    a_gripperForce = m_gripperForce;
+}
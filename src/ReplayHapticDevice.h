@@ -0,0 +1,84 @@
+/****************************************************************************
+ * AIMLAB - Replay Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   cGenericHapticDevice that plays back a recorded session. Before each
+ *   tick the replay loop loads one HapticSample; every getter then returns
+ *   exactly the value the real device returned when the session was
+ *   recorded, so updateFromDevice() sees bit-identical inputs. Forces sent
+ *   by the tool are kept for comparison with the recorded ones instead of
+ *   going anywhere.
+ *
+ *   The device reports the specifications stored in the recording, so the
+ *   tool scales workspace and forces as it did for the original device.
+ *
+ *   With --multirate the same device is the simulation tool's mirror: the
+ *   simulation thread loads the newest live sample into it each step.
+ *
+ *   Also provides the conversion between cHapticDeviceInfo and the
+ *   recording's SessionDeviceSpec, used when a session is recorded.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Also the simulation tool's mirror device
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_REPLAY_HAPTIC_DEVICE_H
+#define AIMLAB_REPLAY_HAPTIC_DEVICE_H
+
+#include "chai3d.h"
+#include "HapticRecord.h"
+
+/**
+ * @brief Copy a device's specifications into a recording header field
+ */
+void captureDeviceSpec(const chai3d::cHapticDeviceInfo& a_info, SessionDeviceSpec& a_spec);
+
+class ReplayHapticDevice : public chai3d::cGenericHapticDevice {
+public:
+    /**
+     * @param a_header Header of the recording (model name and specifications)
+     */
+    explicit ReplayHapticDevice(const SessionFileHeader& a_header);
+    virtual ~ReplayHapticDevice();
+
+    //-----------------------------------------------------------------------
+    // cGenericHapticDevice interface
+    //-----------------------------------------------------------------------
+    virtual bool open();
+    virtual bool close();
+    virtual bool calibrate(bool a_forceCalibration = false);
+    virtual bool getPosition(chai3d::cVector3d& a_position);
+    virtual bool getRotation(chai3d::cMatrix3d& a_rotation);
+    virtual bool getLinearVelocity(chai3d::cVector3d& a_linearVelocity);
+    virtual bool getAngularVelocity(chai3d::cVector3d& a_angularVelocity);
+    virtual bool getGripperAngleRad(double& a_angle);
+    virtual bool getGripperAngularVelocity(double& a_gripperAngularVelocity);
+    virtual bool getUserSwitches(unsigned int& a_userSwitches);
+    virtual bool setForceAndTorqueAndGripperForce(const chai3d::cVector3d& a_force,
+                                                  const chai3d::cVector3d& a_torque,
+                                                  double a_gripperForce);
+
+    //-----------------------------------------------------------------------
+    // Replay
+    //-----------------------------------------------------------------------
+
+    /** @brief Device values to return until the next call */
+    void setSample(const HapticSample& a_sample) { m_sample = a_sample; }
+
+    /** @brief Copy the last force (N), torque (N.m) and gripper force (N) sent by the tool */
+    void getCommand(double a_force[3], double a_torque[3], double& a_gripperForce) const;
+
+private:
+    HapticSample m_sample;
+    double m_force[3];
+    double m_torque[3];
+    double m_gripperForce;
+};
+
+#endif // AIMLAB_REPLAY_HAPTIC_DEVICE_H
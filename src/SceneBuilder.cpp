@@ -0,0 +1,332 @@
+/****************************************************************************
+ * AIMLAB - Scene Builder
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.5
+ *
+ * Description:
+ *   Implementation of buildScene() and CachedCollisionAABB. See
+ *   SceneBuilder.h.
+ *
+ * Changelog:
+ *   v1.5 - 16 October 2026 - Objects and twins created in scene node pools
+ *   v1.4 - 16 October 2026 - Messages go through the asynchronous log
+ *   v1.3 - 16 October 2026 - buildPrimitiveBatch()
+ *   v1.2 - 16 October 2026 - Local object bounds
+ *   v1.1 - 16 October 2026 - buildHapticReplica()
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "SceneBuilder.h"
+#include "AsyncLog.h"
+#include "HapticClock.h"
+
+#include <cmath>
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// CACHED COLLISION TREE
+//===========================================================================
+
+void CachedCollisionAABB::adopt(const MeshView& a_view, cMesh* a_mesh, double a_radius) {
+    m_elements = a_mesh->m_triangles;
+    m_nodes.resize(a_view.nodeCount);
+    for (uint32_t i = 0; i < a_view.nodeCount; i++) {
+        const MeshAabbNode& in = a_view.nodes[i];
+        cCollisionAABBNode& out = m_nodes[i];
+        out.m_bbox.setValue(cVector3d(in.min[0] - a_radius, in.min[1] - a_radius, in.min[2] - a_radius),
+                            cVector3d(in.max[0] + a_radius, in.max[1] + a_radius, in.max[2] + a_radius));
+        out.m_depth = in.depth;
+        out.m_nodeType = in.leaf ? C_AABB_NODE_LEAF : C_AABB_NODE_INTERNAL;
+        out.m_leftSubTree = in.left;
+        out.m_rightSubTree = in.right;
+    }
+    m_rootIndex = a_view.rootIndex;
+}
+
+//===========================================================================
+// HELPERS
+//===========================================================================
+
+/**
+ * @brief Rotation about x, then y, then z (fixed axes), in degrees
+ */
+static cMatrix3d rotationFromDegrees(const double a_deg[3]) {
+    const double d2r = C_PI / 180.0;
+    const double cx = cos(a_deg[0] * d2r), sx = sin(a_deg[0] * d2r);
+    const double cy = cos(a_deg[1] * d2r), sy = sin(a_deg[1] * d2r);
+    const double cz = cos(a_deg[2] * d2r), sz = sin(a_deg[2] * d2r);
+
+    // Rz * Ry * Rx
+    cMatrix3d rot;
+    rot.set(cz * cy, cz * sy * sx - sz * cx, cz * sy * cx + sz * sx,
+            sz * cy, sz * sy * sx + cz * cx, sz * sy * cx - cz * sx,
+            -sy,     cy * sx,                cy * cx);
+    return rot;
+}
+
+static void applyMaterial(const SceneObjectDesc& a_desc, cGenericObject* a_object) {
+    const SessionMaterial& m = a_desc.material;
+    a_object->m_material->setStiffness(m.stiffness);
+    a_object->m_material->setStaticFriction(m.staticFriction);
+    a_object->m_material->setDynamicFriction(m.dynamicFriction);
+    a_object->m_material->setViscosity(m.viscosity);
+
+    a_object->m_material->setColorf((float)a_desc.color[0], (float)a_desc.color[1],
+                                    (float)a_desc.color[2]);
+    a_object->m_material->m_specular.set(0.8f, 0.8f, 0.8f);
+    a_object->m_material->setShininess(100);
+}
+
+/**
+ * @brief Fill a CHAI3D mesh with the vertices and triangles of a view
+ */
+static void fillMesh(const MeshView& a_view, cMesh* a_mesh) {
+    const double* p = a_view.positions;
+    const double* n = a_view.normals;
+    for (uint32_t v = 0; v < a_view.vertexCount; v++) {
+        a_mesh->newVertex(cVector3d(p[v * 3], p[v * 3 + 1], p[v * 3 + 2]),
+                          cVector3d(n[v * 3], n[v * 3 + 1], n[v * 3 + 2]));
+    }
+    const uint32_t* t = a_view.triangles;
+    for (uint32_t i = 0; i < a_view.triangleCount; i++) {
+        a_mesh->newTriangle(t[i * 3], t[i * 3 + 1], t[i * 3 + 2]);
+    }
+}
+
+/**
+ * @brief Haptic mesh with the cached collision tree (empty if not haptic)
+ */
+static cMesh* newHapticMesh(const SceneObjectDesc& a_desc, const MeshView& a_view,
+                            SceneNodePool& a_pool) {
+    cMesh* hapticMesh = new (a_pool) PooledNode<cMesh>();
+    if (a_desc.haptic) {
+        fillMesh(a_view, hapticMesh);
+        CachedCollisionAABB* collision = new CachedCollisionAABB();
+        collision->adopt(a_view, hapticMesh, 0.0);
+        hapticMesh->setCollisionDetector(collision);
+    }
+    return hapticMesh;
+}
+
+/**
+ * @brief Haptic twin of a sphere or box, in a_pool, sharing its material
+ *
+ * Built from the description rather than with copy(), which would put
+ * the twin on the heap.
+ */
+static cGenericObject* newShapeTwin(const SceneObjectDesc& a_desc, const cGenericObject* a_render,
+                                    SceneNodePool& a_pool) {
+    cGenericObject* twin = nullptr;
+    if (a_desc.type == SCENE_OBJECT_SPHERE) {
+        twin = new (a_pool) PooledNode<cShapeSphere>(a_desc.radius);
+    } else {
+        twin = new (a_pool) PooledNode<cShapeBox>(a_desc.size[0], a_desc.size[1], a_desc.size[2]);
+    }
+    twin->m_material = a_render->m_material;
+    return twin;
+}
+
+/**
+ * @brief Name a haptic twin and move it to its scene pose
+ */
+static void placeHapticTwin(const SceneObjectDesc& a_desc, const cMatrix3d& a_rot,
+                            cGenericObject* a_haptic) {
+    a_haptic->m_name = a_desc.name;
+    a_haptic->setLocalPos(a_desc.position[0], a_desc.position[1], a_desc.position[2]);
+    a_haptic->setLocalRot(a_rot);
+    a_haptic->setHapticEnabled(a_desc.haptic);
+}
+
+/**
+ * @brief Box with the given half extents, centred on the origin
+ */
+static ObjectBounds centeredBounds(double a_hx, double a_hy, double a_hz) {
+    ObjectBounds bounds = { { -a_hx, -a_hy, -a_hz }, { a_hx, a_hy, a_hz } };
+    return bounds;
+}
+
+/**
+ * @brief Render mesh and haptic twin (with the cached collision tree)
+ */
+static bool buildMesh(const SceneObjectDesc& a_desc, bool a_useMeshCache,
+                      SceneNodePool& a_renderPool, SceneNodePool& a_hapticPool,
+                      cGenericObject*& a_render, cGenericObject*& a_haptic,
+                      ObjectBounds& a_bounds, string& a_error) {
+    MeshAsset asset;
+    if (!asset.load(a_desc.meshFile, a_desc.scale, a_useMeshCache, a_error)) {
+        return false;
+    }
+    const MeshView& view = asset.view();
+
+    // The tree's root box is the mesh's box (an empty mesh is a point)
+    a_bounds = centeredBounds(0.0, 0.0, 0.0);
+    if (view.rootIndex >= 0) {
+        const MeshAabbNode& root = view.nodes[view.rootIndex];
+        for (int k = 0; k < 3; k++) {
+            a_bounds.min[k] = root.min[k];
+            a_bounds.max[k] = root.max[k];
+        }
+    }
+
+    const uint64_t t0 = hapticNowNs();
+    cMesh* renderMesh = new (a_renderPool) PooledNode<cMesh>();
+    fillMesh(view, renderMesh);
+    renderMesh->setUseDisplayList(true);
+
+    cMesh* hapticMesh = newHapticMesh(a_desc, view, a_hapticPool);
+    hapticMesh->m_material = renderMesh->m_material;
+    const double buildSeconds = (double)(hapticNowNs() - t0) * 1e-9;
+
+    AIMLAB_LOG_INFO("[init] Mesh %s: %u triangles, %s%g ms, objects %g ms", a_desc.name.c_str(),
+                    view.triangleCount,
+                    asset.fromCache() ? "cache " : asset.cacheWritten() ? "parsed and cached " : "parsed ",
+                    asset.loadSeconds() * 1e3, buildSeconds * 1e3);
+    if (!asset.cacheWarning().empty()) {
+        AIMLAB_LOG_WARN("[init] WARNING: Mesh cache not written: %s", asset.cacheWarning().c_str());
+    }
+
+    a_render = renderMesh;
+    a_haptic = hapticMesh;
+    return true;
+}
+
+//===========================================================================
+// SCENE
+//===========================================================================
+
+void applySceneView(const SceneDescription& a_scene, cCamera* a_camera,
+                    cDirectionalLight* a_light) {
+    const SceneCamera& c = a_scene.camera;
+    a_camera->set(cVector3d(c.eye[0], c.eye[1], c.eye[2]),
+                  cVector3d(c.lookAt[0], c.lookAt[1], c.lookAt[2]),
+                  cVector3d(c.up[0], c.up[1], c.up[2]));
+    a_camera->setClippingPlanes(c.nearClip, c.farClip);
+    a_camera->setFieldViewAngleDeg(c.fovDeg);
+
+    const double* d = a_scene.light.direction;
+    a_light->setDir(d[0], d[1], d[2]);
+}
+
+bool buildScene(const SceneDescription& a_scene, bool a_useMeshCache,
+                cWorld* a_world, cWorld* a_hapticWorld,
+                SceneNodePool& a_renderPool, SceneNodePool& a_hapticPool,
+                vector<cGenericObject*>& a_renderObjects,
+                vector<cGenericObject*>& a_hapticObjects,
+                vector<ObjectBounds>& a_localBounds,
+                string& a_error) {
+    for (size_t i = 0; i < a_scene.objects.size(); i++) {
+        const SceneObjectDesc& desc = a_scene.objects[i];
+        cGenericObject* render = nullptr;
+        cGenericObject* haptic = nullptr;
+        ObjectBounds bounds;
+
+        // Haptic twins share the render object's (read-only) material
+        if (desc.type == SCENE_OBJECT_SPHERE) {
+            cShapeSphere* sphere = new (a_renderPool) PooledNode<cShapeSphere>(desc.radius);
+            applyMaterial(desc, sphere);
+            render = sphere;
+            haptic = newShapeTwin(desc, render, a_hapticPool);
+            bounds = centeredBounds(desc.radius, desc.radius, desc.radius);
+        } else if (desc.type == SCENE_OBJECT_BOX) {
+            cShapeBox* box = new (a_renderPool) PooledNode<cShapeBox>(desc.size[0], desc.size[1],
+                                                                      desc.size[2]);
+            applyMaterial(desc, box);
+            render = box;
+            haptic = newShapeTwin(desc, render, a_hapticPool);
+            bounds = centeredBounds(0.5 * desc.size[0], 0.5 * desc.size[1], 0.5 * desc.size[2]);
+        } else {
+            if (!buildMesh(desc, a_useMeshCache, a_renderPool, a_hapticPool, render, haptic, bounds,
+                           a_error)) {
+                return false;
+            }
+            applyMaterial(desc, render);
+        }
+
+        const cMatrix3d rot = rotationFromDegrees(desc.rotationDeg);
+        render->m_name = desc.name;
+        render->setLocalPos(desc.position[0], desc.position[1], desc.position[2]);
+        render->setLocalRot(rot);
+        render->setHapticEnabled(desc.haptic);
+        render->setShowEnabled(true);
+        a_world->addChild(render);
+
+        placeHapticTwin(desc, rot, haptic);
+        a_hapticWorld->addChild(haptic);
+
+        a_renderObjects.push_back(render);
+        a_hapticObjects.push_back(haptic);
+        a_localBounds.push_back(bounds);
+    }
+    return true;
+}
+
+bool buildHapticReplica(const SceneDescription& a_scene, bool a_useMeshCache,
+                        const vector<cGenericObject*>& a_renderObjects,
+                        cWorld* a_replicaWorld, SceneNodePool& a_replicaPool,
+                        vector<cGenericObject*>& a_replicaObjects,
+                        string& a_error) {
+    for (size_t i = 0; i < a_scene.objects.size() && i < a_renderObjects.size(); i++) {
+        const SceneObjectDesc& desc = a_scene.objects[i];
+        cGenericObject* haptic = nullptr;
+
+        if (desc.type != SCENE_OBJECT_MESH) {
+            haptic = newShapeTwin(desc, a_renderObjects[i], a_replicaPool);
+        } else {
+            MeshAsset asset;
+            if (!asset.load(desc.meshFile, desc.scale, a_useMeshCache, a_error)) {
+                return false;
+            }
+            haptic = newHapticMesh(desc, asset.view(), a_replicaPool);
+            haptic->m_material = a_renderObjects[i]->m_material;
+        }
+
+        placeHapticTwin(desc, rotationFromDegrees(desc.rotationDeg), haptic);
+        a_replicaWorld->addChild(haptic);
+        a_replicaObjects.push_back(haptic);
+    }
+    return true;
+}
+
+//===========================================================================
+// PRIMITIVE BATCH
+//===========================================================================
+
+size_t buildPrimitiveBatch(const SceneDescription& a_scene,
+                           const vector<cGenericObject*>& a_hapticObjects,
+                           PrimitiveBatch& a_batch, vector<PrimitiveHandle>& a_handles) {
+    const PrimitiveHandle none = { PRIMITIVE_NONE, 0 };
+    a_handles.assign(a_hapticObjects.size(), none);
+
+    size_t count = 0;
+    for (size_t i = 0; i < a_scene.objects.size() && i < a_hapticObjects.size(); i++) {
+        const SceneObjectDesc& desc = a_scene.objects[i];
+        if (!desc.haptic || desc.type == SCENE_OBJECT_MESH) {
+            continue;
+        }
+
+        // Twins are direct children of the world: local pose = world pose
+        cGenericObject* twin = a_hapticObjects[i];
+        const cVector3d pos = twin->getLocalPos();
+        const cMatrix3d rot = twin->getLocalRot();
+        const double center[3] = { pos.x(), pos.y(), pos.z() };
+        double rows[9];
+        for (int k = 0; k < 9; k++) {
+            rows[k] = rot(k / 3, k % 3);
+        }
+
+        const SessionMaterial& m = desc.material;
+        if (desc.type == SCENE_OBJECT_SPHERE) {
+            a_handles[i] = a_batch.addSphere(center, desc.radius, m.stiffness, m.dynamicFriction);
+        } else {
+            a_handles[i] = a_batch.addBox(center, rows, desc.size, m.stiffness, m.dynamicFriction);
+        }
+        twin->setHapticEnabled(false);
+        count++;
+    }
+    return count;
+}
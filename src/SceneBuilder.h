@@ -0,0 +1,135 @@
+/****************************************************************************
+ * AIMLAB - Scene Builder
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.4
+ *
+ * Description:
+ *   Turns a SceneDescription into CHAI3D objects. Each object is created
+ *   twice, like the original sphere: once in the render world and once as
+ *   a haptic twin in the haptic world, at the same index of renderObjects
+ *   and hapticObjects (the bridge object_id).
+ *
+ *   Meshes come from MeshAsset, mapped from their .aimmesh cache when it
+ *   is current. Only the haptic twin gets a collision detector, a
+ *   CachedCollisionAABB that adopts the tree stored in the cache instead
+ *   of building one with createAABBCollisionDetector().
+ *
+ *   Each additional haptic device gets its own haptic world replica
+ *   (buildHapticReplica()), so no two haptic threads touch the same object.
+ *
+ *   With --primitive-batch, buildPrimitiveBatch() moves a world's haptic
+ *   spheres and boxes into a PrimitiveBatch.
+ *
+ *   Every object is created in a SceneNodePool: render objects in the
+ *   render world's, twins in their haptic world's, so each haptic thread
+ *   traverses nodes that lie together. Twins are built from the
+ *   description, not with copy(), for the same reason.
+ *
+ * Changelog:
+ *   v1.4 - 16 October 2026 - Objects and twins created in scene node pools
+ *   v1.3 - 16 October 2026 - buildPrimitiveBatch()
+ *   v1.2 - 16 October 2026 - Local bounds of each object for the broad phase
+ *   v1.1 - 16 October 2026 - buildHapticReplica() for per-device haptic worlds
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SCENE_BUILDER_H
+#define AIMLAB_SCENE_BUILDER_H
+
+#include "chai3d.h"
+#include "Arena.h"
+#include "MeshCache.h"
+#include "PrimitiveBatch.h"
+#include "SceneDescription.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief cCollisionAABB over a prebuilt tree
+ *
+ * Fills the node array cCollisionAABB::initialize() would build (leaves
+ * first, root last, leaf m_leftSubTree = triangle index) and keeps
+ * CHAI3D's own traversal for the queries.
+ */
+class CachedCollisionAABB : public chai3d::cCollisionAABB {
+public:
+    /**
+     * @param a_view   Mesh the tree was built for
+     * @param a_mesh   CHAI3D mesh holding the same triangles, in the same order
+     * @param a_radius Collision radius added to every box
+     */
+    void adopt(const MeshView& a_view, chai3d::cMesh* a_mesh, double a_radius);
+};
+
+/**
+ * @brief Axis-aligned box of an object in its own frame
+ */
+struct ObjectBounds {
+    double min[3];
+    double max[3];
+};
+
+/**
+ * @brief Point the camera and light as the scene describes
+ */
+void applySceneView(const SceneDescription& a_scene, chai3d::cCamera* a_camera,
+                    chai3d::cDirectionalLight* a_light);
+
+/**
+ * @brief Create every object of the scene in both worlds
+ *
+ * @param a_useMeshCache    false parses meshes and leaves their caches alone
+ * @param a_renderPool      Holds the render-world objects
+ * @param a_hapticPool      Holds the haptic twins
+ * @param a_renderObjects   Receives the render-world objects, in scene order
+ * @param a_hapticObjects   Receives their haptic twins, in scene order
+ * @param a_localBounds     Receives each object's local box, in scene order
+ * @param a_error           Receives the reason on failure
+ */
+bool buildScene(const SceneDescription& a_scene, bool a_useMeshCache,
+                chai3d::cWorld* a_world, chai3d::cWorld* a_hapticWorld,
+                SceneNodePool& a_renderPool, SceneNodePool& a_hapticPool,
+                std::vector<chai3d::cGenericObject*>& a_renderObjects,
+                std::vector<chai3d::cGenericObject*>& a_hapticObjects,
+                std::vector<ObjectBounds>& a_localBounds,
+                std::string& a_error);
+
+/**
+ * @brief Create another set of haptic twins in a separate haptic world
+ *
+ * Twins share the render objects' materials, as buildScene()'s do. Meshes
+ * are mapped again from their cache; each replica gets its own vertices
+ * and collision tree.
+ *
+ * @param a_renderObjects   Render objects from buildScene(), in scene order
+ * @param a_replicaPool     Holds the new twins
+ * @param a_replicaObjects  Receives the new twins, in scene order
+ */
+bool buildHapticReplica(const SceneDescription& a_scene, bool a_useMeshCache,
+                        const std::vector<chai3d::cGenericObject*>& a_renderObjects,
+                        chai3d::cWorld* a_replicaWorld, SceneNodePool& a_replicaPool,
+                        std::vector<chai3d::cGenericObject*>& a_replicaObjects,
+                        std::string& a_error);
+
+/**
+ * @brief Hand a haptic world's spheres and boxes to a PrimitiveBatch
+ *
+ * Every haptic-enabled sphere and box is added to a_batch with its
+ * material's stiffness and dynamic friction, at its twin's pose. The twin
+ * stays in the world for its transform but is no longer haptic-enabled,
+ * so the tool's proxy algorithm skips it.
+ *
+ * @param a_hapticObjects  Twins from buildScene() or buildHapticReplica()
+ * @param a_handles        Receives each object's batch entry, in scene
+ *                         order (PRIMITIVE_NONE: left to CHAI3D)
+ * @return Number of objects moved into the batch
+ */
+size_t buildPrimitiveBatch(const SceneDescription& a_scene,
+                           const std::vector<chai3d::cGenericObject*>& a_hapticObjects,
+                           PrimitiveBatch& a_batch, std::vector<PrimitiveHandle>& a_handles);
+
+#endif // AIMLAB_SCENE_BUILDER_H
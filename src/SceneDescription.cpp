@@ -0,0 +1,245 @@
+/****************************************************************************
+ * AIMLAB - Scene Description
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of the scene file parser. See SceneDescription.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "SceneDescription.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+//===========================================================================
+// HELPERS
+//===========================================================================
+
+static bool toDouble(const string& a_token, double& a_value) {
+    char* end = nullptr;
+    a_value = strtod(a_token.c_str(), &end);
+    return end != a_token.c_str() && *end == '\0';
+}
+
+/**
+ * @brief Read a_count numbers starting at a_tokens[a_first]
+ */
+static bool readNumbers(const vector<string>& a_tokens, size_t a_first, int a_count,
+                        double* a_out) {
+    if (a_first + a_count > a_tokens.size()) {
+        return false;
+    }
+    for (int k = 0; k < a_count; k++) {
+        if (!toDouble(a_tokens[a_first + k], a_out[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static string directoryOf(const string& a_path) {
+    const size_t slash = a_path.find_last_of("/\\");
+    return (slash == string::npos) ? string() : a_path.substr(0, slash + 1);
+}
+
+static bool isAbsolute(const string& a_path) {
+    return (!a_path.empty() && (a_path[0] == '/' || a_path[0] == '\\')) ||
+           (a_path.size() > 1 && a_path[1] == ':');
+}
+
+//===========================================================================
+// DEFAULT SCENE
+//===========================================================================
+
+SceneDescription defaultSceneDescription() {
+    SceneDescription scene;
+    SceneObjectDesc sphere;
+    sphere.type = SCENE_OBJECT_SPHERE;
+    sphere.name = "sphere";
+    sphere.radius = 0.03;
+    scene.objects.push_back(sphere);
+    return scene;
+}
+
+//===========================================================================
+// PARSER
+//===========================================================================
+
+/**
+ * @brief Apply "key value..." pairs from a camera or light line
+ */
+static bool parseKeyValues(const vector<string>& a_tokens, SceneDescription& a_scene,
+                           string& a_reason) {
+    const bool isCamera = (a_tokens[0] == "camera");
+    SceneCamera& cam = a_scene.camera;
+
+    size_t i = 1;
+    while (i < a_tokens.size()) {
+        const string& key = a_tokens[i];
+        double* target = nullptr;
+        int count = 0;
+        double scalar[2];
+
+        if (isCamera && key == "eye")         { target = cam.eye;    count = 3; }
+        else if (isCamera && key == "lookat") { target = cam.lookAt; count = 3; }
+        else if (isCamera && key == "up")     { target = cam.up;     count = 3; }
+        else if (isCamera && key == "fov")    { target = scalar;     count = 1; }
+        else if (isCamera && key == "clip")   { target = scalar;     count = 2; }
+        else if (!isCamera && key == "dir")   { target = a_scene.light.direction; count = 3; }
+        else {
+            a_reason = "unknown " + a_tokens[0] + " setting '" + key + "'";
+            return false;
+        }
+
+        if (!readNumbers(a_tokens, i + 1, count, target)) {
+            a_reason = a_tokens[0] + " " + key + " needs " + to_string(count) + " number(s)";
+            return false;
+        }
+        if (key == "fov") {
+            cam.fovDeg = scalar[0];
+        } else if (key == "clip") {
+            cam.nearClip = scalar[0];
+            cam.farClip = scalar[1];
+        }
+        i += 1 + count;
+    }
+    return true;
+}
+
+/**
+ * @brief Apply one property line to the current object
+ */
+static bool parseProperty(const vector<string>& a_tokens, SceneObjectDesc& a_object,
+                          string& a_reason) {
+    const string& key = a_tokens[0];
+    SessionMaterial& m = a_object.material;
+    double v[3];
+    bool ok = true;
+
+    if (key == "position") {
+        ok = readNumbers(a_tokens, 1, 3, a_object.position);
+    } else if (key == "rotation") {
+        ok = readNumbers(a_tokens, 1, 3, a_object.rotationDeg);
+    } else if (key == "color") {
+        ok = readNumbers(a_tokens, 1, 3, a_object.color);
+    } else if (key == "stiffness") {
+        ok = readNumbers(a_tokens, 1, 1, &m.stiffness) && m.stiffness >= 0.0;
+    } else if (key == "friction") {
+        ok = readNumbers(a_tokens, 1, 2, v) && v[0] >= 0.0 && v[1] >= 0.0;
+        m.staticFriction = v[0];
+        m.dynamicFriction = v[1];
+    } else if (key == "viscosity") {
+        ok = readNumbers(a_tokens, 1, 1, &m.viscosity) && m.viscosity >= 0.0;
+    } else if (key == "haptic") {
+        ok = a_tokens.size() == 2 && (a_tokens[1] == "on" || a_tokens[1] == "off");
+        a_object.haptic = ok && a_tokens[1] == "on";
+    } else if (key == "radius" && a_object.type == SCENE_OBJECT_SPHERE) {
+        ok = readNumbers(a_tokens, 1, 1, &a_object.radius) && a_object.radius > 0.0;
+    } else if (key == "size" && a_object.type == SCENE_OBJECT_BOX) {
+        ok = readNumbers(a_tokens, 1, 3, a_object.size) &&
+             a_object.size[0] > 0.0 && a_object.size[1] > 0.0 && a_object.size[2] > 0.0;
+    } else if (key == "file" && a_object.type == SCENE_OBJECT_MESH) {
+        ok = a_tokens.size() == 2;
+        if (ok) {
+            a_object.meshFile = a_tokens[1];
+        }
+    } else if (key == "scale" && a_object.type == SCENE_OBJECT_MESH) {
+        ok = readNumbers(a_tokens, 1, 1, &a_object.scale) && a_object.scale > 0.0;
+    } else {
+        a_reason = "unknown property '" + key + "' for " + a_object.name;
+        return false;
+    }
+
+    if (!ok) {
+        a_reason = "invalid value for " + key;
+    }
+    return ok;
+}
+
+bool loadSceneDescription(const string& a_filename, SceneDescription& a_scene,
+                          string& a_error) {
+    ifstream in(a_filename.c_str());
+    if (!in) {
+        a_error = "cannot open scene file " + a_filename;
+        return false;
+    }
+
+    SceneDescription scene;
+    scene.sourceFile = a_filename;
+    const string baseDir = directoryOf(a_filename);
+
+    string line;
+    int lineNumber = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        const size_t hash = line.find('#');
+        if (hash != string::npos) {
+            line.erase(hash);
+        }
+
+        istringstream words(line);
+        vector<string> tokens;
+        string token;
+        while (words >> token) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+
+        string reason;
+        bool ok = true;
+        const string& keyword = tokens[0];
+        if (keyword == "camera" || keyword == "light") {
+            ok = parseKeyValues(tokens, scene, reason);
+        } else if (keyword == "sphere" || keyword == "box" || keyword == "mesh") {
+            SceneObjectDesc object;
+            object.type = (keyword == "sphere") ? SCENE_OBJECT_SPHERE
+                        : (keyword == "box")    ? SCENE_OBJECT_BOX : SCENE_OBJECT_MESH;
+            object.name = (tokens.size() > 1) ? tokens[1]
+                                              : keyword + to_string(scene.objects.size());
+            scene.objects.push_back(object);
+        } else if (scene.objects.empty()) {
+            reason = "'" + keyword + "' before the first sphere, box or mesh";
+            ok = false;
+        } else {
+            ok = parseProperty(tokens, scene.objects.back(), reason);
+        }
+
+        if (!ok) {
+            a_error = a_filename + ":" + to_string(lineNumber) + ": " + reason;
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < scene.objects.size(); i++) {
+        SceneObjectDesc& object = scene.objects[i];
+        if (object.type != SCENE_OBJECT_MESH) {
+            continue;
+        }
+        if (object.meshFile.empty()) {
+            a_error = a_filename + ": mesh " + object.name + " has no file";
+            return false;
+        }
+        if (!isAbsolute(object.meshFile)) {
+            object.meshFile = baseDir + object.meshFile;
+        }
+    }
+    if (scene.objects.empty()) {
+        a_error = a_filename + ": scene has no objects";
+        return false;
+    }
+
+    a_scene = scene;
+    return true;
+}
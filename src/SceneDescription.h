@@ -0,0 +1,110 @@
+/****************************************************************************
+ * AIMLAB - Scene Description
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Data-driven scene for aimlab-haptics (--scene FILE): camera, light and
+ *   a list of spheres, boxes and meshes with their placement, color and
+ *   haptic material. Parsing has no CHAI3D dependency; SceneBuilder turns
+ *   a description into render and haptic objects.
+ *
+ *   File format (.scene, plain text, '#' starts a comment):
+ *
+ *     camera eye 0.5 0 0.3  lookat 0 0 0  up 0 0 1  fov 45  clip 0.01 10
+ *     light  dir -1 -1 -1
+ *
+ *     sphere target              # object lines: sphere|box|mesh NAME
+ *         radius    0.03         # properties apply to the object above
+ *         position  0 0 0
+ *         color     0.86 0.08 0.24
+ *         stiffness 1000
+ *         friction  0.3 0.2      # static, dynamic
+ *         viscosity 0.1
+ *
+ *     box wall
+ *         size      0.1 0.01 0.1
+ *         rotation  0 0 45       # degrees about x, then y, then z
+ *
+ *     mesh bunny
+ *         file      bunny.obj    # relative to the scene file
+ *         scale     0.1
+ *         haptic    off
+ *
+ *   Objects keep file order; it is the object_id Unity uses on the bridge.
+ *   defaultSceneDescription() is the built-in scene (one crimson sphere),
+ *   used when no --scene is given.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SCENE_DESCRIPTION_H
+#define AIMLAB_SCENE_DESCRIPTION_H
+
+#include "HapticRecord.h"
+
+#include <string>
+#include <vector>
+
+enum SceneObjectType {
+    SCENE_OBJECT_SPHERE,
+    SCENE_OBJECT_BOX,
+    SCENE_OBJECT_MESH
+};
+
+struct SceneCamera {
+    double eye[3]    = { 0.5, 0.0, 0.3 };
+    double lookAt[3] = { 0.0, 0.0, 0.0 };
+    double up[3]     = { 0.0, 0.0, 1.0 };
+    double fovDeg    = 45.0;
+    double nearClip  = 0.01;
+    double farClip   = 10.0;
+};
+
+struct SceneLight {
+    double direction[3] = { -1.0, -1.0, -1.0 };
+};
+
+struct SceneObjectDesc {
+    SceneObjectType type = SCENE_OBJECT_SPHERE;
+    std::string name;
+    double position[3] = { 0.0, 0.0, 0.0 };
+    double rotationDeg[3] = { 0.0, 0.0, 0.0 };  // extrinsic x, y, z
+    double color[3] = { 0.862745, 0.078431, 0.235294 };  // crimson
+    bool haptic = true;
+    SessionMaterial material = { 1000.0, 0.3, 0.2, 0.1 };
+
+    double radius = 0.03;                       // sphere (m)
+    double size[3] = { 0.05, 0.05, 0.05 };      // box edge lengths (m)
+    std::string meshFile;                       // mesh: .obj, resolved to the scene's directory
+    double scale = 1.0;                         // mesh: applied to vertex positions
+};
+
+struct SceneDescription {
+    std::string sourceFile;                     // empty for the built-in scene
+    SceneCamera camera;
+    SceneLight light;
+    std::vector<SceneObjectDesc> objects;
+};
+
+/**
+ * @brief The scene aimlab-haptics used before scene files: one 30 mm sphere
+ */
+SceneDescription defaultSceneDescription();
+
+/**
+ * @brief Parse a scene file
+ *
+ * @param a_filename .scene file
+ * @param a_scene    Receives the scene; mesh paths are made relative to the
+ *                   working directory
+ * @param a_error    Receives "file:line: reason" on failure
+ */
+bool loadSceneDescription(const std::string& a_filename, SceneDescription& a_scene,
+                          std::string& a_error);
+
+#endif // AIMLAB_SCENE_DESCRIPTION_H
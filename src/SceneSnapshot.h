@@ -0,0 +1,52 @@
+/****************************************************************************
+ * AIMLAB - Haptic Scene Snapshot
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Everything the render thread needs from the haptic thread, copied once
+ *   per haptic tick: tool state plus the global transform of every shared
+ *   object. The haptic thread owns its own cWorld (tool + haptic twins);
+ *   the render thread owns the visible cWorld and applies the latest
+ *   snapshot to it before drawing. The two scene graphs are never touched
+ *   by the other thread.
+ *
+ *   Plain old data so it can live in a TripleBuffer; sized for the same
+ *   object count as the Unity bridge.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SCENE_SNAPSHOT_H
+#define AIMLAB_SCENE_SNAPSHOT_H
+
+#include "TripleBuffer.h"
+#include "bridge/aimlab_bridge.h"
+
+#include <cstdint>
+
+#define SCENE_SNAPSHOT_MAX_OBJECTS AIMLAB_BRIDGE_MAX_OBJECTS
+
+struct SnapshotTransform {
+    double pos[3];              // global position (m)
+    double rot[9];              // global rotation, row-major
+};
+
+struct SceneSnapshot {
+    uint64_t tick;              // haptic tick that produced it, 0 = none yet
+    uint64_t timestampNs;       // hapticNowNs() at publish
+    double devicePos[3];        // tool->getDeviceGlobalPos()
+    double proxyPos[3];         // tool->m_hapticPoint->getGlobalPosProxy()
+    double goalPos[3];          // tool->m_hapticPoint->getGlobalPosGoal()
+    double force[3];            // tool->getDeviceGlobalForce()
+    uint32_t objectCount;
+    SnapshotTransform objects[SCENE_SNAPSHOT_MAX_OBJECTS];
+};
+
+typedef TripleBuffer<SceneSnapshot> SceneSnapshotBuffer;
+
+#endif // AIMLAB_SCENE_SNAPSHOT_H
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * AIMLAB - Haptic Session Reader
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of SessionReader. See SessionReader.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Accept format versions 1 and 2
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "SessionReader.h"
+
+#include <cstring>
+
+using namespace std;
+
+static int seekTo(FILE* a_file, uint64_t a_offset, int a_origin) {
+#ifdef _WIN32
+    return _fseeki64(a_file, (long long)a_offset, a_origin);
+#else
+    return fseeko(a_file, (off_t)a_offset, a_origin);
+#endif
+}
+
+static uint64_t tellFrom(FILE* a_file) {
+#ifdef _WIN32
+    return (uint64_t)_ftelli64(a_file);
+#else
+    return (uint64_t)ftello(a_file);
+#endif
+}
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+SessionReader::SessionReader()
+    : m_file(nullptr),
+      m_recordCount(0),
+      m_index(0),
+      m_timestampNs(0) {
+    memset(&m_header, 0, sizeof(m_header));
+}
+
+SessionReader::~SessionReader() {
+    close();
+}
+
+//===========================================================================
+// OPEN / CLOSE
+//===========================================================================
+
+bool SessionReader::open(const string& a_filename, string& a_error) {
+    close();
+
+    m_file = fopen(a_filename.c_str(), "rb");
+    if (m_file == nullptr) {
+        a_error = "cannot open " + a_filename;
+        return false;
+    }
+
+    if (fread(&m_header, sizeof(m_header), 1, m_file) != 1 ||
+        memcmp(m_header.magic, AIMLAB_REC_MAGIC, sizeof(m_header.magic)) != 0) {
+        a_error = a_filename + " is not an AIMLAB session recording";
+        close();
+        return false;
+    }
+    if (m_header.version < 1 || m_header.version > AIMLAB_REC_VERSION) {
+        a_error = a_filename + ": unsupported recording version " + to_string(m_header.version);
+        close();
+        return false;
+    }
+    if (m_header.recordBytes != sizeof(HapticRecordDisk) ||
+        m_header.headerBytes < sizeof(SessionFileHeader)) {
+        a_error = a_filename + ": unexpected header or record size";
+        close();
+        return false;
+    }
+
+    seekTo(m_file, 0, SEEK_END);
+    const uint64_t size = tellFrom(m_file);
+    m_recordCount = (size > m_header.headerBytes)
+                  ? (size - m_header.headerBytes) / m_header.recordBytes : 0;
+
+    rewind();
+    return true;
+}
+
+void SessionReader::close() {
+    if (m_file != nullptr) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+    m_recordCount = 0;
+    m_index = 0;
+}
+
+void SessionReader::rewind() {
+    if (m_file == nullptr) {
+        return;
+    }
+    seekTo(m_file, m_header.headerBytes, SEEK_SET);
+    m_index = 0;
+    m_timestampNs = m_header.startNs;
+}
+
+//===========================================================================
+// RECORDS
+//===========================================================================
+
+bool SessionReader::next(HapticRecord& a_record, uint32_t* a_dropped) {
+    if (m_file == nullptr || m_index >= m_recordCount) {
+        return false;
+    }
+
+    HapticRecordDisk d;
+    if (fread(&d, sizeof(d), 1, m_file) != 1) {
+        return false;
+    }
+    m_index++;
+    m_timestampNs += d.deltaNs;
+
+    a_record.timestampNs = m_timestampNs;
+    a_record.device = d.device;
+    memcpy(a_record.proxyPos, d.proxyPos, sizeof(a_record.proxyPos));
+    memcpy(a_record.force, d.force, sizeof(a_record.force));
+    memcpy(a_record.torque, d.torque, sizeof(a_record.torque));
+    a_record.gripperForce = d.gripperForce;
+    if (a_dropped != nullptr) {
+        *a_dropped = d.dropped;
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+/****************************************************************************
+ * AIMLAB - Haptic Session Reader
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Sequential reader for .aimrec files written by SessionRecorder.
+ *   Validates the header, then returns records in order with absolute
+ *   timestamps rebuilt from the stored deltas. Plain buffered stdio, so
+ *   it works on any platform the file is copied to.
+ *
+ *   Older format versions are accepted; header fields they lack read as
+ *   zero (check header().version before relying on them).
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Accept format versions 1 and 2
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SESSION_READER_H
+#define AIMLAB_SESSION_READER_H
+
+#include "HapticRecord.h"
+
+#include <cstdio>
+#include <string>
+
+class SessionReader {
+public:
+    SessionReader();
+    ~SessionReader();
+
+    SessionReader(const SessionReader&) = delete;
+    SessionReader& operator=(const SessionReader&) = delete;
+
+    /**
+     * @brief Open a recording and check its header
+     *
+     * @param a_filename .aimrec file
+     * @param a_error    Receives the reason on failure
+     */
+    bool open(const std::string& a_filename, std::string& a_error);
+
+    void close();
+
+    const SessionFileHeader& header() const { return m_header; }
+
+    /** @brief Complete records in the file (a torn trailing record is ignored) */
+    uint64_t recordCount() const { return m_recordCount; }
+
+    /**
+     * @brief Read the next record
+     *
+     * @param a_record  Receives the record with its absolute timestamp
+     * @param a_dropped If not null, receives the records dropped just before it
+     * @return false at end of file or on a read error
+     */
+    bool next(HapticRecord& a_record, uint32_t* a_dropped = nullptr);
+
+    /** @brief Go back to the first record */
+    void rewind();
+
+private:
+    FILE* m_file;
+    SessionFileHeader m_header;
+    uint64_t m_recordCount;
+    uint64_t m_index;
+    uint64_t m_timestampNs;
+};
+
+#endif // AIMLAB_SESSION_READER_H
@@ -0,0 +1,364 @@
+/****************************************************************************
+ * AIMLAB - Haptic Session Recorder
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Implementation of SessionRecorder. See SessionRecorder.h.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - open() takes the descriptive header fields from the caller;
+ *                            addFlags()
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "SessionRecorder.h"
+#include "HapticClock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+// Writer buffer and how full it gets before whole blocks are written out
+static const size_t RECORDER_BUFFER_BYTES = 1024 * 1024;
+static const size_t RECORDER_FLUSH_BYTES  = 256 * 1024;
+
+// Writer poll interval while the ring is empty (ring holds seconds of ticks)
+static const int RECORDER_IDLE_MS = 2;
+
+//===========================================================================
+// ALIGNED BUFFER
+//===========================================================================
+
+static unsigned char* allocateAligned(size_t a_bytes) {
+#ifdef _WIN32
+    return (unsigned char*)_aligned_malloc(a_bytes, AIMLAB_REC_BLOCK_BYTES);
+#else
+    void* memory = nullptr;
+    if (posix_memalign(&memory, AIMLAB_REC_BLOCK_BYTES, a_bytes) != 0) {
+        return nullptr;
+    }
+    return (unsigned char*)memory;
+#endif
+}
+
+static void freeAligned(unsigned char* a_memory) {
+#ifdef _WIN32
+    _aligned_free(a_memory);
+#else
+    free(a_memory);
+#endif
+}
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+SessionRecorder::SessionRecorder(size_t a_ringCapacity)
+    : m_ring(a_ringCapacity),
+      m_open(false),
+      m_droppedSinceLast(0),
+      m_dropped(0),
+      m_stopRequested(false),
+      m_writeFailed(false),
+      m_buffer(nullptr),
+      m_bufferBytes(0),
+      m_bufferFill(0),
+      m_fileOffset(0),
+      m_lastTimestampNs(0),
+      m_recordsWritten(0),
+#ifdef _WIN32
+      m_file(nullptr),
+#else
+      m_fd(-1),
+#endif
+      m_directIO(false),
+      m_openedNs(0),
+      m_flags(0) {
+    memset(&m_header, 0, sizeof(m_header));
+}
+
+SessionRecorder::~SessionRecorder() {
+    close();
+}
+
+//===========================================================================
+// OPEN / CLOSE
+//===========================================================================
+
+bool SessionRecorder::open(const string& a_filename, const SessionFileHeader& a_header,
+                           string& a_error) {
+    if (m_open) {
+        a_error = "recorder already open";
+        return false;
+    }
+
+    m_buffer = allocateAligned(RECORDER_BUFFER_BYTES);
+    if (m_buffer == nullptr) {
+        a_error = "out of memory";
+        return false;
+    }
+    m_bufferBytes = RECORDER_BUFFER_BYTES;
+
+#ifdef _WIN32
+    m_file = fopen(a_filename.c_str(), "wb");
+    if (m_file == nullptr) {
+        a_error = "cannot create " + a_filename;
+        freeAligned(m_buffer);
+        m_buffer = nullptr;
+        return false;
+    }
+    m_directIO = false;
+#else
+    m_fd = -1;
+    m_directIO = false;
+#ifdef O_DIRECT
+    m_fd = ::open(a_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    m_directIO = (m_fd >= 0);
+#endif
+    if (m_fd < 0) {
+        m_fd = ::open(a_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (m_fd < 0) {
+        a_error = "cannot create " + a_filename + ": " + strerror(errno);
+        freeAligned(m_buffer);
+        m_buffer = nullptr;
+        return false;
+    }
+#endif
+
+    // Header occupies the first block so records start block-aligned
+    const uint64_t startNs = hapticNowNs();
+    memset(m_buffer, 0, AIMLAB_REC_HEADER_BYTES);
+    SessionFileHeader* header = (SessionFileHeader*)m_buffer;
+    *header = a_header;
+    memcpy(header->magic, AIMLAB_REC_MAGIC, sizeof(header->magic));
+    header->version = AIMLAB_REC_VERSION;
+    header->headerBytes = AIMLAB_REC_HEADER_BYTES;
+    header->recordBytes = sizeof(HapticRecordDisk);
+    header->startNs = startNs;
+    header->deviceModel[sizeof(header->deviceModel) - 1] = '\0';
+    m_header = *header;
+    m_flags = header->flags;
+
+    m_stats = SessionRecorderStats();
+    m_fileOffset = 0;
+    m_bufferFill = AIMLAB_REC_HEADER_BYTES;
+    m_writeFailed = false;
+    if (!writeBlocks(AIMLAB_REC_HEADER_BYTES)) {
+        a_error = "cannot write header to " + a_filename;
+        m_open = true;
+        close();
+        return false;
+    }
+
+    m_lastTimestampNs = startNs;
+    m_recordsWritten = 0;
+    m_droppedSinceLast = 0;
+    m_dropped = 0;
+    m_openedNs = startNs;
+    m_stopRequested = false;
+    m_open = true;
+    m_writer = thread(&SessionRecorder::writerLoop, this);
+    return true;
+}
+
+const SessionRecorderStats& SessionRecorder::close() {
+    if (!m_open) {
+        return m_stats;
+    }
+
+    m_stopRequested.store(true, memory_order_release);
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+
+    // Everything the producer queued before close() is now visible here
+    while (drain() > 0) {
+        if (m_bufferFill + sizeof(HapticRecordDisk) > m_bufferBytes) {
+            writeBlocks(m_bufferFill & ~(size_t)(AIMLAB_REC_BLOCK_BYTES - 1));
+        }
+    }
+
+    // Pad the tail to a whole block, write it, then cut the file back
+    const uint64_t length = m_fileOffset + m_bufferFill;
+    if (m_bufferFill > 0) {
+        const size_t padded = (m_bufferFill + AIMLAB_REC_BLOCK_BYTES - 1)
+                            & ~(size_t)(AIMLAB_REC_BLOCK_BYTES - 1);
+        memset(m_buffer + m_bufferFill, 0, padded - m_bufferFill);
+        m_bufferFill = padded;
+        writeBlocks(padded);
+    }
+
+    // Flags raised while recording: rewrite the header block in place
+    if (m_flags.load() != m_header.flags) {
+        m_header.flags = m_flags.load();
+        memset(m_buffer, 0, AIMLAB_REC_HEADER_BYTES);
+        memcpy(m_buffer, &m_header, sizeof(m_header));
+        writeAt(m_buffer, AIMLAB_REC_HEADER_BYTES, 0);
+    }
+
+#ifdef _WIN32
+    if (m_file != nullptr) {
+        fclose((FILE*)m_file);
+        m_file = nullptr;
+    }
+#else
+    if (m_fd >= 0) {
+        if (ftruncate(m_fd, (off_t)length) != 0) {
+            m_writeFailed = true;
+        }
+        ::close(m_fd);
+        m_fd = -1;
+    }
+#endif
+
+    freeAligned(m_buffer);
+    m_buffer = nullptr;
+    m_open = false;
+
+    m_stats.records = m_recordsWritten;
+    m_stats.dropped = m_dropped.load(memory_order_relaxed);
+    m_stats.bytes = length;
+    m_stats.seconds = (double)(hapticNowNs() - m_openedNs) * 1e-9;
+    m_stats.directIO = m_directIO;
+    m_stats.writeError = m_writeFailed.load();
+    return m_stats;
+}
+
+//===========================================================================
+// PRODUCER
+//===========================================================================
+
+bool SessionRecorder::record(const HapticRecord& a_record) {
+    Entry entry;
+    entry.record = a_record;
+    entry.droppedBefore = m_droppedSinceLast;
+    if (!m_ring.tryPush(entry)) {
+        m_droppedSinceLast++;
+        m_dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    m_droppedSinceLast = 0;
+    return true;
+}
+
+//===========================================================================
+// WRITER
+//===========================================================================
+
+void SessionRecorder::writerLoop() {
+    while (!m_stopRequested.load(memory_order_acquire)) {
+        const size_t drained = drain();
+
+        if (m_bufferFill >= RECORDER_FLUSH_BYTES ||
+            m_bufferFill + sizeof(HapticRecordDisk) > m_bufferBytes) {
+            writeBlocks(m_bufferFill & ~(size_t)(AIMLAB_REC_BLOCK_BYTES - 1));
+        }
+        if (drained == 0) {
+            this_thread::sleep_for(chrono::milliseconds(RECORDER_IDLE_MS));
+        }
+    }
+}
+
+/**
+ * @brief Move queued records into the write buffer until it is full
+ *
+ * @return Number of records encoded
+ */
+size_t SessionRecorder::drain() {
+    size_t count = 0;
+    Entry entry;
+
+    while (m_bufferFill + sizeof(HapticRecordDisk) <= m_bufferBytes && m_ring.tryPop(entry)) {
+        const HapticRecord& r = entry.record;
+        HapticRecordDisk* d = (HapticRecordDisk*)(m_buffer + m_bufferFill);
+
+        const uint64_t delta = (r.timestampNs > m_lastTimestampNs)
+                             ? r.timestampNs - m_lastTimestampNs : 0;
+        d->deltaNs = (delta > 0xFFFFFFFFull) ? 0xFFFFFFFFu : (uint32_t)delta;
+        d->dropped = (entry.droppedBefore > 0xFFFFFFFFull) ? 0xFFFFFFFFu
+                                                           : (uint32_t)entry.droppedBefore;
+        d->device = r.device;
+        memcpy(d->proxyPos, r.proxyPos, sizeof(d->proxyPos));
+        memcpy(d->force, r.force, sizeof(d->force));
+        memcpy(d->torque, r.torque, sizeof(d->torque));
+        d->gripperForce = r.gripperForce;
+
+        m_lastTimestampNs += d->deltaNs;
+        m_bufferFill += sizeof(HapticRecordDisk);
+        m_recordsWritten++;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Write the first a_bytes (whole blocks) of the buffer and keep the rest
+ */
+bool SessionRecorder::writeBlocks(size_t a_bytes) {
+    if (a_bytes == 0) {
+        return true;
+    }
+    const bool ok = writeAt(m_buffer, a_bytes, m_fileOffset);
+    m_fileOffset += a_bytes;
+    m_bufferFill -= a_bytes;
+    if (m_bufferFill > 0) {
+        memmove(m_buffer, m_buffer + a_bytes, m_bufferFill);
+    }
+    return ok;
+}
+
+bool SessionRecorder::writeAt(const void* a_data, size_t a_bytes, uint64_t a_offset) {
+    m_stats.writeCalls++;
+
+#ifdef _WIN32
+    FILE* file = (FILE*)m_file;
+    if (_fseeki64(file, (long long)a_offset, SEEK_SET) != 0 ||
+        fwrite(a_data, 1, a_bytes, file) != a_bytes) {
+        m_writeFailed = true;
+        return false;
+    }
+    return true;
+#else
+    const unsigned char* data = (const unsigned char*)a_data;
+    while (a_bytes > 0) {
+        const ssize_t written = pwrite(m_fd, data, a_bytes, (off_t)a_offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+#ifdef O_DIRECT
+            // Some file systems accept O_DIRECT at open() and refuse it here
+            if (errno == EINVAL && m_directIO) {
+                const int flags = fcntl(m_fd, F_GETFL);
+                if (flags >= 0 && fcntl(m_fd, F_SETFL, flags & ~O_DIRECT) == 0) {
+                    m_directIO = false;
+                    continue;
+                }
+            }
+#endif
+            m_writeFailed = true;
+            return false;
+        }
+        data += written;
+        a_bytes -= (size_t)written;
+        a_offset += (uint64_t)written;
+    }
+    return true;
+#endif
+}
@@ -0,0 +1,151 @@
+/****************************************************************************
+ * AIMLAB - Haptic Session Recorder
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Records every haptic tick to a .aimrec file (format in HapticRecord.h)
+ *   without putting file I/O on the haptic thread.
+ *
+ *   record() copies one HapticRecord into a preallocated SpscRing and
+ *   returns; it never allocates, locks or blocks. If the ring is full the
+ *   record is dropped and counted, and the next record that gets through
+ *   carries the count so gaps are visible in the file.
+ *
+ *   A background writer thread drains the ring, delta-encodes timestamps
+ *   into 256-byte disk records inside a 4 KiB-aligned buffer and writes
+ *   whole blocks. On Linux the file is opened with O_DIRECT so a long
+ *   session does not fill the page cache behind the haptic loop; file
+ *   systems that refuse O_DIRECT (tmpfs) fall back to buffered writes.
+ *   close() drains what is left, pads the last block and truncates the
+ *   file to its exact length.
+ *
+ *   record() is for one producer thread (the haptic thread); open() and
+ *   close() belong to the thread that owns the recorder.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - open() takes the descriptive header fields from the caller;
+ *                            addFlags()
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SESSION_RECORDER_H
+#define AIMLAB_SESSION_RECORDER_H
+
+#include "HapticRecord.h"
+#include "SpscRing.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Totals reported by SessionRecorder::close()
+ */
+struct SessionRecorderStats {
+    uint64_t records = 0;           // records written to the file
+    uint64_t dropped = 0;           // records lost to a full ring
+    uint64_t bytes = 0;             // final file size
+    double seconds = 0.0;           // open() to close()
+    uint64_t writeCalls = 0;
+    bool directIO = false;          // O_DIRECT stayed enabled to the end
+    bool writeError = false;        // a write or truncate failed; the file is incomplete
+};
+
+class SessionRecorder {
+public:
+    /**
+     * @param a_ringCapacity Records buffered between the haptic thread and
+     *                       the writer (16384 = 16 s at 1 kHz)
+     */
+    explicit SessionRecorder(size_t a_ringCapacity = 16384);
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    /**
+     * @brief Create the file, write its header and start the writer thread
+     *
+     * @param a_filename Output path (.aimrec), truncated if it exists
+     * @param a_header   Descriptive fields (rate, device, flags, material);
+     *                   magic, version, sizes and startNs are filled in here
+     * @param a_error    Receives the reason on failure
+     */
+    bool open(const std::string& a_filename, const SessionFileHeader& a_header,
+              std::string& a_error);
+
+    bool isOpen() const { return m_open; }
+
+    /**
+     * @brief Queue one tick (producer thread; wait-free, no allocation)
+     *
+     * @return false if the ring was full and the record was dropped
+     */
+    bool record(const HapticRecord& a_record);
+
+    /**
+     * @brief Stop the writer, flush everything queued and close the file
+     *
+     * @return Totals for the session (also available from stats())
+     */
+    const SessionRecorderStats& close();
+
+    const SessionRecorderStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Set header flags (any thread; wait-free), written at close()
+     *
+     * @param a_flags AIMLAB_REC_FLAG_* bits to add
+     */
+    void addFlags(uint32_t a_flags) { m_flags.fetch_or(a_flags, std::memory_order_relaxed); }
+
+    /** @brief Records dropped so far (any thread) */
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        HapticRecord record;
+        uint64_t droppedBefore;
+    };
+
+    void writerLoop();
+    size_t drain();
+    bool writeBlocks(size_t a_bytes);
+    bool writeAt(const void* a_data, size_t a_bytes, uint64_t a_offset);
+
+    SpscRing<Entry> m_ring;
+    bool m_open;
+
+    // Producer side
+    uint64_t m_droppedSinceLast;
+    std::atomic<uint64_t> m_dropped;
+
+    // Writer side
+    std::thread m_writer;
+    std::atomic<bool> m_stopRequested;
+    std::atomic<bool> m_writeFailed;
+    unsigned char* m_buffer;        // AIMLAB_REC_BLOCK_BYTES aligned
+    size_t m_bufferBytes;
+    size_t m_bufferFill;
+    uint64_t m_fileOffset;
+    uint64_t m_lastTimestampNs;
+    uint64_t m_recordsWritten;
+
+    // File
+#ifdef _WIN32
+    void* m_file;                   // FILE*
+#else
+    int m_fd;
+#endif
+    bool m_directIO;
+    uint64_t m_openedNs;
+    SessionFileHeader m_header;     // as written by open()
+    std::atomic<uint32_t> m_flags;
+    SessionRecorderStats m_stats;
+};
+
+#endif // AIMLAB_SESSION_RECORDER_H
@@ -0,0 +1,109 @@
+/****************************************************************************
+ * AIMLAB - Shared-Memory Bridge (Haptic Thread Writer)
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.2
+ *
+ * Description:
+ *   Implementation of SharedMemoryBridge. See SharedMemoryBridge.h.
+ *
+ * Changelog:
+ *   v1.2 - 16 October 2026 - One tool slot per device
+ *   v1.1 - 16 October 2026 - Per-reader pollObjectTransforms()
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "SharedMemoryBridge.h"
+
+#include <cstring>
+
+SharedMemoryBridge::SharedMemoryBridge()
+    : m_bridge(nullptr),
+      m_segment(nullptr) {
+    std::memset(m_tick, 0, sizeof(m_tick));
+    std::memset(m_reader.transforms, 0, sizeof(m_reader.transforms));
+}
+
+SharedMemoryBridge::~SharedMemoryBridge() {
+    destroy();
+}
+
+bool SharedMemoryBridge::create(const char* name, uint32_t toolCount) {
+    destroy();
+
+    m_bridge = aimlab_bridge_create(name, toolCount);
+    if (m_bridge == nullptr) {
+        return false;
+    }
+
+    m_segment = aimlab_bridge_segment_ptr(m_bridge);
+    std::memset(m_tick, 0, sizeof(m_tick));
+    m_reader.lastSeq = 0;
+    return true;
+}
+
+void SharedMemoryBridge::destroy() {
+    if (m_bridge != nullptr) {
+        aimlab_bridge_close(m_bridge);
+    }
+    m_bridge = nullptr;
+    m_segment = nullptr;
+}
+
+void SharedMemoryBridge::publishState(uint32_t tool,
+                                      const double devicePos[3],
+                                      const double proxyPos[3],
+                                      const double force[3]) {
+    if (m_segment == nullptr || tool >= AIMLAB_BRIDGE_MAX_TOOLS) {
+        return;
+    }
+
+    // Single writer per slot: its sequence value is only ever modified here
+    aimlab_tool_slot& slot = m_segment->tools[tool];
+    const uint64_t seq = slot.seq;
+    aimlab_seq_store(&slot.seq, seq + 1);
+    AIMLAB_BRIDGE_BARRIER();
+
+    aimlab_haptic_state& state = slot.state;
+    state.tick = ++m_tick[tool];
+    state.timestamp_ns = aimlab_bridge_now_ns();
+    std::memcpy(state.device_pos, devicePos, sizeof(state.device_pos));
+    std::memcpy(state.proxy_pos, proxyPos, sizeof(state.proxy_pos));
+    std::memcpy(state.force, force, sizeof(state.force));
+
+    aimlab_seq_store(&slot.seq, seq + 2);
+}
+
+const aimlab_object_transform* SharedMemoryBridge::pollObjectTransforms(uint32_t& count) {
+    return pollObjectTransforms(m_reader, count);
+}
+
+const aimlab_object_transform* SharedMemoryBridge::pollObjectTransforms(
+        BridgeTransformReader& reader, uint32_t& count) const {
+    count = 0;
+    if (m_segment == nullptr) {
+        return nullptr;
+    }
+
+    const uint64_t before = aimlab_seq_load(&m_segment->transforms_seq);
+    if (before == reader.lastSeq || (before & 1u)) {
+        return nullptr;
+    }
+
+    uint32_t n = m_segment->transform_count;
+    if (n > AIMLAB_BRIDGE_MAX_OBJECTS) {
+        n = AIMLAB_BRIDGE_MAX_OBJECTS;
+    }
+    std::memcpy(reader.transforms, m_segment->transforms, n * sizeof(aimlab_object_transform));
+    AIMLAB_BRIDGE_BARRIER();
+
+    if (aimlab_seq_load(&m_segment->transforms_seq) != before) {
+        return nullptr;     // torn read: try again next tick
+    }
+
+    reader.lastSeq = before;
+    count = n;
+    return reader.transforms;
+}
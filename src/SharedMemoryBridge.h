@@ -0,0 +1,107 @@
+/****************************************************************************
+ * AIMLAB - Shared-Memory Bridge (Haptic Thread Writer)
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.2
+ *
+ * Description:
+ *   Haptic-thread side of the Unity bridge. Publishes the tool state into
+ *   the shared segment every tick and picks up object transforms written
+ *   back by Unity. See src/bridge/aimlab_bridge.h for the segment layout.
+ *
+ *   Both calls are wait-free for the haptic thread: no mutex, no syscall
+ *   and no heap allocation after create(). With one haptic thread per
+ *   device, each thread polls transforms through its own
+ *   BridgeTransformReader and publishes its tool into its own slot.
+ *
+ * Changelog:
+ *   v1.2 - 16 October 2026 - One tool slot per device
+ *   v1.1 - 16 October 2026 - BridgeTransformReader for several polling threads
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SHARED_MEMORY_BRIDGE_H
+#define AIMLAB_SHARED_MEMORY_BRIDGE_H
+
+#include "bridge/aimlab_bridge.h"
+
+#include <cstdint>
+
+/**
+ * @brief One polling thread's last-seen sequence and copy of the transforms
+ */
+struct BridgeTransformReader {
+    uint64_t lastSeq = 0;
+    aimlab_object_transform transforms[AIMLAB_BRIDGE_MAX_OBJECTS];
+};
+
+class SharedMemoryBridge {
+public:
+    SharedMemoryBridge();
+    ~SharedMemoryBridge();
+
+    SharedMemoryBridge(const SharedMemoryBridge&) = delete;
+    SharedMemoryBridge& operator=(const SharedMemoryBridge&) = delete;
+
+    /**
+     * @brief Create the shared segment (call before starting the haptic thread)
+     *
+     * @param name      Segment name, or nullptr for AIMLAB_BRIDGE_DEFAULT_NAME
+     * @param toolCount Devices that publish (1 to AIMLAB_BRIDGE_MAX_TOOLS)
+     * @return true on success
+     */
+    bool create(const char* name = nullptr, uint32_t toolCount = 1);
+
+    /**
+     * @brief Unmap and unlink the segment
+     */
+    void destroy();
+
+    bool isOpen() const { return m_segment != nullptr; }
+
+    /**
+     * @brief Publish one device's tool state for this tick
+     *
+     * Each slot has a single writer: call it for a given tool from one
+     * thread only (that device's haptic thread).
+     *
+     * @param tool      Device index (slot); out of range is ignored
+     * @param devicePos Device position in world coordinates (m)
+     * @param proxyPos  Proxy position in world coordinates (m)
+     * @param force     Interaction force in world coordinates (N)
+     *
+     * Performance Notes:
+     *   - Two sequence stores and a 88-byte copy; safe at any haptic rate
+     */
+    void publishState(uint32_t tool, const double devicePos[3], const double proxyPos[3],
+                      const double force[3]);
+
+    /**
+     * @brief Fetch object transforms if Unity wrote new ones since the last call
+     *
+     * Makes a single attempt; if Unity is mid-write the call returns nullptr
+     * and the caller simply keeps the previous transforms for this tick.
+     *
+     * @param count Receives the number of transforms
+     * @return Pointer to an internal copy, or nullptr if nothing new
+     */
+    const aimlab_object_transform* pollObjectTransforms(uint32_t& count);
+
+    /**
+     * @brief Same, with the caller's reader state (safe from several threads)
+     *
+     * @return Pointer into reader.transforms, or nullptr if nothing new
+     */
+    const aimlab_object_transform* pollObjectTransforms(BridgeTransformReader& reader,
+                                                        uint32_t& count) const;
+
+private:
+    aimlab_bridge* m_bridge;
+    aimlab_bridge_segment* m_segment;
+    uint64_t m_tick[AIMLAB_BRIDGE_MAX_TOOLS];   // per slot, written by its thread only
+    BridgeTransformReader m_reader;
+};
+
+#endif // AIMLAB_SHARED_MEMORY_BRIDGE_H
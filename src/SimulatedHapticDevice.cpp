@@ -0,0 +1,247 @@
+/****************************************************************************
+ * AIMLAB - Simulated Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of SimulatedHapticDevice. See SimulatedHapticDevice.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "SimulatedHapticDevice.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+SimulatedHapticDevice::SimulatedHapticDevice(const SimulatedDeviceConfig& a_config)
+    : cGenericHapticDevice(0),
+      m_config(a_config),
+      m_samplePeriod(1.0 / (a_config.sampleRateHz > 0.0 ? a_config.sampleRateHz : 1000.0)),
+      m_sampleIndex(0) {
+    m_specifications.m_model                      = C_HAPTIC_DEVICE_VIRTUAL;
+    m_specifications.m_modelName                  = "Simulated Device";
+    m_specifications.m_manufacturerName           = "AIMLAB";
+    m_specifications.m_maxLinearForce             = 10.0;
+    m_specifications.m_maxAngularTorque           = 0.0;
+    m_specifications.m_maxGripperForce            = 0.0;
+    m_specifications.m_maxLinearStiffness         = 5000.0;
+    m_specifications.m_maxAngularStiffness        = 0.0;
+    m_specifications.m_maxGripperLinearStiffness  = 0.0;
+    m_specifications.m_maxLinearDamping           = 20.0;
+    m_specifications.m_maxAngularDamping          = 0.0;
+    m_specifications.m_maxGripperAngularDamping   = 0.0;
+    m_specifications.m_workspaceRadius            = a_config.workspaceRadius;
+    m_specifications.m_gripperMaxAngleRad         = 0.0;
+    m_specifications.m_sensedPosition             = true;
+    m_specifications.m_sensedRotation             = false;
+    m_specifications.m_sensedGripper              = false;
+    m_specifications.m_actuatedPosition           = true;
+    m_specifications.m_actuatedRotation           = false;
+    m_specifications.m_actuatedGripper            = false;
+    m_specifications.m_leftHand                   = true;
+    m_specifications.m_rightHand                  = true;
+
+    m_deviceAvailable = true;
+    m_deviceReady = false;
+}
+
+SimulatedHapticDevice::~SimulatedHapticDevice() {
+    close();
+}
+
+//===========================================================================
+// DEVICE INTERFACE
+//===========================================================================
+
+bool SimulatedHapticDevice::open() {
+    if (m_config.motion == SIM_MOTION_FILE && m_trajectory.size() < 2) {
+        if (!loadTrajectory(m_config.trajectoryFile)) {
+            return C_ERROR;
+        }
+    }
+
+    m_sampleIndex = 0;
+    m_position = (m_config.motion == SIM_MOTION_FILE) ? trajectoryPosition(0.0)
+                                                       : scriptedPosition(0.0);
+    m_velocity.zero();
+    m_force.zero();
+    m_startTime = chrono::steady_clock::now();
+    m_deviceReady = true;
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::close() {
+    m_deviceReady = false;
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::calibrate(bool a_forceCalibration) {
+    (void)a_forceCalibration;
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::getPosition(cVector3d& a_position) {
+    if (m_config.clock == SIM_CLOCK_STEP) {
+        advanceTo(m_sampleIndex + 1);
+    } else {
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - m_startTime).count();
+        advanceTo((long long)(elapsed / m_samplePeriod));
+    }
+
+    a_position = m_position;
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::getRotation(cMatrix3d& a_rotation) {
+    a_rotation.identity();
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::getLinearVelocity(cVector3d& a_linearVelocity) {
+    m_linearVelocity = m_velocity;
+    a_linearVelocity = m_velocity;
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::getGripperAngleRad(double& a_angle) {
+    a_angle = 0.0;
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::getUserSwitches(unsigned int& a_userSwitches) {
+    a_userSwitches = 0;
+    return C_SUCCESS;
+}
+
+bool SimulatedHapticDevice::setForceAndTorqueAndGripperForce(const cVector3d& a_force,
+                                                             const cVector3d& a_torque,
+                                                             double a_gripperForce) {
+    (void)a_torque;
+    (void)a_gripperForce;
+    m_force = a_force;
+    return C_SUCCESS;
+}
+
+//===========================================================================
+// TRAJECTORIES
+//===========================================================================
+
+bool SimulatedHapticDevice::loadTrajectory(const string& a_filename) {
+    ifstream file(a_filename.c_str());
+    if (!file) {
+        return false;
+    }
+
+    m_trajectory.clear();
+    string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        for (size_t i = 0; i < line.size(); i++) {
+            if (line[i] == ',') {
+                line[i] = ' ';
+            }
+        }
+
+        istringstream row(line);
+        TrajectorySample sample;
+        double x, y, z;
+        if (!(row >> sample.t >> x >> y >> z)) {
+            continue;   // header or malformed row
+        }
+        sample.pos.set(x, y, z);
+        m_trajectory.push_back(sample);
+    }
+
+    return m_trajectory.size() >= 2;
+}
+
+cVector3d SimulatedHapticDevice::scriptedPosition(double a_time) const {
+    const double phase = 2.0 * C_PI * m_config.circleFrequencyHz * a_time;
+    return m_config.circleCenter + cVector3d(m_config.circleRadius * cos(phase),
+                                             m_config.circleRadius * sin(phase),
+                                             0.0);
+}
+
+cVector3d SimulatedHapticDevice::trajectoryPosition(double a_time) const {
+    const double t0 = m_trajectory.front().t;
+    const double duration = m_trajectory.back().t - t0;
+    double t = t0 + ((duration > 0.0) ? fmod(a_time, duration) : 0.0);
+
+    // Binary search for the enclosing segment
+    size_t lo = 0;
+    size_t hi = m_trajectory.size() - 1;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (m_trajectory[mid].t <= t) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const TrajectorySample& a = m_trajectory[lo];
+    const TrajectorySample& b = m_trajectory[hi];
+    const double span = b.t - a.t;
+    const double u = (span > 0.0) ? (t - a.t) / span : 0.0;
+    return a.pos + u * (b.pos - a.pos);
+}
+
+//===========================================================================
+// SIMULATION STEP
+//===========================================================================
+
+void SimulatedHapticDevice::advanceTo(long long a_sampleIndex) {
+    // Bound the catch-up work if the caller stalled for a long time
+    if (a_sampleIndex - m_sampleIndex > 1000) {
+        m_sampleIndex = a_sampleIndex - 1000;
+    }
+    while (m_sampleIndex < a_sampleIndex) {
+        step();
+    }
+}
+
+void SimulatedHapticDevice::step() {
+    ++m_sampleIndex;
+    const double t = getSimulatedTime();
+    const double dt = m_samplePeriod;
+    const cVector3d previous = m_position;
+
+    switch (m_config.motion) {
+        case SIM_MOTION_CIRCLE:
+            m_position = scriptedPosition(t);
+            m_velocity = (m_position - previous) / dt;
+            break;
+
+        case SIM_MOTION_FILE:
+            m_position = trajectoryPosition(t);
+            m_velocity = (m_position - previous) / dt;
+            break;
+
+        case SIM_MOTION_HAND: {
+            // Semi-implicit Euler: hand spring toward the script, plus the
+            // force the device renders back onto the hand
+            const cVector3d target = scriptedPosition(t);
+            const cVector3d accel = (m_config.handStiffness * (target - m_position)
+                                     - m_config.handDamping * m_velocity
+                                     + m_force) / m_config.handMass;
+            m_velocity += dt * accel;
+            m_position += dt * m_velocity;
+            break;
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/****************************************************************************
+ * AIMLAB - Simulated Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Hardware-free cGenericHapticDevice for headless profiling and CI runs.
+ *   Drives the full tool pipeline (updateFromDevice, computeInteractionForces,
+ *   applyToDevice) from one of three sources:
+ *
+ *     CIRCLE - scripted circular sweep through the scene
+ *     FILE   - recorded trajectory (CSV: t,x,y,z in seconds / device meters),
+ *              linearly interpolated and looped
+ *     HAND   - spring-mass-damper "hand" pulled toward the CIRCLE script
+ *              and pushed back by the rendered force, so contact forces
+ *              actually deflect the motion like a real user would
+ *
+ *   The device samples its source at a configurable transport rate and
+ *   holds the last sample in between, like a serial device would. Time
+ *   advances either with the wall clock or by exactly one sample per
+ *   getPosition() call (STEP clock) for deterministic, faster-than-real-
+ *   time runs.
+ *
+ *   All methods are called from the haptic thread only; no locking.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SIMULATED_HAPTIC_DEVICE_H
+#define AIMLAB_SIMULATED_HAPTIC_DEVICE_H
+
+#include "chai3d.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+//===========================================================================
+// CONFIGURATION
+//===========================================================================
+
+enum SimulatedMotionMode {
+    SIM_MOTION_CIRCLE,
+    SIM_MOTION_FILE,
+    SIM_MOTION_HAND
+};
+
+enum SimulatedClockMode {
+    SIM_CLOCK_WALL,     // follow real time
+    SIM_CLOCK_STEP      // one sample per getPosition() call
+};
+
+struct SimulatedDeviceConfig {
+    SimulatedMotionMode motion = SIM_MOTION_CIRCLE;
+    SimulatedClockMode clock = SIM_CLOCK_WALL;
+    std::string trajectoryFile;             // SIM_MOTION_FILE only
+
+    double sampleRateHz = 1000.0;           // transport rate of the simulated device
+    double workspaceRadius = 0.1;           // m, reported in the specifications
+
+    // Scripted circle in the device x/y plane (device coordinates)
+    double circleRadius = 0.004;            // m
+    double circleFrequencyHz = 0.5;
+    chai3d::cVector3d circleCenter;
+
+    // Hand model (SIM_MOTION_HAND)
+    double handMass = 0.3;                  // kg
+    double handStiffness = 200.0;           // N/m, pull toward scripted target
+    double handDamping = 5.0;               // N.s/m
+};
+
+//===========================================================================
+// DEVICE
+//===========================================================================
+
+class SimulatedHapticDevice : public chai3d::cGenericHapticDevice {
+public:
+    explicit SimulatedHapticDevice(const SimulatedDeviceConfig& a_config);
+    virtual ~SimulatedHapticDevice();
+
+    //-----------------------------------------------------------------------
+    // cGenericHapticDevice interface
+    //-----------------------------------------------------------------------
+    virtual bool open();
+    virtual bool close();
+    virtual bool calibrate(bool a_forceCalibration = false);
+    virtual bool getPosition(chai3d::cVector3d& a_position);
+    virtual bool getRotation(chai3d::cMatrix3d& a_rotation);
+    virtual bool getLinearVelocity(chai3d::cVector3d& a_linearVelocity);
+    virtual bool getGripperAngleRad(double& a_angle);
+    virtual bool getUserSwitches(unsigned int& a_userSwitches);
+    virtual bool setForceAndTorqueAndGripperForce(const chai3d::cVector3d& a_force,
+                                                  const chai3d::cVector3d& a_torque,
+                                                  double a_gripperForce);
+
+    //-----------------------------------------------------------------------
+    // Simulation
+    //-----------------------------------------------------------------------
+
+    /**
+     * @brief Load a recorded trajectory for SIM_MOTION_FILE
+     *
+     * @param a_filename CSV file with rows "t,x,y,z"; '#' lines and a
+     *                   non-numeric header row are skipped
+     * @return true if at least two samples were read
+     */
+    bool loadTrajectory(const std::string& a_filename);
+
+    /** @brief Simulated time of the current sample (s) */
+    double getSimulatedTime() const { return m_sampleIndex * m_samplePeriod; }
+
+    /** @brief Last force commanded by the tool (device frame, N) */
+    const chai3d::cVector3d& getLastForce() const { return m_force; }
+
+    const SimulatedDeviceConfig& getConfig() const { return m_config; }
+
+private:
+    void advanceTo(long long a_sampleIndex);
+    void step();
+    chai3d::cVector3d scriptedPosition(double a_time) const;
+    chai3d::cVector3d trajectoryPosition(double a_time) const;
+
+    struct TrajectorySample {
+        double t;
+        chai3d::cVector3d pos;
+    };
+
+    SimulatedDeviceConfig m_config;
+    std::vector<TrajectorySample> m_trajectory;
+
+    double m_samplePeriod;
+    long long m_sampleIndex;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    chai3d::cVector3d m_position;
+    chai3d::cVector3d m_velocity;
+    chai3d::cVector3d m_force;
+};
+
+#endif // AIMLAB_SIMULATED_HAPTIC_DEVICE_H
@@ -0,0 +1,128 @@
+/****************************************************************************
+ * AIMLAB - Single-Producer Single-Consumer Ring Buffer
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Bounded lock-free FIFO between exactly one producer thread and one
+ *   consumer thread. Storage is allocated once in the constructor; push
+ *   and pop never allocate, lock or make system calls, so the haptic
+ *   thread can feed a background writer at full rate.
+ *
+ *   Head and tail indices live on separate cache lines, and each side
+ *   keeps a private cached copy of the other's index so the shared line
+ *   is only re-read when the ring looks full (producer) or empty
+ *   (consumer).
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_SPSC_RING_H
+#define AIMLAB_SPSC_RING_H
+
+#include "TripleBuffer.h"       // AIMLAB_CACHE_LINE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @param a_capacity Rounded up to a power of two
+     */
+    explicit SpscRing(size_t a_capacity)
+        : m_capacity(roundUp(a_capacity)),
+          m_mask(m_capacity - 1),
+          m_slots(new T[m_capacity]) {
+        m_head.value.store(0, std::memory_order_relaxed);
+        m_tail.value.store(0, std::memory_order_relaxed);
+        m_producer.cachedTail = 0;
+        m_consumer.cachedHead = 0;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return m_capacity; }
+
+    //-----------------------------------------------------------------------
+    // Producer thread
+    //-----------------------------------------------------------------------
+
+    /** @brief Copy one element in; false (nothing written) if the ring is full */
+    bool tryPush(const T& a_value) {
+        const uint64_t head = m_head.value.load(std::memory_order_relaxed);
+        if (head - m_producer.cachedTail >= m_capacity) {
+            m_producer.cachedTail = m_tail.value.load(std::memory_order_acquire);
+            if (head - m_producer.cachedTail >= m_capacity) {
+                return false;
+            }
+        }
+        m_slots[head & m_mask] = a_value;
+        m_head.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //-----------------------------------------------------------------------
+    // Consumer thread
+    //-----------------------------------------------------------------------
+
+    /** @brief Copy one element out; false if the ring is empty */
+    bool tryPop(T& a_value) {
+        const uint64_t tail = m_tail.value.load(std::memory_order_relaxed);
+        if (tail == m_consumer.cachedHead) {
+            m_consumer.cachedHead = m_head.value.load(std::memory_order_acquire);
+            if (tail == m_consumer.cachedHead) {
+                return false;
+            }
+        }
+        a_value = m_slots[tail & m_mask];
+        m_tail.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Elements currently queued (approximate from either side) */
+    size_t size() const {
+        return (size_t)(m_head.value.load(std::memory_order_acquire) -
+                        m_tail.value.load(std::memory_order_acquire));
+    }
+
+private:
+    static size_t roundUp(size_t a_value) {
+        size_t capacity = 2;
+        while (capacity < a_value) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    struct alignas(AIMLAB_CACHE_LINE) Index {
+        std::atomic<uint64_t> value;
+    };
+
+    struct alignas(AIMLAB_CACHE_LINE) ProducerState {
+        uint64_t cachedTail;
+    };
+
+    struct alignas(AIMLAB_CACHE_LINE) ConsumerState {
+        uint64_t cachedHead;
+    };
+
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<T[]> m_slots;
+
+    Index m_head;                   // written by the producer
+    Index m_tail;                   // written by the consumer
+    ProducerState m_producer;
+    ConsumerState m_consumer;
+};
+
+#endif // AIMLAB_SPSC_RING_H
@@ -0,0 +1,133 @@
+/****************************************************************************
+ * AIMLAB - Tapped Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Implementation of TappedHapticDevice. See TappedHapticDevice.h.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "TappedHapticDevice.h"
+
+#include <cstring>
+
+using namespace chai3d;
+using namespace std;
+
+//===========================================================================
+// CONSTRUCTION
+//===========================================================================
+
+TappedHapticDevice::TappedHapticDevice(cGenericHapticDevicePtr a_inner)
+    : cGenericHapticDevice(0),
+      m_inner(a_inner),
+      m_gripperForce(0.0) {
+    memset(&m_sample, 0, sizeof(m_sample));
+    memset(m_force, 0, sizeof(m_force));
+    memset(m_torque, 0, sizeof(m_torque));
+    m_sample.rotation[0] = m_sample.rotation[4] = m_sample.rotation[8] = 1.0;
+
+    // The tool scales its workspace from these
+    m_specifications = m_inner->getSpecifications();
+    m_deviceAvailable = true;
+    m_deviceReady = true;
+}
+
+TappedHapticDevice::~TappedHapticDevice() {
+}
+
+//===========================================================================
+// DEVICE INTERFACE
+//===========================================================================
+
+bool TappedHapticDevice::open() {
+    return m_inner->open();
+}
+
+bool TappedHapticDevice::close() {
+    return m_inner->close();
+}
+
+bool TappedHapticDevice::calibrate(bool a_forceCalibration) {
+    return m_inner->calibrate(a_forceCalibration);
+}
+
+bool TappedHapticDevice::getPosition(cVector3d& a_position) {
+    const bool result = m_inner->getPosition(a_position);
+    m_sample.position[0] = a_position.x();
+    m_sample.position[1] = a_position.y();
+    m_sample.position[2] = a_position.z();
+    return result;
+}
+
+bool TappedHapticDevice::getRotation(cMatrix3d& a_rotation) {
+    const bool result = m_inner->getRotation(a_rotation);
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            m_sample.rotation[3 * r + c] = a_rotation(r, c);
+        }
+    }
+    return result;
+}
+
+bool TappedHapticDevice::getLinearVelocity(cVector3d& a_linearVelocity) {
+    const bool result = m_inner->getLinearVelocity(a_linearVelocity);
+    m_sample.linearVelocity[0] = a_linearVelocity.x();
+    m_sample.linearVelocity[1] = a_linearVelocity.y();
+    m_sample.linearVelocity[2] = a_linearVelocity.z();
+    return result;
+}
+
+bool TappedHapticDevice::getAngularVelocity(cVector3d& a_angularVelocity) {
+    const bool result = m_inner->getAngularVelocity(a_angularVelocity);
+    m_sample.angularVelocity[0] = a_angularVelocity.x();
+    m_sample.angularVelocity[1] = a_angularVelocity.y();
+    m_sample.angularVelocity[2] = a_angularVelocity.z();
+    return result;
+}
+
+bool TappedHapticDevice::getGripperAngleRad(double& a_angle) {
+    const bool result = m_inner->getGripperAngleRad(a_angle);
+    m_sample.gripperAngle = a_angle;
+    return result;
+}
+
+bool TappedHapticDevice::getGripperAngularVelocity(double& a_gripperAngularVelocity) {
+    const bool result = m_inner->getGripperAngularVelocity(a_gripperAngularVelocity);
+    m_sample.gripperAngularVelocity = a_gripperAngularVelocity;
+    return result;
+}
+
+bool TappedHapticDevice::getUserSwitches(unsigned int& a_userSwitches) {
+    const bool result = m_inner->getUserSwitches(a_userSwitches);
+    m_sample.userSwitches = a_userSwitches;
+    return result;
+}
+
+bool TappedHapticDevice::setForceAndTorqueAndGripperForce(const cVector3d& a_force,
+                                                          const cVector3d& a_torque,
+                                                          double a_gripperForce) {
+    m_force[0]  = a_force.x();  m_force[1]  = a_force.y();  m_force[2]  = a_force.z();
+    m_torque[0] = a_torque.x(); m_torque[1] = a_torque.y(); m_torque[2] = a_torque.z();
+    m_gripperForce = a_gripperForce;
+    return m_inner->setForceAndTorqueAndGripperForce(a_force, a_torque, a_gripperForce);
+}
+
+//===========================================================================
+// CAPTURED VALUES
+//===========================================================================
+
+void TappedHapticDevice::getCommand(double a_force[3], double a_torque[3],
+                                    double& a_gripperForce) const {
+    for (int k = 0; k < 3; k++) {
+        a_force[k]  = m_force[k];
+        a_torque[k] = m_torque[k];
+    }
+    a_gripperForce = m_gripperForce;
+}
@@ -0,0 +1,74 @@
+/****************************************************************************
+ * AIMLAB - Tapped Haptic Device
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Pass-through cGenericHapticDevice that forwards every call to an
+ *   inner device and keeps a copy of what went through it: the raw
+ *   values the tool read in updateFromDevice() and the force / torque /
+ *   gripper force it commanded in applyToDevice(). The session recorder
+ *   reads those copies after each tick, so a recording holds exactly the
+ *   device inputs the pipeline saw, not values reconstructed from the
+ *   tool's world-frame state.
+ *
+ *   The tool is given the tap; the application keeps opening, calibrating
+ *   and closing the inner device itself. Haptic thread only; no locking,
+ *   no allocation.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_TAPPED_HAPTIC_DEVICE_H
+#define AIMLAB_TAPPED_HAPTIC_DEVICE_H
+
+#include "chai3d.h"
+#include "HapticRecord.h"
+
+class TappedHapticDevice : public chai3d::cGenericHapticDevice {
+public:
+    explicit TappedHapticDevice(chai3d::cGenericHapticDevicePtr a_inner);
+    virtual ~TappedHapticDevice();
+
+    //-----------------------------------------------------------------------
+    // cGenericHapticDevice interface (forwarded)
+    //-----------------------------------------------------------------------
+    virtual bool open();
+    virtual bool close();
+    virtual bool calibrate(bool a_forceCalibration = false);
+    virtual bool getPosition(chai3d::cVector3d& a_position);
+    virtual bool getRotation(chai3d::cMatrix3d& a_rotation);
+    virtual bool getLinearVelocity(chai3d::cVector3d& a_linearVelocity);
+    virtual bool getAngularVelocity(chai3d::cVector3d& a_angularVelocity);
+    virtual bool getGripperAngleRad(double& a_angle);
+    virtual bool getGripperAngularVelocity(double& a_gripperAngularVelocity);
+    virtual bool getUserSwitches(unsigned int& a_userSwitches);
+    virtual bool setForceAndTorqueAndGripperForce(const chai3d::cVector3d& a_force,
+                                                  const chai3d::cVector3d& a_torque,
+                                                  double a_gripperForce);
+
+    //-----------------------------------------------------------------------
+    // Captured values
+    //-----------------------------------------------------------------------
+
+    /** @brief Device values returned to the tool since the last reset */
+    const HapticSample& getSample() const { return m_sample; }
+
+    /** @brief Copy the last commanded force (N), torque (N.m) and gripper force (N) */
+    void getCommand(double a_force[3], double a_torque[3], double& a_gripperForce) const;
+
+    chai3d::cGenericHapticDevicePtr getInner() const { return m_inner; }
+
+private:
+    chai3d::cGenericHapticDevicePtr m_inner;
+    HapticSample m_sample;
+    double m_force[3];
+    double m_torque[3];
+    double m_gripperForce;
+};
+
+#endif // AIMLAB_TAPPED_HAPTIC_DEVICE_H
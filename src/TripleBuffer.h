@@ -0,0 +1,101 @@
+/****************************************************************************
+ * AIMLAB - Lock-Free Triple Buffer
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.0
+ *
+ * Description:
+ *   Single-producer / single-consumer "latest value" channel. The writer
+ *   fills its private slot and publishes it with one atomic exchange; the
+ *   reader swaps in the newest published slot with one atomic exchange.
+ *   Neither side ever waits for the other, and the reader always sees a
+ *   complete value: a 50 ms render frame cannot stall a 1 kHz writer, and
+ *   intermediate values the reader was too slow to see are simply dropped.
+ *
+ *   Every slot and both private indices live on their own cache line, so
+ *   the only line the threads share on the hot path is the exchange index.
+ *
+ *   Alignment: C++14 operator new ignores over-alignment, so give the
+ *   buffer static or automatic storage rather than allocating it with new.
+ *
+ * Changelog:
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_TRIPLE_BUFFER_H
+#define AIMLAB_TRIPLE_BUFFER_H
+
+#include <atomic>
+
+#define AIMLAB_CACHE_LINE 64
+
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : m_middle(1),
+          m_writeIndex(0),
+          m_readIndex(2) {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    //-----------------------------------------------------------------------
+    // Writer thread
+    //-----------------------------------------------------------------------
+
+    /** @brief Slot the writer may fill; contents are whatever it held last */
+    T& writeBuffer() { return m_slots[m_writeIndex.value].value; }
+
+    /** @brief Make the write buffer the latest value (release) */
+    void publish() {
+        const unsigned previous = m_middle.exchange(m_writeIndex.value | DIRTY,
+                                                    std::memory_order_acq_rel);
+        m_writeIndex.value = previous & INDEX_MASK;
+    }
+
+    //-----------------------------------------------------------------------
+    // Reader thread
+    //-----------------------------------------------------------------------
+
+    /**
+     * @brief Take the latest published value, if there is a newer one
+     *
+     * @return true if readBuffer() changed
+     */
+    bool acquire() {
+        if ((m_middle.load(std::memory_order_relaxed) & DIRTY) == 0) {
+            return false;
+        }
+        const unsigned previous = m_middle.exchange(m_readIndex.value, std::memory_order_acq_rel);
+        m_readIndex.value = previous & INDEX_MASK;
+        return true;
+    }
+
+    /** @brief Most recently acquired value (value-initialised before the first) */
+    const T& readBuffer() const { return m_slots[m_readIndex.value].value; }
+
+private:
+    static const unsigned INDEX_MASK = 0x3;
+    static const unsigned DIRTY = 0x4;
+
+    struct alignas(AIMLAB_CACHE_LINE) Slot {
+        T value;
+        Slot() : value() {}
+    };
+
+    struct alignas(AIMLAB_CACHE_LINE) Index {
+        unsigned value;
+        Index(unsigned v) : value(v) {}
+    };
+
+    Slot m_slots[3];
+    alignas(AIMLAB_CACHE_LINE) std::atomic<unsigned> m_middle;  // shared: index | DIRTY
+    Index m_writeIndex;                                         // writer only
+    Index m_readIndex;                                          // reader only
+};
+
+#endif // AIMLAB_TRIPLE_BUFFER_H
@@ -0,0 +1,275 @@
+/****************************************************************************
+ * AIMLAB - Haptic/Unity Shared-Memory Bridge (C Reader Library)
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Platform mapping and seqlock reader/writer routines for the segment
+ *   described in aimlab_bridge.h. Built both into aimlab-haptics (writer)
+ *   and as the standalone aimlab-bridge shared library loaded by Unity.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - One tool slot per haptic device
+ *   v1.0 - 16 October 2026 - Initial POSIX shm / Win32 file-mapping backend
+ *
+ ****************************************************************************/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 200809L     // shm_open, ftruncate, clock_gettime
+#endif
+
+#include "aimlab_bridge.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+// Number of attempts before a reader reports AIMLAB_BRIDGE_BUSY
+#define AIMLAB_BRIDGE_READ_RETRIES 64
+
+struct aimlab_bridge {
+    aimlab_bridge_segment* segment;
+    int owner;
+    char name[128];
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+};
+
+//===========================================================================
+// PLATFORM MAPPING
+//===========================================================================
+
+static aimlab_bridge* bridgeMap(const char* name, int create) {
+    aimlab_bridge* bridge;
+    const size_t size = sizeof(aimlab_bridge_segment);
+
+    if (name == NULL) {
+        name = AIMLAB_BRIDGE_DEFAULT_NAME;
+    }
+
+    bridge = (aimlab_bridge*)calloc(1, sizeof(aimlab_bridge));
+    if (bridge == NULL) {
+        return NULL;
+    }
+    strncpy(bridge->name, name, sizeof(bridge->name) - 1);
+    bridge->owner = create;
+
+#ifdef _WIN32
+    if (create) {
+        bridge->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                             0, (DWORD)size, name);
+    } else {
+        bridge->mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+    }
+    if (bridge->mapping == NULL) {
+        free(bridge);
+        return NULL;
+    }
+    bridge->segment = (aimlab_bridge_segment*)MapViewOfFile(bridge->mapping, FILE_MAP_ALL_ACCESS,
+                                                            0, 0, size);
+    if (bridge->segment == NULL) {
+        CloseHandle(bridge->mapping);
+        free(bridge);
+        return NULL;
+    }
+#else
+    {
+        int fd;
+        void* addr;
+
+        if (create) {
+            shm_unlink(name);   // drop stale segments left by a crashed run
+            fd = shm_open(name, O_CREAT | O_RDWR, 0666);
+        } else {
+            fd = shm_open(name, O_RDWR, 0);
+        }
+        if (fd < 0) {
+            free(bridge);
+            return NULL;
+        }
+        if (create && ftruncate(fd, (off_t)size) != 0) {
+            close(fd);
+            shm_unlink(name);
+            free(bridge);
+            return NULL;
+        }
+        addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            if (create) {
+                shm_unlink(name);
+            }
+            free(bridge);
+            return NULL;
+        }
+        bridge->segment = (aimlab_bridge_segment*)addr;
+    }
+#endif
+
+    return bridge;
+}
+
+aimlab_bridge* aimlab_bridge_create(const char* name, uint32_t tool_count) {
+    aimlab_bridge* bridge = bridgeMap(name, 1);
+    aimlab_bridge_segment* s;
+
+    if (bridge == NULL) {
+        return NULL;
+    }
+
+    s = bridge->segment;
+    memset(s, 0, sizeof(*s));
+    s->segment_size = (uint32_t)sizeof(*s);
+    s->max_objects  = AIMLAB_BRIDGE_MAX_OBJECTS;
+    s->max_tools    = AIMLAB_BRIDGE_MAX_TOOLS;
+    s->tool_count   = (tool_count < 1) ? 1
+                    : (tool_count > AIMLAB_BRIDGE_MAX_TOOLS) ? AIMLAB_BRIDGE_MAX_TOOLS : tool_count;
+    s->version      = AIMLAB_BRIDGE_VERSION;
+    AIMLAB_BRIDGE_BARRIER();
+    s->magic        = AIMLAB_BRIDGE_MAGIC;    // written last: marks segment ready
+
+    return bridge;
+}
+
+aimlab_bridge* aimlab_bridge_open(const char* name) {
+    aimlab_bridge* bridge = bridgeMap(name, 0);
+
+    if (bridge == NULL) {
+        return NULL;
+    }
+
+    if (bridge->segment->magic != AIMLAB_BRIDGE_MAGIC ||
+        bridge->segment->version != AIMLAB_BRIDGE_VERSION ||
+        bridge->segment->segment_size != sizeof(aimlab_bridge_segment)) {
+        aimlab_bridge_close(bridge);
+        return NULL;
+    }
+
+    return bridge;
+}
+
+void aimlab_bridge_close(aimlab_bridge* bridge) {
+    if (bridge == NULL) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(bridge->segment);
+    CloseHandle(bridge->mapping);
+#else
+    munmap(bridge->segment, sizeof(aimlab_bridge_segment));
+    if (bridge->owner) {
+        shm_unlink(bridge->name);
+    }
+#endif
+
+    free(bridge);
+}
+
+aimlab_bridge_segment* aimlab_bridge_segment_ptr(aimlab_bridge* bridge) {
+    return (bridge != NULL) ? bridge->segment : NULL;
+}
+
+//===========================================================================
+// SEQLOCK ACCESS
+//===========================================================================
+
+uint32_t aimlab_bridge_tool_count(aimlab_bridge* bridge) {
+    return (bridge != NULL) ? bridge->segment->tool_count : 0;
+}
+
+int aimlab_bridge_read_tool_state(aimlab_bridge* bridge, uint32_t tool, aimlab_haptic_state* out) {
+    aimlab_tool_slot* slot;
+    int attempt;
+
+    if (tool >= AIMLAB_BRIDGE_MAX_TOOLS) {
+        return AIMLAB_BRIDGE_ERROR;
+    }
+    slot = &bridge->segment->tools[tool];
+
+    for (attempt = 0; attempt < AIMLAB_BRIDGE_READ_RETRIES; ++attempt) {
+        uint64_t before = aimlab_seq_load(&slot->seq);
+        uint64_t after;
+
+        if (before == 0) {
+            return AIMLAB_BRIDGE_EMPTY;
+        }
+        if (before & 1u) {
+            continue;       // writer is mid-update
+        }
+
+        memcpy(out, (const void*)&slot->state, sizeof(*out));
+        AIMLAB_BRIDGE_BARRIER();
+        after = aimlab_seq_load(&slot->seq);
+
+        if (before == after) {
+            return AIMLAB_BRIDGE_OK;
+        }
+    }
+
+    return AIMLAB_BRIDGE_BUSY;
+}
+
+int aimlab_bridge_read_state(aimlab_bridge* bridge, aimlab_haptic_state* out) {
+    return aimlab_bridge_read_tool_state(bridge, 0, out);
+}
+
+int aimlab_bridge_write_transforms(aimlab_bridge* bridge,
+                                   const aimlab_object_transform* transforms,
+                                   uint32_t count) {
+    aimlab_bridge_segment* s = bridge->segment;
+    uint64_t seq;
+
+    if (count > AIMLAB_BRIDGE_MAX_OBJECTS) {
+        count = AIMLAB_BRIDGE_MAX_OBJECTS;
+    }
+    if (count > 0 && transforms == NULL) {
+        return AIMLAB_BRIDGE_ERROR;
+    }
+
+    seq = aimlab_seq_load(&s->transforms_seq);
+    aimlab_seq_store(&s->transforms_seq, seq + 1);
+    AIMLAB_BRIDGE_BARRIER();
+
+    s->transform_count = count;
+    if (count > 0) {
+        memcpy(s->transforms, transforms, count * sizeof(aimlab_object_transform));
+    }
+
+    aimlab_seq_store(&s->transforms_seq, seq + 2);
+    return AIMLAB_BRIDGE_OK;
+}
+
+//===========================================================================
+// CLOCK
+//===========================================================================
+
+uint64_t aimlab_bridge_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = { 0 };
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart) * 1000000000ull +
+                      ((counter.QuadPart % frequency.QuadPart) * 1000000000ull) / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
@@ -0,0 +1,248 @@
+/****************************************************************************
+ * AIMLAB - Haptic/Unity Shared-Memory Bridge (C API)
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.1
+ *
+ * Description:
+ *   Plain-C description of the shared-memory segment exchanged between the
+ *   haptic thread of aimlab-haptics and an external consumer (Unity via
+ *   P/Invoke, or any C/C++ tool).
+ *
+ *   The segment carries two independent channels, each guarded by a
+ *   single-writer sequence lock (seqlock):
+ *
+ *     haptic -> consumer : per device (tool slot), device position, proxy
+ *                          position and interaction force, republished
+ *                          every tick by that device's haptic thread
+ *     consumer -> haptic : up to AIMLAB_BRIDGE_MAX_OBJECTS object transforms
+ *
+ *   Writers never block and never allocate. Readers copy the payload and
+ *   retry if the sequence number changed underneath them, so a slow reader
+ *   (Unity at 90 Hz) can never stall the 1 kHz writer.
+ *
+ *   The segment is a POSIX shm object on Linux/macOS (shm_open) and a named
+ *   file mapping on Windows (CreateFileMapping). All timestamps use the
+ *   same monotonic clock as aimlab_bridge_now_ns(), so the consumer can
+ *   compute the age of each sample directly.
+ *
+ * Changelog:
+ *   v1.1 - 16 October 2026 - Segment version 2: one tool slot per haptic device
+ *                            (aimlab_bridge_read_tool_state, aimlab_bridge_tool_count)
+ *   v1.0 - 16 October 2026 - Initial seqlock segment layout and reader API
+ *
+ ****************************************************************************/
+
+#ifndef AIMLAB_BRIDGE_H
+#define AIMLAB_BRIDGE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===========================================================================
+// EXPORT MACRO
+//===========================================================================
+
+#if defined(_WIN32) && defined(AIMLAB_BRIDGE_SHARED)
+    #define AIMLAB_BRIDGE_API __declspec(dllexport)
+#elif defined(__GNUC__) && defined(AIMLAB_BRIDGE_SHARED)
+    #define AIMLAB_BRIDGE_API __attribute__((visibility("default")))
+#else
+    #define AIMLAB_BRIDGE_API
+#endif
+
+//===========================================================================
+// CONSTANTS
+//===========================================================================
+
+#define AIMLAB_BRIDGE_MAGIC         0x424D4941u     /* "AIMB" little-endian */
+#define AIMLAB_BRIDGE_VERSION       2u
+#define AIMLAB_BRIDGE_MAX_OBJECTS   64u
+#define AIMLAB_BRIDGE_MAX_TOOLS     4u      /* one per haptic device */
+#define AIMLAB_BRIDGE_CACHE_LINE    64
+
+#ifdef _WIN32
+    #define AIMLAB_BRIDGE_DEFAULT_NAME "Local\\aimlab_haptic_bridge"
+#else
+    #define AIMLAB_BRIDGE_DEFAULT_NAME "/aimlab_haptic_bridge"
+#endif
+
+/* Return codes */
+#define AIMLAB_BRIDGE_OK             0
+#define AIMLAB_BRIDGE_ERROR         -1      /* OS call failed */
+#define AIMLAB_BRIDGE_BAD_SEGMENT   -2      /* magic/version mismatch */
+#define AIMLAB_BRIDGE_EMPTY         -3      /* nothing published yet */
+#define AIMLAB_BRIDGE_BUSY          -4      /* writer kept the lock, retry later */
+
+/* aimlab_object_transform::flags */
+#define AIMLAB_TRANSFORM_VALID      0x1u
+
+//===========================================================================
+// SEGMENT LAYOUT
+//===========================================================================
+
+/* Tool state published by the haptic thread (world frame, meters / N). */
+typedef struct aimlab_haptic_state {
+    uint64_t tick;              /* haptic tick counter since pipeline start */
+    uint64_t timestamp_ns;      /* aimlab_bridge_now_ns() at publish time  */
+    double   device_pos[3];     /* tool->getDeviceGlobalPos()              */
+    double   proxy_pos[3];      /* haptic point proxy position             */
+    double   force[3];          /* tool->getDeviceGlobalForce()            */
+} aimlab_haptic_state;
+
+/* Object pose written by the consumer (world frame, row-major rotation). */
+typedef struct aimlab_object_transform {
+    uint32_t object_id;
+    uint32_t flags;
+    double   pos[3];
+    double   rot[9];
+} aimlab_object_transform;
+
+/* One device's tool state with its own sequence lock. */
+typedef struct aimlab_tool_slot {
+    volatile uint64_t seq;
+    uint8_t  pad_seq[AIMLAB_BRIDGE_CACHE_LINE - 8];
+    aimlab_haptic_state state;
+    uint8_t  pad_state[AIMLAB_BRIDGE_CACHE_LINE - (sizeof(aimlab_haptic_state) % AIMLAB_BRIDGE_CACHE_LINE)];
+} aimlab_tool_slot;
+
+/*
+ * Each sequence counter lives on its own cache line, followed by its
+ * payload, so the haptic writers (one per tool slot) and the transform
+ * writer never contend on the same line. Odd sequence values mean "write
+ * in progress". tool_count is the number of devices aimlab-haptics drives;
+ * slots at and above it are never written.
+ */
+typedef struct aimlab_bridge_segment {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t segment_size;
+    uint32_t max_objects;
+    uint32_t max_tools;
+    uint32_t tool_count;
+    uint8_t  pad_header[AIMLAB_BRIDGE_CACHE_LINE - 24];
+
+    aimlab_tool_slot tools[AIMLAB_BRIDGE_MAX_TOOLS];
+
+    volatile uint64_t transforms_seq;
+    uint8_t  pad_transforms_seq[AIMLAB_BRIDGE_CACHE_LINE - 8];
+    uint32_t transform_count;
+    uint32_t pad_transform_count;
+    aimlab_object_transform transforms[AIMLAB_BRIDGE_MAX_OBJECTS];
+} aimlab_bridge_segment;
+
+//===========================================================================
+// SEQLOCK PRIMITIVES (shared by the C reader and the C++ writer)
+//===========================================================================
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+    /* x86/x64 only: TSO plus a compiler barrier gives acquire/release. */
+    #define AIMLAB_BRIDGE_BARRIER()        _ReadWriteBarrier()
+    static __inline uint64_t aimlab_seq_load(volatile uint64_t* p) {
+        uint64_t v = *p; _ReadWriteBarrier(); return v;
+    }
+    static __inline void aimlab_seq_store(volatile uint64_t* p, uint64_t v) {
+        _ReadWriteBarrier(); *p = v;
+    }
+#else
+    #define AIMLAB_BRIDGE_BARRIER()        __atomic_thread_fence(__ATOMIC_SEQ_CST)
+    static inline uint64_t aimlab_seq_load(volatile uint64_t* p) {
+        return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+    }
+    static inline void aimlab_seq_store(volatile uint64_t* p, uint64_t v) {
+        __atomic_store_n(p, v, __ATOMIC_RELEASE);
+    }
+#endif
+
+//===========================================================================
+// API
+//===========================================================================
+
+typedef struct aimlab_bridge aimlab_bridge;
+
+/**
+ * @brief Create (or recreate) the segment as its writer
+ *
+ * Used by aimlab-haptics. The segment is zeroed and stamped with the
+ * magic/version header.
+ *
+ * @param name       Segment name, or NULL for AIMLAB_BRIDGE_DEFAULT_NAME
+ * @param tool_count Devices that will publish (clamped to 1..AIMLAB_BRIDGE_MAX_TOOLS)
+ * @return Handle, or NULL on failure
+ */
+AIMLAB_BRIDGE_API aimlab_bridge* aimlab_bridge_create(const char* name, uint32_t tool_count);
+
+/**
+ * @brief Attach to an existing segment as a consumer
+ *
+ * @param name Segment name, or NULL for AIMLAB_BRIDGE_DEFAULT_NAME
+ * @return Handle, or NULL if the segment does not exist or is incompatible
+ */
+AIMLAB_BRIDGE_API aimlab_bridge* aimlab_bridge_open(const char* name);
+
+/**
+ * @brief Unmap the segment and release the handle
+ *
+ * The creator additionally unlinks the name (POSIX).
+ */
+AIMLAB_BRIDGE_API void aimlab_bridge_close(aimlab_bridge* bridge);
+
+/**
+ * @brief Direct pointer to the mapped segment (for the writer side)
+ */
+AIMLAB_BRIDGE_API aimlab_bridge_segment* aimlab_bridge_segment_ptr(aimlab_bridge* bridge);
+
+/**
+ * @brief Number of tool slots the writer publishes (one per haptic device)
+ */
+AIMLAB_BRIDGE_API uint32_t aimlab_bridge_tool_count(aimlab_bridge* bridge);
+
+/**
+ * @brief Copy the latest consistent state of one device's tool
+ *
+ * @param tool Device index, below aimlab_bridge_tool_count()
+ * @param out  Destination
+ * @return AIMLAB_BRIDGE_OK, AIMLAB_BRIDGE_EMPTY, AIMLAB_BRIDGE_BUSY, or
+ *         AIMLAB_BRIDGE_ERROR for a tool index out of range
+ *
+ * Performance Notes:
+ *   - Lock-free; retries a bounded number of times if a write overlaps
+ */
+AIMLAB_BRIDGE_API int aimlab_bridge_read_tool_state(aimlab_bridge* bridge, uint32_t tool,
+                                                    aimlab_haptic_state* out);
+
+/**
+ * @brief Copy the latest consistent state of the first device's tool
+ *
+ * Same as aimlab_bridge_read_tool_state(bridge, 0, out).
+ */
+AIMLAB_BRIDGE_API int aimlab_bridge_read_state(aimlab_bridge* bridge, aimlab_haptic_state* out);
+
+/**
+ * @brief Publish object transforms for the haptic scene
+ *
+ * Only one process may write transforms at a time.
+ *
+ * @param transforms Array of transforms
+ * @param count      Number of entries (clamped to AIMLAB_BRIDGE_MAX_OBJECTS)
+ * @return AIMLAB_BRIDGE_OK or AIMLAB_BRIDGE_ERROR
+ */
+AIMLAB_BRIDGE_API int aimlab_bridge_write_transforms(aimlab_bridge* bridge,
+                                                     const aimlab_object_transform* transforms,
+                                                     uint32_t count);
+
+/**
+ * @brief Monotonic clock shared by writer and readers (nanoseconds)
+ */
+AIMLAB_BRIDGE_API uint64_t aimlab_bridge_now_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AIMLAB_BRIDGE_H */
@@ -2,8 +2,8 @@
  * AIMLAB Haptics - Starter Application
  * 
  * Author: Pi Ko (pi.ko@nyu.edu)
- * Date: 04 February 2026
- * Version: v2.1
+ * Date: 16 October 2026
+ * Version: v3.12
  * 
  * Description:
  *   Starter CHAI3D application with Haply haptic device support.
@@ -40,13 +40,50 @@
  *   - Auto-detection of Haply devices
  *   - Graceful fallback when no device is connected
  *   - Basic 3D scene with camera, lighting, and haptic object
- *   - Real-time haptic rendering thread (1 kHz+)
+ *   - Real-time haptic rendering thread (1 kHz+), one per device (--devices),
+ *     each with its own haptic world so the threads share no lock
  *   - GLUT-based graphics rendering
  *   - Keyboard controls for interaction
+ *   - Lock-free shared-memory bridge to Unity (tool state out, object
+ *     transforms in; see src/bridge/aimlab_bridge.h)
+ *   - Optional fixed-rate haptic scheduler (--rate) with absolute-deadline
+ *     sleeps, overrun policy, SCHED_FIFO and CPU pinning
+ *   - Headless offscreen rendering (--headless, EGL surfaceless), frame cap
+ *     (--max-fps) and frame-time benchmark (--bench-frames)
+ *   - Haptic and render threads own separate scene graphs; the render thread
+ *     draws from triple-buffered snapshots published by the haptic thread
+ *   - Incremental global transform update: only moved subtrees are
+ *     recomputed each haptic tick (--full-transforms for the old traversal)
+ *   - Uniform-grid broad phase: the interaction pass only visits objects
+ *     near the tool, so its cost does not grow with the scene
+ *   - Multirate rendering (--multirate): a 100-200 Hz simulation thread
+ *     reduces the scene near the tool to contact planes that the haptic
+ *     thread renders at full rate
+ *   - Batched primitive forces (--primitive-batch): spheres and boxes in
+ *     one SIMD pass, for scenes with thousands of primitives
+ *   - Binary session recording of every haptic tick (--record) through a
+ *     preallocated ring and background writer; convert with aimlab-recording
+ *   - Offline replay of recordings (--replay) with force diff and ticks/s,
+ *     usable as a regression gate; material overrides (--stiffness, ...)
+ *   - Scene files (--scene) with spheres, boxes and OBJ meshes; meshes are
+ *     compiled once to a memory-mapped .aimmesh cache with their AABB tree
+ *   - Per-stage haptic loop timing with p50/p99/p99.9/max and missed-deadline
+ *     count, printed periodically and exported at exit (--stats-out)
+ *   - Simulated device (--device sim) and graphics-free runs (--no-graphics)
+ *     for hardware-free profiling and CI
+ *   - Scene nodes placed in per-world arenas (--no-scene-pool for the heap)
+ *     and a per-tick scratch arena, so the haptic tick never calls malloc
+ *   - Device filter (--device-filter) for slow or jittery devices: sample
+ *     extrapolation, least-squares velocity and passivity-controlled force
+ *     smoothing, with the time since the reading changed in the statistics
+ * 
+ * Command Line:
+ *   Run with --help for the full list (see src/AppOptions.cpp).
  * 
  * Controls:
  *   - ESC or 'q': Quit application
  *   - 'f': Toggle fullscreen mode
+ *   - 'r': Restart the haptic pipeline in place
  * 
  * Prerequisites (Current Build):
  *   - CHAI3D library from GitHub fork (included as submodule)
@@ -63,6 +100,60 @@
  *   .\run-official-demos.ps1
  * 
  * Changelog:
+ *   v3.12 - 16 October 2026 - sampleAge stage renamed sinceChange: the time since the
+ *                              device reading changed, not the age of the measurement
+ *   v3.11 - 16 October 2026 - Every device publishes its tool to its own Unity bridge slot
+ *   v3.10 - 16 October 2026 - Device filter (--device-filter, FilteredHapticDevice.h):
+ *                              extrapolated positions, least-squares velocity and
+ *                              passivity-controlled force smoothing; sampleAge stage;
+ *                              filter settings recorded and reused by --replay
+ *   v3.9 - 16 October 2026 - Scene nodes in per-world node pools (Arena.h, --no-scene-pool);
+ *                              broad-phase candidates in a per-tick scratch arena reset
+ *                              at the end of computeHapticTick()
+ *   v3.8 - 16 October 2026 - Haptic pipeline lifecycle (HapticPipeline.h): threads joined on
+ *                              stop with the schedulers woken, restart in place ('r',
+ *                              --restart-cycles), GLUT main loop left instead of exit()
+ *   v3.7 - 16 October 2026 - UDP tool-state stream (--stream, HapticStreamPublisher.h):
+ *                              haptic threads queue samples at --stream-rate, an I/O
+ *                              thread batches them into datagrams
+ *   v3.6 - 16 October 2026 - Console messages go through the asynchronous log (AsyncLog.h):
+ *                              queued per thread and written by a log thread; [debug]
+ *                              device position every 60 frames with AIMLAB_LOG_LEVEL=DEBUG
+ *   v3.5 - 16 October 2026 - Batched primitive forces (--primitive-batch): haptic spheres and
+ *                              boxes rendered by the PrimitiveBatch SoA kernel (AVX2 when
+ *                              available, --no-simd for scalar) instead of CHAI3D
+ *   v3.4 - 16 October 2026 - Multirate mode (--multirate HZ): the CHAI3D pipeline runs in a
+ *                              simulation thread and publishes local contact planes; the
+ *                              haptic thread renders them at full rate
+ *   v3.3 - 16 October 2026 - Broad phase (HapticBroadPhase): only objects near the tool are
+ *                              in the haptic world during computeInteractionForces();
+ *                              --no-broadphase, --broadphase-cell
+ *   v3.2 - 16 October 2026 - One haptic thread per device (--devices): each device has its
+ *                              own haptic world replica, scheduler (--cpu N + i), stats and
+ *                              snapshots; per-device and aggregate rate/jitter
+ *   v3.1 - 16 October 2026 - Data-driven scene (--scene): objects, meshes, materials and
+ *                              camera from a scene file; meshes mapped from a binary cache
+ *                              with a prebuilt collision tree
+ *   v3.0 - 16 October 2026 - Deterministic replay (--replay): recorded device samples run
+ *                              through the same tick code faster than real time, forces diffed
+ *                              against the recording; sphere material options
+ *   v2.9 - 16 October 2026 - Session recorder (--record): every haptic tick queued to a
+ *                              wait-free ring and written to a .aimrec file by a writer thread
+ *   v2.8 - 16 October 2026 - Headless EGL rendering through cFrameBuffer, --max-fps frame
+ *                              cap, --bench-frames frame-time percentiles
+ *   v2.7 - 16 October 2026 - Separate haptic world (tool + haptic twins); render thread
+ *                              draws from a triple-buffered SceneSnapshot; atomic run flags
+ *   v2.6 - 16 October 2026 - IncrementalTransformUpdater replaces the per-tick
+ *                              world->computeGlobalPositions(true) traversal
+ *   v2.5 - 16 October 2026 - Fixed-rate HapticScheduler (--rate, --overrun, --fifo, --cpu);
+ *                              wake-up lateness recorded in HapticLoopStats
+ *   v2.4 - 16 October 2026 - Per-stage haptic loop instrumentation (HapticLoopStats);
+ *                              periodic stats summary replaces the per-60-frames position
+ *                              print; CSV/JSON export at close()
+ *   v2.3 - 16 October 2026 - Command-line options; SimulatedHapticDevice backend selectable
+ *                              with --device sim; --no-graphics/--duration headless runs
+ *   v2.2 - 16 October 2026 - Publish tool state to Unity shared-memory bridge every haptic
+ *                              tick; apply object transforms written back by Unity
  *   v2.1 - 04 February 2026 - Fixed emoji encoding for Windows console (replaced with ASCII)
  *   v2.0 - 04 February 2026 - Major documentation update: clarified device compatibility,
  *                              protocol limitations, added Inverse3 guidance, reorganized docs
@@ -86,6 +177,30 @@
  ****************************************************************************/
 
 #include "chai3d.h"
+#include "AppOptions.h"
+#include "Arena.h"
+#include "AsyncLog.h"
+#include "FilteredHapticDevice.h"
+#include "HapticBroadPhase.h"
+#include "HapticClock.h"
+#include "HapticLoopStats.h"
+#include "HapticPipeline.h"
+#include "HapticScheduler.h"
+#include "HapticStreamPublisher.h"
+#include "HeadlessContext.h"
+#include "IncrementalTransformUpdater.h"
+#include "LatencyHistogram.h"
+#include "LocalContactModel.h"
+#include "PrimitiveBatch.h"
+#include "ReplayHapticDevice.h"
+#include "SceneBuilder.h"
+#include "SceneDescription.h"
+#include "SceneSnapshot.h"
+#include "SessionReader.h"
+#include "SessionRecorder.h"
+#include "SharedMemoryBridge.h"
+#include "SimulatedHapticDevice.h"
+#include "TappedHapticDevice.h"
 
 // Platform-specific GLUT includes
 #ifdef __APPLE__
@@ -93,6 +208,17 @@
 #else
     #include <GL/glut.h>
 #endif
+#ifdef FREEGLUT
+    #include <GL/freeglut_ext.h>                // glutLeaveMainLoop()
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
 
 using namespace chai3d;
 using namespace std;
@@ -101,24 +227,100 @@ using namespace std;
 // GLOBAL VARIABLES
 //===========================================================================
 
-// CHAI3D World and Scene Objects
+// CHAI3D World and Scene Objects (render thread only)
 cWorld* world;
 cCamera* camera;
 cDirectionalLight* light;
-cShapeSphere* sphere;
+SceneNodePool renderNodes;              // The render world's nodes
+
+/**
+ * @brief Everything one haptic device's thread owns
+ *
+ * Each device has its own haptic world (tool plus a twin of every scene
+ * object), scheduler, statistics and snapshot buffer, so haptic threads
+ * share no mutable state and take no lock. Device 0 also publishes the
+ * tool state to Unity and feeds --record.
+ */
+struct HapticDeviceLoop {
+    int index = 0;
+    cGenericHapticDevicePtr device;
+    string model;
+    std::shared_ptr<FilteredHapticDevice> filter;   // --device-filter: in front of the device
+    cWorld* world = nullptr;                    // Haptic world: tool plus object twins
+    SceneNodePool nodes;                        // Holds the haptic world's nodes
+    Arena scratch;                              // Per-tick temporaries, reset as each tick ends
+    cToolCursor* tool = nullptr;
+    vector<cGenericObject*> objects;            // Twins, index = object_id (moved by the bridge)
+    BridgeTransformReader bridgeReader;         // This thread's view of Unity's transforms
+    HapticScheduler* scheduler = nullptr;       // Paces updateHaptics() (free-running if --rate 0)
+    IncrementalTransformUpdater* transformUpdater = nullptr;  // nullptr = full traversal each tick
+    HapticBroadPhase* broadPhase = nullptr;     // nullptr = every object in the world (--no-broadphase)
+    PrimitiveBatch* primitives = nullptr;       // --primitive-batch: haptic spheres and boxes
+    vector<PrimitiveHandle> primitiveOf;        // object_id -> batch entry (PRIMITIVE_NONE = CHAI3D)
+    HapticLoopStats stats;
+    SceneSnapshotBuffer snapshots;              // Haptic -> render
+    cShapeSphere* cursorProxy = nullptr;        // Render world, moved from snapshots
+    cShapeSphere* cursorDevice = nullptr;
 
-// Haptic Device and Tool
+    // Multirate (--multirate): the simulation thread runs the tool on the
+    // haptic thread's samples; the haptic thread renders its contact planes
+    HapticSampleBuffer samples;                 // Haptic -> simulation
+    LocalContactBuffer contactModels;           // Simulation -> haptic
+    std::shared_ptr<ReplayHapticDevice> mirror; // The tool's device: serves the latest sample
+    HapticScheduler* simulationScheduler = nullptr;
+    HapticLoopStats simulationStats;
+    double workspaceScale = 1.0;                // Device -> world position (tool at the origin)
+};
+
+// Haptic Devices (static storage: the snapshot buffers are over-aligned)
 cHapticDeviceHandler* handler;
-cGenericHapticDevicePtr hapticDevice;
-cToolCursor* tool;
+HapticDeviceLoop deviceLoops[AIMLAB_MAX_HAPTIC_DEVICES];
+static_assert(AIMLAB_MAX_HAPTIC_DEVICES <= AIMLAB_BRIDGE_MAX_TOOLS,
+              "every haptic device needs a Unity bridge tool slot");
+int deviceLoopCount = 0;
+
+// Command-Line Options
+AppOptions options;
+
+// Haptic and simulation threads of every device, stopped and restarted as one
+HapticPipeline hapticPipeline;
 
-// Simulation State
-bool simulationRunning  = false;
-bool simulationFinished = true;     // Start true so close() doesn't hang if haptics never started
-cThread* hapticThread;
+// Tool
+const double toolRadius = 0.015;        // Larger cursor (15mm) so it's visible
 
 // Device State
-bool hapticDeviceConnected = false;  // Whether a haptic device was successfully initialized
+bool hapticDeviceConnected = false;  // Whether at least one haptic device was initialized
+
+// Render objects: index = aimlab_object_transform::object_id = snapshot object index
+vector<cGenericObject*> renderObjects;  // Moved from device 0's snapshots
+vector<ObjectBounds> objectBounds;      // Local boxes, same index (for the broad phase)
+
+// Headless Rendering
+HeadlessContext headlessContext;
+cFrameBufferPtr frameBuffer;            // Offscreen target used instead of the window
+LatencyHistogram frameTimes;            // Render thread only
+
+// Unity Bridge
+SharedMemoryBridge unityBridge;
+
+// Session Recording (--record): the tool reads the device through recordTap
+SessionRecorder sessionRecorder;
+std::shared_ptr<TappedHapticDevice> recordTap;
+
+// Network stream (--stream): tool state queued per device, sent over UDP by an I/O thread
+HapticStreamPublisher hapticStream;
+
+// Session Replay (--replay): recorded samples drive replayDevice on the main thread
+SessionReader replayReader;
+std::shared_ptr<ReplayHapticDevice> replayDevice;
+uint64_t replayTickNs = 0;              // Recorded time of the tick being replayed
+
+// Scene description (built-in sphere, --scene file, or the recording's scene);
+// the first object's material is the one recorded and overridden
+SceneDescription scene;
+
+// Process exit status (1 = replayed forces differ from the recording)
+int exitCode = 0;
 
 // Window Dimensions
 int windowW = 1024;
@@ -128,69 +330,808 @@ int windowH = 768;
 // FUNCTION DECLARATIONS
 //===========================================================================
 
-void updateHaptics();
+void updateHaptics(void* loopArg);
+void computeHapticTick(HapticDeviceLoop& loop, HapticLoopStats& stats);
+void updateSimulation(void* loopArg);
+void computeLocalTick(HapticDeviceLoop& loop);
+void publishContactModel(HapticDeviceLoop& loop);
+void runReplay();
+void applyBridgeTransforms(HapticDeviceLoop& loop);
+void recordSessionTick(HapticDeviceLoop& loop, uint64_t timestampNs);
+void streamToolState(HapticDeviceLoop& loop, uint64_t timestampNs, const double devicePos[3],
+                     const double deviceRot[9], const double proxyPos[3], const double force[3]);
+void publishSceneSnapshot(HapticDeviceLoop& loop);
+const SceneSnapshot& acquireSceneSnapshot(HapticDeviceLoop& loop);
+void dumpHapticStats(const SceneSnapshot& snapshot);
+void renderFrame();
 void updateGraphics();
+void scheduleRedisplay();
+void runHeadless();
 void resizeWindow(int w, int h);
 void keySelect(unsigned char key, int x, int y);
+void startHapticPipeline();
+void restartHapticPipeline(uint64_t& stopNs, uint64_t& startNs);
+void runRestartCycles();
+void requestQuit();
 void close();
 
 //===========================================================================
 // HAPTIC THREAD FUNCTION
 //===========================================================================
 
-void updateHaptics() {
-    simulationRunning  = true;
-    simulationFinished = false;
+/**
+ * @brief Haptic thread of one device (one per entry of deviceLoops)
+ *
+ * @param loopArg The device's HapticDeviceLoop
+ */
+void updateHaptics(void* loopArg) {
+    HapticDeviceLoop& loop = *static_cast<HapticDeviceLoop*>(loopArg);
+
+    // Real-time priority / affinity must be applied from this thread
+    string schedulerInfo;
+    const bool configured = loop.scheduler->configureCurrentThread(schedulerInfo);
+    char device[32] = "";
+    if (deviceLoopCount > 1) {
+        snprintf(device, sizeof(device), " (device %d)", loop.index);
+    }
+    if (hapticPipeline.starts() > 1) {
+        // Restarted: same settings as the first run, already reported
+    } else if (configured) {
+        AIMLAB_LOG_INFO("[init] Haptic scheduler%s: %s", device, schedulerInfo.c_str());
+    } else {
+        AIMLAB_LOG_WARN("[init] WARNING: Haptic scheduler%s: %s", device, schedulerInfo.c_str());
+    }
+    const bool fixedRate = !loop.scheduler->isFreeRunning();
+    loop.scheduler->start(hapticNowNs());
+
+    while (hapticPipeline.isRunning()) {
+        // Sleep until this tick's absolute deadline (no-op when free-running);
+        // stop() cuts the sleep short
+        const uint64_t lateness = loop.scheduler->waitForNextTick();
+        if (!hapticPipeline.isRunning()) {
+            break;
+        }
+
+        loop.stats.beginTick(hapticNowNs());
+        if (fixedRate) {
+            loop.stats.recordStage(STAGE_WAKE_LATENESS, lateness);
+        }
+
+        // Multirate: the simulation thread owns the tool and the objects
+        if (loop.mirror != nullptr) {
+            computeLocalTick(loop);
+            loop.stats.endTick(hapticNowNs());
+            continue;
+        }
+
+        applyBridgeTransforms(loop);
+
+        computeHapticTick(loop, loop.stats);
+
+        // Publish tool state to Unity into this device's slot (wait-free,
+        // no allocation)
+        {
+            const cVector3d devicePos = loop.tool->getDeviceGlobalPos();
+            const cVector3d proxyPos  = loop.tool->m_hapticPoint->getGlobalPosProxy();
+            const cVector3d force     = loop.tool->getDeviceGlobalForce();
+            const double devicePosOut[3] = { devicePos.x(), devicePos.y(), devicePos.z() };
+            const double proxyPosOut[3]  = { proxyPos.x(),  proxyPos.y(),  proxyPos.z()  };
+            const double forceOut[3]     = { force.x(),     force.y(),     force.z()     };
+            unityBridge.publishState((uint32_t)loop.index, devicePosOut, proxyPosOut, forceOut);
+        }
+
+        // Network stream at --stream-rate: queued here, sent by the I/O thread
+        const uint64_t now = hapticNowNs();
+        if (hapticStream.sampleDue(loop.index, now)) {
+            const cVector3d devicePos = loop.tool->getDeviceGlobalPos();
+            const cMatrix3d deviceRot = loop.tool->getDeviceGlobalRot();
+            const cVector3d proxyPos  = loop.tool->m_hapticPoint->getGlobalPosProxy();
+            const cVector3d force     = loop.tool->getDeviceGlobalForce();
+            double pos[3], rot[9], proxy[3], forceOut[3];
+            for (int r = 0; r < 3; r++) {
+                pos[r] = devicePos(r);
+                proxy[r] = proxyPos(r);
+                forceOut[r] = force(r);
+                for (int c = 0; c < 3; c++) {
+                    rot[3 * r + c] = deviceRot(r, c);
+                }
+            }
+            streamToolState(loop, now, pos, rot, proxy, forceOut);
+        }
+
+        // Hand the render thread a consistent copy of this tick
+        publishSceneSnapshot(loop);
+
+        loop.stats.endTick(hapticNowNs());
+    }
+}
+
+/**
+ * @brief One pass of the haptic pipeline, shared by updateHaptics(),
+ *        updateSimulation() and runReplay()
+ *
+ * Updates global transforms, reads the device, computes and sends the
+ * force, records stage timings into a_stats and queues the tick for
+ * --record. Resets the loop's scratch arena when done.
+ */
+void computeHapticTick(HapticDeviceLoop& loop, HapticLoopStats& stats) {
+    // Timestamp each pipeline stage
+    const uint64_t t0 = hapticNowNs();
+    if (loop.transformUpdater != nullptr) {
+        loop.transformUpdater->update();
+    } else {
+        loop.world->computeGlobalPositions(true);
+    }
+    const uint64_t t1 = hapticNowNs();
+    // With --multirate the haptic thread owns the filter and this tool reads the mirror
+    FilteredHapticDevice* filter = (loop.mirror == nullptr) ? loop.filter.get() : nullptr;
+    if (filter != nullptr) {
+        // A replay runs the filter on the recorded clock, so its forces repeat
+        filter->beginTick((replayDevice != nullptr) ? replayTickNs : t1);
+    }
+    loop.tool->updateFromDevice();
+    const uint64_t t2 = hapticNowNs();
+    if (loop.broadPhase != nullptr) {
+        loop.broadPhase->update(loop.tool->getDeviceGlobalPos(),
+                                loop.tool->m_hapticPoint->getGlobalPosProxy(), loop.scratch);
+    }
+    const uint64_t t3 = hapticNowNs();
+    loop.tool->computeInteractionForces();
+    const uint64_t t4 = hapticNowNs();
+    if (loop.primitives != nullptr) {
+        // Batched spheres and boxes push on the device position, on top of
+        // the proxy force of everything CHAI3D rendered
+        const cVector3d pos = loop.tool->getDeviceGlobalPos();
+        const cVector3d vel = loop.tool->getDeviceGlobalLinVel();
+        PrimitiveTool probe = { { pos.x(), pos.y(), pos.z() }, { vel.x(), vel.y(), vel.z() },
+                                toolRadius };
+        double force[3];
+        loop.primitives->computeForce(probe, force);
+        loop.tool->addDeviceGlobalForce(cVector3d(force[0], force[1], force[2]));
+    }
+    const uint64_t t5 = hapticNowNs();
+    loop.tool->applyToDevice();
+    const uint64_t t6 = hapticNowNs();
+
+    stats.recordStage(STAGE_GLOBAL_POSITIONS,   t1 - t0);
+    stats.recordStage(STAGE_UPDATE_FROM_DEVICE, t2 - t1);
+    stats.recordStage(STAGE_BROAD_PHASE,        t3 - t2);
+    stats.recordStage(STAGE_INTERACTION_FORCES, t4 - t3);
+    stats.recordStage(STAGE_PRIMITIVES,         t5 - t4);
+    stats.recordStage(STAGE_APPLY_TO_DEVICE,    t6 - t5);
+    if (filter != nullptr) {
+        stats.recordStage(STAGE_SINCE_CHANGE, filter->getFilter().timeSinceChangeNs());
+    }
+
+    // Queue this tick for the session file (wait-free, no allocation)
+    if (loop.index == 0 && recordTap != nullptr) {
+        recordSessionTick(loop, t1);
+    }
+
+    loop.scratch.reset();
+}
+
+/**
+ * @brief Apply object transforms written by Unity since this loop's last poll
+ *
+ * Transforms refer to objects by their index in loop.objects; unknown
+ * ids and entries without AIMLAB_TRANSFORM_VALID are ignored.
+ */
+void applyBridgeTransforms(HapticDeviceLoop& loop) {
+    uint32_t count = 0;
+    const aimlab_object_transform* transforms =
+        unityBridge.pollObjectTransforms(loop.bridgeReader, count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const aimlab_object_transform& t = transforms[i];
+        if (!(t.flags & AIMLAB_TRANSFORM_VALID) || t.object_id >= loop.objects.size()) {
+            continue;
+        }
+
+        cMatrix3d rot;
+        rot.set(t.rot[0], t.rot[1], t.rot[2],
+                t.rot[3], t.rot[4], t.rot[5],
+                t.rot[6], t.rot[7], t.rot[8]);
 
-    while (simulationRunning) {
-        world->computeGlobalPositions(true);
-        tool->updateFromDevice();
-        tool->computeInteractionForces();
-        tool->applyToDevice();
+        cGenericObject* object = loop.objects[t.object_id];
+        object->setLocalPos(t.pos[0], t.pos[1], t.pos[2]);
+        object->setLocalRot(rot);
+        if (loop.broadPhase != nullptr) {
+            // Recomputes the global transform too: the object may be detached
+            loop.broadPhase->objectMoved(t.object_id);
+        } else if (loop.transformUpdater != nullptr) {
+            loop.transformUpdater->markDirty(object);
+        }
+        if (loop.primitives != nullptr) {
+            loop.primitives->setPose(loop.primitiveOf[t.object_id], t.pos, t.rot);
+        }
+        if (loop.index == 0 && recordTap != nullptr) {
+            sessionRecorder.addFlags(AIMLAB_REC_FLAG_BRIDGE_MOVED);
+        }
     }
+}
+
+/**
+ * @brief Copy what the tool read and commanded this tick into the recorder
+ *
+ * @param timestampNs When updateFromDevice() started
+ */
+void recordSessionTick(HapticDeviceLoop& loop, uint64_t timestampNs) {
+    HapticRecord record;
+    record.timestampNs = timestampNs;
+    record.device = recordTap->getSample();
+
+    const cVector3d proxyPos = loop.tool->m_hapticPoint->getGlobalPosProxy();
+    record.proxyPos[0] = proxyPos.x();
+    record.proxyPos[1] = proxyPos.y();
+    record.proxyPos[2] = proxyPos.z();
+    recordTap->getCommand(record.force, record.torque, record.gripperForce);
 
-    simulationFinished = true;
+    sessionRecorder.record(record);
+}
+
+/**
+ * @brief Queue one --stream sample; only memory writes, the I/O thread sends
+ */
+void streamToolState(HapticDeviceLoop& loop, uint64_t timestampNs, const double devicePos[3],
+                     const double deviceRot[9], const double proxyPos[3], const double force[3]) {
+    HapticStreamSample sample;
+    sample.timestampNs = timestampNs;
+    sample.tick = loop.stats.ticks() + 1;
+    for (int k = 0; k < 3; k++) {
+        sample.devicePos[k] = (float)devicePos[k];
+        sample.proxyPos[k] = (float)proxyPos[k];
+        sample.force[k] = (float)force[k];
+    }
+    hapticStreamSetRotation(sample, deviceRot);
+    hapticStream.publish(loop.index, sample);
+}
+
+//===========================================================================
+// MULTIRATE RENDERING
+//===========================================================================
+
+/**
+ * @brief Read everything the tool would read from a device in updateFromDevice()
+ */
+static void readHapticSample(cGenericHapticDevice& device, HapticSample& sample) {
+    cVector3d position, linearVelocity, angularVelocity;
+    cMatrix3d rotation;
+    unsigned int userSwitches = 0;
+    device.getPosition(position);
+    device.getRotation(rotation);
+    device.getLinearVelocity(linearVelocity);
+    device.getAngularVelocity(angularVelocity);
+    device.getGripperAngleRad(sample.gripperAngle);
+    device.getGripperAngularVelocity(sample.gripperAngularVelocity);
+    device.getUserSwitches(userSwitches);
+
+    for (int r = 0; r < 3; r++) {
+        sample.position[r] = position(r);
+        sample.linearVelocity[r] = linearVelocity(r);
+        sample.angularVelocity[r] = angularVelocity(r);
+        for (int c = 0; c < 3; c++) {
+            sample.rotation[3 * r + c] = rotation(r, c);
+        }
+    }
+    sample.userSwitches = userSwitches;
+}
+
+/**
+ * @brief Haptic tick in multirate mode: device -> local contact model -> force
+ *
+ * Hands the device sample to the simulation thread and renders the newest
+ * contact model it published. Never waits on the simulation thread; costs
+ * the same whatever the scene holds.
+ */
+void computeLocalTick(HapticDeviceLoop& loop) {
+    const uint64_t t0 = hapticNowNs();
+    cGenericHapticDevice& device = (loop.filter != nullptr) ? *loop.filter : *loop.device;
+    if (loop.filter != nullptr) {
+        loop.filter->beginTick(t0);
+    }
+    HapticSample& sample = loop.samples.writeBuffer();
+    readHapticSample(device, sample);
+    const double pos[3] = { loop.workspaceScale * sample.position[0],
+                            loop.workspaceScale * sample.position[1],
+                            loop.workspaceScale * sample.position[2] };
+    double rot[9];
+    memcpy(rot, sample.rotation, sizeof(rot));      // for --stream; sample is shared after publish()
+    loop.samples.publish();
+    const uint64_t t1 = hapticNowNs();
+
+    // No planes until the first simulation step: zero force
+    loop.contactModels.acquire();
+    const LocalContactModel& model = loop.contactModels.readBuffer();
+    double force[3];
+    computeLocalContactForce(model, pos, force);
+    const uint64_t t2 = hapticNowNs();
+
+    device.setForceAndTorqueAndGripperForce(cVector3d(force[0], force[1], force[2]),
+                                            cVector3d(0.0, 0.0, 0.0), 0.0);
+    const uint64_t t3 = hapticNowNs();
+
+    loop.stats.recordStage(STAGE_UPDATE_FROM_DEVICE, t1 - t0);
+    loop.stats.recordStage(STAGE_INTERACTION_FORCES, t2 - t1);
+    loop.stats.recordStage(STAGE_APPLY_TO_DEVICE,    t3 - t2);
+    if (model.step != 0) {
+        loop.stats.recordStage(STAGE_MODEL_AGE, t1 - model.timestampNs);
+    }
+    if (loop.filter != nullptr) {
+        loop.stats.recordStage(STAGE_SINCE_CHANGE, loop.filter->getFilter().timeSinceChangeNs());
+    }
+
+    // Unity gets the device at full rate and the simulation's proxy
+    unityBridge.publishState((uint32_t)loop.index, pos, model.proxyPos, force);
+    if (hapticStream.sampleDue(loop.index, t3)) {
+        streamToolState(loop, t0, pos, rot, model.proxyPos, force);
+    }
+}
+
+/**
+ * @brief Simulation thread of one device in multirate mode
+ *
+ * Runs the full pipeline (bridge transforms, broad phase, CHAI3D
+ * interaction) at --multirate HZ on the haptic thread's latest device
+ * sample, then publishes the contact model and the render snapshot. Its
+ * tool's force goes to the mirror device, not to the hardware.
+ *
+ * @param loopArg The device's HapticDeviceLoop
+ */
+void updateSimulation(void* loopArg) {
+    HapticDeviceLoop& loop = *static_cast<HapticDeviceLoop*>(loopArg);
+    loop.simulationScheduler->start(hapticNowNs());
+
+    while (hapticPipeline.isRunning()) {
+        const uint64_t lateness = loop.simulationScheduler->waitForNextTick();
+        if (!hapticPipeline.isRunning()) {
+            break;
+        }
+        loop.simulationStats.beginTick(hapticNowNs());
+        loop.simulationStats.recordStage(STAGE_WAKE_LATENESS, lateness);
+
+        applyBridgeTransforms(loop);
+
+        // Keep the previous sample until the haptic thread publishes one
+        if (loop.samples.acquire()) {
+            loop.mirror->setSample(loop.samples.readBuffer());
+        }
+        computeHapticTick(loop, loop.simulationStats);
+
+        publishContactModel(loop);
+        publishSceneSnapshot(loop);
+
+        loop.simulationStats.endTick(hapticNowNs());
+    }
+}
+
+/**
+ * @brief Add one contact as a plane of the local model
+ *
+ * @param normal Out of the surface (need not be unit length)
+ */
+static void addContactPlane(LocalContactModel& model, const cVector3d& point,
+                            const cVector3d& normal, const cGenericObject* object) {
+    const double p[3] = { point.x(), point.y(), point.z() };
+    const double n[3] = { normal.x(), normal.y(), normal.z() };
+    addLocalContactPlane(model, p, n, object->m_material->getStiffness());
+}
+
+/**
+ * @brief Reduce the simulation tool's contacts to planes for the haptic thread
+ *
+ * Simulation thread, after computeHapticTick(). The tool's contact radius
+ * includes AIMLAB_LOCAL_MODEL_MARGIN, so surfaces the tool is about to
+ * reach are already in the model.
+ */
+void publishContactModel(HapticDeviceLoop& loop) {
+    LocalContactModel& model = loop.contactModels.writeBuffer();
+    cHapticPoint* point = loop.tool->m_hapticPoint;
+    const cVector3d proxy = point->getGlobalPosProxy();
+    model.planeCount = 0;
+
+    // Finger-proxy contacts (meshes): the proxy is outside the surface
+    for (int i = 0; i < point->getNumCollisionEvents(); i++) {
+        const cCollisionEvent* event = point->getCollisionEvent(i);
+        cVector3d normal = event->m_globalNormal;
+        if (normal.dot(proxy - event->m_globalPos) < 0.0) {
+            normal.negate();
+        }
+        addContactPlane(model, event->m_globalPos, normal, event->m_object);
+    }
+
+    // Potential-field contacts (shapes): nearest surface point, object frame
+    for (int i = 0; i < point->getNumInteractionEvents(); i++) {
+        const cInteractionEvent* event = point->getInteractionEvent(i);
+        const cGenericObject* object = event->m_object;
+        cVector3d normal = object->getGlobalRot() * (event->m_localPos - event->m_localSurfacePos);
+        if (event->m_isInside) {
+            normal.negate();
+        }
+        addContactPlane(model, object->getGlobalPos() + object->getGlobalRot() * event->m_localSurfacePos,
+                        normal, object);
+    }
+
+    for (int k = 0; k < 3; k++) {
+        model.proxyPos[k] = proxy(k);
+    }
+    model.toolRadius = toolRadius;
+    model.step = loop.simulationStats.ticks() + 1;
+    model.timestampNs = hapticNowNs();
+    loop.contactModels.publish();
+}
+
+//===========================================================================
+// SCENE SNAPSHOTS
+//===========================================================================
+
+/**
+ * @brief Copy tool state and shared-object transforms into the next snapshot
+ *
+ * Haptic thread, once per tick, after applyToDevice(). Never blocks.
+ */
+void publishSceneSnapshot(HapticDeviceLoop& loop) {
+    SceneSnapshot& snapshot = loop.snapshots.writeBuffer();
+
+    const cVector3d devicePos = loop.tool->getDeviceGlobalPos();
+    const cVector3d proxyPos  = loop.tool->m_hapticPoint->getGlobalPosProxy();
+    const cVector3d goalPos   = loop.tool->m_hapticPoint->getGlobalPosGoal();
+    const cVector3d force     = loop.tool->getDeviceGlobalForce();
+    for (int k = 0; k < 3; k++) {
+        snapshot.devicePos[k] = devicePos(k);
+        snapshot.proxyPos[k]  = proxyPos(k);
+        snapshot.goalPos[k]   = goalPos(k);
+        snapshot.force[k]     = force(k);
+    }
+
+    const size_t count = (loop.objects.size() < SCENE_SNAPSHOT_MAX_OBJECTS)
+                       ? loop.objects.size() : SCENE_SNAPSHOT_MAX_OBJECTS;
+    for (size_t i = 0; i < count; i++) {
+        const cVector3d& pos = loop.objects[i]->getGlobalPos();
+        const cMatrix3d& rot = loop.objects[i]->getGlobalRot();
+        SnapshotTransform& out = snapshot.objects[i];
+        for (int r = 0; r < 3; r++) {
+            out.pos[r] = pos(r);
+            for (int c = 0; c < 3; c++) {
+                out.rot[r * 3 + c] = rot(r, c);
+            }
+        }
+    }
+    snapshot.objectCount = (uint32_t)count;
+    snapshot.tick = loop.stats.ticks() + 1;
+    snapshot.timestampNs = hapticNowNs();
+
+    loop.snapshots.publish();
+}
+
+/**
+ * @brief Latest complete snapshot of one device (render thread / idle loop only)
+ *
+ * tick == 0 until the device's haptic thread has published its first tick.
+ */
+const SceneSnapshot& acquireSceneSnapshot(HapticDeviceLoop& loop) {
+    loop.snapshots.acquire();
+    return loop.snapshots.readBuffer();
+}
+
+/**
+ * @brief Move the render world's objects to a snapshot
+ */
+static void applySceneSnapshot(const SceneSnapshot& snapshot) {
+    if (snapshot.tick == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < snapshot.objectCount && i < renderObjects.size(); i++) {
+        const SnapshotTransform& t = snapshot.objects[i];
+        cMatrix3d rot;
+        rot.set(t.rot[0], t.rot[1], t.rot[2],
+                t.rot[3], t.rot[4], t.rot[5],
+                t.rot[6], t.rot[7], t.rot[8]);
+        renderObjects[i]->setLocalPos(t.pos[0], t.pos[1], t.pos[2]);
+        renderObjects[i]->setLocalRot(rot);
+    }
+}
+
+/**
+ * @brief Move one device's cursor pair to its snapshot
+ */
+static void applyCursorSnapshot(HapticDeviceLoop& loop, const SceneSnapshot& snapshot) {
+    if (snapshot.tick == 0 || loop.cursorProxy == nullptr) {
+        return;
+    }
+    loop.cursorProxy->setLocalPos(snapshot.proxyPos[0], snapshot.proxyPos[1], snapshot.proxyPos[2]);
+    loop.cursorDevice->setLocalPos(snapshot.goalPos[0], snapshot.goalPos[1], snapshot.goalPos[2]);
+}
+
+//===========================================================================
+// STATISTICS
+//===========================================================================
+
+/**
+ * @brief Tick rate (from the mean period) and period jitter (p99 - p50)
+ */
+static void rateAndJitter(const HapticLoopStats::Report& report, double& rateHz, double& jitterUs) {
+    const LatencyHistogram::Snapshot& period = report.stages[STAGE_PERIOD];
+    rateHz = (period.count > 0 && period.mean() > 0.0) ? 1e9 / period.mean() : 0.0;
+    jitterUs = (period.count > 0) ? (double)(period.percentile(0.99) - period.percentile(0.5)) * 1e-3
+                                  : 0.0;
+}
+
+/**
+ * @brief --stats-out file of one device: as given for device 0, else with
+ *        ".devN" before the extension (stats.json -> stats.dev1.json)
+ */
+static string deviceStatsFile(const string& file, int device) {
+    if (device == 0) {
+        return file;
+    }
+    const size_t dot = file.find_last_of('.');
+    const size_t slash = file.find_last_of("/\\");
+    const size_t split = (dot != string::npos && (slash == string::npos || dot > slash))
+                       ? dot : file.size();
+    return file.substr(0, split) + ".dev" + to_string(device) + file.substr(split);
+}
+
+/**
+ * @brief Print a windowed haptic loop summary every statsIntervalSeconds
+ *
+ * One summary per device, plus the aggregate rate and worst jitter when
+ * several devices run. Called from the render loop (or the idle loop with
+ * --no-graphics). Only reads the lock-free histograms; no haptic thread
+ * is ever blocked.
+ */
+void dumpHapticStats(const SceneSnapshot& snapshot) {
+    static std::unique_ptr<HapticLoopStats::Report> previous[AIMLAB_MAX_HAPTIC_DEVICES];
+    static std::unique_ptr<HapticLoopStats::Report> current[AIMLAB_MAX_HAPTIC_DEVICES];
+    static uint64_t nextDumpNs = 0;
+    static bool havePrevious = false;
+    static char text[8192];
+
+    if (!hapticDeviceConnected || options.statsIntervalSeconds <= 0.0) {
+        return;
+    }
+
+    const uint64_t now = hapticNowNs();
+    if (now < nextDumpNs) {
+        return;
+    }
+    nextDumpNs = now + (uint64_t)(options.statsIntervalSeconds * 1e9);
+
+    for (int i = 0; i < deviceLoopCount; i++) {
+        if (current[i] == nullptr) {
+            previous[i].reset(new HapticLoopStats::Report());
+            current[i].reset(new HapticLoopStats::Report());
+        }
+        deviceLoops[i].stats.snapshot(*current[i]);
+    }
+
+    if (havePrevious) {
+        size_t length = 0;
+        double totalRate = 0.0, minRate = 0.0, worstJitter = 0.0;
+        for (int i = 0; i < deviceLoopCount && length < sizeof(text); i++) {
+            HapticLoopStats::Report window = *current[i];
+            window.subtract(*previous[i]);
+
+            if (deviceLoopCount > 1) {
+                const int n = snprintf(text + length, sizeof(text) - length, "[stats] device %d (%s)\n",
+                                       i, deviceLoops[i].model.c_str());
+                length += (n > 0) ? (size_t)n : 0;
+            }
+            if (length < sizeof(text)) {
+                length += HapticLoopStats::formatSummary(window, text + length, sizeof(text) - length);
+            }
+
+            double rate, jitter;
+            rateAndJitter(window, rate, jitter);
+            totalRate += rate;
+            minRate = (i == 0 || rate < minRate) ? rate : minRate;
+            worstJitter = std::max(worstJitter, jitter);
+        }
+        if (deviceLoopCount > 1 && length < sizeof(text)) {
+            const int n = snprintf(text + length, sizeof(text) - length,
+                                   "[stats] %d devices: %.0f Hz total, slowest %.0f Hz, "
+                                   "worst period jitter %.2f us\n",
+                                   deviceLoopCount, totalRate, minRate, worstJitter);
+            length += (n > 0) ? (size_t)n : 0;
+        }
+        if (length < sizeof(text)) {
+            snprintf(text + length, sizeof(text) - length, "[stats]   tool pos %.4f, %.4f, %.4f\n",
+                     snapshot.devicePos[0], snapshot.devicePos[1], snapshot.devicePos[2]);
+        }
+
+        // One log message per line; the log thread does the writing
+        for (char* line = text; *line != '\0';) {
+            char* end = strchr(line, '\n');
+            if (end != nullptr) {
+                *end = '\0';
+            }
+            AIMLAB_LOG_INFO("%s", line);
+            if (end == nullptr) {
+                break;
+            }
+            line = end + 1;
+        }
+    }
+    for (int i = 0; i < deviceLoopCount; i++) {
+        std::swap(previous[i], current[i]);
+    }
+    havePrevious = true;
 }
 
 //===========================================================================
 // GRAPHICS CALLBACKS
 //===========================================================================
 
-void updateGraphics() {
-    camera->renderView(windowW, windowH);
+/**
+ * @brief Draw one frame into the window or the headless framebuffer
+ */
+void renderFrame() {
+    // Draw only from the latest complete haptic snapshots; no haptic
+    // thread touches this world. Objects follow device 0's haptic world
+    // (every replica applies the same bridge transforms); each device
+    // draws its own cursor.
+    const SceneSnapshot& snapshot = acquireSceneSnapshot(deviceLoops[0]);
+    applySceneSnapshot(snapshot);
+    applyCursorSnapshot(deviceLoops[0], snapshot);
+    for (int i = 1; i < deviceLoopCount; i++) {
+        applyCursorSnapshot(deviceLoops[i], acquireSceneSnapshot(deviceLoops[i]));
+    }
+    world->computeGlobalPositions(true);
+
+    if (frameBuffer != nullptr) {
+        frameBuffer->renderView();
+    } else {
+        camera->renderView(windowW, windowH);
+    }
+
+    // Periodic haptic loop statistics (includes device 0's tool position)
+    dumpHapticStats(snapshot);
 
-    // Debug: print tool position to console every ~60 frames
     if (hapticDeviceConnected) {
         static int frameCount = 0;
         static bool warnedZeroPosition = false;
         if (++frameCount % 60 == 0) {
-            cVector3d pos = tool->getDeviceGlobalPos();
-            cout << "[debug] Tool pos: "
-                 << pos.x() << ", "
-                 << pos.y() << ", "
-                 << pos.z() << endl;
+            cVector3d pos(snapshot.devicePos[0], snapshot.devicePos[1], snapshot.devicePos[2]);
+            AIMLAB_LOG_DEBUG("[debug] Frame %d: device position %.4f, %.4f, %.4f", frameCount,
+                             pos(0), pos(1), pos(2));
 
             // Check for persistent zero position (Inverse3 protocol mismatch symptom)
             if (!warnedZeroPosition && frameCount > 300) {  // After 5 seconds @ 60fps
                 if (pos.length() < 0.001) {  // Essentially zero
-                    cout << endl;
-                    cout << "  WARNING: Position is stuck at (0,0,0)" << endl;
-                    cout << "  If you have Inverse3, this is a protocol mismatch." << endl;
-                    cout << "  Use: .\\run-official-demos.ps1" << endl;
-                    cout << "  See: docs/INVERSE3_PROTOCOL_NOTES.md" << endl;
-                    cout << endl;
+                    AIMLAB_LOG_WARN("\n"
+                                    "  WARNING: Position is stuck at (0,0,0)\n"
+                                    "  If you have Inverse3, this is a protocol mismatch.\n"
+                                    "  Use: .\\run-official-demos.ps1\n"
+                                    "  See: docs/INVERSE3_PROTOCOL_NOTES.md\n");
                     warnedZeroPosition = true;
                 }
             }
         }
     }
 
+}
+
+void updateGraphics() {
+    renderFrame();
     glutSwapBuffers();
 
-    // Keep redrawing
+    // Keep redrawing (at most --max-fps)
+    scheduleRedisplay();
+}
+
+static void redisplayTimer(int) {
     glutPostRedisplay();
 }
 
+/**
+ * @brief Request the next GLUT frame, honouring the --max-fps cap
+ */
+void scheduleRedisplay() {
+    if (options.maxFps <= 0.0) {
+        glutPostRedisplay();
+        return;
+    }
+
+    static uint64_t nextFrameNs = 0;
+    const uint64_t periodNs = (uint64_t)(1e9 / options.maxFps);
+    const uint64_t now = hapticNowNs();
+    nextFrameNs = (nextFrameNs + periodNs > now) ? nextFrameNs + periodNs : now;
+
+    const unsigned int delayMs = (unsigned int)((nextFrameNs - now) / 1000000);
+    if (delayMs == 0) {
+        glutPostRedisplay();
+    } else {
+        glutTimerFunc(delayMs, redisplayTimer, 0);
+    }
+}
+
+/**
+ * @brief Offscreen render loop (--headless / --bench-frames)
+ *
+ * Each frame is followed by glFinish() so the measured time includes the
+ * GPU (or llvmpipe) work, not just command submission.
+ */
+void runHeadless() {
+    const int warmupFrames = 10;
+    const uint64_t periodNs = (options.maxFps > 0.0 && options.benchFrames == 0)
+                            ? (uint64_t)(1e9 / options.maxFps) : 0;
+    uint64_t nextFrameNs = hapticNowNs();
+    cPrecisionClock runClock;
+    runClock.start(true);
+
+    for (int frame = 0; ; frame++) {
+        if (options.benchFrames > 0 && frame >= options.benchFrames + warmupFrames) {
+            break;
+        }
+        if (options.durationSeconds > 0.0 &&
+            runClock.getCurrentTimeSeconds() >= options.durationSeconds) {
+            break;
+        }
+
+        const uint64_t t0 = hapticNowNs();
+        renderFrame();
+        glFinish();
+        if (frame >= warmupFrames || options.benchFrames == 0) {
+            frameTimes.record(hapticNowNs() - t0);
+        }
+
+        if (periodNs != 0) {
+            nextFrameNs += periodNs;
+            const uint64_t now = hapticNowNs();
+            if (nextFrameNs > now) {
+                cSleepMs((unsigned int)((nextFrameNs - now) / 1000000));
+            } else {
+                nextFrameNs = now;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Print (and optionally export) headless frame-time percentiles
+ */
+static void reportFrameTimes() {
+    std::unique_ptr<LatencyHistogram::Snapshot> s(new LatencyHistogram::Snapshot());
+    frameTimes.snapshot(*s);
+    if (s->count == 0) {
+        return;
+    }
+
+    const double p50 = s->percentile(0.5) * 1e-6;
+    const double p90 = s->percentile(0.9) * 1e-6;
+    const double p99 = s->percentile(0.99) * 1e-6;
+    const double mean = s->mean() * 1e-6;
+    const double maxMs = s->max * 1e-6;
+    const std::string renderer = headlessContext.getRenderer();
+
+    AIMLAB_LOG_INFO("[frames] %llu frames at %dx%d on %s", (unsigned long long)s->count,
+                    options.framebufferWidth, options.framebufferHeight, renderer.c_str());
+    AIMLAB_LOG_INFO("[frames] mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f ms  (%.1f fps)",
+                    mean, p50, p90, p99, maxMs, mean > 0.0 ? 1000.0 / mean : 0.0);
+
+    if (!options.benchOutputFile.empty()) {
+        FILE* file = fopen(options.benchOutputFile.c_str(), "w");
+        if (file == nullptr) {
+            AIMLAB_LOG_WARN("[frames] WARNING: Could not write %s", options.benchOutputFile.c_str());
+            return;
+        }
+        fprintf(file, "{\n");
+        fprintf(file, "  \"frames\": %llu,\n", (unsigned long long)s->count);
+        fprintf(file, "  \"width\": %d,\n", options.framebufferWidth);
+        fprintf(file, "  \"height\": %d,\n", options.framebufferHeight);
+        fprintf(file, "  \"renderer\": \"%s\",\n", renderer.c_str());
+        fprintf(file, "  \"mean_ms\": %.4f,\n", mean);
+        fprintf(file, "  \"p50_ms\": %.4f,\n", p50);
+        fprintf(file, "  \"p90_ms\": %.4f,\n", p90);
+        fprintf(file, "  \"p99_ms\": %.4f,\n", p99);
+        fprintf(file, "  \"max_ms\": %.4f\n", maxMs);
+        fprintf(file, "}\n");
+        fclose(file);
+        AIMLAB_LOG_INFO("[frames] Frame times written to %s", options.benchOutputFile.c_str());
+    }
+}
+
 void resizeWindow(int w, int h) {
     windowW = w;
     windowH = h;
@@ -198,40 +1139,647 @@ void resizeWindow(int w, int h) {
 
 void keySelect(unsigned char key, int x, int y) {
     if (key == 27 || key == 'q') {
-        close();
+        requestQuit();
     }
 
     if (key == 'f') {
         glutFullScreen();
     }
+
+    if (key == 'r' && hapticPipeline.isRunning()) {
+        uint64_t stopNs, startNs;
+        restartHapticPipeline(stopNs, startNs);
+        AIMLAB_LOG_INFO("[restart] Haptic pipeline stopped in %.2f ms, running again in %.2f ms.",
+                        stopNs * 1e-6, startNs * 1e-6);
+    }
+}
+
+/**
+ * @brief Leave the GLUT main loop; main() then calls close()
+ *
+ * Without freeglut there is no way back from glutMainLoop(), so clean up
+ * and exit from here as before.
+ */
+void requestQuit() {
+#ifdef FREEGLUT
+    glutLeaveMainLoop();
+#else
+    close();
+    exit(exitCode);
+#endif
+}
+
+//===========================================================================
+// HAPTIC PIPELINE LIFECYCLE
+//===========================================================================
+
+/**
+ * @brief Register every device's haptic (and simulation) thread and start them
+ */
+void startHapticPipeline() {
+    hapticPipeline.clearThreads();
+    for (int i = 0; i < deviceLoopCount; i++) {
+        HapticDeviceLoop& loop = deviceLoops[i];
+        hapticPipeline.addThread(updateHaptics, &loop, loop.scheduler, HAPTIC_THREAD_PRIORITY_HIGH);
+        if (loop.mirror != nullptr) {
+            hapticPipeline.addThread(updateSimulation, &loop, loop.simulationScheduler,
+                                     HAPTIC_THREAD_PRIORITY_NORMAL);
+        }
+    }
+    hapticPipeline.start();
+}
+
+/**
+ * @brief Stop every haptic and simulation thread and start them again in place
+ *
+ * Devices stay open and the scene stays loaded; statistics keep their
+ * totals without counting the pause as a tick period. Nothing is changed
+ * while the threads are stopped: this restarts the same pipeline. A
+ * caller that swaps a loop's device or scene between trials does so
+ * between hapticPipeline.stop() and start() itself.
+ *
+ * @param stopNs Receives the time until every thread had returned
+ * @param startNs Receives the time until every thread was running again
+ */
+void restartHapticPipeline(uint64_t& stopNs, uint64_t& startNs) {
+    stopNs = hapticPipeline.stop();
+    for (int i = 0; i < deviceLoopCount; i++) {
+        deviceLoops[i].stats.markRestart();
+        deviceLoops[i].simulationStats.markRestart();
+    }
+    startNs = hapticPipeline.start();
+}
+
+/**
+ * @brief --restart-cycles: stop and restart the pipeline, report the latency
+ *
+ * Each cycle lets every haptic (and simulation) thread finish a tick, then
+ * restarts the pipeline. Stop latency runs from stop() until the last
+ * thread is joined; start latency from start() until every thread has
+ * finished its first tick. Sets exitCode to 1 if a thread never ticked or
+ * the p99 stop latency is over 5 ms.
+ */
+void runRestartCycles() {
+    const uint64_t tickTimeoutNs = 1000000000ull;
+    const double stopLimitMs = 5.0;
+    std::unique_ptr<LatencyHistogram> stopTimes(new LatencyHistogram());
+    std::unique_ptr<LatencyHistogram> startTimes(new LatencyHistogram());
+    int stalled = 0;
+
+    AIMLAB_LOG_INFO("[restart] %d stop/start cycles of %d thread%s...", options.restartCycles,
+                    hapticPipeline.threadCount(), hapticPipeline.threadCount() > 1 ? "s" : "");
+
+    uint64_t ticks[AIMLAB_MAX_HAPTIC_DEVICES][2] = {};
+    uint64_t startedNs = hapticNowNs();
+    for (int cycle = 0; cycle <= options.restartCycles; cycle++) {
+        // Every thread ticks at least once since the last start
+        bool ticked = false;
+        while (!ticked) {
+            ticked = true;
+            for (int i = 0; i < deviceLoopCount; i++) {
+                const HapticDeviceLoop& loop = deviceLoops[i];
+                ticked = ticked && loop.stats.ticks() > ticks[i][0] &&
+                         (loop.mirror == nullptr || loop.simulationStats.ticks() > ticks[i][1]);
+            }
+            if (!ticked && hapticNowNs() - startedNs > tickTimeoutNs) {
+                stalled++;
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (cycle > 0) {
+            startTimes->record(hapticNowNs() - startedNs);
+        }
+        if (cycle == options.restartCycles) {
+            break;
+        }
+
+        for (int i = 0; i < deviceLoopCount; i++) {
+            ticks[i][0] = deviceLoops[i].stats.ticks();
+            ticks[i][1] = deviceLoops[i].simulationStats.ticks();
+        }
+        uint64_t stopNs, startNs;
+        const uint64_t stoppingNs = hapticNowNs();
+        restartHapticPipeline(stopNs, startNs);
+        stopTimes->record(stopNs);
+        startedNs = stoppingNs + stopNs;            // start() followed stop() at once
+    }
+
+    std::unique_ptr<LatencyHistogram::Snapshot> stop(new LatencyHistogram::Snapshot());
+    std::unique_ptr<LatencyHistogram::Snapshot> start(new LatencyHistogram::Snapshot());
+    stopTimes->snapshot(*stop);
+    startTimes->snapshot(*start);
+    AIMLAB_LOG_INFO("[restart] Stop:  p50 %.3f  p99 %.3f  max %.3f ms (request to last join)",
+                    stop->percentile(0.5) * 1e-6, stop->percentile(0.99) * 1e-6, stop->max * 1e-6);
+    AIMLAB_LOG_INFO("[restart] Start: p50 %.3f  p99 %.3f  max %.3f ms (start to every thread's "
+                    "first tick)", start->percentile(0.5) * 1e-6, start->percentile(0.99) * 1e-6,
+                    start->max * 1e-6);
+
+    if (stalled > 0 || stop->percentile(0.99) * 1e-6 > stopLimitMs) {
+        AIMLAB_LOG_ERROR("[restart] FAIL: %d cycles without a tick, stop p99 limit %g ms",
+                         stalled, stopLimitMs);
+        exitCode = 1;
+    } else {
+        AIMLAB_LOG_INFO("[restart] PASS: every thread ticked after every start, stop p99 within %g ms",
+                        stopLimitMs);
+    }
+}
+
+//===========================================================================
+// SESSION REPLAY
+//===========================================================================
+
+/**
+ * @brief Run every recorded tick through computeHapticTick() and diff forces
+ *
+ * Runs on the main thread back to back, with no scheduler and no wall
+ * clock, so a session replays as fast as the pipeline allows. A tick
+ * differs if its force, torque or gripper force is not bit-identical to
+ * the recorded one, or with --replay-tolerance, if the largest difference
+ * exceeds the tolerance. Any difference sets exitCode to 1.
+ */
+void runReplay() {
+    HapticDeviceLoop& replayLoop = deviceLoops[0];
+    const SessionFileHeader& header = replayReader.header();
+    if (header.flags & AIMLAB_REC_FLAG_BRIDGE_MOVED) {
+        AIMLAB_LOG_WARN("[replay] WARNING: Unity moved objects during this session. That motion is not\n"
+                        "[replay]          recorded; replayed objects stay where they started.");
+    }
+    const SessionMaterial& material = scene.objects[0].material;
+    AIMLAB_LOG_INFO("[replay] %llu ticks from %s (material: stiffness %g, friction %g/%g, viscosity %g)",
+                    (unsigned long long)replayReader.recordCount(), options.replayFile.c_str(),
+                    material.stiffness, material.staticFriction, material.dynamicFriction,
+                    material.viscosity);
+
+    FILE* diffFile = nullptr;
+    if (!options.replayDiffFile.empty()) {
+        diffFile = fopen(options.replayDiffFile.c_str(), "w");
+        if (diffFile == nullptr) {
+            AIMLAB_LOG_WARN("[replay] WARNING: Could not create %s", options.replayDiffFile.c_str());
+        } else {
+            fprintf(diffFile, "tick,t_s,rec_fx,rec_fy,rec_fz,fx,fy,fz,diff\n");
+        }
+    }
+
+    HapticRecord recorded;
+    recorded.timestampNs = header.startNs;
+    uint32_t dropped = 0;
+    uint64_t ticks = 0, differing = 0, gaps = 0;
+    uint64_t firstDiffTick = 0, worstTick = 0;
+    double maxDiff = 0.0;
+    const uint64_t startNs = hapticNowNs();
+
+    while (replayReader.next(recorded, &dropped)) {
+        if (dropped > 0) {
+            gaps++;
+        }
+
+        replayDevice->setSample(recorded.device);
+        replayTickNs = recorded.timestampNs;
+        replayLoop.stats.beginTick(hapticNowNs());
+        computeHapticTick(replayLoop, replayLoop.stats);
+        replayLoop.stats.endTick(hapticNowNs());
+
+        double force[3], torque[3], gripperForce;
+        replayDevice->getCommand(force, torque, gripperForce);
+
+        const bool identical = memcmp(force, recorded.force, sizeof(force)) == 0 &&
+                               memcmp(torque, recorded.torque, sizeof(torque)) == 0 &&
+                               memcmp(&gripperForce, &recorded.gripperForce, sizeof(double)) == 0;
+        double diff = 0.0;
+        for (int k = 0; k < 3; k++) {
+            diff = std::max(diff, fabs(force[k] - recorded.force[k]));
+            diff = std::max(diff, fabs(torque[k] - recorded.torque[k]));
+        }
+        diff = std::max(diff, fabs(gripperForce - recorded.gripperForce));
+
+        const bool differs = (options.replayTolerance > 0.0) ? diff > options.replayTolerance
+                                                             : !identical;
+        if (differs) {
+            if (differing == 0) {
+                firstDiffTick = ticks;
+            }
+            differing++;
+        }
+        if (diff > maxDiff) {
+            maxDiff = diff;
+            worstTick = ticks;
+        }
+
+        if (diffFile != nullptr) {
+            fprintf(diffFile, "%llu,%.9f,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g\n",
+                    (unsigned long long)ticks,
+                    (double)(recorded.timestampNs - header.startNs) * 1e-9,
+                    recorded.force[0], recorded.force[1], recorded.force[2],
+                    force[0], force[1], force[2], diff);
+        }
+        ticks++;
+    }
+
+    const double elapsed = (double)(hapticNowNs() - startNs) * 1e-9;
+    const double recordedSeconds = (double)(recorded.timestampNs - header.startNs) * 1e-9;
+    if (diffFile != nullptr) {
+        fclose(diffFile);
+    }
+
+    AIMLAB_LOG_INFO("[replay] %llu ticks in %.3f s: %.0f ticks/s (%.0fx real time)",
+                    (unsigned long long)ticks, elapsed, (elapsed > 0.0) ? ticks / elapsed : 0.0,
+                    (ticks > 0 && elapsed > 0.0) ? recordedSeconds / elapsed : 0.0);
+    if (differing == 0) {
+        if (options.replayTolerance > 0.0) {
+            AIMLAB_LOG_INFO("[replay] Forces match the recording within %g N (max diff %.3g N)",
+                            options.replayTolerance, maxDiff);
+        } else {
+            AIMLAB_LOG_INFO("[replay] Forces are bit-identical to the recording");
+        }
+    } else {
+        AIMLAB_LOG_ERROR("[replay] FAIL: %llu of %llu ticks differ; first at tick %llu, "
+                         "max diff %.6g N at tick %llu",
+                         (unsigned long long)differing, (unsigned long long)ticks,
+                         (unsigned long long)firstDiffTick, maxDiff, (unsigned long long)worstTick);
+        exitCode = 1;
+    }
+    if (gaps > 0) {
+        AIMLAB_LOG_WARN("[replay] WARNING: Recording has %llu gaps from dropped ticks; forces after a "
+                        "gap may differ", (unsigned long long)gaps);
+    }
 }
 
 //===========================================================================
 // CLEANUP FUNCTION
 //===========================================================================
 
+/**
+ * @brief Stop the haptic pipeline, report and free everything
+ *
+ * Called once by main() on every way out, after the main loop returns;
+ * main() then returns exitCode.
+ */
 void close() {
-    // Stop haptic thread
-    simulationRunning = false;
+    // Stop and join every haptic and simulation thread (no-op if never started)
+    const uint64_t stopNs = hapticPipeline.stop();
+    if (stopNs > 0) {
+        AIMLAB_LOG_INFO("[exit] Haptic pipeline stopped in %.2f ms.", stopNs * 1e-6);
+    }
 
-    // Wait for haptic thread to finish (only if it was started)
-    if (hapticDeviceConnected) {
-        while (!simulationFinished) {
-            cSleepMs(100);
+    // Flush the session file (the haptic thread has stopped producing)
+    if (sessionRecorder.isOpen()) {
+        const SessionRecorderStats& recorded = sessionRecorder.close();
+        AIMLAB_LOG_INFO("[exit] Recorded %llu ticks (%llu dropped), %.1f MB at %.2f MB/s%s to %s",
+                        (unsigned long long)recorded.records, (unsigned long long)recorded.dropped,
+                        (double)recorded.bytes / (1024.0 * 1024.0),
+                        (double)recorded.bytes / (1024.0 * 1024.0) / recorded.seconds,
+                        recorded.directIO ? " (O_DIRECT)" : "", options.recordFile.c_str());
+        if (recorded.writeError) {
+            AIMLAB_LOG_WARN("[exit] WARNING: Write error; %s is incomplete.", options.recordFile.c_str());
         }
     }
 
-    // Close haptic device connection
-    if (hapticDevice != nullptr) {
-        hapticDevice->close();
+    // Send the last queued stream samples
+    if (hapticStream.isOpen()) {
+        const HapticStreamPublisherStats& streamed = hapticStream.close();
+        AIMLAB_LOG_INFO("[exit] Streamed %llu samples in %llu datagrams (%.0f samples/s), "
+                        "%llu dropped, %llu send errors.",
+                        (unsigned long long)streamed.samples, (unsigned long long)streamed.datagrams,
+                        (double)streamed.samples / streamed.seconds,
+                        (unsigned long long)streamed.dropped, (unsigned long long)streamed.sendErrors);
+    }
+
+    // Close haptic device connections
+    for (int i = 0; i < deviceLoopCount; i++) {
+        deviceLoops[i].device->close();
     }
 
-    // Delete allocated objects
-    delete hapticThread;
+    // Release Unity bridge segment
+    unityBridge.destroy();
+
+    // Headless frame-time report (no-op if no offscreen frames were drawn)
+    reportFrameTimes();
+    frameBuffer.reset();
+    headlessContext.destroy();
+
+    // Per-device totals; rate from the mean tick period, jitter = p99 - p50 period
+    std::unique_ptr<HapticLoopStats::Report> report(new HapticLoopStats::Report());
+    double totalRate = 0.0, minRate = 0.0, worstJitter = 0.0;
+    for (int i = 0; i < deviceLoopCount; i++) {
+        HapticDeviceLoop& loop = deviceLoops[i];
+        loop.stats.snapshot(*report);
+        double rate, jitter;
+        rateAndJitter(*report, rate, jitter);
+        totalRate += rate;
+        minRate = (i == 0 || rate < minRate) ? rate : minRate;
+        worstJitter = std::max(worstJitter, jitter);
+
+        char device[64];
+        if (deviceLoopCount > 1) {
+            snprintf(device, sizeof(device), "Device %d (%s):", i, loop.model.c_str());
+        } else {
+            snprintf(device, sizeof(device), "Haptic loop completed");
+        }
+        AIMLAB_LOG_INFO("[exit] %s %llu ticks, %llu missed deadlines, %.0f Hz, period jitter %.2f us.",
+                        device, (unsigned long long)loop.stats.ticks(),
+                        (unsigned long long)loop.stats.missedDeadlines(), rate, jitter);
+        if (!loop.scheduler->isFreeRunning()) {
+            AIMLAB_LOG_INFO("[exit] Scheduler: %llu overruns, %llu skipped ticks.",
+                            (unsigned long long)loop.scheduler->overruns(),
+                            (unsigned long long)loop.scheduler->skippedTicks());
+        }
+        if (loop.filter != nullptr) {
+            const DeviceFilter& filter = loop.filter->getFilter();
+            const LatencyHistogram::Snapshot& age = report->stages[STAGE_SINCE_CHANGE];
+            AIMLAB_LOG_INFO("[exit] Device filter: %llu samples in %llu ticks, since change p50 %.2f ms, "
+                            "p99 %.2f ms; passivity damping on %llu ticks, %.3g J dissipated.",
+                            (unsigned long long)filter.samples(), (unsigned long long)report->ticks,
+                            age.percentile(0.5) * 1e-6, age.percentile(0.99) * 1e-6,
+                            (unsigned long long)filter.dampedTicks(), filter.dissipatedEnergy());
+        }
+        if (loop.mirror != nullptr) {
+            const double ageUs = report->stages[STAGE_MODEL_AGE].percentile(0.99) * 1e-3;
+            std::unique_ptr<HapticLoopStats::Report> simulation(new HapticLoopStats::Report());
+            loop.simulationStats.snapshot(*simulation);
+            double simulationRate, simulationJitter;
+            rateAndJitter(*simulation, simulationRate, simulationJitter);
+            AIMLAB_LOG_INFO("[exit] Simulation thread: %llu steps, %.0f Hz, step p99 %.2f us, "
+                            "contact model age p99 %.2f us.",
+                            (unsigned long long)loop.simulationStats.ticks(), simulationRate,
+                            simulation->stages[STAGE_TICK].percentile(0.99) * 1e-3, ageUs);
+        }
+
+        if (!options.statsOutputFile.empty()) {
+            const string file = deviceStatsFile(options.statsOutputFile, i);
+            if (loop.stats.exportToFile(file)) {
+                AIMLAB_LOG_INFO("[exit] Statistics written to %s", file.c_str());
+            } else {
+                AIMLAB_LOG_WARN("[exit] WARNING: Could not write %s", file.c_str());
+            }
+        }
+    }
+    if (deviceLoopCount > 1) {
+        AIMLAB_LOG_INFO("[exit] %d devices: %.0f Hz total, slowest %.0f Hz, worst period jitter %.2f us.",
+                        deviceLoopCount, totalRate, minRate, worstJitter);
+    }
+
+    // Delete allocated objects (device 0's world exists even without a device)
+    for (int i = 0; i < AIMLAB_MAX_HAPTIC_DEVICES; i++) {
+        delete deviceLoops[i].simulationScheduler;
+        delete deviceLoops[i].scheduler;
+        delete deviceLoops[i].transformUpdater;
+        delete deviceLoops[i].broadPhase;       // Reattaches objects before the world goes
+        delete deviceLoops[i].primitives;
+        delete deviceLoops[i].world;
+    }
     delete world;
     delete handler;
 
-    exit(0);
+    // Write what is still queued before the process exits
+    asyncLogStop();
+}
+
+//===========================================================================
+// DEVICE SETUP
+//===========================================================================
+
+/**
+ * @brief Open and calibrate one detected device, explaining any failure
+ *
+ * @return true if the device is ready for a haptic thread
+ */
+static bool openHapticDevice(const cGenericHapticDevicePtr& device) {
+    cHapticDeviceInfo info = device->getSpecifications();
+    AIMLAB_LOG_INFO("[init] Device found: %s", info.m_modelName.c_str());
+    AIMLAB_LOG_INFO("[init] Manufacturer: %s", info.m_manufacturerName.c_str());
+
+    // Check if detected device is Inverse3
+    if (info.m_modelName.find("Inverse3") != std::string::npos) {
+        AIMLAB_LOG_WARN("\n"
+                        "  =============================================\n"
+                        "  IMPORTANT: Inverse3 Detected!\n"
+                        "  =============================================\n"
+                        "  This build uses the GitHub CHAI3D fork which\n"
+                        "  does NOT support Inverse3 protocol.\n"
+                        "\n"
+                        "  Symptoms you may experience:\n"
+                        "    - Position always reads (0, 0, 0)\n"
+                        "    - Device appears connected but doesn't track\n"
+                        "    - Force feedback may not work\n"
+                        "\n"
+                        "  Solution - Use Official Demos:\n"
+                        "    .\\run-official-demos.ps1\n"
+                        "\n"
+                        "  For details:\n"
+                        "    docs/INVERSE3_PROTOCOL_NOTES.md\n"
+                        "    docs/USING_OFFICIAL_CHAI3D.md\n"
+                        "  =============================================\n"
+                        "\n"
+                        "  Attempting to continue anyway...\n");
+    }
+
+    // Check for "no device" placeholder that CHAI3D returns on failure
+    if (info.m_modelName == "no device") {
+        AIMLAB_LOG_WARN("\n"
+                        "  =============================================\n"
+                        "  WARNING: Serial port error (ACCESS_DENIED).\n"
+                        "  =============================================\n"
+                        "  CHAI3D detected a serial port but could not\n"
+                        "  open it. This usually means another process\n"
+                        "  (e.g., Haply Hub) is holding the port.\n"
+                        "\n"
+                        "  Fix:\n"
+                        "    - Close Haply Hub\n"
+                        "    - Run: .\\run.ps1 (auto-kills background services)\n"
+                        "  =============================================\n"
+                        "\n"
+                        "  Continuing in VISUAL-ONLY mode...\n");
+
+        return false;
+
+    } else if (!device->open()) {
+        AIMLAB_LOG_WARN("\n"
+                        "  WARNING: Could not open device connection.\n"
+                        "  Continuing in VISUAL-ONLY mode...\n");
+
+        return false;
+
+    } else {
+        // Device opened successfully
+        AIMLAB_LOG_INFO("[init] Device connection opened successfully.");
+
+        device->calibrate();
+        AIMLAB_LOG_INFO("[init] Device calibrated.");
+
+        // If Pantograph detected, confirm it's working
+        if (info.m_modelName.find("Pantograph") != std::string::npos) {
+            AIMLAB_LOG_INFO("[init] Pantograph protocol active.");
+            AIMLAB_LOG_INFO("[init] Device should work correctly!");
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Give a device its tool, cursors, scheduler and statistics
+ *
+ * loop.world and loop.objects must already hold the device's haptic
+ * world. Device 0's tool reads through the session recorder's tap.
+ */
+static void setupDeviceLoop(HapticDeviceLoop& loop) {
+    loop.tool = new (loop.nodes) PooledNode<cToolCursor>(loop.world);
+    loop.world->addChild(loop.tool);
+
+    // Session recording: hand the tool a tap that keeps what it reads
+    // and commands; the recorder's writer thread starts here
+    cGenericHapticDevicePtr toolDevice = loop.device;
+    if (loop.index == 0 && !options.recordFile.empty()) {
+        const cHapticDeviceInfo info = loop.device->getSpecifications();
+        SessionFileHeader header;
+        memset(&header, 0, sizeof(header));
+        header.nominalRateHz = (replayDevice != nullptr) ? 0.0 : options.scheduler.rateHz;
+        strncpy(header.deviceModel, info.m_modelName.c_str(), sizeof(header.deviceModel) - 1);
+        captureDeviceSpec(info, header.device);
+        header.material = scene.objects[0].material;
+        strncpy(header.sceneFile, options.sceneFile.c_str(), sizeof(header.sceneFile) - 1);
+        if (options.primitiveBatch) {
+            header.flags |= AIMLAB_REC_FLAG_PRIMITIVE_BATCH;
+        }
+        if (options.deviceFilter.enabled) {
+            const DeviceFilterConfig& filter = options.deviceFilter;
+            header.flags |= AIMLAB_REC_FLAG_DEVICE_FILTER;
+            header.filter.window = filter.window;
+            header.filter.passivity = filter.passivity ? 1u : 0u;
+            header.filter.horizonS = filter.horizonS;
+            header.filter.cutoffHz = filter.cutoffHz;
+            header.filter.maxDamping = filter.maxDamping;
+        }
+
+        string error;
+        if (sessionRecorder.open(options.recordFile, header, error)) {
+            recordTap = std::make_shared<TappedHapticDevice>(loop.device);
+            toolDevice = recordTap;
+            AIMLAB_LOG_INFO("[init] Recording haptic session to %s", options.recordFile.c_str());
+        } else {
+            AIMLAB_LOG_WARN("[init] WARNING: Not recording: %s", error.c_str());
+        }
+    }
+
+    // Device filter in front of the tap, so a recording keeps raw samples
+    if (options.deviceFilter.enabled) {
+        loop.filter = std::make_shared<FilteredHapticDevice>(toolDevice, options.deviceFilter);
+        toolDevice = loop.filter;
+        if (loop.index == 0) {
+            const DeviceFilter& filter = loop.filter->getFilter();
+            AIMLAB_LOG_INFO("[init] Device filter: %d-sample velocity fit, %g ms horizon, "
+                            "%g Hz force cutoff, passivity controller %s (max %g N.s/m)",
+                            filter.config().window, filter.config().horizonS * 1e3,
+                            filter.config().cutoffHz, filter.config().passivity ? "on" : "off",
+                            filter.maxDamping());
+        }
+    }
+
+    // Multirate: the tool runs in the simulation thread and reads a mirror
+    // of the device; only the haptic thread touches the hardware (through
+    // the filter, if any)
+    double contactRadius = toolRadius;
+    if (options.multirateHz > 0.0) {
+        const cHapticDeviceInfo info = loop.device->getSpecifications();
+        SessionFileHeader header;
+        memset(&header, 0, sizeof(header));
+        strncpy(header.deviceModel, info.m_modelName.c_str(), sizeof(header.deviceModel) - 1);
+        captureDeviceSpec(info, header.device);
+        loop.mirror = std::make_shared<ReplayHapticDevice>(header);
+        toolDevice = loop.mirror;
+        contactRadius += AIMLAB_LOCAL_MODEL_MARGIN;
+    }
+    loop.tool->setHapticDevice(toolDevice);
+    loop.tool->setRadius(toolRadius);
+    if (loop.mirror != nullptr) {
+        loop.tool->m_hapticPoint->setRadiusContact(contactRadius);
+    }
+    loop.tool->setWorkspaceRadius(1.0);       // Wider workspace mapping for Pantograph
+    loop.tool->enableDynamicObjects(true);
+    loop.tool->start();
+    loop.workspaceScale = loop.tool->getWorkspaceScaleFactor();
+
+    // The tool is not in the render world; draw its proxy and device
+    // positions from snapshots with the same bright colors
+    loop.cursorProxy = new (renderNodes) PooledNode<cShapeSphere>(toolRadius);
+    loop.cursorProxy->m_material->setWhite();
+    loop.cursorProxy->setHapticEnabled(false);
+    world->addChild(loop.cursorProxy);
+
+    loop.cursorDevice = new (renderNodes) PooledNode<cShapeSphere>(toolRadius);
+    loop.cursorDevice->m_material->setYellowGold();
+    loop.cursorDevice->setHapticEnabled(false);
+    world->addChild(loop.cursorDevice);
+
+    // Only the tool moves every tick; everything else is marked dirty
+    // where its local transform is set (see applyBridgeTransforms)
+    if (options.incrementalTransforms) {
+        loop.transformUpdater = new IncrementalTransformUpdater(loop.world);
+        loop.transformUpdater->markAlwaysDirty(loop.tool);
+    }
+
+    // Batched primitives: CHAI3D keeps the meshes
+    if (options.primitiveBatch) {
+        loop.primitives = new PrimitiveBatch();
+        loop.primitives->setUseSimd(options.primitiveSimd);
+        const size_t batched = buildPrimitiveBatch(scene, loop.objects, *loop.primitives,
+                                                   loop.primitiveOf);
+        if (loop.index == 0) {
+            AIMLAB_LOG_INFO("[init] Primitive batch: %zu of %zu objects (haptic spheres and boxes), "
+                            "%s kernel", batched, scene.objects.size(),
+                            loop.primitives->usesSimd() ? "AVX2" : "scalar");
+        }
+    }
+
+    // Broad phase over the haptic-enabled objects CHAI3D renders; the query
+    // box is the contact radius plus the same again as margin
+    if (options.broadPhase) {
+        vector<bool> haptic;
+        for (size_t i = 0; i < scene.objects.size(); i++) {
+            const bool batched = loop.primitives != nullptr &&
+                                 loop.primitiveOf[i].kind != PRIMITIVE_NONE;
+            haptic.push_back(scene.objects[i].haptic && !batched);
+        }
+        loop.broadPhase = new HapticBroadPhase(loop.world, loop.objects, objectBounds, haptic,
+                                               2.0 * contactRadius, options.broadPhaseCellSize);
+        if (loop.index == 0) {
+            AIMLAB_LOG_INFO("[init] Broad phase: %zu haptic objects, grid cell %g m",
+                            loop.broadPhase->grid().boxCount(), loop.broadPhase->cellSize());
+        }
+
+        // Room for the largest candidate list, so no tick allocates
+        loop.scratch.reserve(loop.broadPhase->scratchBytes());
+    }
+
+    // Device i runs on core --cpu + i
+    HapticSchedulerConfig config = options.scheduler;
+    if (config.cpu >= 0) {
+        config.cpu += loop.index;
+    }
+    loop.scheduler = new HapticScheduler(config);
+
+    // Missed deadline: explicit --deadline-us, else 1.5 periods at a fixed
+    // rate, else the original 1 ms (1 kHz) budget
+    double deadlineUs = options.deadlineMicroseconds;
+    if (deadlineUs <= 0.0) {
+        deadlineUs = loop.scheduler->isFreeRunning()
+                   ? 1000.0 : 1.5e-3 * (double)loop.scheduler->periodNs();
+    }
+    loop.stats.setDeadlineNs((uint64_t)(deadlineUs * 1000.0));
+
+    // Simulation thread: fixed rate, no spin, no real-time priority or pinning
+    if (loop.mirror != nullptr) {
+        HapticSchedulerConfig simulationConfig;
+        simulationConfig.rateHz = options.multirateHz;
+        simulationConfig.spinNs = 0;
+        loop.simulationScheduler = new HapticScheduler(simulationConfig);
+        loop.simulationStats.setDeadlineNs((uint64_t)(1.5e9 / options.multirateHz));
+        if (loop.index == 0) {
+            AIMLAB_LOG_INFO("[init] Multirate: simulation thread at %g Hz, contact planes within "
+                            "%g mm rendered by the haptic thread",
+                            options.multirateHz, AIMLAB_LOCAL_MODEL_MARGIN * 1e3);
+        }
+    }
 }
 
 //===========================================================================
@@ -239,85 +1787,180 @@ void close() {
 //===========================================================================
 
 int main(int argc, char* argv[]) {
+    if (!parseAppOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // Console messages from here on are written by the log thread
+    asyncLogStart();
+
     //-----------------------------------------------------------------------
     // BANNER
     //-----------------------------------------------------------------------
-    cout << endl;
-    cout << "========================================" << endl;
-    cout << "  AIMLAB Haptics Starter Application"    << endl;
-    cout << "  Author: Pi Ko (pi.ko@nyu.edu)"        << endl;
-    cout << "  Date:   04 February 2026"              << endl;
-    cout << "  Version: v2.1"                         << endl;
-    cout << "========================================" << endl;
-    cout << "  Device Support:"                        << endl;
-    cout << "    [OK] Pantograph (2-DOF)"             << endl;
-    cout << "    [X]  Inverse3 (use official demos)"  << endl;
-    cout << "========================================" << endl;
-    cout << endl;
+    AIMLAB_LOG_INFO("\n"
+                    "========================================\n"
+                    "  AIMLAB Haptics Starter Application\n"
+                    "  Author: Pi Ko (pi.ko@nyu.edu)\n"
+                    "  Date:   16 October 2026\n"
+                    "  Version: v3.12\n"
+                    "========================================\n"
+                    "  Device Support:\n"
+                    "    [OK] Pantograph (2-DOF)\n"
+                    "    [X]  Inverse3 (use official demos)\n"
+                    "========================================\n");
 
     //-----------------------------------------------------------------------
     // GLUT INITIALIZATION
     //-----------------------------------------------------------------------
-    glutInit(&argc, argv);
-    glutInitWindowSize(windowW, windowH);
-    glutInitDisplayMode(GLUT_RGB | GLUT_DEPTH | GLUT_DOUBLE);
-    glutCreateWindow("AIMLAB - Haptic Environment");
-    glutDisplayFunc(updateGraphics);
-    glutReshapeFunc(resizeWindow);
-    glutKeyboardFunc(keySelect);
+    if (options.headless) {
+        string error;
+        if (!headlessContext.create(error)) {
+            AIMLAB_LOG_ERROR("[init] ERROR: Headless rendering unavailable: %s", error.c_str());
+            return 1;
+        }
+        windowW = options.framebufferWidth;
+        windowH = options.framebufferHeight;
+        AIMLAB_LOG_INFO("[init] Headless OpenGL context: %s", headlessContext.getRenderer().c_str());
+    } else if (options.graphicsEnabled) {
+        glutInit(&argc, argv);
+        glutInitWindowSize(windowW, windowH);
+        glutInitDisplayMode(GLUT_RGB | GLUT_DEPTH | GLUT_DOUBLE);
+        glutCreateWindow("AIMLAB - Haptic Environment");
+        glutDisplayFunc(updateGraphics);
+        glutReshapeFunc(resizeWindow);
+        glutKeyboardFunc(keySelect);
+#ifdef FREEGLUT
+        // Closing the window returns from glutMainLoop() like 'q' does
+        glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
+#endif
+    } else {
+        AIMLAB_LOG_INFO("[init] Graphics disabled (--no-graphics).");
+    }
+
+    //-----------------------------------------------------------------------
+    // SESSION REPLAY (recording supplies the device, scene and material)
+    //-----------------------------------------------------------------------
+    if (!options.replayFile.empty()) {
+        string error;
+        if (!replayReader.open(options.replayFile, error)) {
+            AIMLAB_LOG_ERROR("[init] ERROR: %s", error.c_str());
+            return 1;
+        }
+        const SessionFileHeader& header = replayReader.header();
+        if (header.version < 2) {
+            AIMLAB_LOG_ERROR("[init] ERROR: %s predates replay support (format version %u); "
+                             "record it again.", options.replayFile.c_str(), header.version);
+            return 1;
+        }
+        if (options.sceneFile.empty() && header.version >= 3) {
+            options.sceneFile = header.sceneFile;
+        }
+        if (header.flags & AIMLAB_REC_FLAG_PRIMITIVE_BATCH) {
+            options.primitiveBatch = true;
+        }
+        if (header.version >= 4 && (header.flags & AIMLAB_REC_FLAG_DEVICE_FILTER)) {
+            DeviceFilterConfig& filter = options.deviceFilter;
+            filter.enabled = true;
+            filter.window = header.filter.window;
+            filter.passivity = header.filter.passivity != 0;
+            filter.horizonS = header.filter.horizonS;
+            filter.cutoffHz = header.filter.cutoffHz;
+            filter.maxDamping = header.filter.maxDamping;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+    // SCENE DESCRIPTION
+    //-----------------------------------------------------------------------
+    scene = defaultSceneDescription();
+    if (!options.sceneFile.empty()) {
+        string error;
+        if (!loadSceneDescription(options.sceneFile, scene, error)) {
+            AIMLAB_LOG_ERROR("[init] ERROR: %s", error.c_str());
+            return 1;
+        }
+        AIMLAB_LOG_INFO("[init] Scene %s: %zu objects", options.sceneFile.c_str(), scene.objects.size());
+    }
+
+    // First object's material: recorded one on replay, then command-line overrides
+    SessionMaterial& material = scene.objects[0].material;
+    if (!options.replayFile.empty()) {
+        material = replayReader.header().material;
+    }
+    if (options.stiffness >= 0.0)       material.stiffness = options.stiffness;
+    if (options.staticFriction >= 0.0)  material.staticFriction = options.staticFriction;
+    if (options.dynamicFriction >= 0.0) material.dynamicFriction = options.dynamicFriction;
+    if (options.viscosity >= 0.0)       material.viscosity = options.viscosity;
 
     //-----------------------------------------------------------------------
     // WORLD
     //-----------------------------------------------------------------------
-    cout << "[init] Creating 3D world..." << endl;
-    world = new cWorld();
+    AIMLAB_LOG_INFO("[init] Creating 3D world...");
+    renderNodes.setEnabled(options.scenePool);
+    for (int i = 0; i < AIMLAB_MAX_HAPTIC_DEVICES; i++) {
+        deviceLoops[i].nodes.setEnabled(options.scenePool);
+    }
+    world = new (renderNodes) PooledNode<cWorld>();
     world->m_backgroundColor.setBlack();
 
     //-----------------------------------------------------------------------
     // CAMERA
     //-----------------------------------------------------------------------
-    cout << "[init] Setting up camera..." << endl;
-    camera = new cCamera(world);
+    AIMLAB_LOG_INFO("[init] Setting up camera...");
+    camera = new (renderNodes) PooledNode<cCamera>(world);
     world->addChild(camera);
-    camera->set(cVector3d(0.5, 0.0, 0.3),   // eye
-                cVector3d(0.0, 0.0, 0.0),    // lookat
-                cVector3d(0.0, 0.0, 1.0));   // up
-    camera->setClippingPlanes(0.01, 10.0);
-    camera->setFieldViewAngleDeg(45);
+
+    // Headless: render into an offscreen framebuffer instead of the window
+    if (options.headless) {
+        frameBuffer = cFrameBuffer::create();
+        if (!frameBuffer->setup(camera, windowW, windowH, true, true)) {
+            AIMLAB_LOG_ERROR("[init] ERROR: Could not create %dx%d offscreen framebuffer.",
+                             windowW, windowH);
+            return 1;
+        }
+    }
 
     //-----------------------------------------------------------------------
     // LIGHTING
     //-----------------------------------------------------------------------
-    cout << "[init] Configuring lighting..." << endl;
-    light = new cDirectionalLight(world);
+    AIMLAB_LOG_INFO("[init] Configuring lighting...");
+    light = new (renderNodes) PooledNode<cDirectionalLight>(world);
     world->addChild(light);
     light->setEnabled(true);
-    light->setDir(-1.0, -1.0, -1.0);
     light->m_ambient.set(0.3f, 0.3f, 0.3f);
     light->m_diffuse.set(0.7f, 0.7f, 0.7f);
     light->m_specular.set(1.0f, 1.0f, 1.0f);
 
+    // Camera placement and light direction (built-in defaults or --scene)
+    applySceneView(scene, camera, light);
+
     //-----------------------------------------------------------------------
     // SCENE OBJECTS
     //-----------------------------------------------------------------------
-    cout << "[init] Creating scene objects..." << endl;
-    sphere = new cShapeSphere(0.03);     // 30 mm radius
-    world->addChild(sphere);
-    sphere->setLocalPos(0.0, 0.0, 0.0);
-
-    // Haptic material
-    sphere->m_material->setStiffness(1000.0);
-    sphere->m_material->setStaticFriction(0.3);
-    sphere->m_material->setDynamicFriction(0.2);
-    sphere->m_material->setViscosity(0.1);
-
-    // Visual appearance
-    sphere->m_material->setRedCrimson();
-    sphere->m_material->m_specular.set(0.8f, 0.8f, 0.8f);
-    sphere->m_material->setShininess(100);
-
-    sphere->setHapticEnabled(true);
-    sphere->setShowEnabled(true);
+    // Each object also gets a haptic twin in the haptic world. Unity moves
+    // the twins through the bridge (object_id = scene index); the render
+    // thread follows them through snapshots.
+    AIMLAB_LOG_INFO("[init] Creating scene objects...");
+    deviceLoops[0].world = new (deviceLoops[0].nodes) PooledNode<cWorld>();
+    {
+        string error;
+        if (!buildScene(scene, options.meshCache, world, deviceLoops[0].world, renderNodes,
+                        deviceLoops[0].nodes, renderObjects, deviceLoops[0].objects, objectBounds,
+                        error)) {
+            AIMLAB_LOG_ERROR("[init] ERROR: %s", error.c_str());
+            return 1;
+        }
+    }
+    if (options.scenePool) {
+        AIMLAB_LOG_INFO("[init] Scene node pools: %zu render nodes (%zu KB), %zu haptic nodes (%zu KB)",
+                        renderNodes.liveNodes(), renderNodes.arena().bytesUsed() / 1024,
+                        deviceLoops[0].nodes.liveNodes(),
+                        deviceLoops[0].nodes.arena().bytesUsed() / 1024);
+    }
+    if (renderObjects.size() > SCENE_SNAPSHOT_MAX_OBJECTS) {
+        AIMLAB_LOG_WARN("[init] WARNING: Only the first %u objects can be moved by Unity.",
+                        SCENE_SNAPSHOT_MAX_OBJECTS);
+    }
 
     //-----------------------------------------------------------------------
     // HAPTIC DEVICE (with graceful fallback)
@@ -348,172 +1991,188 @@ int main(int argc, char* argv[]) {
     // gracefully fall back to visual-only mode if device fails.
     //-----------------------------------------------------------------------
 
-    cout << "[init] Detecting haptic devices..." << endl;
+    // Every device that opens gets its own haptic thread; devices after the
+    // first get their own replica of the haptic world
     handler = new cHapticDeviceHandler();
-    handler->getDevice(hapticDevice, 0);
+    vector<cGenericHapticDevicePtr> candidates;
+    if (!options.replayFile.empty()) {
+        AIMLAB_LOG_INFO("[init] Replaying recorded session %s...", options.replayFile.c_str());
+        replayDevice = std::make_shared<ReplayHapticDevice>(replayReader.header());
+        candidates.push_back(replayDevice);
+    } else if (options.useSimulatedDevice) {
+        const int count = (options.deviceCount > 0) ? options.deviceCount : 1;
+        AIMLAB_LOG_INFO("[init] Using %d simulated haptic device%s...", count, count > 1 ? "s" : "");
+        for (int i = 0; i < count; i++) {
+            candidates.push_back(std::make_shared<SimulatedHapticDevice>(options.simulated));
+        }
+    } else {
+        AIMLAB_LOG_INFO("[init] Detecting haptic devices...");
+        const int detected = (int)handler->getNumDevices();
+        int count = (options.deviceCount > 0) ? options.deviceCount : detected;
+        if (count > detected && detected > 0) {
+            AIMLAB_LOG_WARN("[init] WARNING: --devices %d but only %d detected.", count, detected);
+            count = detected;
+        }
+        if (count > AIMLAB_MAX_HAPTIC_DEVICES) {
+            AIMLAB_LOG_WARN("[init] WARNING: %d devices detected; using the first %d.", detected,
+                            AIMLAB_MAX_HAPTIC_DEVICES);
+            count = AIMLAB_MAX_HAPTIC_DEVICES;
+        }
+        // Always ask for device 0, as before: CHAI3D may hand back a
+        // "no device" placeholder that openHapticDevice() explains
+        for (int i = 0; i < std::max(count, 1); i++) {
+            cGenericHapticDevicePtr device;
+            handler->getDevice(device, (unsigned int)i);
+            if (device != nullptr) {
+                candidates.push_back(device);
+            }
+        }
+    }
 
-    if (hapticDevice == nullptr) {
+    if (candidates.empty()) {
         // ------------------------------------------------------------------
         // NO DEVICE AT ALL
         // ------------------------------------------------------------------
-        cout << endl;
-        cout << "  =============================================" << endl;
-        cout << "  WARNING: No haptic device detected." << endl;
-        cout << "  =============================================" << endl;
-        cout << "  The application will run in VISUAL-ONLY mode." << endl;
-        cout << "  You can view the 3D scene but haptic feedback" << endl;
-        cout << "  is disabled." << endl;
-        cout << endl;
-        cout << "  Device Support:" << endl;
-        cout << "    [OK] Haply Pantograph (2-DOF) - fully supported" << endl;
-        cout << "    [X]  Haply Inverse3 (3-DOF) - use official demos" << endl;
-        cout << endl;
-        cout << "  For Pantograph:" << endl;
-        cout << "    1. Connect device via USB" << endl;
-        cout << "    2. Close Haply Hub (port conflict)" << endl;
-        cout << "    3. Run: .\\run.ps1" << endl;
-        cout << endl;
-        cout << "  For Inverse3:" << endl;
-        cout << "    1. Download: https://develop.haply.co/releases/chai3d" << endl;
-        cout << "    2. Run: .\\run-official-demos.ps1" << endl;
-        cout << "    3. See: docs/USING_OFFICIAL_CHAI3D.md" << endl;
-        cout << "  =============================================" << endl;
-        cout << endl;
-
-        hapticDeviceConnected = false;
+        AIMLAB_LOG_WARN("\n"
+                        "  =============================================\n"
+                        "  WARNING: No haptic device detected.\n"
+                        "  =============================================\n"
+                        "  The application will run in VISUAL-ONLY mode.\n"
+                        "  You can view the 3D scene but haptic feedback\n"
+                        "  is disabled.\n"
+                        "\n"
+                        "  Device Support:\n"
+                        "    [OK] Haply Pantograph (2-DOF) - fully supported\n"
+                        "    [X]  Haply Inverse3 (3-DOF) - use official demos\n"
+                        "\n"
+                        "  For Pantograph:\n"
+                        "    1. Connect device via USB\n"
+                        "    2. Close Haply Hub (port conflict)\n"
+                        "    3. Run: .\\run.ps1\n"
+                        "\n"
+                        "  For Inverse3:\n"
+                        "    1. Download: https://develop.haply.co/releases/chai3d\n"
+                        "    2. Run: .\\run-official-demos.ps1\n"
+                        "    3. See: docs/USING_OFFICIAL_CHAI3D.md\n"
+                        "\n"
+                        "  Without hardware:\n"
+                        "    Run with --device sim for a simulated device\n"
+                        "  =============================================\n");
 
     } else {
-        // ------------------------------------------------------------------
-        // DEVICE FOUND — attempt to open it
-        // ------------------------------------------------------------------
-        cHapticDeviceInfo info = hapticDevice->getSpecifications();
-        cout << "[init] Device found: " << info.m_modelName << endl;
-        cout << "[init] Manufacturer: " << info.m_manufacturerName << endl;
-
-        // Check if detected device is Inverse3
-        if (info.m_modelName.find("Inverse3") != std::string::npos) {
-            cout << endl;
-            cout << "  =============================================" << endl;
-            cout << "  IMPORTANT: Inverse3 Detected!" << endl;
-            cout << "  =============================================" << endl;
-            cout << "  This build uses the GitHub CHAI3D fork which" << endl;
-            cout << "  does NOT support Inverse3 protocol." << endl;
-            cout << endl;
-            cout << "  Symptoms you may experience:" << endl;
-            cout << "    - Position always reads (0, 0, 0)" << endl;
-            cout << "    - Device appears connected but doesn't track" << endl;
-            cout << "    - Force feedback may not work" << endl;
-            cout << endl;
-            cout << "  Solution - Use Official Demos:" << endl;
-            cout << "    .\\run-official-demos.ps1" << endl;
-            cout << endl;
-            cout << "  For details:" << endl;
-            cout << "    docs/INVERSE3_PROTOCOL_NOTES.md" << endl;
-            cout << "    docs/USING_OFFICIAL_CHAI3D.md" << endl;
-            cout << "  =============================================" << endl;
-            cout << endl;
-            cout << "  Attempting to continue anyway..." << endl;
-            cout << endl;
-        }
-
-        // Check for "no device" placeholder that CHAI3D returns on failure
-        if (info.m_modelName == "no device") {
-            cout << endl;
-            cout << "  =============================================" << endl;
-            cout << "  WARNING: Serial port error (ACCESS_DENIED)." << endl;
-            cout << "  =============================================" << endl;
-            cout << "  CHAI3D detected a serial port but could not"  << endl;
-            cout << "  open it. This usually means another process"  << endl;
-            cout << "  (e.g., Haply Hub) is holding the port."       << endl;
-            cout << endl;
-            cout << "  Fix:" << endl;
-            cout << "    - Close Haply Hub" << endl;
-            cout << "    - Run: .\\run.ps1 (auto-kills background services)" << endl;
-            cout << "  =============================================" << endl;
-            cout << endl;
-            cout << "  Continuing in VISUAL-ONLY mode..." << endl;
-            cout << endl;
-
-            hapticDeviceConnected = false;
-
-        } else if (!hapticDevice->open()) {
-            cout << endl;
-            cout << "  WARNING: Could not open device connection." << endl;
-            cout << "  Continuing in VISUAL-ONLY mode..." << endl;
-            cout << endl;
-
-            hapticDeviceConnected = false;
-
-        } else {
-            // Device opened successfully
-            cout << "[init] Device connection opened successfully." << endl;
-
-            hapticDevice->calibrate();
-            cout << "[init] Device calibrated." << endl;
-
-            hapticDeviceConnected = true;
-
-            // If Pantograph detected, confirm it's working
-            if (info.m_modelName.find("Pantograph") != std::string::npos) {
-                cout << "[init] Pantograph protocol active." << endl;
-                cout << "[init] Device should work correctly!" << endl;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (!openHapticDevice(candidates[i])) {
+                continue;
             }
+            HapticDeviceLoop& loop = deviceLoops[deviceLoopCount];
+            loop.index = deviceLoopCount++;
+            loop.device = candidates[i];
+            loop.model = candidates[i]->getSpecifications().m_modelName;
         }
+        hapticDeviceConnected = (deviceLoopCount > 0);
     }
 
     //-----------------------------------------------------------------------
-    // HAPTIC TOOL (only if device is connected)
+    // HAPTIC TOOLS (one per connected device)
     //-----------------------------------------------------------------------
     if (hapticDeviceConnected) {
-        cout << "[init] Creating haptic cursor..." << endl;
-        tool = new cToolCursor(world);
-        world->addChild(tool);
-        tool->setHapticDevice(hapticDevice);
-        tool->setRadius(0.015);              // Larger cursor (15mm) so it's visible
-        tool->setWorkspaceRadius(1.0);       // Wider workspace mapping for Pantograph
-        tool->enableDynamicObjects(true);
-        tool->start();
+        AIMLAB_LOG_INFO("[init] Creating haptic cursor%s...", deviceLoopCount > 1 ? "s" : "");
+        for (int i = 0; i < deviceLoopCount; i++) {
+            HapticDeviceLoop& loop = deviceLoops[i];
+            if (i > 0) {
+                string error;
+                loop.world = new (loop.nodes) PooledNode<cWorld>();
+                if (!buildHapticReplica(scene, options.meshCache, renderObjects,
+                                        loop.world, loop.nodes, loop.objects, error)) {
+                    AIMLAB_LOG_ERROR("[init] ERROR: %s", error.c_str());
+                    return 1;
+                }
+            }
+            setupDeviceLoop(loop);
+        }
 
-        // Make cursor visible with bright colors
-        tool->setShowEnabled(true);          // Ensure cursor rendering is enabled
-        tool->m_hapticPoint->m_sphereProxy->m_material->setWhite();
-        tool->m_hapticPoint->m_sphereGoal->m_material->setYellowGold();
+        // Unity bridge (optional; haptics run regardless)
+        if (options.bridgeEnabled) {
+            const char* bridgeName = options.bridgeName.empty() ? AIMLAB_BRIDGE_DEFAULT_NAME
+                                                                : options.bridgeName.c_str();
+            if (unityBridge.create(bridgeName, (uint32_t)deviceLoopCount)) {
+                AIMLAB_LOG_INFO("[init] Unity bridge ready: %s, %d tool slot%s", bridgeName,
+                                deviceLoopCount, deviceLoopCount > 1 ? "s" : "");
+            } else {
+                AIMLAB_LOG_WARN("[init] WARNING: Could not create Unity bridge segment.");
+            }
+        }
+
+        // UDP stream (optional; opened before the haptic threads start)
+        if (options.streamEnabled) {
+            string error;
+            if (hapticStream.open(options.stream, error)) {
+                AIMLAB_LOG_INFO("[init] Streaming tool state to %s:%u at %g Hz, %d sample%s per datagram",
+                                options.stream.host.c_str(), (unsigned)options.stream.port,
+                                options.stream.rateHz, options.stream.batch,
+                                options.stream.batch > 1 ? "s" : "");
+            } else {
+                AIMLAB_LOG_WARN("[init] WARNING: Could not open stream to %s:%u: %s",
+                                options.stream.host.c_str(), (unsigned)options.stream.port,
+                                error.c_str());
+            }
+        }
 
-        cout << "[init] Starting haptic rendering thread..." << endl;
-        hapticThread = new cThread();
-        hapticThread->start(updateHaptics, CTHREAD_PRIORITY_HAPTICS);
+        // Replay drives the pipeline from the main loop instead
+        if (replayDevice == nullptr) {
+            AIMLAB_LOG_INFO("[init] Starting %d haptic rendering thread%s...", deviceLoopCount,
+                            deviceLoopCount > 1 ? "s" : "");
+            startHapticPipeline();
+        }
     }
 
     //-----------------------------------------------------------------------
     // READY
     //-----------------------------------------------------------------------
-    cout << endl;
-    cout << "========================================" << endl;
-    if (hapticDeviceConnected) {
-        cout << "  Application ready (haptics ENABLED)"  << endl;
-    } else {
-        cout << "  Application ready (VISUAL-ONLY mode)" << endl;
-    }
-    cout << "========================================" << endl;
-    cout << "  Controls:" << endl;
-    cout << "    ESC / 'q' - Quit" << endl;
-    cout << "    'f'       - Fullscreen" << endl;
-    cout << "========================================" << endl;
-    cout << endl;
+    AIMLAB_LOG_INFO("\n"
+                    "========================================\n"
+                    "  Application ready (%s)\n"
+                    "========================================\n"
+                    "  Controls:\n"
+                    "    ESC / 'q' - Quit\n"
+                    "    'f'       - Fullscreen\n"
+                    "    'r'       - Restart haptic pipeline\n"
+                    "========================================\n",
+                    hapticDeviceConnected ? "haptics ENABLED" : "VISUAL-ONLY mode");
 
     // Show helpful next steps if no haptics
     if (!hapticDeviceConnected) {
-        cout << "  Next Steps:" << endl;
-        cout << "     - For Pantograph: Close Haply Hub, run .\\run.ps1" << endl;
-        cout << "     - For Inverse3: Run .\\run-official-demos.ps1" << endl;
-        cout << "     - See docs/ folder for troubleshooting guides" << endl;
-        cout << endl;
+        AIMLAB_LOG_INFO("  Next Steps:\n"
+                        "     - For Pantograph: Close Haply Hub, run .\\run.ps1\n"
+                        "     - For Inverse3: Run .\\run-official-demos.ps1\n"
+                        "     - Without hardware: run with --device sim\n"
+                        "     - See docs/ folder for troubleshooting guides\n");
     }
 
     //-----------------------------------------------------------------------
     // MAIN LOOP
     //-----------------------------------------------------------------------
-    glutMainLoop();
+    if (replayDevice != nullptr) {
+        runReplay();
+    } else if (options.headless) {
+        runHeadless();
+    } else if (options.graphicsEnabled) {
+        glutMainLoop();                 // returns after requestQuit() (freeglut)
+    } else if (!hapticDeviceConnected) {
+        AIMLAB_LOG_WARN("  Nothing to run: no graphics and no haptic device.");
+    } else if (options.restartCycles > 0) {
+        runRestartCycles();
+    } else {
+        // Haptics run on their own thread; just wait out the requested duration
+        cPrecisionClock runClock;
+        runClock.start(true);
+        while (options.durationSeconds <= 0.0 ||
+               runClock.getCurrentTimeSeconds() < options.durationSeconds) {
+            dumpHapticStats(acquireSceneSnapshot(deviceLoops[0]));
+            cSleepMs(10);
+        }
+    }
 
-    return 0;
+    close();
+    return exitCode;
 }
@@ -0,0 +1,297 @@
+/****************************************************************************
+ * AIMLAB - Session Recording Tool
+ *
+ * Author: Pi Ko (pi.ko@nyu.edu)
+ * Date: 16 October 2026
+ * Version: v1.3
+ *
+ * Description:
+ *   Inspects and converts .aimrec files written by aimlab-haptics --record.
+ *
+ *     info     Header, record count, duration, rate and timing gaps
+ *     csv      One row per tick; doubles printed with %.17g so values
+ *              round-trip exactly
+ *     columns  One raw little-endian file per field plus schema.json, in
+ *              the spirit of a Parquet column chunk: each field loads
+ *              directly, e.g. numpy.fromfile("force_x.f64", "<f8")
+ *
+ * Usage:
+ *   aimlab-recording info    FILE
+ *   aimlab-recording csv     FILE [OUT.csv]       (stdout if omitted)
+ *   aimlab-recording columns FILE OUTDIR
+ *
+ * Changelog:
+ *   v1.3 - 16 October 2026 - info prints the device filter of format 4 recordings
+ *   v1.2 - 16 October 2026 - info prints the scene file of format 3 recordings
+ *   v1.1 - 16 October 2026 - info prints the format 2 device specifications and material
+ *   v1.0 - 16 October 2026 - Initial implementation
+ *
+ ****************************************************************************/
+
+#include "SessionReader.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+    #include <direct.h>
+#else
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+
+//===========================================================================
+// FIELDS
+//===========================================================================
+
+// Double-valued fields in record order (see HapticRecord.h)
+static const char* const DOUBLE_FIELDS[] = {
+    "device_x", "device_y", "device_z",
+    "rot_00", "rot_01", "rot_02", "rot_10", "rot_11", "rot_12", "rot_20", "rot_21", "rot_22",
+    "vel_x", "vel_y", "vel_z",
+    "angvel_x", "angvel_y", "angvel_z",
+    "gripper_angle", "gripper_angvel",
+    "proxy_x", "proxy_y", "proxy_z",
+    "force_x", "force_y", "force_z",
+    "torque_x", "torque_y", "torque_z",
+    "gripper_force"
+};
+static const int DOUBLE_FIELD_COUNT = (int)(sizeof(DOUBLE_FIELDS) / sizeof(DOUBLE_FIELDS[0]));
+
+static void doubleValues(const HapticRecord& r, double* out) {
+    int n = 0;
+    for (int k = 0; k < 3; k++) out[n++] = r.device.position[k];
+    for (int k = 0; k < 9; k++) out[n++] = r.device.rotation[k];
+    for (int k = 0; k < 3; k++) out[n++] = r.device.linearVelocity[k];
+    for (int k = 0; k < 3; k++) out[n++] = r.device.angularVelocity[k];
+    out[n++] = r.device.gripperAngle;
+    out[n++] = r.device.gripperAngularVelocity;
+    for (int k = 0; k < 3; k++) out[n++] = r.proxyPos[k];
+    for (int k = 0; k < 3; k++) out[n++] = r.force[k];
+    for (int k = 0; k < 3; k++) out[n++] = r.torque[k];
+    out[n++] = r.gripperForce;
+}
+
+static bool openReader(SessionReader& reader, const char* filename) {
+    string error;
+    if (!reader.open(filename, error)) {
+        fprintf(stderr, "error: %s\n", error.c_str());
+        return false;
+    }
+    return true;
+}
+
+//===========================================================================
+// COMMANDS
+//===========================================================================
+
+static int commandInfo(const char* filename) {
+    SessionReader reader;
+    if (!openReader(reader, filename)) {
+        return 1;
+    }
+
+    const SessionFileHeader& h = reader.header();
+    HapticRecord r;
+    uint32_t dropped = 0;
+    uint64_t totalDropped = 0, records = 0, firstNs = 0, lastNs = 0, maxGapNs = 0, prevNs = 0;
+    while (reader.next(r, &dropped)) {
+        if (records == 0) {
+            firstNs = r.timestampNs;
+        } else if (r.timestampNs - prevNs > maxGapNs) {
+            maxGapNs = r.timestampNs - prevNs;
+        }
+        prevNs = lastNs = r.timestampNs;
+        totalDropped += dropped;
+        records++;
+    }
+
+    const double span = (records > 1) ? (double)(lastNs - firstNs) * 1e-9 : 0.0;
+    printf("file         : %s\n", filename);
+    printf("format       : version %u, %u-byte records\n", h.version, h.recordBytes);
+    printf("device       : %s\n", h.deviceModel);
+    printf("nominal rate : %s\n", h.nominalRateHz > 0.0 ? (to_string((int)h.nominalRateHz) + " Hz").c_str()
+                                                        : "free-running");
+    if (h.version >= 2) {
+        printf("workspace    : %.4f m radius, max force %.2f N, max stiffness %.0f N/m\n",
+               h.device.workspaceRadius, h.device.maxLinearForce, h.device.maxLinearStiffness);
+        printf("material     : stiffness %g N/m, friction %g/%g, viscosity %g\n",
+               h.material.stiffness, h.material.staticFriction, h.material.dynamicFriction,
+               h.material.viscosity);
+        if (h.version >= 3) {
+            printf("scene        : %s\n", h.sceneFile[0] ? h.sceneFile : "built-in");
+        }
+        if (h.version >= 4 && (h.flags & AIMLAB_REC_FLAG_DEVICE_FILTER)) {
+            char damping[32] = "device maximum";
+            if (h.filter.maxDamping > 0.0) {
+                snprintf(damping, sizeof(damping), "%g N.s/m", h.filter.maxDamping);
+            }
+            printf("device filter: window %d, horizon %g ms, cutoff %g Hz, passivity %s "
+                   "(max damping %s)\n", h.filter.window, h.filter.horizonS * 1e3,
+                   h.filter.cutoffHz, h.filter.passivity ? "on" : "off", damping);
+        }
+        if (h.flags & AIMLAB_REC_FLAG_BRIDGE_MOVED) {
+            printf("note         : Unity moved objects during the session (not recorded)\n");
+        }
+    }
+    printf("records      : %llu (%llu dropped while recording)\n",
+           (unsigned long long)records, (unsigned long long)totalDropped);
+    printf("duration     : %.3f s\n", span);
+    if (span > 0.0) {
+        printf("mean rate    : %.1f Hz\n", (double)(records - 1) / span);
+        printf("largest gap  : %.3f ms\n", (double)maxGapNs * 1e-6);
+    }
+    return 0;
+}
+
+static int commandCsv(const char* filename, const char* outName) {
+    SessionReader reader;
+    if (!openReader(reader, filename)) {
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (outName != nullptr) {
+        out = fopen(outName, "w");
+        if (out == nullptr) {
+            fprintf(stderr, "error: cannot create %s\n", outName);
+            return 1;
+        }
+    }
+
+    fprintf(out, "t_s,t_ns,dropped,switches");
+    for (int i = 0; i < DOUBLE_FIELD_COUNT; i++) {
+        fprintf(out, ",%s", DOUBLE_FIELDS[i]);
+    }
+    fprintf(out, "\n");
+
+    const uint64_t startNs = reader.header().startNs;
+    HapticRecord r;
+    uint32_t dropped = 0;
+    double values[DOUBLE_FIELD_COUNT];
+    while (reader.next(r, &dropped)) {
+        fprintf(out, "%.9f,%llu,%u,%u", (double)(r.timestampNs - startNs) * 1e-9,
+                (unsigned long long)r.timestampNs, dropped, r.device.userSwitches);
+        doubleValues(r, values);
+        for (int i = 0; i < DOUBLE_FIELD_COUNT; i++) {
+            fprintf(out, ",%.17g", values[i]);
+        }
+        fprintf(out, "\n");
+    }
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
+
+static int commandColumns(const char* filename, const char* outDir) {
+    SessionReader reader;
+    if (!openReader(reader, filename)) {
+        return 1;
+    }
+
+#ifdef _WIN32
+    _mkdir(outDir);
+#else
+    mkdir(outDir, 0755);
+#endif
+
+    const string dir = string(outDir) + "/";
+    vector<FILE*> files;
+    vector<string> names;
+    vector<string> types;
+
+    // Integer columns first, then every double field
+    names.push_back("t_ns");     types.push_back("u64");
+    names.push_back("dropped");  types.push_back("u32");
+    names.push_back("switches"); types.push_back("u32");
+    for (int i = 0; i < DOUBLE_FIELD_COUNT; i++) {
+        names.push_back(DOUBLE_FIELDS[i]);
+        types.push_back("f64");
+    }
+    for (size_t i = 0; i < names.size(); i++) {
+        const string path = dir + names[i] + "." + types[i];
+        FILE* f = fopen(path.c_str(), "wb");
+        if (f == nullptr) {
+            fprintf(stderr, "error: cannot create %s\n", path.c_str());
+            for (size_t j = 0; j < files.size(); j++) {
+                fclose(files[j]);
+            }
+            return 1;
+        }
+        files.push_back(f);
+    }
+
+    HapticRecord r;
+    uint32_t dropped = 0;
+    double values[DOUBLE_FIELD_COUNT];
+    uint64_t rows = 0;
+    while (reader.next(r, &dropped)) {
+        fwrite(&r.timestampNs, sizeof(uint64_t), 1, files[0]);
+        fwrite(&dropped, sizeof(uint32_t), 1, files[1]);
+        fwrite(&r.device.userSwitches, sizeof(uint32_t), 1, files[2]);
+        doubleValues(r, values);
+        for (int i = 0; i < DOUBLE_FIELD_COUNT; i++) {
+            fwrite(&values[i], sizeof(double), 1, files[3 + i]);
+        }
+        rows++;
+    }
+    for (size_t i = 0; i < files.size(); i++) {
+        fclose(files[i]);
+    }
+
+    // numpy dtype strings; all columns are little-endian
+    const string schemaPath = dir + "schema.json";
+    FILE* schema = fopen(schemaPath.c_str(), "w");
+    if (schema == nullptr) {
+        fprintf(stderr, "error: cannot create %s\n", schemaPath.c_str());
+        return 1;
+    }
+    const SessionFileHeader& h = reader.header();
+    fprintf(schema, "{\n  \"source\": \"%s\",\n  \"rows\": %llu,\n  \"start_ns\": %llu,\n"
+                    "  \"nominal_rate_hz\": %g,\n  \"device\": \"%s\",\n  \"columns\": [\n",
+            filename, (unsigned long long)rows, (unsigned long long)h.startNs,
+            h.nominalRateHz, h.deviceModel);
+    for (size_t i = 0; i < names.size(); i++) {
+        const char* dtype = (types[i] == "u64") ? "<u8" : (types[i] == "u32") ? "<u4" : "<f8";
+        fprintf(schema, "    { \"name\": \"%s\", \"file\": \"%s.%s\", \"dtype\": \"%s\" }%s\n",
+                names[i].c_str(), names[i].c_str(), types[i].c_str(), dtype,
+                (i + 1 < names.size()) ? "," : "");
+    }
+    fprintf(schema, "  ]\n}\n");
+    fclose(schema);
+
+    printf("%llu rows x %zu columns written to %s\n",
+           (unsigned long long)rows, names.size(), outDir);
+    return 0;
+}
+
+//===========================================================================
+// MAIN
+//===========================================================================
+
+static void printUsage(const char* program) {
+    fprintf(stderr,
+            "usage: %s info    FILE\n"
+            "       %s csv     FILE [OUT.csv]\n"
+            "       %s columns FILE OUTDIR\n",
+            program, program, program);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && !strcmp(argv[1], "info")) {
+        return commandInfo(argv[2]);
+    }
+    if (argc >= 3 && !strcmp(argv[1], "csv")) {
+        return commandCsv(argv[2], argc >= 4 ? argv[3] : nullptr);
+    }
+    if (argc >= 4 && !strcmp(argv[1], "columns")) {
+        return commandColumns(argv[2], argv[3]);
+    }
+    printUsage(argv[0]);
+    return 1;
+}